@@ -1,7 +1,10 @@
 #include "AudioCapture.h"
+#include "MemoryAccounting.h"
 #include <iostream>
 #include <cstring>
 #include <algorithm>
+#include <pthread.h>
+#include <sched.h>
 
 namespace NovaVoice {
 
@@ -11,11 +14,21 @@ AudioCapture::AudioCapture()
     , deviceName_("default")
     , isInitialized_(false)
     , isCapturing_(false)
+    , pcmTapSessionId_(0)
+    , processStage_(StageProfiler::INVALID_STAGE)
+    , lastPeriodFrames_(0)
+    , periodFrames_(Config::FRAMES_PER_BUFFER)
+    , periodsPerBuffer_(Config::PERIODS_PER_BUFFER)
+    , linkedDrive_(false)
+    , rtPriority_(0)
     , gain_(Config::VOLUME_GAIN)
     , capturedFrames_(0)
-    , bufferOverruns_(0) {
+    , bufferOverruns_(0)
+    , truncatedPeriods_(0) {
+    MemoryScope memory(MemoryTag::AUDIO_IO);
     
-    captureBuffer_.resize(Config::FRAMES_PER_BUFFER * Config::CHANNELS * (Config::BITS_PER_SAMPLE / 8));
+    captureBuffer_.resize(Config::MAX_PERIOD_FRAMES * Config::CHANNELS * (Config::BITS_PER_SAMPLE / 8));
+    processBuffer_.resize(captureBuffer_.size());
 }
 
 AudioCapture::~AudioCapture() {
@@ -53,11 +66,13 @@ bool AudioCapture::initialize(const std::string& deviceName) {
 bool AudioCapture::configureDevice() {
     int error;
     
-    // Hardware parametreleri için alan ayır
-    error = snd_pcm_hw_params_malloc(&hwParams_);
-    if (error < 0) {
-        handleAlsaError("snd_pcm_hw_params_malloc", error);
-        return false;
+    // Hardware parametreleri için alan ayır (yeniden yapılandırmada mevcut alan kullanılır)
+    if (!hwParams_) {
+        error = snd_pcm_hw_params_malloc(&hwParams_);
+        if (error < 0) {
+            handleAlsaError("snd_pcm_hw_params_malloc", error);
+            return false;
+        }
     }
     
     // Mevcut hardware parametrelerini al
@@ -100,14 +115,28 @@ bool AudioCapture::configureDevice() {
         logInfo("Sample rate ayarlandı: " + std::to_string(sampleRate) + " Hz (istenen: " + std::to_string(Config::SAMPLE_RATE) + " Hz)");
     }
     
-    // Buffer boyutunu ayarla
-    snd_pcm_uframes_t frames = Config::FRAMES_PER_BUFFER;
+    // Buffer boyutunu ayarla; ses buffer'ları MAX_PERIOD_FRAMES için ayrıldı
+    snd_pcm_uframes_t maxFrames = Config::MAX_PERIOD_FRAMES;
+    error = snd_pcm_hw_params_set_period_size_max(pcmHandle_, hwParams_, &maxFrames, nullptr);
+    if (error < 0) {
+        handleAlsaError("snd_pcm_hw_params_set_period_size_max", error);
+        return false;
+    }
+    
+    snd_pcm_uframes_t frames = periodFrames_;
     error = snd_pcm_hw_params_set_period_size_near(pcmHandle_, hwParams_, &frames, nullptr);
     if (error < 0) {
         handleAlsaError("snd_pcm_hw_params_set_period_size_near", error);
         return false;
     }
     
+    snd_pcm_uframes_t bufferFrames = frames * periodsPerBuffer_;
+    error = snd_pcm_hw_params_set_buffer_size_near(pcmHandle_, hwParams_, &bufferFrames);
+    if (error < 0) {
+        handleAlsaError("snd_pcm_hw_params_set_buffer_size_near", error);
+        return false;
+    }
+    
     // Hardware parametrelerini uygula
     error = snd_pcm_hw_params(pcmHandle_, hwParams_);
     if (error < 0) {
@@ -115,9 +144,62 @@ bool AudioCapture::configureDevice() {
         return false;
     }
     
+    // Cihazın gerçekte seçtiği periyodu kullan; buffer'lardan büyükse kırpmak sayaçları
+    // donanımdan ayırır, bu yüzden yapılandırma reddedilir
+    error = snd_pcm_hw_params_get_period_size(hwParams_, &frames, nullptr);
+    if (error < 0) {
+        handleAlsaError("snd_pcm_hw_params_get_period_size", error);
+        return false;
+    }
+    
+    if (frames > Config::MAX_PERIOD_FRAMES) {
+        logError("Cihaz periyodu desteklenenden büyük: " + std::to_string(frames) + " frame (en fazla " +
+                 std::to_string(Config::MAX_PERIOD_FRAMES) + ")");
+        return false;
+    }
+    periodFrames_ = static_cast<size_t>(frames);
+    
     return true;
 }
 
+bool AudioCapture::setPeriodFrames(size_t frames) {
+    if (!pcmHandle_) {
+        return false;
+    }
+    
+    // hw parametreleri yalnızca SETUP durumunda değiştirilebilir
+    snd_pcm_drop(pcmHandle_);
+    
+    size_t previous = periodFrames_;
+    periodFrames_ = std::max(Config::MIN_PERIOD_FRAMES, std::min(frames, Config::MAX_PERIOD_FRAMES));
+    
+    if (!configureDevice()) {
+        // Eski ayara geri dön
+        periodFrames_ = previous;
+        configureDevice();
+        return false;
+    }
+    
+    logInfo("Capture periyodu: " + std::to_string(previous) + " -> " + std::to_string(periodFrames_.load()) + " frame");
+    return true;
+}
+
+bool AudioCapture::applyProfile(const LatencyProfile& profile) {
+    if (isCapturing_) {
+        logError("Profil çalışırken uygulanamaz");
+        return false;
+    }
+    
+    periodsPerBuffer_ = std::max<size_t>(2, profile.periodsPerBuffer);
+    rtPriority_ = profile.rtPriority;
+    if (!pcmHandle_) {
+        periodFrames_ = std::max(Config::MIN_PERIOD_FRAMES, std::min(profile.periodFrames, Config::MAX_PERIOD_FRAMES));
+        return true;
+    }
+    
+    return setPeriodFrames(profile.periodFrames);
+}
+
 void AudioCapture::cleanup() {
     if (hwParams_) {
         snd_pcm_hw_params_free(hwParams_);
@@ -157,12 +239,42 @@ bool AudioCapture::start() {
     return true;
 }
 
+bool AudioCapture::startLinked() {
+    if (!isInitialized_) {
+        logError("AudioCapture başlatılmamış");
+        return false;
+    }
+    
+    if (isCapturing_) {
+        logError("AudioCapture zaten çalışıyor");
+        return false;
+    }
+    
+    // PCM hazırlığı ve başlatma AudioDuplex tarafından yapılır
+    isCapturing_ = true;
+    linkedDrive_ = true;
+    lastPeriodFrames_ = 0;
+    
+    logInfo("AudioCapture harici sürüş modunda başlatıldı");
+    return true;
+}
+
+bool AudioCapture::processPeriod() {
+    return readAudioData();
+}
+
+const int16_t* AudioCapture::getLastPeriod(size_t& frames) const {
+    frames = lastPeriodFrames_;
+    return reinterpret_cast<const int16_t*>(captureBuffer_.data());
+}
+
 void AudioCapture::stop() {
     if (!isCapturing_) {
         return;
     }
     
     isCapturing_ = false;
+    linkedDrive_ = false;
     
     // PCM'i durdur
     if (pcmHandle_) {
@@ -174,6 +286,9 @@ void AudioCapture::stop() {
         captureThread_.join();
     }
     
+    if (truncatedPeriods_ > 0) {
+        logError("İşleme buffer'ına sığmayıp kesilen periyot: " + std::to_string(truncatedPeriods_.load()));
+    }
     logInfo("AudioCapture durduruldu");
 }
 
@@ -181,6 +296,20 @@ void AudioCapture::setBufferManager(std::shared_ptr<BufferManager> bufferManager
     bufferManager_ = bufferManager;
 }
 
+void AudioCapture::setSidetone(std::shared_ptr<Sidetone> sidetone) {
+    sidetone_ = sidetone;
+}
+
+void AudioCapture::setPcmTap(std::shared_ptr<PcmTapPublisher> tap, uint32_t sessionId) {
+    pcmTap_ = tap;
+    pcmTapSessionId_ = sessionId;
+}
+
+void AudioCapture::setStageProfiler(std::shared_ptr<StageProfiler> profiler) {
+    profiler_ = profiler;
+    processStage_ = profiler_ ? profiler_->addStage("capture.process") : StageProfiler::INVALID_STAGE;
+}
+
 void AudioCapture::setOnAudioCaptured(std::function<void(const uint8_t*, size_t)> callback) {
     onAudioCaptured_ = callback;
 }
@@ -190,45 +319,108 @@ void AudioCapture::setGain(float gain) {
 }
 
 void AudioCapture::captureLoop() {
+    applyRealtimePriority();
+    RealtimeSection realtime("capture");
+    
     while (isCapturing_) {
         if (!readAudioData()) {
             // Hata durumunda kısa bekle
+            BlockingSection blocking;
             std::this_thread::sleep_for(std::chrono::milliseconds(10));
         }
     }
 }
 
+void AudioCapture::applyRealtimePriority() {
+    if (rtPriority_ <= 0) {
+        return;
+    }
+    
+    struct sched_param param;
+    std::memset(&param, 0, sizeof(param));
+    param.sched_priority = rtPriority_;
+    
+    int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (error != 0) {
+        logError(std::string("SCHED_FIFO ayarlanamadı (normal öncelikle devam): ") + std::strerror(error));
+        return;
+    }
+    
+    logInfo("Capture thread'i SCHED_FIFO önceliği: " + std::to_string(rtPriority_));
+}
+
 bool AudioCapture::readAudioData() {
     if (!pcmHandle_ || !isCapturing_) {
         return false;
     }
     
-    snd_pcm_sframes_t framesRead = snd_pcm_readi(pcmHandle_, 
-                                                 captureBuffer_.data(), 
-                                                 Config::FRAMES_PER_BUFFER);
+    // Tek bilinçli bekleme noktası: periyot dolana kadar bloklar
+    snd_pcm_sframes_t framesRead;
+    {
+        BlockingSection blocking;
+        framesRead = snd_pcm_readi(pcmHandle_, captureBuffer_.data(), periodFrames_);
+    }
+    
+    lastPeriodFrames_ = framesRead > 0 ? static_cast<size_t>(framesRead) : 0;
     
     if (framesRead < 0) {
-        if (framesRead == -EPIPE) {
-            // Buffer overrun
+        if (framesRead == -EPIPE || framesRead == -ESTRPIPE) {
+            // Buffer overrun veya askıya alma
             bufferOverruns_++;
-            logError("Buffer overrun oluştu");
-            
-            // PCM'i yeniden hazırla
-            int error = snd_pcm_prepare(pcmHandle_);
-            if (error < 0) {
-                handleAlsaError("snd_pcm_prepare (recovery)", error);
-                return false;
-            }
+            return recoverFromXrun(static_cast<int>(framesRead));
         } else {
             handleAlsaError("snd_pcm_readi", framesRead);
             return false;
         }
     } else if (framesRead > 0) {
-        size_t bytesRead = framesRead * Config::CHANNELS * (Config::BITS_PER_SAMPLE / 8);
-        processAudioData(captureBuffer_.data(), bytesRead);
-        capturedFrames_ += framesRead;
+        processCapturedPeriod(reinterpret_cast<const int16_t*>(captureBuffer_.data()),
+                              static_cast<size_t>(framesRead));
+        xrunTracker_.markIo();
+    }
+    
+    return true;
+}
+
+bool AudioCapture::processCapturedPeriod(const int16_t* samples, size_t frames) {
+    if (!samples || frames == 0) {
+        return false;
     }
     
+    size_t bytes = frames * Config::CHANNELS * (Config::BITS_PER_SAMPLE / 8);
+    StageProfiler::Scope scope(profiler_.get(), processStage_);
+    processAudioData(reinterpret_cast<const uint8_t*>(samples), bytes);
+    capturedFrames_ += frames;
+    return true;
+}
+
+bool AudioCapture::recoverFromXrun(int error) {
+    auto detected = std::chrono::steady_clock::now();
+    bool suspended = (error == -ESTRPIPE);
+    
+    // snd_pcm_recover: EPIPE için prepare, ESTRPIPE için resume (gerekirse prepare)
+    int result = snd_pcm_recover(pcmHandle_, error, 1);
+    
+    // Capture prepare sonrası PREPARED kalır; kesinti süresini kısaltmak için hemen başlat.
+    // Linked modda playback de hazırlanmıştır, önce ön doldurulması gerekir (AudioDuplex)
+    if (result >= 0 && !linkedDrive_ && snd_pcm_state(pcmHandle_) == SND_PCM_STATE_PREPARED) {
+        result = snd_pcm_start(pcmHandle_);
+    }
+    
+    uint64_t lostFrames = xrunTracker_.recordRecovery(detected, suspended, result >= 0, periodFrames_);
+    
+    if (result < 0) {
+        handleAlsaError("snd_pcm_recover (capture)", result);
+        return false;
+    }
+    
+    // Medya saatini kayıp kadar ilerlet
+    if (bufferManager_ && lostFrames >= periodFrames_) {
+        bufferManager_->skipInputSequence(static_cast<uint32_t>(lostFrames / periodFrames_));
+    }
+    
+    XrunStats stats = xrunTracker_.getStats();
+    logError(std::string(suspended ? "Cihaz askıya alındı" : "Buffer overrun oluştu") +
+             ", kurtarma: " + std::to_string(static_cast<int>(stats.lastRecoveryUs)) + " us");
     return true;
 }
 
@@ -237,22 +429,40 @@ void AudioCapture::processAudioData(const uint8_t* data, size_t size) {
         return;
     }
     
-    // Gain uygulamak için kopya oluştur
-    std::vector<uint8_t> processedData(data, data + size);
+    // Gain uygulamak için kopya (ham periyot gecikme ölçümü için korunur).
+    // Sığmayan kısım atılır; ses thread'inde loglanmaz, sayılır
+    if (size > processBuffer_.size()) {
+        truncatedPeriods_++;
+        size = processBuffer_.size();
+    }
+    uint8_t* processedData = processBuffer_.data();
+    std::memcpy(processedData, data, size);
     
     // Gain uygula
     if (gain_ != 1.0f) {
-        applyGain(processedData.data(), size);
+        applyGain(processedData, size);
+    }
+    
+    // Sidetone: ağır DSP ve ağ yolundan önce
+    if (sidetone_) {
+        sidetone_->push(reinterpret_cast<const int16_t*>(processedData),
+                        size / (Config::CHANNELS * (Config::BITS_PER_SAMPLE / 8)));
+    }
+    
+    // Dış dinleyiciler: örnekler doğrudan paylaşılan ring'e yazılır, okuyucu beklenmez
+    if (pcmTap_) {
+        pcmTap_->write(pcmTapSessionId_, reinterpret_cast<const int16_t*>(processedData),
+                       size / (Config::BITS_PER_SAMPLE / 8), Config::SAMPLE_RATE, true);
     }
     
     // Buffer manager'a gönder
     if (bufferManager_) {
-        bufferManager_->pushInputBuffer(processedData.data(), size);
+        bufferManager_->pushInputBuffer(processedData, size);
     }
     
     // Callback çağır
     if (onAudioCaptured_) {
-        onAudioCaptured_(processedData.data(), size);
+        onAudioCaptured_(processedData, size);
     }
 }
 
@@ -7,6 +7,12 @@
 #include <alsa/asoundlib.h>
 #include "Config.h"
 #include "BufferManager.h"
+#include "XrunTracker.h"
+#include "Sidetone.h"
+#include "PcmTap.h"
+#include "LatencyProfile.h"
+#include "StageProfiler.h"
+#include "RealtimeCheck.h"
 
 namespace NovaVoice {
 
@@ -20,9 +26,37 @@ public:
     bool start();
     void stop();
     
+    // Harici sürüş (AudioDuplex): thread başlatmadan çalışma durumuna geçer,
+    // her periyot processPeriod() ile okunur
+    bool startLinked();
+    bool processPeriod();
+    const int16_t* getLastPeriod(size_t& frames) const;
+    
+    // Okuma sonrası periyot gövdesi (gain, sidetone, tap, gönderim kuyruğu);
+    // cihazdan bağımsız çağrılabilir (nova_bench rtcheck aynı yolu ölçer)
+    bool processCapturedPeriod(const int16_t* samples, size_t frames);
+    snd_pcm_t* getPcmHandle() const { return pcmHandle_; }
+    
+    // Periyot boyutunu yeniden müzakere eder: akışı durdurur (drop) ve
+    // hw parametrelerini yeniden uygular. Sonrasında prepare/start çağıranındır.
+    bool setPeriodFrames(size_t frames);
+    size_t getPeriodFrames() const { return periodFrames_; }
+    
+    // Profilin periyot ve buffer derinliği (start öncesi; açık cihazda yeniden müzakere)
+    bool applyProfile(const LatencyProfile& profile);
+    
     // Buffer manager bağlantısı
     void setBufferManager(std::shared_ptr<BufferManager> bufferManager);
     
+    // Gain sonrası örnekleri doğrudan playback'e kopyalayan sidetone yolu
+    void setSidetone(std::shared_ptr<Sidetone> sidetone);
+    
+    // İşlenmiş periyotları dış süreçlere yayınlayan tap (sessionId: yerel akış kimliği)
+    void setPcmTap(std::shared_ptr<PcmTapPublisher> tap, uint32_t sessionId);
+    
+    // Periyot işleme süresi ve donanım sayaçları ("capture.process")
+    void setStageProfiler(std::shared_ptr<StageProfiler> profiler);
+    
     // Callback ayarlama
     void setOnAudioCaptured(std::function<void(const uint8_t*, size_t)> callback);
     
@@ -37,6 +71,8 @@ public:
     // İstatistikler
     uint64_t getCapturedFrames() const { return capturedFrames_; }
     uint64_t getBufferOverruns() const { return bufferOverruns_; }
+    uint64_t getTruncatedPeriods() const { return truncatedPeriods_; }  // İşleme buffer'ına sığmayıp kesilen periyotlar
+    XrunStats getXrunStats() const { return xrunTracker_.getStats(); }
     
     // Cihaz bilgileri
     std::string getDeviceName() const { return deviceName_; }
@@ -59,7 +95,18 @@ private:
     
     // Buffer yönetimi
     std::shared_ptr<BufferManager> bufferManager_;
+    std::shared_ptr<Sidetone> sidetone_;
+    std::shared_ptr<PcmTapPublisher> pcmTap_;
+    uint32_t pcmTapSessionId_;
+    std::shared_ptr<StageProfiler> profiler_;
+    int processStage_;
     std::vector<uint8_t> captureBuffer_;
+    std::vector<uint8_t> processBuffer_;  // Gain uygulanmış kopya (ses thread'inde ayırma yok)
+    size_t lastPeriodFrames_;
+    std::atomic<size_t> periodFrames_;  // Cihazın kabul ettiği periyot (frame)
+    size_t periodsPerBuffer_;           // ALSA buffer = periyot x bu değer
+    bool linkedDrive_;  // Linked modda yeniden başlatma AudioDuplex'e bırakılır
+    int rtPriority_;    // Capture thread'i SCHED_FIFO önceliği (0: değiştirme)
     
     // Ses ayarları
     float gain_;
@@ -70,12 +117,16 @@ private:
     // İstatistikler
     std::atomic<uint64_t> capturedFrames_;
     std::atomic<uint64_t> bufferOverruns_;
+    std::atomic<uint64_t> truncatedPeriods_;
+    XrunTracker xrunTracker_;
     
     // İç metodlar
     bool configureDevice();
     void cleanup();
     void captureLoop();
+    void applyRealtimePriority();
     bool readAudioData();
+    bool recoverFromXrun(int error);
     void processAudioData(const uint8_t* data, size_t size);
     void applyGain(uint8_t* data, size_t size);
     
@@ -0,0 +1,354 @@
+#include "AudioDuplex.h"
+#include <iostream>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <chrono>
+
+namespace NovaVoice {
+
+AudioDuplex::AudioDuplex()
+    : isInitialized_(false)
+    , isLinked_(false)
+    , isRunning_(false)
+    , probeEnabled_(false)
+    , rtPriority_(Config::AUDIO_RT_PRIORITY)
+    , adaptivePeriod_(false)
+    , lastSwitchUs_(0)
+    , periods_(0)
+    , wakeups_(0)
+    , errors_(0)
+    , captureStartDelay_(0)
+    , playbackStartDelay_(0) {
+}
+
+AudioDuplex::~AudioDuplex() {
+    stop();
+}
+
+bool AudioDuplex::initialize(std::shared_ptr<AudioCapture> capture, std::shared_ptr<AudioPlayer> player) {
+    if (!capture || !player || !capture->isInitialized() || !player->isInitialized()) {
+        logError("Capture ve player önce başlatılmalı");
+        return false;
+    }
+
+    // Servis döngüsü her capture periyoduna aynı boyda bir playback yazımı yapar
+    if (capture->getPeriodFrames() != player->getPeriodFrames()) {
+        logError("Capture ve playback farklı periyot kabul etti (" + std::to_string(capture->getPeriodFrames()) +
+                 " / " + std::to_string(player->getPeriodFrames()) + " frame)");
+        return false;
+    }
+
+    capture_ = capture;
+    player_ = player;
+    isInitialized_ = true;
+
+    logInfo("AudioDuplex başlatıldı");
+    return true;
+}
+
+void AudioDuplex::enableLatencyProbe(bool enable) {
+    if (isRunning_) {
+        logError("Latency probe çalışırken değiştirilemez");
+        return;
+    }
+
+    probeEnabled_ = enable;
+}
+
+void AudioDuplex::enableAdaptivePeriod(bool enable) {
+    if (isRunning_) {
+        logError("Periyot uyarlama çalışırken değiştirilemez");
+        return;
+    }
+
+    adaptivePeriod_ = enable;
+}
+
+void AudioDuplex::setRealtimePriority(int priority) {
+    if (isRunning_) {
+        logError("Thread önceliği çalışırken değiştirilemez");
+        return;
+    }
+
+    rtPriority_ = priority;
+}
+
+bool AudioDuplex::start() {
+    if (!isInitialized_) {
+        logError("AudioDuplex başlatılmamış");
+        return false;
+    }
+
+    if (isRunning_) {
+        logError("AudioDuplex zaten çalışıyor");
+        return false;
+    }
+
+    if (!capture_->startLinked() || !player_->startLinked()) {
+        stop();
+        return false;
+    }
+
+    if (probeEnabled_) {
+        player_->setOnBeforeWrite([this](int16_t* samples, size_t frames) {
+            probe_.onPlayback(samples, frames);
+        });
+    }
+
+    if (!startStreams()) {
+        stop();
+        return false;
+    }
+
+    if (adaptivePeriod_) {
+        tuner_.reset(player_->getPeriodFrames());
+    }
+
+    periods_ = 0;
+    wakeups_ = 0;
+    errors_ = 0;
+    isRunning_ = true;
+    serviceThread_ = std::thread(&AudioDuplex::serviceLoop, this);
+
+    logInfo(std::string("Full-duplex akış başlatıldı (") + (isLinked_ ? "linked" : "bağlantısız") +
+            ", başlangıç farkı: " + std::to_string(playbackStartDelay_ - captureStartDelay_) + " frame)");
+    return true;
+}
+
+bool AudioDuplex::startStreams(bool concealGap) {
+    snd_pcm_t* capturePcm = capture_->getPcmHandle();
+    snd_pcm_t* playbackPcm = player_->getPcmHandle();
+
+    // Akışları bağla: prepare/start/drop artık iki akışa birlikte uygulanır
+    int error = snd_pcm_link(capturePcm, playbackPcm);
+    if (error < 0) {
+        handleAlsaError("snd_pcm_link (bağlantısız devam ediliyor)", error);
+        isLinked_ = false;
+    } else {
+        isLinked_ = true;
+    }
+
+    error = snd_pcm_prepare(capturePcm);
+    if (error < 0) {
+        handleAlsaError("snd_pcm_prepare (capture)", error);
+        return false;
+    }
+
+    if (!isLinked_) {
+        error = snd_pcm_prepare(playbackPcm);
+        if (error < 0) {
+            handleAlsaError("snd_pcm_prepare (playback)", error);
+            return false;
+        }
+    }
+
+    // Profilin ön doldurması: ilk capture periyodu dolarken playback aç kalmasın.
+    // Probe ve LatencyProfile::deviceBudgetMs aynı derinliği varsayar
+    size_t prefillPeriods = player_->getPrefillPeriods();
+    if (probeEnabled_) {
+        probe_.reset(prefillPeriods * player_->getPeriodFrames());
+    }
+
+    bool prefilled = concealGap ? player_->prefillConcealment(prefillPeriods) : player_->prefillSilence(prefillPeriods);
+    if (!prefilled) {
+        logError("Playback ön doldurma başarısız");
+        return false;
+    }
+
+    // Başlangıç eşiği prefill ile tetiklenmediyse akışları açıkça başlat
+    if (snd_pcm_state(capturePcm) != SND_PCM_STATE_RUNNING) {
+        error = snd_pcm_start(capturePcm);
+        if (error < 0) {
+            handleAlsaError("snd_pcm_start", error);
+            return false;
+        }
+    }
+
+    if (!isLinked_ && snd_pcm_state(playbackPcm) != SND_PCM_STATE_RUNNING) {
+        snd_pcm_start(playbackPcm);
+    }
+
+    recordStartAlignment();
+    return true;
+}
+
+bool AudioDuplex::switchPeriod(size_t frames) {
+    auto switchStart = std::chrono::steady_clock::now();
+    size_t previous = player_->getPeriodFrames();
+
+    // Bağı çöz: iki akış ayrı ayrı yeniden yapılandırılır
+    if (isLinked_) {
+        snd_pcm_unlink(capture_->getPcmHandle());
+        isLinked_ = false;
+    }
+
+    // İki akış da bloklamadan durdurulur (drop); oturum (UDP, buffer'lar) korunur
+    // set_period_size_near iki cihaza farklı periyot verebilir; döngü eşit boy varsayar
+    bool ok = player_->setPeriodFrames(frames) && capture_->setPeriodFrames(frames);
+    if (ok && player_->getPeriodFrames() != capture_->getPeriodFrames()) {
+        logError("Cihazlar farklı periyot kabul etti (playback " + std::to_string(player_->getPeriodFrames()) +
+                 ", capture " + std::to_string(capture_->getPeriodFrames()) + " frame)");
+        ok = false;
+    }
+    if (!ok) {
+        logError("Periyot değiştirilemedi, önceki ayarla devam ediliyor");
+        player_->setPeriodFrames(previous);
+        capture_->setPeriodFrames(previous);
+    }
+
+    // Atılan playback sesi son periyodun sönümlenen tekrarıyla örtülür
+    if (!startStreams(true)) {
+        return false;
+    }
+
+    tuner_.reset(player_->getPeriodFrames());
+    lastSwitchUs_ = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - switchStart).count());
+
+    logInfo("Periyot " + std::to_string(previous) + " -> " + std::to_string(player_->getPeriodFrames()) +
+            " frame (geçiş: " + std::to_string(lastSwitchUs_ / 1000) + " ms)");
+    return ok;
+}
+
+void AudioDuplex::stop() {
+    bool wasRunning = isRunning_.exchange(false);
+
+    // Bloklanmış snd_pcm_readi'yi uyandır
+    if (capture_ && capture_->getPcmHandle()) {
+        snd_pcm_drop(capture_->getPcmHandle());
+    }
+
+    if (serviceThread_.joinable()) {
+        serviceThread_.join();
+    }
+
+    if (capture_) {
+        capture_->stop();
+    }
+
+    if (player_) {
+        player_->stop();
+        if (probeEnabled_) {
+            player_->setOnBeforeWrite(nullptr);
+        }
+    }
+
+    if (isLinked_ && capture_ && capture_->getPcmHandle()) {
+        snd_pcm_unlink(capture_->getPcmHandle());
+        isLinked_ = false;
+    }
+
+    if (wasRunning) {
+        logInfo("Full-duplex akış durduruldu (periyot: " + std::to_string(periods_.load()) +
+                ", uyanma: " + std::to_string(wakeups_.load()) + ")");
+    }
+}
+
+void AudioDuplex::serviceLoop() {
+    applyRealtimePriority();
+    RealtimeSection realtime("duplex");
+
+    while (isRunning_) {
+        uint64_t overrunsBefore = capture_->getBufferOverruns();
+        uint64_t xrunsBefore = overrunsBefore + player_->getBufferUnderruns();
+
+        // Tek bekleme noktası: capture periyodu dolana kadar snd_pcm_readi bloklar
+        bool captured = capture_->processPeriod();
+        wakeups_++;
+
+        if (!isRunning_) {
+            break;
+        }
+
+        // Linked capture kurtarması playback'i de PREPARED'a çeker: boş başlamasın
+        if (isLinked_ && capture_->getBufferOverruns() != overrunsBefore) {
+            player_->prefillAfterReset();
+        }
+
+        // Uyanma gecikmesi: periyot okunduktan sonra cihazda zaten bekleyen frame'ler
+        if (adaptivePeriod_ && captured) {
+            snd_pcm_sframes_t pending = snd_pcm_avail(capture_->getPcmHandle());
+            tuner_.recordWakeup(pending > 0 ? static_cast<size_t>(pending) : 0);
+        }
+
+        if (captured && probeEnabled_) {
+            size_t frames = 0;
+            const int16_t* samples = capture_->getLastPeriod(frames);
+            probe_.onCapture(samples, frames);
+        }
+
+        // Playback bir periyot önde; yazma bloklamadan tamamlanır
+        if (!player_->processPeriod()) {
+            errors_++;
+        }
+
+        bool xrunOccurred = capture_->getBufferOverruns() + player_->getBufferUnderruns() != xrunsBefore;
+
+        // Xrun sonrası iki akışın frame sayaçları artık hizalı değil; ölçümü yeniden başlat
+        if (probeEnabled_ && xrunOccurred) {
+            probe_.reset(player_->getPrefillPeriods() * player_->getPeriodFrames());
+        }
+
+        if (!captured) {
+            errors_++;
+        }
+
+        periods_++;
+
+        if (adaptivePeriod_) {
+            if (xrunOccurred) {
+                tuner_.recordXrun();
+            }
+
+            size_t newPeriod = tuner_.evaluate();
+            // Periyot değişimi nadir ve bilinçli bir yeniden yapılandırmadır
+            BlockingSection reconfigure;
+            if (newPeriod != 0 && isRunning_ && !switchPeriod(newPeriod)) {
+                errors_++;
+            }
+        }
+    }
+}
+
+void AudioDuplex::applyRealtimePriority() {
+    struct sched_param param;
+    std::memset(&param, 0, sizeof(param));
+    param.sched_priority = rtPriority_;
+
+    int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (error != 0) {
+        logError(std::string("SCHED_FIFO ayarlanamadı (normal öncelikle devam): ") + std::strerror(error));
+        return;
+    }
+
+    logInfo("Ses thread'i SCHED_FIFO önceliği: " + std::to_string(rtPriority_));
+}
+
+void AudioDuplex::recordStartAlignment() {
+    snd_pcm_sframes_t delay = 0;
+
+    // Capture gecikmesi: okunmayı bekleyen frame; playback: çalınmayı bekleyen
+    if (snd_pcm_delay(capture_->getPcmHandle(), &delay) == 0) {
+        captureStartDelay_ = static_cast<long>(delay);
+    }
+
+    if (snd_pcm_delay(player_->getPcmHandle(), &delay) == 0) {
+        playbackStartDelay_ = static_cast<long>(delay);
+    }
+}
+
+void AudioDuplex::handleAlsaError(const std::string& operation, int error) const {
+    std::string errorMsg = operation + " başarısız: " + snd_strerror(error);
+    logError(errorMsg);
+}
+
+void AudioDuplex::logError(const std::string& message) const {
+    std::cerr << "[AudioDuplex ERROR] " << message << std::endl;
+}
+
+void AudioDuplex::logInfo(const std::string& message) const {
+    std::cout << "[AudioDuplex INFO] " << message << std::endl;
+}
+
+} // namespace NovaVoice
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <alsa/asoundlib.h>
+#include "Config.h"
+#include "AudioCapture.h"
+#include "AudioPlayer.h"
+#include "LatencyProbe.h"
+#include "PeriodTuner.h"
+
+namespace NovaVoice {
+
+/**
+ * @brief Tek thread ile sürülen full-duplex ses akışı
+ *
+ * Capture ve playback PCM'lerini snd_pcm_link ile bağlar, böylece iki akış
+ * aynı anda başlar/durur ve aynı saat ile ilerler. Her periyotta tek bir
+ * uyanma ile önce capture okunur, ardından playback yazılır; ayrı
+ * capture/playback thread'lerine göre uyanma sayısı yarıya iner.
+ * Link desteklenmeyen cihazlarda bağlantısız ama yine tek thread ile çalışır.
+ */
+class AudioDuplex {
+public:
+    AudioDuplex();
+    ~AudioDuplex();
+
+    // === YÖNETİM ===
+    bool initialize(std::shared_ptr<AudioCapture> capture, std::shared_ptr<AudioPlayer> player);
+    bool start();
+    void stop();
+
+    // Playback'e darbe ekleyip capture'da yakalayan ölçüm (start öncesi)
+    void enableLatencyProbe(bool enable);
+
+    // Uyanma gecikmesi ve xrun oranına göre periyodu çalışırken değiştir (start öncesi)
+    void enableAdaptivePeriod(bool enable);
+
+    // Ses thread'inin SCHED_FIFO önceliği (start öncesi)
+    void setRealtimePriority(int priority);
+
+    // === DURUM ===
+    bool isRunning() const { return isRunning_; }
+    bool isLinked() const { return isLinked_; }
+
+    // === İSTATİSTİKLER ===
+    uint64_t getPeriods() const { return periods_; }
+    uint64_t getWakeups() const { return wakeups_; }
+    uint64_t getErrors() const { return errors_; }
+    long getCaptureStartDelay() const { return captureStartDelay_; }
+    long getPlaybackStartDelay() const { return playbackStartDelay_; }
+    const LatencyProbe* getLatencyProbe() const { return probeEnabled_ ? &probe_ : nullptr; }
+    const PeriodTuner* getPeriodTuner() const { return adaptivePeriod_ ? &tuner_ : nullptr; }
+    size_t getPeriodFrames() const { return player_ ? player_->getPeriodFrames() : 0; }
+    double getLastSwitchMs() const { return lastSwitchUs_ / 1000.0; }
+
+private:
+    std::shared_ptr<AudioCapture> capture_;
+    std::shared_ptr<AudioPlayer> player_;
+    bool isInitialized_;
+    bool isLinked_;
+
+    // Thread yönetimi
+    std::thread serviceThread_;
+    std::atomic<bool> isRunning_;
+
+    // Ölçüm
+    bool probeEnabled_;
+    LatencyProbe probe_;
+
+    int rtPriority_;
+
+    // Periyot uyarlama
+    bool adaptivePeriod_;
+    PeriodTuner tuner_;
+    std::atomic<uint64_t> lastSwitchUs_;
+
+    // İstatistikler
+    std::atomic<uint64_t> periods_;
+    std::atomic<uint64_t> wakeups_;
+    std::atomic<uint64_t> errors_;
+    long captureStartDelay_;
+    long playbackStartDelay_;
+
+    // İç metodlar
+    void serviceLoop();
+    bool startStreams(bool concealGap = false);   // concealGap: ilk ön doldurma periyodu gizleme
+    bool switchPeriod(size_t frames);
+    void applyRealtimePriority();
+    void recordStartAlignment();
+
+    // Hata yönetimi
+    void handleAlsaError(const std::string& operation, int error) const;
+    void logError(const std::string& message) const;
+    void logInfo(const std::string& message) const;
+};
+
+} // namespace NovaVoice
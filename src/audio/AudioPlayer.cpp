@@ -1,7 +1,10 @@
 #include "AudioPlayer.h"
+#include "MemoryAccounting.h"
 #include <iostream>
 #include <cstring>
 #include <algorithm>
+#include <pthread.h>
+#include <sched.h>
 
 namespace NovaVoice {
 
@@ -11,15 +14,35 @@ AudioPlayer::AudioPlayer()
     , deviceName_("default")
     , isInitialized_(false)
     , isPlaying_(false)
+    , fillStage_(StageProfiler::INVALID_STAGE)
+    , processStage_(StageProfiler::INVALID_STAGE)
     , volume_(Config::VOLUME_GAIN)
     , isMuted_(false)
     , playedFrames_(0)
     , bufferUnderruns_(0)
-    , droppedPackets_(0) {
-    
-    size_t bufferSize = Config::FRAMES_PER_BUFFER * Config::CHANNELS * (Config::BITS_PER_SAMPLE / 8);
+    , droppedPackets_(0)
+    , concealedFrames_(0) {
+    MemoryScope memory(MemoryTag::AUDIO_IO);
+    
+    periodFrames_ = Config::FRAMES_PER_BUFFER;
+    periodsPerBuffer_ = Config::PERIODS_PER_BUFFER;
+    prefillPeriods_ = Config::PLAYBACK_PREFILL_PERIODS;
+    concealPeriods_ = Config::PLAYBACK_CONCEAL_PERIODS;
+    resyncPackets_ = Config::PLAYBACK_RESYNC_PACKETS;
+    rtPriority_ = 0;
+    
+    // Buffer'lar en büyük periyoda göre ayrılır; periyot değişiminde yeniden ayırma yok
+    size_t bufferSize = Config::MAX_PERIOD_FRAMES * Config::CHANNELS * (Config::BITS_PER_SAMPLE / 8);
     playbackBuffer_.resize(bufferSize);
     silenceBuffer_.resize(bufferSize, 0); // Sessizlik için sıfırlar
+    lastPeriod_.resize(bufferSize, 0);
+    lastPeriodSize_ = 0;
+    stretchInput_.resize(Config::MAX_PERIOD_FRAMES * Config::CHANNELS, 0);
+    decodeBuffer_.resize(2 * bufferSize, 0); // Esnetilmiş en büyük paket
+    concealHistory_.resize(Config::MAX_PERIOD_FRAMES * Config::CHANNELS, 0);
+    concealHistorySize_ = 0;
+    concealPhase_ = 0;
+    concealRun_ = 0;
 }
 
 AudioPlayer::~AudioPlayer() {
@@ -57,11 +80,13 @@ bool AudioPlayer::initialize(const std::string& deviceName) {
 bool AudioPlayer::configureDevice() {
     int error;
     
-    // Hardware parametreleri için alan ayır
-    error = snd_pcm_hw_params_malloc(&hwParams_);
-    if (error < 0) {
-        handleAlsaError("snd_pcm_hw_params_malloc", error);
-        return false;
+    // Hardware parametreleri için alan ayır (yeniden yapılandırmada mevcut alan kullanılır)
+    if (!hwParams_) {
+        error = snd_pcm_hw_params_malloc(&hwParams_);
+        if (error < 0) {
+            handleAlsaError("snd_pcm_hw_params_malloc", error);
+            return false;
+        }
     }
     
     // Mevcut hardware parametrelerini al
@@ -104,14 +129,28 @@ bool AudioPlayer::configureDevice() {
         logInfo("Sample rate ayarlandı: " + std::to_string(sampleRate) + " Hz (istenen: " + std::to_string(Config::SAMPLE_RATE) + " Hz)");
     }
     
-    // Buffer boyutunu ayarla
-    snd_pcm_uframes_t frames = Config::FRAMES_PER_BUFFER;
+    // Buffer boyutunu ayarla; ses buffer'ları MAX_PERIOD_FRAMES için ayrıldı
+    snd_pcm_uframes_t maxFrames = Config::MAX_PERIOD_FRAMES;
+    error = snd_pcm_hw_params_set_period_size_max(pcmHandle_, hwParams_, &maxFrames, nullptr);
+    if (error < 0) {
+        handleAlsaError("snd_pcm_hw_params_set_period_size_max", error);
+        return false;
+    }
+    
+    snd_pcm_uframes_t frames = periodFrames_;
     error = snd_pcm_hw_params_set_period_size_near(pcmHandle_, hwParams_, &frames, nullptr);
     if (error < 0) {
         handleAlsaError("snd_pcm_hw_params_set_period_size_near", error);
         return false;
     }
     
+    snd_pcm_uframes_t bufferFrames = frames * periodsPerBuffer_;
+    error = snd_pcm_hw_params_set_buffer_size_near(pcmHandle_, hwParams_, &bufferFrames);
+    if (error < 0) {
+        handleAlsaError("snd_pcm_hw_params_set_buffer_size_near", error);
+        return false;
+    }
+    
     // Hardware parametrelerini uygula
     error = snd_pcm_hw_params(pcmHandle_, hwParams_);
     if (error < 0) {
@@ -119,9 +158,75 @@ bool AudioPlayer::configureDevice() {
         return false;
     }
     
+    // Cihazın gerçekte seçtiği periyodu kullan; buffer'lardan büyükse kırpmak sayaçları
+    // donanımdan ayırır, bu yüzden yapılandırma reddedilir
+    error = snd_pcm_hw_params_get_period_size(hwParams_, &frames, nullptr);
+    if (error < 0) {
+        handleAlsaError("snd_pcm_hw_params_get_period_size", error);
+        return false;
+    }
+    
+    if (frames > Config::MAX_PERIOD_FRAMES) {
+        logError("Cihaz periyodu desteklenenden büyük: " + std::to_string(frames) + " frame (en fazla " +
+                 std::to_string(Config::MAX_PERIOD_FRAMES) + ")");
+        return false;
+    }
+    periodFrames_ = static_cast<size_t>(frames);
+    
+    return true;
+}
+
+bool AudioPlayer::setPeriodFrames(size_t frames) {
+    if (!pcmHandle_) {
+        return false;
+    }
+    
+    // SETUP durumuna hemen geç: drain tüm ALSA buffer'ı çalana kadar (büyük
+    // periyotta ~170 ms) gerçek zamanlı thread'i bloklardı. Atılan ses,
+    // yeniden başlatmada prefillConcealment ile örtülür.
+    snd_pcm_drop(pcmHandle_);
+    
+    size_t previous = periodFrames_;
+    periodFrames_ = std::max(Config::MIN_PERIOD_FRAMES, std::min(frames, Config::MAX_PERIOD_FRAMES));
+    
+    if (!configureDevice()) {
+        // Eski ayara geri dön
+        periodFrames_ = previous;
+        configureDevice();
+        return false;
+    }
+    
+    logInfo("Playback periyodu: " + std::to_string(previous) + " -> " + std::to_string(periodFrames_.load()) + " frame");
     return true;
 }
 
+bool AudioPlayer::applyProfile(const LatencyProfile& profile) {
+    if (isPlaying_) {
+        logError("Profil çalışırken uygulanamaz");
+        return false;
+    }
+    
+    // Ön doldurma buffer'ın tamamını kaplamamalı
+    periodsPerBuffer_ = std::max<size_t>(2, profile.periodsPerBuffer);
+    prefillPeriods_ = std::max<size_t>(1, std::min(profile.prefillPeriods, periodsPerBuffer_ - 1));
+    concealPeriods_ = std::max<size_t>(1, profile.concealPeriods);
+    // Kurtarmada kuyrukta, cihaza ön doldurulan kadar paket kalır (paket = periyot)
+    resyncPackets_ = prefillPeriods_;
+    rtPriority_ = profile.rtPriority;
+    playout_.applyProfile(profile);
+    
+    if (!pcmHandle_) {
+        periodFrames_ = std::max(Config::MIN_PERIOD_FRAMES, std::min(profile.periodFrames, Config::MAX_PERIOD_FRAMES));
+        return true;
+    }
+    
+    return setPeriodFrames(profile.periodFrames);
+}
+
+size_t AudioPlayer::periodBytes() const {
+    return periodFrames_ * Config::CHANNELS * (Config::BITS_PER_SAMPLE / 8);
+}
+
 void AudioPlayer::cleanup() {
     if (hwParams_) {
         snd_pcm_hw_params_free(hwParams_);
@@ -154,6 +259,7 @@ bool AudioPlayer::start() {
         return false;
     }
     
+    playout_.reset();
     isPlaying_ = true;
     playbackThread_ = std::thread(&AudioPlayer::playbackLoop, this);
     
@@ -161,6 +267,167 @@ bool AudioPlayer::start() {
     return true;
 }
 
+bool AudioPlayer::startLinked() {
+    if (!isInitialized_) {
+        logError("AudioPlayer başlatılmamış");
+        return false;
+    }
+    
+    if (isPlaying_) {
+        logError("AudioPlayer zaten çalışıyor");
+        return false;
+    }
+    
+    // PCM hazırlığı ve başlatma AudioDuplex tarafından yapılır
+    playout_.reset();
+    isPlaying_ = true;
+    
+    logInfo("AudioPlayer harici sürüş modunda başlatıldı");
+    return true;
+}
+
+bool AudioPlayer::processPeriod() {
+    // Linked modda thread bloklanmamalı: paket yoksa beklemeden gizleme/sessizlik
+    return renderPeriod(false);
+}
+
+bool AudioPlayer::renderPeriod(bool wait) {
+    size_t frames = periodFrames_;
+    size_t bytes = periodBytes();
+    int16_t* samples = reinterpret_cast<int16_t*>(playbackBuffer_.data());
+    
+    // Periyot her zaman tam: paket boyutundan bağımsız, eksik kısım gizlenir
+    // (bekleyen doldurma ölçülmez: süre paket varışını yansıtır)
+    size_t audioFrames = 0;
+    {
+        StageProfiler::Scope scope(wait ? nullptr : profiler_.get(), fillStage_);
+        audioFrames = fillPeriod(samples, frames, wait);
+    }
+    
+    {
+        StageProfiler::Scope scope(profiler_.get(), processStage_);
+        processAudioData(playbackBuffer_.data(), bytes);
+        
+        if (sidetone_) {
+            sidetone_->mixInto(samples, frames);
+        }
+        
+        if (onBeforeWrite_) {
+            onBeforeWrite_(samples, frames);
+        }
+    }
+    
+    bool written = writeAudioData(playbackBuffer_.data(), bytes);
+    if (written && audioFrames > 0) {
+        playout_.onAudioWritten(audioFrames);
+    }
+    
+    return written;
+}
+
+size_t AudioPlayer::fillPeriod(int16_t* output, size_t frames, bool wait) {
+    size_t needed = frames * Config::CHANNELS;
+    
+    // Halka bir periyot tutana kadar paket çöz (10/20/40 ms, boyut fark etmez)
+    while (playbackRing_.available() < needed) {
+        size_t decodedSize = decodeBuffer_.size();
+        if (!getNextAudioData(decodeBuffer_.data(), decodedSize, wait)) {
+            break;
+        }
+        
+        size_t sampleCount = decodedSize / sizeof(int16_t);
+        size_t written = playbackRing_.write(reinterpret_cast<const int16_t*>(decodeBuffer_.data()), sampleCount);
+        if (written < sampleCount) {
+            droppedPackets_++;
+        }
+        
+        // Periyot başına en fazla bir kez bekle
+        wait = false;
+    }
+    
+    size_t read = playbackRing_.read(output, needed);
+    
+    // Gizleme kaynağı yalnızca gerçek örneklerdir: gizlenen (sönümlenmiş) çıkış
+    // tarihçeye geri yazılmaz, yoksa sönüm ardışık boşluklarda katlanırdı
+    if (read > 0) {
+        rememberRealSamples(output, read, needed);
+        concealRun_ = 0;
+    }
+    
+    if (read < needed) {
+        concealGap(output + read, needed - read);
+    }
+    
+    return read / Config::CHANNELS;
+}
+
+void AudioPlayer::rememberRealSamples(const int16_t* samples, size_t count, size_t historySize) {
+    historySize = std::min(historySize, concealHistory_.size());
+    
+    if (count >= historySize) {
+        std::memcpy(concealHistory_.data(), samples + count - historySize, historySize * sizeof(int16_t));
+        concealHistorySize_ = historySize;
+    } else {
+        // Kısmi okuma: eski tarihçenin sonu + yeni örnekler (tarihçe son gerçek örnekle biter)
+        size_t keep = std::min(concealHistorySize_, historySize - count);
+        std::memmove(concealHistory_.data(), concealHistory_.data() + concealHistorySize_ - keep,
+                     keep * sizeof(int16_t));
+        std::memcpy(concealHistory_.data() + keep, samples, count * sizeof(int16_t));
+        concealHistorySize_ = keep + count;
+    }
+    
+    // Tarihçenin periyodik tekrarında son gerçek örneği izleyen örnek [0]'dır
+    concealPhase_ = 0;
+}
+
+void AudioPlayer::concealGap(int16_t* output, size_t sampleCount) {
+    concealedFrames_ += sampleCount / Config::CHANNELS;
+    
+    // Art arda gizleme sınırı aşıldı veya kaynak yok: sessizlik
+    if (concealRun_ >= concealPeriods_ || concealHistorySize_ == 0) {
+        std::memset(output, 0, sampleCount * sizeof(int16_t));
+        return;
+    }
+    
+    // Son gerçek örnekleri kaldığı yerden tekrarla, her gizlenen periyotta sıfıra doğru sönümle
+    float startGain = 1.0f - static_cast<float>(concealRun_) / concealPeriods_;
+    float endGain = 1.0f - static_cast<float>(concealRun_ + 1) / concealPeriods_;
+    for (size_t i = 0; i < sampleCount; ++i) {
+        float gain = startGain + (endGain - startGain) * static_cast<float>(i) / static_cast<float>(sampleCount);
+        output[i] = static_cast<int16_t>(concealHistory_[concealPhase_] * gain);
+        concealPhase_ = (concealPhase_ + 1) % concealHistorySize_;
+    }
+    
+    concealRun_++;
+}
+
+bool AudioPlayer::prefillConcealment(size_t periods) {
+    if (!pcmHandle_) {
+        return false;
+    }
+    
+    // İlk periyot: son çalınan periyodun sönümlenen tekrarı (atılan sesin yerine)
+    size_t first = 0;
+    if (periods > 0 && lastPeriodSize_ > 0) {
+        if (!writeFadedLastPeriod()) {
+            return false;
+        }
+        first = 1;
+    }
+    
+    return prefillSilence(periods - first);
+}
+
+bool AudioPlayer::prefillSilence(size_t periods) {
+    for (size_t i = 0; i < periods; ++i) {
+        if (!writeAudioData(silenceBuffer_.data(), periodBytes())) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
 void AudioPlayer::stop() {
     if (!isPlaying_) {
         return;
@@ -185,6 +452,16 @@ void AudioPlayer::setBufferManager(std::shared_ptr<BufferManager> bufferManager)
     bufferManager_ = bufferManager;
 }
 
+void AudioPlayer::setSidetone(std::shared_ptr<Sidetone> sidetone) {
+    sidetone_ = sidetone;
+}
+
+void AudioPlayer::setStageProfiler(std::shared_ptr<StageProfiler> profiler) {
+    profiler_ = profiler;
+    fillStage_ = profiler_ ? profiler_->addStage("playback.fill") : StageProfiler::INVALID_STAGE;
+    processStage_ = profiler_ ? profiler_->addStage("playback.process") : StageProfiler::INVALID_STAGE;
+}
+
 bool AudioPlayer::playData(const uint8_t* data, size_t size) {
     if (!data || size == 0 || !isInitialized_) {
         return false;
@@ -213,36 +490,79 @@ void AudioPlayer::setOnAudioPlayed(std::function<void(size_t)> callback) {
     onAudioPlayed_ = callback;
 }
 
+void AudioPlayer::setOnBeforeWrite(std::function<void(int16_t*, size_t)> callback) {
+    onBeforeWrite_ = callback;
+}
+
 void AudioPlayer::playbackLoop() {
+    applyRealtimePriority();
+    RealtimeSection realtime("playback");
+    
     while (isPlaying_) {
-        size_t dataSize = playbackBuffer_.size();
-        
-        if (getNextAudioData(playbackBuffer_.data(), dataSize)) {
-            // Ses verisi mevcut, çal
-            processAudioData(playbackBuffer_.data(), dataSize);
-            writeAudioData(playbackBuffer_.data(), dataSize);
-        } else {
-            // Ses verisi yok, sessizlik çal
-            playSilence();
-        }
+        // Her yazım tam bir periyot; tempo snd_pcm_writei'nin bloklamasıyla belirlenir
+        renderPeriod(true);
     }
 }
 
-bool AudioPlayer::getNextAudioData(uint8_t* buffer, size_t& size) {
+void AudioPlayer::applyRealtimePriority() {
+    if (rtPriority_ <= 0) {
+        return;
+    }
+    
+    struct sched_param param;
+    std::memset(&param, 0, sizeof(param));
+    param.sched_priority = rtPriority_;
+    
+    int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (error != 0) {
+        logError(std::string("SCHED_FIFO ayarlanamadı (normal öncelikle devam): ") + std::strerror(error));
+        return;
+    }
+    
+    logInfo("Playback thread'i SCHED_FIFO önceliği: " + std::to_string(rtPriority_));
+}
+
+bool AudioPlayer::getNextAudioData(uint8_t* buffer, size_t& size, bool wait) {
     if (!bufferManager_) {
         return false;
     }
     
-    auto packet = bufferManager_->getNextPlaybackPacket();
+    // Başlatma politikası: talkspurt başında hedef seviye birikene kadar sessizlik
+    // Derinlik: kuyruktaki paketler + halkada çalınmayı bekleyen örnekler
+    size_t ringFrames = playbackRing_.available() / Config::CHANNELS;
+    if (!playout_.shouldStart(bufferManager_->getOutputBufferSize(), ringFrames)) {
+        return false;
+    }
+    
+    std::shared_ptr<AudioPacket> packet;
+    if (wait) {
+        // Thread'in temposu: paket gelene kadar bilinçli bekleme
+        BlockingSection blocking;
+        packet = bufferManager_->getNextPlaybackPacket();
+    } else {
+        packet = bufferManager_->tryGetNextPlaybackPacket();
+    }
     if (!packet || packet->data.empty()) {
+        bufferManager_->retirePacket(std::move(packet));
+        playout_.onStarved();
         return false;
     }
     
-    size_t copySize = std::min(size, packet->data.size());
-    std::memcpy(buffer, packet->data.data(), copySize);
-    size = copySize;
+    size_t frameBytes = Config::CHANNELS * (Config::BITS_PER_SAMPLE / 8);
+    size_t inputFrames = std::min(packet->data.size(), stretchInput_.size() * sizeof(int16_t)) / frameBytes;
+    playout_.onPacketDequeued(packet->timestamp, inputFrames);
     
-    return true;
+    // Kuyruk hedeften saparsa paketi hafifçe uzat/kısalt
+    double ratio = playout_.getStretchRatio(bufferManager_->getOutputBufferSize(), ringFrames);
+    std::memcpy(stretchInput_.data(), packet->data.data(), inputFrames * frameBytes);
+    
+    // Son referans bu thread'de düşmesin (free ağ thread'ine devredilir)
+    bufferManager_->retirePacket(std::move(packet));
+    size_t outputFrames = playout_.stretch(stretchInput_.data(), inputFrames,
+                                           reinterpret_cast<int16_t*>(buffer), size / frameBytes, ratio);
+    size = outputFrames * frameBytes;
+    
+    return size > 0;
 }
 
 void AudioPlayer::processAudioData(uint8_t* data, size_t size) {
@@ -281,26 +601,33 @@ bool AudioPlayer::writeAudioData(const uint8_t* data, size_t size) {
     
     size_t framesToWrite = size / (Config::CHANNELS * (Config::BITS_PER_SAMPLE / 8));
     
-    snd_pcm_sframes_t framesWritten = snd_pcm_writei(pcmHandle_, data, framesToWrite);
+    snd_pcm_sframes_t framesWritten;
+    {
+        BlockingSection blocking;
+        framesWritten = snd_pcm_writei(pcmHandle_, data, framesToWrite);
+    }
     
-    if (framesWritten < 0) {
-        if (framesWritten == -EPIPE) {
-            // Buffer underrun
-            bufferUnderruns_++;
-            logError("Buffer underrun oluştu");
-            
-            // PCM'i yeniden hazırla
-            int error = snd_pcm_prepare(pcmHandle_);
-            if (error < 0) {
-                handleAlsaError("snd_pcm_prepare (recovery)", error);
-                return false;
-            }
-        } else {
-            handleAlsaError("snd_pcm_writei", framesWritten);
+    if (framesWritten == -EPIPE || framesWritten == -ESTRPIPE) {
+        // Buffer underrun veya askıya alma: kurtar, ön doldur, bu periyodu tekrar yaz
+        bufferUnderruns_++;
+        if (!recoverFromXrun(static_cast<int>(framesWritten))) {
             return false;
         }
+        
+        BlockingSection blocking;
+        framesWritten = snd_pcm_writei(pcmHandle_, data, framesToWrite);
+    }
+    
+    if (framesWritten < 0) {
+        handleAlsaError("snd_pcm_writei", framesWritten);
+        return false;
     } else if (framesWritten > 0) {
         playedFrames_ += framesWritten;
+        xrunTracker_.markIo();
+        
+        // Gizleme için son periyodu sakla
+        lastPeriodSize_ = std::min(size, lastPeriod_.size());
+        std::memcpy(lastPeriod_.data(), data, lastPeriodSize_);
         
         // Callback çağır
         if (onAudioPlayed_) {
@@ -311,12 +638,88 @@ bool AudioPlayer::writeAudioData(const uint8_t* data, size_t size) {
     return true;
 }
 
-void AudioPlayer::playSilence() {
-    // Kısa sessizlik çal
-    writeAudioData(silenceBuffer_.data(), silenceBuffer_.size());
+bool AudioPlayer::recoverFromXrun(int error) {
+    auto detected = std::chrono::steady_clock::now();
+    bool suspended = (error == -ESTRPIPE);
+    
+    // snd_pcm_recover: EPIPE için prepare, ESTRPIPE için resume (gerekirse prepare)
+    int result = snd_pcm_recover(pcmHandle_, error, 1);
+    
+    // Boş buffer'dan yeniden başlamak hemen tekrar underrun demek: hedef seviyeye doldur
+    bool prefilled = (result >= 0) && writePrefill();
+    
+    // Kesinti süresince biriken paketler artık geç; playout kuyruğunu hedefe indir
+    size_t resynced = 0;
+    if (result >= 0 && bufferManager_) {
+        resynced = bufferManager_->resyncPlayback(resyncPackets_);
+    }
+    
+    xrunTracker_.recordRecovery(detected, suspended, prefilled, periodFrames_);
+    
+    if (result < 0) {
+        handleAlsaError("snd_pcm_recover (playback)", result);
+        return false;
+    }
+    
+    XrunStats stats = xrunTracker_.getStats();
+    logError(std::string(suspended ? "Cihaz askıya alındı" : "Buffer underrun oluştu") +
+             ", kurtarma: " + std::to_string(static_cast<int>(stats.lastRecoveryUs)) + " us" +
+             ", atılan paket: " + std::to_string(resynced));
+    return prefilled;
+}
+
+bool AudioPlayer::prefillAfterReset() {
+    if (!pcmHandle_ || !isPlaying_) {
+        return false;
+    }
     
-    // Kısa bekle
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    if (bufferManager_) {
+        bufferManager_->resyncPlayback(resyncPackets_);
+    }
+    
+    return writePrefill();
+}
+
+bool AudioPlayer::writePrefill() {
+    size_t frameBytes = Config::CHANNELS * (Config::BITS_PER_SAMPLE / 8);
+    
+    for (size_t i = 0; i < prefillPeriods_; ++i) {
+        // İlk periyot: son periyodun sönümlenen tekrarı (sert kesinti yerine)
+        if (i == 0 && lastPeriodSize_ > 0) {
+            if (!writeFadedLastPeriod()) {
+                return false;
+            }
+            continue;
+        }
+        
+        snd_pcm_sframes_t written = snd_pcm_writei(pcmHandle_, silenceBuffer_.data(), periodBytes() / frameBytes);
+        if (written < 0) {
+            handleAlsaError("snd_pcm_writei (prefill)", static_cast<int>(written));
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool AudioPlayer::writeFadedLastPeriod() {
+    size_t frameBytes = Config::CHANNELS * (Config::BITS_PER_SAMPLE / 8);
+    int16_t* samples = reinterpret_cast<int16_t*>(lastPeriod_.data());
+    size_t sampleCount = lastPeriodSize_ / sizeof(int16_t);
+    for (size_t j = 0; j < sampleCount; ++j) {
+        float fade = 1.0f - static_cast<float>(j) / static_cast<float>(sampleCount);
+        samples[j] = static_cast<int16_t>(samples[j] * fade);
+    }
+    
+    snd_pcm_sframes_t written = snd_pcm_writei(pcmHandle_, lastPeriod_.data(), lastPeriodSize_ / frameBytes);
+    
+    // Gizleme bir kez kullanılır; ardışık kesintilerde sessizlik çalınır
+    lastPeriodSize_ = 0;
+    if (written < 0) {
+        handleAlsaError("snd_pcm_writei (prefill)", static_cast<int>(written));
+        return false;
+    }
+    return true;
 }
 
 void AudioPlayer::handleAlsaError(const std::string& operation, int error) const {
@@ -7,6 +7,13 @@
 #include <alsa/asoundlib.h>
 #include "Config.h"
 #include "BufferManager.h"
+#include "XrunTracker.h"
+#include "PlayoutController.h"
+#include "LatencyProfile.h"
+#include "StageProfiler.h"
+#include "RealtimeCheck.h"
+#include "Sidetone.h"
+#include "RingBuffer.h"
 
 namespace NovaVoice {
 
@@ -20,6 +27,27 @@ public:
     bool start();
     void stop();
     
+    // Harici sürüş (AudioDuplex): thread başlatmadan çalışma durumuna geçer,
+    // her periyot processPeriod() ile tam bir periyot yazılır (beklemeden)
+    bool startLinked();
+    bool processPeriod();
+    bool prefillSilence(size_t periods);
+    // İlk periyot son çalınan periyodun sönümlenen tekrarı, kalanı sessizlik
+    bool prefillConcealment(size_t periods);
+    // Bağlı capture akışı xrun ile yeniden hazırlandığında playback'i hedef seviyeye doldurur
+    bool prefillAfterReset();
+    snd_pcm_t* getPcmHandle() const { return pcmHandle_; }
+    
+    // Periyot boyutunu yeniden müzakere eder: buffer'daki sesi atar (drop, bloklamaz)
+    // ve hw parametrelerini yeniden uygular. Sonrasında prepare/prefillConcealment çağıranındır.
+    bool setPeriodFrames(size_t frames);
+    size_t getPeriodFrames() const { return periodFrames_; }
+    
+    // Profilin periyot, buffer derinliği, ön doldurma, gizleme ve jitter payı
+    // ayarları (start öncesi; açık cihazda yeniden müzakere)
+    bool applyProfile(const LatencyProfile& profile);
+    size_t getPrefillPeriods() const { return prefillPeriods_; }
+    
     // Buffer manager bağlantısı
     void setBufferManager(std::shared_ptr<BufferManager> bufferManager);
     
@@ -41,6 +69,9 @@ public:
     uint64_t getPlayedFrames() const { return playedFrames_; }
     uint64_t getBufferUnderruns() const { return bufferUnderruns_; }
     uint64_t getDroppedPackets() const { return droppedPackets_; }
+    uint64_t getConcealedFrames() const { return concealedFrames_; }
+    XrunStats getXrunStats() const { return xrunTracker_.getStats(); }
+    const PlayoutController& getPlayout() const { return playout_; }
     
     // Cihaz bilgileri
     std::string getDeviceName() const { return deviceName_; }
@@ -48,9 +79,20 @@ public:
     uint16_t getChannels() const { return Config::CHANNELS; }
     uint16_t getBitsPerSample() const { return Config::BITS_PER_SAMPLE; }
     
+    // Capture'dan gelen sidetone'u her periyoda karıştır
+    void setSidetone(std::shared_ptr<Sidetone> sidetone);
+    
+    // Periyot işleme süresi ve donanım sayaçları ("playback.process": ALSA
+    // yazımı hariç; linked modda "playback.fill": paket çözme + esnetme + gizleme)
+    void setStageProfiler(std::shared_ptr<StageProfiler> profiler);
+    
     // Callback ayarlama
     void setOnAudioPlayed(std::function<void(size_t)> callback);
     
+    // ALSA'ya yazılmadan hemen önce periyot üzerinde çalışan kanca
+    // (latency probe, sidetone vb.; playback thread'inde çağrılır)
+    void setOnBeforeWrite(std::function<void(int16_t*, size_t)> callback);
+    
 private:
     // ALSA handle
     snd_pcm_t* pcmHandle_;
@@ -66,8 +108,32 @@ private:
     
     // Buffer yönetimi
     std::shared_ptr<BufferManager> bufferManager_;
+    std::shared_ptr<Sidetone> sidetone_;
+    std::shared_ptr<StageProfiler> profiler_;
+    int fillStage_;
+    int processStage_;
     std::vector<uint8_t> playbackBuffer_;
     std::vector<uint8_t> silenceBuffer_;
+    std::vector<uint8_t> lastPeriod_;      // Gizleme (concealment) için son çalınan periyot
+    size_t lastPeriodSize_;
+    std::atomic<size_t> periodFrames_;     // Cihazın kabul ettiği periyot (frame)
+    size_t periodsPerBuffer_;              // ALSA buffer = periyot x bu değer
+    size_t prefillPeriods_;                // Xrun/başlangıç sonrası hedef doluluk
+    size_t concealPeriods_;                // Sessizliğe sönümlenmeden önce gizlenen periyot
+    size_t resyncPackets_;                 // Xrun sonrası playout kuyruğunda kalan paket
+    int rtPriority_;                       // Playback thread'i SCHED_FIFO önceliği (0: değiştirme)
+    
+    // Playout başlatma politikası ve zaman esnetme
+    PlayoutController playout_;
+    std::vector<int16_t> stretchInput_;
+    
+    // Örnek düzeyinde esnek halka: paket boyutu ile periyot boyutunu ayırır
+    SpscRingBuffer<int16_t> playbackRing_{Config::PLAYBACK_RING_FRAMES * Config::CHANNELS};
+    std::vector<uint8_t> decodeBuffer_;
+    std::vector<int16_t> concealHistory_;  // Son gerçek (gizlenmemiş) örnekler
+    size_t concealHistorySize_;
+    size_t concealPhase_;                  // Gizlemenin tarihçede kaldığı yer
+    size_t concealRun_;                    // Art arda gizlenen periyot sayısı
     
     // Ses ayarları
     float volume_;
@@ -75,23 +141,34 @@ private:
     
     // Callback fonksiyonu
     std::function<void(size_t)> onAudioPlayed_;
+    std::function<void(int16_t*, size_t)> onBeforeWrite_;
     
     // İstatistikler
     std::atomic<uint64_t> playedFrames_;
     std::atomic<uint64_t> bufferUnderruns_;
     std::atomic<uint64_t> droppedPackets_;
+    std::atomic<uint64_t> concealedFrames_;
+    XrunTracker xrunTracker_;
     
     // İç metodlar
     bool configureDevice();
     void cleanup();
     void playbackLoop();
+    void applyRealtimePriority();
     bool writeAudioData(const uint8_t* data, size_t size);
     void processAudioData(uint8_t* data, size_t size);
     void applyVolume(uint8_t* data, size_t size);
-    void playSilence();
+    bool renderPeriod(bool wait);
+    size_t fillPeriod(int16_t* output, size_t frames, bool wait);
+    void concealGap(int16_t* output, size_t sampleCount);
+    void rememberRealSamples(const int16_t* samples, size_t count, size_t historySize);
+    size_t periodBytes() const;
+    bool recoverFromXrun(int error);
+    bool writePrefill();
+    bool writeFadedLastPeriod();
     
     // Buffer yönetimi
-    bool getNextAudioData(uint8_t* buffer, size_t& size);
+    bool getNextAudioData(uint8_t* buffer, size_t& size, bool wait = true);
     
     // Hata yönetimi
     void handleAlsaError(const std::string& operation, int error) const;
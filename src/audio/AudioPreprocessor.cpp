@@ -1,4 +1,5 @@
 #include "AudioPreprocessor.h"
+#include "MemoryAccounting.h"
 #include <iostream>
 #include <algorithm>
 #include <cmath>
@@ -14,17 +15,12 @@ AudioPreprocessor::AudioPreprocessor()
     , currentGain_(1.0f)
     , targetGain_(1.0f)
     , maxGainHistorySize_(50)
+    , speechDetected_(false)
     , maxTimingHistorySize_(100) {
+    MemoryScope memory(MemoryTag::DENOISER);
     
     gainHistory_.reserve(maxGainHistorySize_);
     processingTimes_.reserve(maxTimingHistorySize_);
-    
-    // Initialize buffers
-    tempBuffer_.resize(Config::FRAMES_PER_BUFFER);
-    tempBufferInt16_.resize(Config::FRAMES_PER_BUFFER);
-    processBuffer_.resize(Config::FRAMES_PER_BUFFER);
-    resampleBuffer_.resize(Config::FRAMES_PER_BUFFER * 2);
-    resampleBufferInt16_.resize(Config::FRAMES_PER_BUFFER * 2);
 }
 
 AudioPreprocessor::~AudioPreprocessor() {
@@ -32,6 +28,7 @@ AudioPreprocessor::~AudioPreprocessor() {
 }
 
 bool AudioPreprocessor::initialize(const PreprocessingConfig& config) {
+    MemoryScope memory(MemoryTag::DENOISER);
     if (initialized_) {
         logError("AudioPreprocessor zaten başlatılmış");
         return false;
@@ -53,6 +50,12 @@ bool AudioPreprocessor::initialize(const PreprocessingConfig& config) {
         return false;
     }
     
+    if (!buildGraphs()) {
+        logError("Processing graph kurulamadı");
+        shutdownComponents();
+        return false;
+    }
+    
     // Initialize statistics
     stats_ = AudioStats();
     lastProcessTime_ = std::chrono::steady_clock::now();
@@ -78,6 +81,7 @@ void AudioPreprocessor::shutdown() {
 }
 
 bool AudioPreprocessor::processInput(int16_t* audioData, size_t sampleCount) {
+    MemoryScope memory(MemoryTag::DENOISER);
     if (!initialized_ || !audioData) {
         return false;
     }
@@ -90,16 +94,10 @@ bool AudioPreprocessor::processInput(int16_t* audioData, size_t sampleCount) {
     auto startTime = std::chrono::steady_clock::now();
     
     try {
-        // Convert to float
-        int16ToFloat(audioData, tempBuffer_.data(), sampleCount);
-        
-        // Process audio chain
-        bool success = processAudioChain(tempBuffer_.data(), sampleCount, true);
+        // Process audio chain (float dönüşümü graph buffer'ında)
+        bool success = processAudioChain(audioData, sampleCount, true);
         
         if (success) {
-            // Convert back to int16
-            floatToInt16(tempBuffer_.data(), audioData, sampleCount);
-            
             totalProcessedSamples_ += sampleCount;
             totalProcessedFrames_++;
             
@@ -118,6 +116,7 @@ bool AudioPreprocessor::processInput(int16_t* audioData, size_t sampleCount) {
 }
 
 bool AudioPreprocessor::processInput(float* audioData, size_t sampleCount) {
+    MemoryScope memory(MemoryTag::DENOISER);
     if (!initialized_ || !audioData) {
         return false;
     }
@@ -169,18 +168,8 @@ bool AudioPreprocessor::processOutput(int16_t* audioData, size_t sampleCount) {
     }
     
     try {
-        // Convert to float
-        int16ToFloat(audioData, tempBuffer_.data(), sampleCount);
-        
         // Process audio chain (output path - less processing)
-        bool success = processAudioChain(tempBuffer_.data(), sampleCount, false);
-        
-        if (success) {
-            // Convert back to int16
-            floatToInt16(tempBuffer_.data(), audioData, sampleCount);
-        }
-        
-        return success;
+        return processAudioChain(audioData, sampleCount, false);
         
     } catch (const std::exception& e) {
         logError("Output processing exception: " + std::string(e.what()));
@@ -336,6 +325,29 @@ void AudioPreprocessor::updateConfig(const PreprocessingConfig& config) {
     
     targetGain_ = config_.agcTargetLevel;
     
+    // Etkin aşamalar değişmiş olabilir: yeni graph'lar ayrı kurulur, process*
+    // çağrıları onları periyot başında devralır (çalışan graph'a dokunulmaz)
+    if (initialized_) {
+        int inputSource = ProcessingGraph::INVALID_NODE;
+        int outputSource = ProcessingGraph::INVALID_NODE;
+        std::unique_ptr<ProcessingGraph> input = buildInputGraph(inputSource);
+        std::unique_ptr<ProcessingGraph> output = buildOutputGraph(outputSource);
+        if (!input || !output) {
+            logError("Processing graph yeniden kurulamadı");
+        } else {
+            logInfo("Yeni giriş zinciri: " + input->describe());
+            // Önceki devirden kalanlar: işleyen thread retired'a yalnızca kilitle yazar
+            inputGraph_.retired.reset();
+            outputGraph_.retired.reset();
+            inputGraph_.pending = std::move(input);
+            inputGraph_.pendingSource = inputSource;
+            inputGraph_.hasPending.store(true, std::memory_order_release);
+            outputGraph_.pending = std::move(output);
+            outputGraph_.pendingSource = outputSource;
+            outputGraph_.hasPending.store(true, std::memory_order_release);
+        }
+    }
+    
     logInfo("Config güncellendi");
 }
 
@@ -447,6 +459,20 @@ bool AudioPreprocessor::isSpeechDetected() const {
     return false;
 }
 
+void AudioPreprocessor::setStageProfiler(std::shared_ptr<StageProfiler> profiler) {
+    profiler_ = profiler;
+    if (inputGraph_.active) {
+        inputGraph_.active->setProfiler(profiler, "input.");
+    }
+    if (outputGraph_.active) {
+        outputGraph_.active->setProfiler(profiler, "output.");
+    }
+    
+    if (codec_) {
+        codec_->setStageProfiler(profiler);
+    }
+}
+
 void AudioPreprocessor::setOnSpeechDetected(std::function<void(bool)> callback) {
     onSpeechDetected_ = callback;
 }
@@ -496,53 +522,79 @@ bool AudioPreprocessor::processAudioChain(float* audioData, size_t sampleCount,
         return false;
     }
     
+    int sourceNode = ProcessingGraph::INVALID_NODE;
+    ProcessingGraph* activeGraph = acquireGraph(isInput ? inputGraph_ : outputGraph_, sourceNode);
+    if (!activeGraph) {
+        return false;
+    }
+    ProcessingGraph& graph = *activeGraph;
+    float* source = graph.getSourceBuffer(sourceNode);
+    if (!source) {
+        return false;
+    }
+    
+    std::memcpy(source, audioData, sampleCount * sizeof(float));
+    if (!runChain(graph, sampleCount, isInput)) {
+        return false;
+    }
+    std::memcpy(audioData, graph.getOutputBuffer(), sampleCount * sizeof(float));
+    
+    return true;
+}
+
+bool AudioPreprocessor::processAudioChain(int16_t* audioData, size_t sampleCount, bool isInput) {
+    if (!audioData || sampleCount == 0) {
+        return false;
+    }
+    
+    int sourceNode = ProcessingGraph::INVALID_NODE;
+    ProcessingGraph* activeGraph = acquireGraph(isInput ? inputGraph_ : outputGraph_, sourceNode);
+    if (!activeGraph) {
+        return false;
+    }
+    ProcessingGraph& graph = *activeGraph;
+    float* source = graph.getSourceBuffer(sourceNode);
+    if (!source) {
+        return false;
+    }
+    
+    int16ToFloat(audioData, source, sampleCount);
+    if (!runChain(graph, sampleCount, isInput)) {
+        return false;
+    }
+    floatToInt16(graph.getOutputBuffer(), audioData, sampleCount);
+    
+    return true;
+}
+
+ProcessingGraph* AudioPreprocessor::acquireGraph(GraphSlot& slot, int& source) {
+    // Periyot sınırı: bekleyen graph devralınır. Kilit updateConfig'te tutuluyorsa
+    // beklenmez; bu periyot eski graph ile işlenir, devir bir sonrakinde yapılır.
+    if (slot.hasPending.load(std::memory_order_acquire)) {
+        std::unique_lock<std::mutex> lock(configMutex_, std::try_to_lock);
+        if (lock.owns_lock() && slot.pending) {
+            slot.retired = std::move(slot.active);
+            slot.active = std::move(slot.pending);
+            slot.activeSource = slot.pendingSource;
+            slot.hasPending.store(false, std::memory_order_relaxed);
+        }
+    }
+    
+    source = slot.activeSource;
+    return slot.active.get();
+}
+
+bool AudioPreprocessor::runChain(ProcessingGraph& graph, size_t sampleCount, bool isInput) {
     try {
-        bool speechDetected = false;
+        speechDetected_ = false;
         
-        if (isInput) {
-            // Input processing chain
-            
-            // 1. Automatic Gain Control (AGC)
-            if (config_.enableAGC) {
-                applyAGC(audioData, sampleCount);
-            }
-            
-            // 2. Noise Suppression
-            if (config_.enableNoiseSupression && noiseSuppresor_) {
-                // Resample to RNNoise sample rate if necessary
-                if (Config::SAMPLE_RATE != Config::RNNOISE_SAMPLE_RATE) {
-                    // TODO: Implement sample rate conversion for RNNoise
-                    logDebug("Sample rate conversion needed for RNNoise");
-                }
-                
-                // Process in RNNoise frame sizes
-                size_t frameSize = Config::RNNOISE_FRAME_SIZE;
-                if (sampleCount >= frameSize) {
-                    noiseSuppresor_->process(audioData, frameSize);
-                    speechDetected = noiseSuppresor_->isSpeechDetected();
-                }
-            }
-            
-            // 3. Voice Activity Detection
-            if (config_.enableVAD) {
-                float speechProb = noiseSuppresor_ ? noiseSuppresor_->getCurrentSpeechProbability() : 0.5f;
-                applyVAD(audioData, sampleCount, speechProb);
-                speechDetected = speechProb > config_.vadThreshold;
-            }
-            
-            // Call speech detection callback
-            if (onSpeechDetected_) {
-                onSpeechDetected_(speechDetected);
-            }
-        } else {
-            // Output processing chain (simpler)
-            
-            // Apply volume control
-            if (config_.enableAGC) {
-                for (size_t i = 0; i < sampleCount; ++i) {
-                    audioData[i] *= currentGain_;
-                }
-            }
+        if (!graph.run(sampleCount)) {
+            return false;
+        }
+        
+        // Call speech detection callback
+        if (isInput && onSpeechDetected_) {
+            onSpeechDetected_(speechDetected_);
         }
         
         // Update statistics
@@ -556,14 +608,116 @@ bool AudioPreprocessor::processAudioChain(float* audioData, size_t sampleCount,
     }
 }
 
+bool AudioPreprocessor::buildGraphs() {
+    // initialize sırasında: henüz işleyen thread yok, doğrudan etkin graph olur
+    inputGraph_.active = buildInputGraph(inputGraph_.activeSource);
+    outputGraph_.active = buildOutputGraph(outputGraph_.activeSource);
+    if (!inputGraph_.active || !outputGraph_.active) {
+        return false;
+    }
+    
+    logInfo("Giriş zinciri: " + inputGraph_.active->describe());
+    logInfo("Çıkış zinciri: " + outputGraph_.active->describe());
+    return true;
+}
+
+std::unique_ptr<ProcessingGraph> AudioPreprocessor::buildInputGraph(int& source) {
+    // validateSampleCount ile aynı üst sınır
+    const size_t maxFrames = Config::FRAMES_PER_BUFFER * 4;
+    const StageSpec spec(maxFrames, Config::SAMPLE_RATE);
+    
+    // Input processing chain: 1. AGC, 2. Noise Suppression, 3. VAD
+    auto graph = std::make_unique<ProcessingGraph>();
+    source = graph->addSource("capture", maxFrames, Config::SAMPLE_RATE);
+    int last = source;
+    
+    if (config_.enableAGC) {
+        last = graph->addStage<AudioPreprocessor, &AudioPreprocessor::agcStage>("agc", spec, this, {last});
+    }
+    
+    if (config_.enableNoiseSupression && noiseSuppresor_) {
+        last = graph->addStage<AudioPreprocessor, &AudioPreprocessor::denoiseStage>("denoise", spec, this, {last});
+    }
+    
+    if (config_.enableVAD) {
+        last = graph->addStage<AudioPreprocessor, &AudioPreprocessor::vadStage>("vad", spec, this, {last});
+    }
+    
+    if (!graph->setOutput(last) || !graph->build()) {
+        return nullptr;
+    }
+    if (profiler_) {
+        graph->setProfiler(profiler_, "input.");
+    }
+    return graph;
+}
+
+std::unique_ptr<ProcessingGraph> AudioPreprocessor::buildOutputGraph(int& source) {
+    const size_t maxFrames = Config::FRAMES_PER_BUFFER * 4;
+    const StageSpec spec(maxFrames, Config::SAMPLE_RATE);
+    
+    // Output processing chain (simpler): volume control
+    auto graph = std::make_unique<ProcessingGraph>();
+    source = graph->addSource("playback", maxFrames, Config::SAMPLE_RATE);
+    int last = source;
+    
+    if (config_.enableAGC) {
+        last = graph->addStage<AudioPreprocessor, &AudioPreprocessor::volumeStage>("volume", spec, this, {last});
+    }
+    
+    if (!graph->setOutput(last) || !graph->build()) {
+        return nullptr;
+    }
+    if (profiler_) {
+        graph->setProfiler(profiler_, "output.");
+    }
+    return graph;
+}
+
+void AudioPreprocessor::agcStage(const float* const* inputs, size_t, float* output, size_t frames) {
+    if (inputs[0] != output) {
+        std::memcpy(output, inputs[0], frames * sizeof(float));
+    }
+    applyAGC(output, frames);
+}
+
+void AudioPreprocessor::denoiseStage(const float* const* inputs, size_t, float* output, size_t frames) {
+    if (inputs[0] != output) {
+        std::memcpy(output, inputs[0], frames * sizeof(float));
+    }
+    
+    // Process in RNNoise frame sizes (SAMPLE_RATE == RNNOISE_SAMPLE_RATE); tam frame'lerin hepsi
+    size_t frameSize = Config::RNNOISE_FRAME_SIZE;
+    for (size_t offset = 0; offset + frameSize <= frames; offset += frameSize) {
+        noiseSuppresor_->process(output + offset, frameSize);
+    }
+    if (frames >= frameSize) {
+        speechDetected_ = noiseSuppresor_->isSpeechDetected();
+    }
+}
+
+void AudioPreprocessor::vadStage(const float* const* inputs, size_t, float* output, size_t frames) {
+    if (inputs[0] != output) {
+        std::memcpy(output, inputs[0], frames * sizeof(float));
+    }
+    
+    float speechProb = noiseSuppresor_ ? noiseSuppresor_->getCurrentSpeechProbability() : 0.5f;
+    applyVAD(output, frames, speechProb);
+    speechDetected_ = speechProb > config_.vadThreshold;
+}
+
+void AudioPreprocessor::volumeStage(const float* const* inputs, size_t, float* output, size_t frames) {
+    const float* input = inputs[0];
+    for (size_t i = 0; i < frames; ++i) {
+        output[i] = input[i] * currentGain_;
+    }
+}
+
 bool AudioPreprocessor::applyAGC(float* audioData, size_t sampleCount) {
     if (!audioData || sampleCount == 0) {
         return false;
     }
     
-    // Calculate current audio level
-    float currentLevel = calculateAudioLevel(audioData, sampleCount);
-    
     // Update gain control
     updateGainControl(audioData, sampleCount);
     
@@ -693,6 +847,7 @@ bool AudioPreprocessor::initializeComponents() {
         // Initialize Noise Suppressor
         if (config_.enableNoiseSupression) {
             noiseSuppresor_ = std::make_shared<NoiseSuppresor>();
+            noiseSuppresor_->setModelPath(config_.noiseModelPath);
             if (!noiseSuppresor_->initialize()) {
                 logError("NoiseSuppresor initialization failed");
                 return false;
@@ -706,6 +861,7 @@ bool AudioPreprocessor::initializeComponents() {
         // Initialize Codec
         if (config_.enableCodec) {
             codec_ = std::make_shared<LyraCodec>();
+            codec_->setStageProfiler(profiler_);
             if (!codec_->initialize(Config::LYRA_SAMPLE_RATE, Config::CHANNELS, config_.targetBitrate)) {
                 logError("LyraCodec initialization failed");
                 return false;
@@ -10,6 +10,8 @@
 #include "NoiseSuppresor.h"
 #include "LyraCodec.h"
 #include "BitrateCalculator.h"
+#include "ProcessingGraph.h"
+#include "StageProfiler.h"
 
 namespace NovaVoice {
 
@@ -26,6 +28,7 @@ struct PreprocessingConfig {
     float vadThreshold = 0.5f;
     float agcTargetLevel = 0.7f;
     uint32_t targetBitrate = Config::LYRA_DEFAULT_BITRATE;
+    std::string noiseModelPath;  // Boş = gömülü RNNoise modeli (paylaşılan)
     
     PreprocessingConfig() = default;
 };
@@ -106,6 +109,9 @@ public:
     std::shared_ptr<LyraCodec> getCodec() { return codec_; }
     std::shared_ptr<BitrateCalculator> getBitrateCalculator() { return bitrateCalculator_; }
     
+    // Graf aşamaları ("input.agc", "input.denoise", ...) ve codec için ölçüm
+    void setStageProfiler(std::shared_ptr<StageProfiler> profiler);
+    
     // === CALLBACKS ===
     void setOnSpeechDetected(std::function<void(bool)> callback);
     void setOnBitrateChanged(std::function<void(uint32_t)> callback);
@@ -125,6 +131,7 @@ private:
     std::shared_ptr<NoiseSuppresor> noiseSuppresor_;
     std::shared_ptr<LyraCodec> codec_;
     std::shared_ptr<BitrateCalculator> bitrateCalculator_;
+    std::shared_ptr<StageProfiler> profiler_;
     
     // Audio statistics
     AudioStats stats_;
@@ -137,14 +144,22 @@ private:
     std::vector<float> gainHistory_;
     size_t maxGainHistorySize_;
     
-    // Processing buffers
-    std::vector<float> tempBuffer_;
-    std::vector<int16_t> tempBufferInt16_;
-    std::vector<float> processBuffer_;
-    
-    // Sample rate conversion
-    std::vector<float> resampleBuffer_;
-    std::vector<int16_t> resampleBufferInt16_;
+    // Processing graphs (giriş: AGC -> denoise -> VAD, çıkış: ses seviyesi)
+    // Buffer'lar build sırasında planlanır; işleme sırasında bellek ayrılmaz.
+    // updateConfig yeni graph'ı ayrı kurar (pending); işleyen thread onu
+    // periyot başında devralır. Eski graph retired'a geçer ve bir sonraki
+    // updateConfig'te (ses thread'i dışında) serbest bırakılır.
+    struct GraphSlot {
+        std::unique_ptr<ProcessingGraph> active;
+        std::unique_ptr<ProcessingGraph> pending;
+        std::unique_ptr<ProcessingGraph> retired;
+        int activeSource = ProcessingGraph::INVALID_NODE;
+        int pendingSource = ProcessingGraph::INVALID_NODE;
+        std::atomic<bool> hasPending{false};
+    };
+    GraphSlot inputGraph_;
+    GraphSlot outputGraph_;
+    bool speechDetected_;
     
     // Timing
     std::chrono::steady_clock::time_point lastProcessTime_;
@@ -158,8 +173,19 @@ private:
     
     // Processing methods
     bool processAudioChain(float* audioData, size_t sampleCount, bool isInput);
-    bool resampleAudio(const float* input, size_t inputSize, uint32_t inputRate,
-                      float* output, size_t& outputSize, uint32_t outputRate);
+    bool processAudioChain(int16_t* audioData, size_t sampleCount, bool isInput);
+    bool runChain(ProcessingGraph& graph, size_t sampleCount, bool isInput);
+    bool buildGraphs();
+    std::unique_ptr<ProcessingGraph> buildInputGraph(int& source);
+    std::unique_ptr<ProcessingGraph> buildOutputGraph(int& source);
+    ProcessingGraph* acquireGraph(GraphSlot& slot, int& source);
+    
+    // Graph stages (aşama başına tek çağrı)
+    void agcStage(const float* const* inputs, size_t inputCount, float* output, size_t frames);
+    void denoiseStage(const float* const* inputs, size_t inputCount, float* output, size_t frames);
+    void vadStage(const float* const* inputs, size_t inputCount, float* output, size_t frames);
+    void volumeStage(const float* const* inputs, size_t inputCount, float* output, size_t frames);
+    
     bool applyAGC(float* audioData, size_t sampleCount);
     bool applyVAD(float* audioData, size_t sampleCount, float speechProbability);
     
@@ -0,0 +1,100 @@
+#include "LatencyProbe.h"
+#include <cmath>
+#include <cstdlib>
+
+namespace NovaVoice {
+
+LatencyProbe::LatencyProbe()
+    : playbackFrame_(0)
+    , captureFrame_(0)
+    , nextEmitFrame_(0)
+    , burstRemaining_(0)
+    , burstPhase_(0)
+    , pendingEmitFrame_(0)
+    , pending_(false)
+    , measurements_(0)
+    , missed_(0)
+    , lastLatencyFrames_(0)
+    , minLatencyFrames_(0)
+    , maxLatencyFrames_(0) {
+}
+
+void LatencyProbe::reset(uint64_t playbackOffsetFrames) {
+    playbackFrame_ = playbackOffsetFrames;
+    captureFrame_ = 0;
+    nextEmitFrame_ = playbackOffsetFrames + (static_cast<uint64_t>(Config::SAMPLE_RATE) *
+                                             Config::LATENCY_PROBE_INTERVAL_MS) / 1000;
+    burstRemaining_ = 0;
+    burstPhase_ = 0;
+    pending_ = false;
+}
+
+void LatencyProbe::onPlayback(int16_t* samples, size_t frames) {
+    uint64_t start = playbackFrame_;
+    uint64_t end = start + frames;
+
+    // Önceki darbe hâlâ bekleniyorsa yenisini ekleme (eşleşme karışmasın)
+    if (burstRemaining_ == 0 && !pending_ && nextEmitFrame_ >= start && nextEmitFrame_ < end) {
+        pendingEmitFrame_ = nextEmitFrame_;
+        pending_ = true;
+        burstRemaining_ = BURST_FRAMES;
+        burstPhase_ = 0;
+    }
+
+    if (burstRemaining_ > 0) {
+        size_t offset = pendingEmitFrame_ > start ? static_cast<size_t>(pendingEmitFrame_ - start) : 0;
+        for (size_t i = offset; i < frames && burstRemaining_ > 0; ++i, --burstRemaining_, ++burstPhase_) {
+            float value = BURST_AMPLITUDE * std::sin(2.0f * static_cast<float>(M_PI) * BURST_FREQUENCY *
+                                                     burstPhase_ / Config::SAMPLE_RATE);
+            for (uint16_t ch = 0; ch < Config::CHANNELS; ++ch) {
+                samples[i * Config::CHANNELS + ch] = static_cast<int16_t>(value);
+            }
+        }
+    }
+
+    if (nextEmitFrame_ < end) {
+        nextEmitFrame_ += (static_cast<uint64_t>(Config::SAMPLE_RATE) * Config::LATENCY_PROBE_INTERVAL_MS) / 1000;
+    }
+
+    playbackFrame_ = end;
+}
+
+void LatencyProbe::onCapture(const int16_t* samples, size_t frames) {
+    uint64_t start = captureFrame_;
+    captureFrame_ = start + frames;
+
+    if (!pending_) {
+        return;
+    }
+
+    uint64_t emitFrame = pendingEmitFrame_;
+
+    for (size_t i = 0; i < frames; ++i) {
+        uint64_t frameIndex = start + i;
+        if (frameIndex < emitFrame) {
+            continue;
+        }
+
+        if (std::abs(static_cast<int>(samples[i * Config::CHANNELS])) >= DETECT_THRESHOLD) {
+            uint64_t latency = frameIndex - emitFrame;
+            lastLatencyFrames_ = latency;
+            if (measurements_ == 0 || latency < minLatencyFrames_) {
+                minLatencyFrames_ = latency;
+            }
+            if (latency > maxLatencyFrames_) {
+                maxLatencyFrames_ = latency;
+            }
+            measurements_++;
+            pending_ = false;
+            return;
+        }
+    }
+
+    // Loopback yoksa darbe hiç gelmez; bir sonrakine izin ver
+    if (captureFrame_ > emitFrame + DETECT_TIMEOUT_FRAMES) {
+        missed_++;
+        pending_ = false;
+    }
+}
+
+} // namespace NovaVoice
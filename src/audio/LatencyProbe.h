@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include "Config.h"
+
+namespace NovaVoice {
+
+/**
+ * @brief Döngüsel (loopback) gecikme ölçer
+ *
+ * Playback akışına belirli aralıklarla kısa bir ton darbesi ekler ve
+ * capture akışında eşik ile yakalar. Gecikme, iki akışın frame
+ * sayaçları üzerinden hesaplanır (duvar saati kullanılmaz); bu yüzden
+ * capture ve playback'in aynı anda başlatıldığı linked modda doğrudur.
+ */
+class LatencyProbe {
+public:
+    LatencyProbe();
+
+    // Playback sayacını önceden yazılmış (prefill) frame kadar ileri alır
+    void reset(uint64_t playbackOffsetFrames);
+
+    // Playback thread'inde: ALSA'ya yazılmadan önce darbe ekler
+    void onPlayback(int16_t* samples, size_t frames);
+
+    // Capture thread'inde: okunan periyotta darbeyi arar
+    void onCapture(const int16_t* samples, size_t frames);
+
+    // === SONUÇLAR ===
+    uint64_t getMeasurementCount() const { return measurements_; }
+    uint64_t getMissedCount() const { return missed_; }
+    double getLastLatencyMs() const { return framesToMs(lastLatencyFrames_); }
+    double getMinLatencyMs() const { return framesToMs(minLatencyFrames_); }
+    double getMaxLatencyMs() const { return framesToMs(maxLatencyFrames_); }
+
+private:
+    static constexpr size_t BURST_FRAMES = Config::SAMPLE_RATE / 200;   // 5 ms
+    static constexpr uint32_t BURST_FREQUENCY = 1000;                    // Hz
+    static constexpr int16_t BURST_AMPLITUDE = 16000;
+    static constexpr int16_t DETECT_THRESHOLD = 4000;
+    static constexpr uint64_t DETECT_TIMEOUT_FRAMES = Config::SAMPLE_RATE / 2;
+
+    // Frame sayaçları (playback: prefill dahil yazılan, capture: okunan)
+    std::atomic<uint64_t> playbackFrame_;
+    std::atomic<uint64_t> captureFrame_;
+    uint64_t nextEmitFrame_;
+    size_t burstRemaining_;
+    size_t burstPhase_;
+
+    // Yayınlanmış ama henüz yakalanmamış darbe
+    std::atomic<uint64_t> pendingEmitFrame_;
+    std::atomic<bool> pending_;
+
+    // Sonuçlar
+    std::atomic<uint64_t> measurements_;
+    std::atomic<uint64_t> missed_;
+    std::atomic<uint64_t> lastLatencyFrames_;
+    std::atomic<uint64_t> minLatencyFrames_;
+    std::atomic<uint64_t> maxLatencyFrames_;
+
+    static double framesToMs(uint64_t frames) {
+        return static_cast<double>(frames) * 1000.0 / Config::SAMPLE_RATE;
+    }
+};
+
+} // namespace NovaVoice
@@ -3,6 +3,9 @@
 #include <algorithm>
 #include <cmath>
 #include <numeric>
+#include <map>
+#include <cstdio>
+#include "MemoryAccounting.h"
 
 // RNNoise includes (conditional)
 #ifdef HAVE_RNNOISE
@@ -13,6 +16,75 @@ extern "C" {
 
 namespace NovaVoice {
 
+static_assert(DenoiseFrontEnd::FRAME_SIZE == Config::RNNOISE_FRAME_SIZE, "RNNoise frame boyutu");
+static_assert(DenoiseFrontEnd::NB_FEATURES == DenoiseNet::INPUT_SIZE, "RNNoise özellik sayısı");
+
+namespace {
+
+// Aynı yoldan yüklenen ağ bu süreçteki oturumlarda paylaşılır (const);
+// bant sayısı özellik çıkarımıyla uyuşmayan modeller reddedilir
+std::shared_ptr<const DenoiseNet> loadSharedNet(const std::string& path) {
+    static std::mutex mutex;
+    static std::map<std::string, std::weak_ptr<const DenoiseNet>> nets;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = nets.find(path);
+    if (it != nets.end()) {
+        if (auto existing = it->second.lock()) {
+            return existing;
+        }
+    }
+
+    auto net = std::make_shared<DenoiseNet>();
+    if (!net->loadFromFile(path) || net->getGainCount() != DenoiseFrontEnd::NB_BANDS) {
+        return nullptr;
+    }
+
+    nets[path] = net;
+    return net;
+}
+
+} // namespace
+
+#ifdef HAVE_RNNOISE
+namespace {
+
+// renamenoise_model_from_file metin dosyasını kendi heap kopyasına ayrıştırır;
+// ağırlıklar dosyadan yerinde kullanılamaz, bu yüzden dosya eşlenmez. Aynı
+// yoldan ayrıştırılan kopya bu süreçteki oturumlarda paylaşılır (süreçler
+// arası paylaşım yok); son oturum bıraktığında serbest kalır
+std::shared_ptr<ReNameNoiseModel> loadSharedModel(const std::string& path) {
+    static std::mutex mutex;
+    static std::map<std::string, std::weak_ptr<ReNameNoiseModel>> models;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = models.find(path);
+    if (it != models.end()) {
+        if (auto existing = it->second.lock()) {
+            return existing;
+        }
+    }
+
+    FILE* stream = fopen(path.c_str(), "r");
+    if (!stream) {
+        return nullptr;
+    }
+    ReNameNoiseModel* raw = renamenoise_model_from_file(stream);
+    fclose(stream);
+    if (!raw) {
+        return nullptr;
+    }
+
+    std::shared_ptr<ReNameNoiseModel> model(raw, renamenoise_model_free);
+    models[path] = model;
+    return model;
+}
+
+} // namespace
+#endif
+
 NoiseSuppresor::NoiseSuppresor()
     : initialized_(false)
     , sampleRate_(Config::RNNOISE_SAMPLE_RATE)
@@ -26,6 +98,7 @@ NoiseSuppresor::NoiseSuppresor()
     , processedFrames_(0)
     , totalSamples_(0)
     , maxHistorySize_(100) {
+    MemoryScope memory(MemoryTag::DENOISER);
     
     noiseHistory_.reserve(maxHistorySize_);
     speechHistory_.reserve(maxHistorySize_);
@@ -38,6 +111,7 @@ NoiseSuppresor::~NoiseSuppresor() {
 }
 
 bool NoiseSuppresor::initialize(uint32_t sampleRate) {
+    MemoryScope memory(MemoryTag::DENOISER);
     if (initialized_) {
         logError("NoiseSuppresor zaten başlatılmış");
         return false;
@@ -50,21 +124,43 @@ bool NoiseSuppresor::initialize(uint32_t sampleRate) {
     
     sampleRate_ = sampleRate;
     
+    // Harici model: önce in-tree int8 çıkarım
+    if (!modelPath_.empty()) {
+        denoiseNet_ = loadSharedNet(modelPath_);
+        if (denoiseNet_) {
+            frontEnd_ = std::make_unique<DenoiseFrontEnd>();
+            denoiseState_.reset();
+            logInfo("Harici model int8 çıkarımla çalışacak: " + modelPath_);
+        }
+    }
+    
 #ifdef HAVE_RNNOISE
-    // RNNoise'i initialize et
-    try {
-        rnnState_ = renamenoise_create(nullptr);
-        if (!rnnState_) {
-            logError("RNNoise state oluşturulamadı");
+    // RNNoise'i initialize et (harici model DenoiseNet'e yüklenemediyse)
+    if (!denoiseNet_) {
+        try {
+            if (!modelPath_.empty()) {
+                rnnModel_ = loadSharedModel(modelPath_);
+                if (!rnnModel_) {
+                    logError("RNNoise modeli yüklenemedi: " + modelPath_);
+                    return false;
+                }
+            }
+        
+            rnnState_ = renamenoise_create(rnnModel_.get());
+            if (!rnnState_) {
+                logError("RNNoise state oluşturulamadı");
+                return false;
+            }
+            logInfo("RNNoise başarıyla başlatıldı");
+        } catch (const std::exception& e) {
+            logError("RNNoise initialization hatası: " + std::string(e.what()));
             return false;
         }
-        logInfo("RNNoise başarıyla başlatıldı");
-    } catch (const std::exception& e) {
-        logError("RNNoise initialization hatası: " + std::string(e.what()));
-        return false;
     }
 #else
-    logInfo("RNNoise mevcut değil, fallback algoritma kullanılacak");
+    if (!denoiseNet_) {
+        logInfo("RNNoise mevcut değil, fallback algoritma kullanılacak");
+    }
 #endif
     
     initialized_ = true;
@@ -83,7 +179,10 @@ void NoiseSuppresor::shutdown() {
         renamenoise_destroy(rnnState_);
         rnnState_ = nullptr;
     }
+    rnnModel_.reset();
 #endif
+    denoiseNet_.reset();
+    frontEnd_.reset();
     
     initialized_ = false;
     noiseHistory_.clear();
@@ -94,13 +193,14 @@ void NoiseSuppresor::shutdown() {
 
 bool NoiseSuppresor::isRNNoiseAvailable() const {
 #ifdef HAVE_RNNOISE
-    return rnnState_ != nullptr;
+    return denoiseNet_ != nullptr || rnnState_ != nullptr;
 #else
-    return false;
+    return denoiseNet_ != nullptr;
 #endif
 }
 
 bool NoiseSuppresor::process(float* audioData, size_t frameSize) {
+    MemoryScope memory(MemoryTag::DENOISER);
     if (!initialized_) {
         logError("NoiseSuppresor başlatılmamış");
         return false;
@@ -114,15 +214,11 @@ bool NoiseSuppresor::process(float* audioData, size_t frameSize) {
     try {
         bool success = false;
         
-#ifdef HAVE_RNNOISE
         if (isRNNoiseAvailable()) {
             success = processRNNoise(audioData, frameSize);
         } else {
             success = processFallback(audioData, frameSize);
         }
-#else
-        success = processFallback(audioData, frameSize);
-#endif
         
         if (success) {
             processedFrames_++;
@@ -223,11 +319,29 @@ float NoiseSuppresor::getAverageSpeechProbability() const {
     return sum / static_cast<float>(speechHistory_.size());
 }
 
+size_t NoiseSuppresor::getSessionFootprintBytes() const {
+    size_t bytes = sizeof(*this);
+    bytes += (tempBuffer_.capacity() + outputBuffer_.capacity()) * sizeof(float);
+    bytes += (noiseHistory_.capacity() + speechHistory_.capacity()) * sizeof(float);
+    if (frontEnd_) {
+        bytes += sizeof(DenoiseFrontEnd);
+    }
+#ifdef HAVE_RNNOISE
+    if (rnnState_) {
+        bytes += static_cast<size_t>(renamenoise_get_size());
+    }
+#endif
+    return bytes;
+}
+
 std::string NoiseSuppresor::getInfo() const {
     std::string info = "NoiseSuppresor Info:\n";
     info += "Sample Rate: " + std::to_string(sampleRate_) + " Hz\n";
     info += "Frame Size: " + std::to_string(Config::RNNOISE_FRAME_SIZE) + " samples\n";
     info += "RNNoise Available: " + std::string(isRNNoiseAvailable() ? "Yes" : "No") + "\n";
+    info += "Model: " + (modelPath_.empty() ? std::string("built-in") : modelPath_) + "\n";
+    info += "Inference: " + std::string(denoiseNet_ ? "int8 (DenoiseNet)" : "ReNameNoise") + "\n";
+    info += "Session Footprint: " + std::to_string(getSessionFootprintBytes()) + " bytes\n";
     info += "Suppression Level: " + std::to_string(suppressionLevel_) + "\n";
     info += "Threshold: " + std::to_string(threshold_) + "\n";
     info += "VAD Enabled: " + std::string(vadEnabled_ ? "Yes" : "No") + "\n";
@@ -243,14 +357,25 @@ std::string NoiseSuppresor::getInfo() const {
 // PRIVATE METHODS
 
 bool NoiseSuppresor::processRNNoise(float* audioData, size_t frameSize) {
-#ifdef HAVE_RNNOISE
-    if (!rnnState_ || frameSize != Config::RNNOISE_FRAME_SIZE) {
+    if (frameSize != Config::RNNOISE_FRAME_SIZE) {
         return false;
     }
     
     try {
         // RNNoise process (returns speech probability)
-        float speechProb = renamenoise_process_frame(rnnState_, audioData, audioData);
+        float speechProb;
+        if (denoiseNet_) {
+            speechProb = processQuantizedFrame(audioData);
+        } else {
+#ifdef HAVE_RNNOISE
+            if (!rnnState_) {
+                return false;
+            }
+            speechProb = renamenoise_process_frame(rnnState_, audioData, audioData);
+#else
+            return false;
+#endif
+        }
         
         // Calculate noise level
         float noiseLevel = calculateNoiseLevel(audioData, frameSize);
@@ -279,9 +404,31 @@ bool NoiseSuppresor::processRNNoise(float* audioData, size_t frameSize) {
         logError("RNNoise processing error: " + std::string(e.what()));
         return false;
     }
-#else
-    return false;
-#endif
+}
+
+float NoiseSuppresor::processQuantizedFrame(float* audioData) {
+    // DenoiseFrontEnd RNNoise gibi int16 ölçeğinde çalışır
+    constexpr float scale = 32768.0f;
+    float* frame = outputBuffer_.data();
+    for (size_t i = 0; i < Config::RNNOISE_FRAME_SIZE; ++i) {
+        frame[i] = audioData[i] * scale;
+    }
+    
+    float features[DenoiseNet::INPUT_SIZE];
+    float gains[DenoiseNet::MAX_WIDTH];
+    float speechProb = 0.0f;
+    if (frontEnd_->analyze(frame, features)) {
+        speechProb = denoiseNet_->computeInt8(denoiseState_, features, gains);
+        frontEnd_->synthesize(gains, frame);
+    } else {
+        // Sessiz frame: ağ çalıştırılmaz, spektrum olduğu gibi sentezlenir
+        frontEnd_->synthesize(nullptr, frame);
+    }
+    
+    for (size_t i = 0; i < Config::RNNOISE_FRAME_SIZE; ++i) {
+        audioData[i] = frame[i] / scale;
+    }
+    return speechProb;
 }
 
 bool NoiseSuppresor::processFallback(float* audioData, size_t frameSize) {
@@ -565,7 +712,7 @@ float calculateSNR(const float* signal, const float* noise, size_t frameSize) {
     return 10.0f * std::log10(signalPower / noisePower);
 }
 
-float calculateTHD(const float* audioData, size_t frameSize, uint32_t sampleRate) {
+float calculateTHD(const float* audioData, size_t frameSize, uint32_t /*sampleRate*/) {
     // Simplified THD calculation
     // In a real implementation, you would use FFT to find harmonics
     
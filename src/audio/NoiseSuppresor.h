@@ -6,12 +6,16 @@
 #include <mutex>
 #include <string>
 #include "Config.h"
+#include "DenoiseNet.h"
+#include "DenoiseFrontEnd.h"
 
 // RNNoise forward declarations (conditional)
 #ifdef HAVE_RNNOISE
 extern "C" {
     struct ReNameNoiseDenoiseState;
     typedef struct ReNameNoiseDenoiseState ReNameNoiseDenoiseState;
+    struct ReNameNoiseModel;
+    typedef struct ReNameNoiseModel ReNameNoiseModel;
 }
 #endif
 
@@ -32,6 +36,13 @@ struct NoiseMetrics {
  * 
  * Bu sınıf RNNoise kütüphanesini kullanarak real-time gürültü engelleme
  * işlemi yapar. RNNoise mevcut değilse basit gürültü azaltma algoritması kullanır.
+ * Harici model dosyası verilirse süreç içinde bir kez ayrıştırılır ve aynı
+ * süreçteki oturumlar bu kopyayı paylaşır; her oturum yalnızca kendi
+ * recurrent state'ini tutar. Harici model DenoiseNet'e yüklenebiliyorsa
+ * frame'ler RNNoise ile aynı özellik çıkarımından (DenoiseFrontEnd) geçip
+ * int8 çekirdeklerle çalıştırılır; yüklenemezse ReNameNoise kullanılır.
+ * Gömülü modelin ağırlıkları kütüphane dışına açık olmadığından gömülü
+ * model her zaman ReNameNoise ile çalışır.
  */
 class NoiseSuppresor {
 public:
@@ -43,6 +54,12 @@ public:
     void shutdown();
     bool isInitialized() const { return initialized_; }
     bool isRNNoiseAvailable() const;
+    bool isQuantizedInference() const { return denoiseNet_ != nullptr; }
+    
+    // Harici RNNoise model dosyası (initialize'dan önce; boş = gömülü model)
+    // Aynı dosya DenoiseNet'e yüklenebiliyorsa int8 çıkarım kullanılır
+    void setModelPath(const std::string& path) { modelPath_ = path; }
+    const std::string& getModelPath() const { return modelPath_; }
     
     // === NOISE SUPPRESSION ===
     bool process(float* audioData, size_t frameSize);
@@ -73,8 +90,14 @@ public:
     float getAverageNoiseLevel() const;
     float getAverageSpeechProbability() const;
     
+    // === MEMORY ===
+    // Yalnızca bu oturuma ait bellek (RNN state + iç buffer'lar)
+    size_t getSessionFootprintBytes() const;
+    
     // === UTILITY ===
     size_t getRequiredFrameSize() const { return Config::RNNOISE_FRAME_SIZE; }
+    // Çıkışın girişe göre gecikmesi (örnek): RNNoise yolları bir frame overlap-add gecikmesi ekler
+    size_t getDelaySamples() const { return isRNNoiseAvailable() ? Config::RNNOISE_FRAME_SIZE : 0; }
     uint32_t getSampleRate() const { return sampleRate_; }
     std::string getInfo() const;
     
@@ -88,8 +111,13 @@ private:
     bool adaptiveEnabled_;     // Adaptive suppression
     
     // RNNoise state
+    std::string modelPath_;
+    std::shared_ptr<const DenoiseNet> denoiseNet_;  // Harici model, int8 çıkarım (paylaşılan)
+    std::unique_ptr<DenoiseFrontEnd> frontEnd_;     // Oturuma özgü özellik/sentez durumu
+    DenoiseNet::State denoiseState_;
 #ifdef HAVE_RNNOISE
     ReNameNoiseDenoiseState* rnnState_;
+    std::shared_ptr<ReNameNoiseModel> rnnModel_;   // Süreç içinde paylaşılan, salt okunur
 #endif
     
     // Metrics
@@ -109,6 +137,7 @@ private:
     
     // Processing methods
     bool processRNNoise(float* audioData, size_t frameSize);
+    float processQuantizedFrame(float* audioData);
     bool processFallback(float* audioData, size_t frameSize);
     float calculateNoiseLevel(const float* audioData, size_t frameSize);
     float calculateSpeechProbability(const float* audioData, size_t frameSize);
@@ -0,0 +1,460 @@
+#include "PcmTap.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <iostream>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace NovaVoice {
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Ring indeksleri süreçler arası kilitsiz olmalı");
+static_assert((PcmTap::FILTER_TAPS & (PcmTap::FILTER_TAPS - 1)) == 0, "Filtre geçmişi 2'nin kuvveti olmalı");
+
+namespace {
+
+constexpr uint64_t RING_MASK = PcmTap::RING_SAMPLES - 1;
+constexpr size_t HISTORY_MASK = PcmTap::FILTER_TAPS - 1;
+
+uint64_t monotonicNs() {
+    // vDSO: sistem çağrısı yapmaz
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ull + static_cast<uint64_t>(now.tv_nsec);
+}
+
+bool isReadable(uint32_t state) {
+    return state == PcmTap::ACTIVE || state == PcmTap::ENDED;
+}
+
+} // namespace
+
+// === SAYFA ADLARI ===
+
+std::string PcmTap::defaultName() {
+    return std::string(NAME_PREFIX) + std::to_string(getpid());
+}
+
+std::string PcmTap::pathFor(const std::string& name) {
+    // Tam yol verilmişse aynen kullanılır
+    if (!name.empty() && name[0] == '/') {
+        return name;
+    }
+    return std::string(DIRECTORY) + "/" + name;
+}
+
+// === YAZICI ===
+
+PcmTapPublisher::PcmTapPublisher()
+    : page_(nullptr)
+    , coefficientFactor_(0)
+    , writtenSamples_(0)
+    , rejectedWrites_(0) {
+    std::memset(decimators_, 0, sizeof(decimators_));
+    std::memset(coefficients_, 0, sizeof(coefficients_));
+}
+
+PcmTapPublisher::~PcmTapPublisher() {
+    close();
+}
+
+bool PcmTapPublisher::open(const std::string& name) {
+    close();
+
+    // Konuşma sesi: yalnızca motoru çalıştıran kullanıcı okuyabilir. Çalışan bir motorun
+    // sayfası kesilmez (okuyucuları bozulur); çökmüş bir sürecin bıraktığı sayfa silinip yeniden denenir
+    path_ = PcmTap::pathFor(name);
+    int fd = ::open(path_.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    if (fd < 0 && errno == EEXIST && removeStalePage()) {
+        fd = ::open(path_.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    }
+    if (fd < 0) {
+        logError("Sayfa oluşturulamadı: " + path_ + " (" + std::strerror(errno) + ")");
+        return false;
+    }
+
+    if (ftruncate(fd, sizeof(PcmTap::Layout)) != 0) {
+        logError("Sayfa boyutlandırılamadı: " + path_);
+        ::close(fd);
+        unlink(path_.c_str());
+        return false;
+    }
+
+    void* memory = mmap(nullptr, sizeof(PcmTap::Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        logError("Sayfa eşlenemedi: " + path_);
+        unlink(path_.c_str());
+        return false;
+    }
+
+    // Ring'ler gerçek zamanlı yolda ilk dokunuşta sayfa hatası vermesin (başarısızsa yalnızca ilk yazım yavaşlar)
+    mlock(memory, sizeof(PcmTap::Layout));
+
+    // ftruncate sayfayı sıfırlar (tüm ring'ler FREE); başlık en son magic ile yayınlanır
+    page_ = new (memory) PcmTap::Layout;
+    page_->version = PcmTap::VERSION;
+    page_->sampleRate = PcmTap::SAMPLE_RATE;
+    page_->ringSamples = static_cast<uint32_t>(PcmTap::RING_SAMPLES);
+    page_->sessionCount = static_cast<uint32_t>(PcmTap::MAX_SESSIONS);
+    page_->pid = static_cast<uint32_t>(getpid());
+    page_->startNs = monotonicNs();
+    page_->nextGeneration.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    page_->magic = PcmTap::MAGIC;
+
+    designFilter(Config::SAMPLE_RATE / PcmTap::SAMPLE_RATE);
+    return true;
+}
+
+bool PcmTapPublisher::removeStalePage() {
+    int fd = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return errno == ENOENT;  // Bu arada silinmiş
+    }
+
+    // Başlık: magic, version, sampleRate, ringSamples, sessionCount, pid
+    uint32_t header[6] = {};
+    ssize_t bytes = pread(fd, header, sizeof(header), 0);
+    ::close(fd);
+
+    uint32_t pid = header[5];
+    if (bytes != static_cast<ssize_t>(sizeof(header)) || header[0] != PcmTap::MAGIC || pid == 0) {
+        logError("Sayfa adı motora ait olmayan bir dosyada kullanılıyor: " + path_);
+        errno = EEXIST;
+        return false;
+    }
+
+    if (kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH) {
+        logError("Sayfa başka bir motor tarafından kullanılıyor (pid " + std::to_string(pid) + "): " + path_);
+        errno = EEXIST;
+        return false;
+    }
+
+    if (unlink(path_.c_str()) != 0 && errno != ENOENT) {
+        return false;
+    }
+    return true;
+}
+
+void PcmTapPublisher::close() {
+    if (!page_) {
+        return;
+    }
+
+    munmap(page_, sizeof(PcmTap::Layout));
+    unlink(path_.c_str());
+    page_ = nullptr;
+}
+
+bool PcmTapPublisher::write(uint32_t sessionId, const int16_t* samples, size_t count, uint32_t inputRate, bool local) {
+    if (!page_ || !samples || count == 0) {
+        return false;
+    }
+
+    // Yalnızca tam katlı hızlar: 16 kHz kopyalanır, motor hızı tasarlanmış filtreyle indirilir
+    uint32_t factor = inputRate / PcmTap::SAMPLE_RATE;
+    if (inputRate % PcmTap::SAMPLE_RATE != 0 || (factor != 1 && factor != coefficientFactor_)) {
+        rejectedWrites_++;
+        return false;
+    }
+
+    int index = findRing(sessionId);
+    if (index < 0) {
+        index = claimRing(sessionId, local);
+        if (index < 0) {
+            rejectedWrites_++;
+            return false;
+        }
+    }
+
+    PcmTap::Ring& ring = page_->rings[index];
+    Decimator& decimator = decimators_[index];
+    if (decimator.factor != factor) {
+        std::memset(&decimator, 0, sizeof(decimator));
+        decimator.factor = factor;
+    }
+
+    size_t outputs = (decimator.phase + count) / factor;
+    uint64_t head = ring.writeIndex.load(std::memory_order_relaxed);
+
+    // Üzerine yazılacak bölge örnekler değişmeden önce ilan edilir (okuyucu kopyasını buna göre keser)
+    ring.writeReserve.store(head + outputs, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint64_t position = head;
+    if (factor == 1) {
+        for (size_t i = 0; i < count; ++i) {
+            ring.samples[position++ & RING_MASK] = samples[i];
+        }
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            decimator.history[decimator.position] = samples[i];
+            decimator.position = (decimator.position + 1) & HISTORY_MASK;
+            if (++decimator.phase < factor) {
+                continue;
+            }
+            decimator.phase = 0;
+
+            float sum = 0.0f;
+            for (size_t tap = 0; tap < PcmTap::FILTER_TAPS; ++tap) {
+                sum += coefficients_[tap] * decimator.history[(decimator.position + tap) & HISTORY_MASK];
+            }
+            ring.samples[position++ & RING_MASK] =
+                static_cast<int16_t>(std::max(-32768.0f, std::min(32767.0f, std::round(sum))));
+        }
+    }
+
+    ring.lastWriteNs.store(monotonicNs(), std::memory_order_relaxed);
+    ring.writeIndex.store(position, std::memory_order_release);
+    writtenSamples_.fetch_add(position - head, std::memory_order_relaxed);
+    return true;
+}
+
+void PcmTapPublisher::endSession(uint32_t sessionId) {
+    if (!page_) {
+        return;
+    }
+
+    int index = findRing(sessionId);
+    if (index >= 0) {
+        uint32_t expected = PcmTap::ACTIVE;
+        page_->rings[index].state.compare_exchange_strong(expected, PcmTap::ENDED, std::memory_order_release);
+    }
+}
+
+int PcmTapPublisher::findRing(uint32_t sessionId) const {
+    for (size_t i = 0; i < PcmTap::MAX_SESSIONS; ++i) {
+        const PcmTap::Ring& ring = page_->rings[i];
+        if (ring.state.load(std::memory_order_acquire) == PcmTap::ACTIVE &&
+            ring.sessionId.load(std::memory_order_relaxed) == sessionId) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+int PcmTapPublisher::claimRing(uint32_t sessionId, bool local) {
+    // Önce boş yuva; yoksa en uzun süredir yazılmayan biten oturum
+    int candidate = -1;
+    uint64_t oldestNs = UINT64_MAX;
+    for (size_t i = 0; i < PcmTap::MAX_SESSIONS; ++i) {
+        uint32_t state = page_->rings[i].state.load(std::memory_order_relaxed);
+        if (state == PcmTap::FREE) {
+            candidate = static_cast<int>(i);
+            break;
+        }
+        uint64_t lastWrite = page_->rings[i].lastWriteNs.load(std::memory_order_relaxed);
+        if (state == PcmTap::ENDED && lastWrite < oldestNs) {
+            candidate = static_cast<int>(i);
+            oldestNs = lastWrite;
+        }
+    }
+    if (candidate < 0) {
+        return -1;
+    }
+
+    // Başka bir yazıcı thread aynı yuvayı aldıysa bu seferlik vazgeç (bir sonraki yazım yeniden dener)
+    PcmTap::Ring& ring = page_->rings[candidate];
+    uint32_t expected = ring.state.load(std::memory_order_relaxed);
+    if (expected != PcmTap::FREE && expected != PcmTap::ENDED) {
+        return -1;
+    }
+    if (!ring.state.compare_exchange_strong(expected, PcmTap::CLAIMING, std::memory_order_acq_rel)) {
+        return -1;
+    }
+
+    // generation önce değişir: sıfırlanan indeksleri gören okuyucu eski kopyasını atar
+    ring.generation.store(page_->nextGeneration.fetch_add(1, std::memory_order_relaxed) + 1,
+                          std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    ring.sessionId.store(sessionId, std::memory_order_relaxed);
+    ring.local.store(local ? 1 : 0, std::memory_order_relaxed);
+    ring.startNs.store(monotonicNs(), std::memory_order_relaxed);
+    ring.writeReserve.store(0, std::memory_order_relaxed);
+    ring.writeIndex.store(0, std::memory_order_relaxed);
+    ring.lastWriteNs.store(0, std::memory_order_relaxed);
+    std::memset(&decimators_[candidate], 0, sizeof(Decimator));
+
+    ring.state.store(PcmTap::ACTIVE, std::memory_order_release);
+    return candidate;
+}
+
+void PcmTapPublisher::designFilter(uint32_t factor) {
+    coefficientFactor_ = factor;
+    if (factor <= 1) {
+        return;
+    }
+
+    // Hamming pencereli sinc; kesim yeni Nyquist'in %90'ı (48 kHz -> 16 kHz için 7.2 kHz)
+    double cutoff = 0.45 / factor;
+    double center = (PcmTap::FILTER_TAPS - 1) / 2.0;
+    double sum = 0.0;
+    for (size_t tap = 0; tap < PcmTap::FILTER_TAPS; ++tap) {
+        double x = tap - center;
+        double sinc = 2.0 * cutoff * (x == 0.0 ? 1.0 : std::sin(2.0 * M_PI * cutoff * x) / (2.0 * M_PI * cutoff * x));
+        double window = 0.54 - 0.46 * std::cos(2.0 * M_PI * tap / (PcmTap::FILTER_TAPS - 1));
+        coefficients_[tap] = static_cast<float>(sinc * window);
+        sum += coefficients_[tap];
+    }
+
+    // Birim DC kazancı
+    for (auto& coefficient : coefficients_) {
+        coefficient = static_cast<float>(coefficient / sum);
+    }
+}
+
+void PcmTapPublisher::logError(const std::string& message) const {
+    std::cerr << "[PcmTapPublisher ERROR] " << message << std::endl;
+}
+
+// === OKUYUCU ===
+
+PcmTapReader::PcmTapReader()
+    : page_(nullptr) {
+}
+
+PcmTapReader::~PcmTapReader() {
+    detach();
+}
+
+bool PcmTapReader::attach(const std::string& name) {
+    detach();
+
+    std::string path = PcmTap::pathFor(name);
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        logError("Sayfa açılamadı: " + path + " (" + std::strerror(errno) + ")");
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(PcmTap::Layout)) {
+        logError("Sayfa boyutu uyumsuz: " + path);
+        ::close(fd);
+        return false;
+    }
+
+    void* memory = mmap(nullptr, sizeof(PcmTap::Layout), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        logError("Sayfa eşlenemedi: " + path);
+        return false;
+    }
+
+    const auto* page = static_cast<const PcmTap::Layout*>(memory);
+    if (page->magic != PcmTap::MAGIC || page->version != PcmTap::VERSION ||
+        page->ringSamples != PcmTap::RING_SAMPLES || page->sessionCount != PcmTap::MAX_SESSIONS) {
+        logError("Sayfa sürümü uyumsuz: " + path + " (sürüm " + std::to_string(page->version) +
+                 ", beklenen " + std::to_string(PcmTap::VERSION) + ")");
+        munmap(memory, sizeof(PcmTap::Layout));
+        return false;
+    }
+
+    page_ = page;
+    return true;
+}
+
+void PcmTapReader::detach() {
+    if (!page_) {
+        return;
+    }
+
+    munmap(const_cast<PcmTap::Layout*>(page_), sizeof(PcmTap::Layout));
+    page_ = nullptr;
+}
+
+std::vector<PcmTapSession> PcmTapReader::listSessions() const {
+    std::vector<PcmTapSession> sessions;
+    if (!page_) {
+        return sessions;
+    }
+
+    for (size_t i = 0; i < PcmTap::MAX_SESSIONS; ++i) {
+        const PcmTap::Ring& ring = page_->rings[i];
+        uint32_t state = ring.state.load(std::memory_order_acquire);
+        if (!isReadable(state)) {
+            continue;
+        }
+
+        PcmTapSession session;
+        session.ring = i;
+        session.sessionId = ring.sessionId.load(std::memory_order_relaxed);
+        session.generation = ring.generation.load(std::memory_order_relaxed);
+        session.local = ring.local.load(std::memory_order_relaxed) != 0;
+        session.ended = state == PcmTap::ENDED;
+        session.startNs = ring.startNs.load(std::memory_order_relaxed);
+        session.writtenSamples = ring.writeIndex.load(std::memory_order_acquire);
+        session.lastWriteNs = ring.lastWriteNs.load(std::memory_order_relaxed);
+        sessions.push_back(session);
+    }
+    return sessions;
+}
+
+size_t PcmTapReader::read(size_t ringIndex, PcmTapCursor& cursor, int16_t* out, size_t maxSamples) const {
+    if (!page_ || ringIndex >= PcmTap::MAX_SESSIONS || !out || maxSamples == 0) {
+        return 0;
+    }
+
+    const PcmTap::Ring& ring = page_->rings[ringIndex];
+    if (!isReadable(ring.state.load(std::memory_order_acquire))) {
+        return 0;
+    }
+
+    uint32_t generation = ring.generation.load(std::memory_order_acquire);
+    uint64_t head = ring.writeIndex.load(std::memory_order_acquire);
+    uint64_t oldest = head > PcmTap::RING_SAMPLES ? head - PcmTap::RING_SAMPLES : 0;
+
+    // Yeni oturum: ring'de kalan en eski örnekten başla
+    if (cursor.generation != generation) {
+        cursor = PcmTapCursor();
+        cursor.generation = generation;
+        cursor.position = oldest;
+    }
+    if (cursor.position < oldest) {
+        cursor.droppedSamples += oldest - cursor.position;
+        cursor.position = oldest;
+    }
+    if (head <= cursor.position) {
+        return 0;
+    }
+
+    size_t count = static_cast<size_t>(std::min<uint64_t>(head - cursor.position, maxSamples));
+    size_t offset = static_cast<size_t>(cursor.position & RING_MASK);
+    size_t first = std::min(count, PcmTap::RING_SAMPLES - offset);
+    std::memcpy(out, ring.samples + offset, first * sizeof(int16_t));
+    std::memcpy(out + first, ring.samples, (count - first) * sizeof(int16_t));
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    // Kopya sırasında yuva başka oturuma verildiyse kopya geçersiz
+    if (ring.generation.load(std::memory_order_relaxed) != generation) {
+        cursor.generation = 0;
+        return 0;
+    }
+
+    // Yazıcının ilan ettiği bölgenin bir ring gerisi artık güvenilmez
+    uint64_t reserve = ring.writeReserve.load(std::memory_order_relaxed);
+    uint64_t valid = reserve > PcmTap::RING_SAMPLES ? reserve - PcmTap::RING_SAMPLES : 0;
+    size_t overwritten = 0;
+    if (valid > cursor.position) {
+        overwritten = static_cast<size_t>(std::min<uint64_t>(count, valid - cursor.position));
+        std::memmove(out, out + overwritten, (count - overwritten) * sizeof(int16_t));
+        cursor.droppedSamples += overwritten;
+    }
+
+    cursor.position += count;
+    return count - overwritten;
+}
+
+void PcmTapReader::logError(const std::string& message) const {
+    std::cerr << "[PcmTapReader ERROR] " << message << std::endl;
+}
+
+} // namespace NovaVoice
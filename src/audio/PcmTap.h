@@ -0,0 +1,172 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Config.h"
+
+namespace NovaVoice {
+
+/**
+ * @brief İşlenmiş sesin dış süreçlere /dev/shm üzerinden dağıtımı
+ *
+ * Sayfa, oturum (yerel mikrofon ve her uzak akış) başına sabit boyutlu bir
+ * 16 kHz int16 ring içerir. Her ring'in tek yazıcısı vardır (yakalama ya da
+ * alım thread'i); yazıcı okuyucuyu hiç beklemez, ring dolunca en eski
+ * örneklerin üzerine yazar. Okuyucu kendi imlecini tutar, örnekleri
+ * doğrudan eşlenmiş sayfadan kopyalar ve kopya sırasında üzerine yazılan
+ * kısmı (writeReserve ile) atıp kayıp olarak sayar. Yuva yeni bir oturuma
+ * verildiğinde sayfa genelinde tekil yeni bir generation alır; okuyucu
+ * imleci sıfırlanır.
+ */
+namespace PcmTap {
+
+constexpr uint32_t MAGIC = 0x4E565054;   // "NVPT"
+constexpr uint32_t VERSION = 1;
+constexpr const char* DIRECTORY = "/dev/shm";
+constexpr const char* NAME_PREFIX = "nova_tap.";
+
+constexpr uint32_t SAMPLE_RATE = Config::LYRA_SAMPLE_RATE;      // Yayınlanan hız
+constexpr size_t RING_SAMPLES = 32768;                          // ~2 s @ 16 kHz (2'nin kuvveti)
+constexpr size_t MAX_SESSIONS = Config::MAX_STREAMS + 1;        // + yerel mikrofon
+constexpr size_t FILTER_TAPS = 32;                              // Decimation alçak geçiren filtresi
+
+static_assert((RING_SAMPLES & (RING_SAMPLES - 1)) == 0, "Ring boyutu 2'nin kuvveti olmalı");
+
+enum SessionState : uint32_t {
+    FREE = 0,
+    CLAIMING = 1,       // Yazıcı yuvayı hazırlıyor, okunmaz
+    ACTIVE = 2,
+    ENDED = 3           // Oturum bitti; örnekler yuva yeniden verilene kadar okunabilir
+};
+
+struct Ring {
+    alignas(64) std::atomic<uint32_t> state;
+    std::atomic<uint32_t> generation;       // Yuvadaki oturumun sayfa genelinde tekil numarası
+    std::atomic<uint32_t> sessionId;
+    std::atomic<uint32_t> local;            // 1: yerel mikrofon
+    std::atomic<uint64_t> startNs;          // Oturumun ilk örneği (CLOCK_MONOTONIC)
+    alignas(64) std::atomic<uint64_t> writeReserve;   // Yazım başlamadan ilan edilen son konum
+    std::atomic<uint64_t> writeIndex;       // Yayınlanan toplam örnek (konum = indeks % RING_SAMPLES)
+    std::atomic<uint64_t> lastWriteNs;      // writeIndex'in yazıldığı an
+    alignas(64) int16_t samples[RING_SAMPLES];
+};
+
+struct Layout {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sampleRate;
+    uint32_t ringSamples;
+    uint32_t sessionCount;
+    uint32_t pid;
+    uint64_t startNs;
+    std::atomic<uint32_t> nextGeneration;
+    Ring rings[MAX_SESSIONS];
+};
+
+// Varsayılan sayfa adı: nova_tap.<pid>
+std::string defaultName();
+std::string pathFor(const std::string& name);
+
+} // namespace PcmTap
+
+// Okuyucu tarafında bir oturumun özeti
+struct PcmTapSession {
+    size_t ring;
+    uint32_t sessionId;
+    uint32_t generation;
+    bool local;
+    bool ended;
+    uint64_t startNs;
+    uint64_t writtenSamples;
+    uint64_t lastWriteNs;
+};
+
+// Okuyucu imleci; ring başına bir tane tutulur
+struct PcmTapCursor {
+    uint32_t generation;
+    uint64_t position;          // Sıradaki okunacak örnek indeksi
+    uint64_t droppedSamples;    // Okuyucu geride kaldığı için üzerine yazılanlar
+
+    PcmTapCursor() : generation(0), position(0), droppedSamples(0) {}
+};
+
+class PcmTapPublisher {
+public:
+    PcmTapPublisher();
+    ~PcmTapPublisher();
+
+    PcmTapPublisher(const PcmTapPublisher&) = delete;
+    PcmTapPublisher& operator=(const PcmTapPublisher&) = delete;
+
+    bool open(const std::string& name);
+    void close();       // Sayfa dosyası da silinir
+    bool isOpen() const { return page_ != nullptr; }
+    const std::string& getPath() const { return path_; }
+
+    // Oturumun tek yazıcı thread'inden çağrılır; ayırma, kilit ve sistem çağrısı yok.
+    // inputRate: PcmTap::SAMPLE_RATE (kopya) ya da onun tam katı (decimation)
+    bool write(uint32_t sessionId, const int16_t* samples, size_t count, uint32_t inputRate, bool local = false);
+    // Herhangi bir thread'den; ring okunabilir kalır, yeni oturuma verilebilir
+    void endSession(uint32_t sessionId);
+
+    // İstatistikler
+    uint64_t getWrittenSamples() const { return writtenSamples_; }
+    uint64_t getRejectedWrites() const { return rejectedWrites_; }
+
+private:
+    // Yazıcı süreç tarafında kalan ring başına filtre durumu (sayfada değil)
+    struct Decimator {
+        float history[PcmTap::FILTER_TAPS];
+        size_t position;
+        uint32_t phase;
+        uint32_t factor;
+    };
+
+    PcmTap::Layout* page_;
+    std::string path_;
+    Decimator decimators_[PcmTap::MAX_SESSIONS];
+    float coefficients_[PcmTap::FILTER_TAPS];
+    uint32_t coefficientFactor_;
+
+    std::atomic<uint64_t> writtenSamples_;
+    std::atomic<uint64_t> rejectedWrites_;
+
+    int findRing(uint32_t sessionId) const;
+    int claimRing(uint32_t sessionId, bool local);
+    void designFilter(uint32_t factor);
+    bool removeStalePage();     // Sahibi ölmüş sayfayı siler; canlı ya da yabancı dosyada false
+
+    void logError(const std::string& message) const;
+};
+
+class PcmTapReader {
+public:
+    PcmTapReader();
+    ~PcmTapReader();
+
+    PcmTapReader(const PcmTapReader&) = delete;
+    PcmTapReader& operator=(const PcmTapReader&) = delete;
+
+    bool attach(const std::string& name);
+    void detach();
+    bool isAttached() const { return page_ != nullptr; }
+    uint32_t getWriterPid() const { return page_ ? page_->pid : 0; }
+    uint32_t getSampleRate() const { return page_ ? page_->sampleRate : 0; }
+
+    // Okunabilir (ACTIVE/ENDED) oturumlar
+    std::vector<PcmTapSession> listSessions() const;
+
+    // İmleçten itibaren en fazla maxSamples örnek kopyalar; yeni generation'da imleç
+    // ring'deki en eski örneğe konur. Yazıcıyı hiç bekletmez.
+    size_t read(size_t ring, PcmTapCursor& cursor, int16_t* out, size_t maxSamples) const;
+
+private:
+    const PcmTap::Layout* page_;
+
+    void logError(const std::string& message) const;
+};
+
+} // namespace NovaVoice
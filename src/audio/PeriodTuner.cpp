@@ -0,0 +1,79 @@
+#include "PeriodTuner.h"
+#include <algorithm>
+
+namespace NovaVoice {
+
+PeriodTuner::PeriodTuner()
+    : periodFrames_(Config::FRAMES_PER_BUFFER)
+    , windowPeriods_(1)
+    , periodsInWindow_(0)
+    , windowMaxLateness_(0)
+    , windowXruns_(0)
+    , stableWindows_(0)
+    , switches_(0)
+    , lastWindowMaxLateness_(0)
+    , lastWindowXruns_(0) {
+    reset(Config::FRAMES_PER_BUFFER);
+}
+
+void PeriodTuner::reset(size_t periodFrames) {
+    periodFrames_ = periodFrames;
+
+    // Pencere süresi sabit; periyot küçüldükçe daha çok örnek toplanır
+    size_t windowFrames = static_cast<size_t>(Config::SAMPLE_RATE) * Config::PERIOD_TUNE_WINDOW_MS / 1000;
+    windowPeriods_ = std::max<size_t>(1, windowFrames / std::max<size_t>(1, periodFrames));
+
+    periodsInWindow_ = 0;
+    windowMaxLateness_ = 0;
+    windowXruns_ = 0;
+}
+
+void PeriodTuner::recordWakeup(size_t latenessFrames) {
+    windowMaxLateness_ = std::max(windowMaxLateness_, latenessFrames);
+    periodsInWindow_++;
+}
+
+void PeriodTuner::recordXrun() {
+    windowXruns_++;
+}
+
+size_t PeriodTuner::evaluate() {
+    if (periodsInWindow_ < windowPeriods_ && windowXruns_ == 0) {
+        return 0;
+    }
+
+    size_t period = periodFrames_;
+    size_t maxLateness = windowMaxLateness_;
+    uint64_t xruns = windowXruns_;
+
+    lastWindowMaxLateness_ = maxLateness;
+    lastWindowXruns_ = xruns;
+    reset(period);
+
+    // Host bu periyodu taşıyamıyor: hemen büyüt
+    if (xruns > 0 || maxLateness > period / 2) {
+        stableWindows_ = 0;
+        size_t larger = std::min(period * 2, Config::MAX_PERIOD_FRAMES);
+        if (larger != period) {
+            switches_++;
+            return larger;
+        }
+        return 0;
+    }
+
+    // Yarım periyotta bile rahat bir pay kalıyorsa küçült (histerezisli)
+    size_t smaller = std::max(period / 2, Config::MIN_PERIOD_FRAMES);
+    if (maxLateness < smaller / 4) {
+        if (++stableWindows_ >= Config::PERIOD_TUNE_STABLE_WINDOWS && smaller != period) {
+            stableWindows_ = 0;
+            switches_++;
+            return smaller;
+        }
+    } else {
+        stableWindows_ = 0;
+    }
+
+    return 0;
+}
+
+} // namespace NovaVoice
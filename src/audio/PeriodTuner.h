@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include "Config.h"
+
+namespace NovaVoice {
+
+/**
+ * @brief Gözlenen zamanlama sapmasına göre ALSA periyot boyutu seçer
+ *
+ * Her periyotta ses thread'inin uyanma gecikmesi (okuma sonrası cihazda
+ * bekleyen frame sayısı) ve xrun'lar kaydedilir. PERIOD_TUNE_WINDOW_MS
+ * uzunluğundaki pencerelerin sonunda:
+ *  - xrun olduysa veya en kötü gecikme periyodun yarısını aştıysa periyot ikiye katlanır,
+ *  - PERIOD_TUNE_STABLE_WINDOWS pencere boyunca gecikme yarı periyodun
+ *    dörtte birinin altında kaldıysa periyot yarıya indirilir.
+ * Sınırlar Config::MIN_PERIOD_FRAMES / MAX_PERIOD_FRAMES.
+ */
+class PeriodTuner {
+public:
+    PeriodTuner();
+
+    // Yeni periyotla pencereyi sıfırlar (geçişten sonra çağrılır)
+    void reset(size_t periodFrames);
+
+    // Ses thread'inden periyot başına bir kez
+    void recordWakeup(size_t latenessFrames);
+    void recordXrun();
+
+    // Pencere tamamlandığında önerilen periyot; değişiklik yoksa 0
+    size_t evaluate();
+
+    // === İSTATİSTİKLER ===
+    size_t getPeriodFrames() const { return periodFrames_; }
+    uint64_t getSwitches() const { return switches_; }
+    size_t getLastWindowMaxLateness() const { return lastWindowMaxLateness_; }
+    uint64_t getLastWindowXruns() const { return lastWindowXruns_; }
+
+private:
+    std::atomic<size_t> periodFrames_;
+    size_t windowPeriods_;
+    size_t periodsInWindow_;
+    size_t windowMaxLateness_;
+    uint64_t windowXruns_;
+    size_t stableWindows_;
+
+    std::atomic<uint64_t> switches_;
+    std::atomic<size_t> lastWindowMaxLateness_;
+    std::atomic<uint64_t> lastWindowXruns_;
+};
+
+} // namespace NovaVoice
@@ -0,0 +1,284 @@
+#include "ProcessingGraph.h"
+#include <iostream>
+#include <algorithm>
+#include <limits>
+
+namespace NovaVoice {
+
+ProcessingGraph::ProcessingGraph()
+    : outputNode_(INVALID_NODE)
+    , built_(false)
+    , bufferStride_(0)
+    , bufferCount_(0)
+    , outputBuffer_(nullptr)
+    , sourceFrames_(0)
+    , sourceRate_(0) {
+}
+
+int ProcessingGraph::addSource(const std::string& name, size_t frames, uint32_t sampleRate) {
+    if (frames == 0 || sampleRate == 0) {
+        logError("Geçersiz kaynak: " + name);
+        return INVALID_NODE;
+    }
+
+    built_ = false;
+    nodes_.push_back(Node{name, frames, sampleRate, false, true, nullptr, nullptr, {}, -1});
+    return static_cast<int>(nodes_.size()) - 1;
+}
+
+int ProcessingGraph::addStage(const std::string& name, const StageSpec& spec, StageFunction function,
+                              void* context, std::initializer_list<int> inputs) {
+    if (!function || spec.frames == 0 || spec.sampleRate == 0) {
+        logError("Geçersiz aşama: " + name);
+        return INVALID_NODE;
+    }
+
+    // Girişler önceden eklenmiş olmalı: id sırası geçerli bir topolojik sıradır
+    for (int input : inputs) {
+        if (!validateNode(input)) {
+            logError("Aşama '" + name + "' tanımsız girişe bağlı");
+            return INVALID_NODE;
+        }
+    }
+
+    built_ = false;
+    nodes_.push_back(Node{name, spec.frames, spec.sampleRate, spec.inPlace, false, function, context,
+                          std::vector<int>(inputs), -1});
+    return static_cast<int>(nodes_.size()) - 1;
+}
+
+bool ProcessingGraph::setOutput(int node) {
+    if (!validateNode(node)) {
+        return false;
+    }
+
+    built_ = false;
+    outputNode_ = node;
+    return true;
+}
+
+void ProcessingGraph::setProfiler(std::shared_ptr<StageProfiler> profiler, const std::string& prefix) {
+    profiler_ = profiler;
+    profilePrefix_ = prefix;
+
+    for (Step& step : steps_) {
+        step.profileStage = profiler_ ? profiler_->addStage(profilePrefix_ + nodes_[step.node].name)
+                                      : StageProfiler::INVALID_STAGE;
+    }
+}
+
+void ProcessingGraph::clear() {
+    nodes_.clear();
+    outputNode_ = INVALID_NODE;
+    built_ = false;
+    steps_.clear();
+    inputPointers_.clear();
+    storage_.clear();
+    bufferCount_ = 0;
+    outputBuffer_ = nullptr;
+}
+
+bool ProcessingGraph::build() {
+    built_ = false;
+    steps_.clear();
+    inputPointers_.clear();
+    storage_.clear();
+    bufferCount_ = 0;
+    outputBuffer_ = nullptr;
+
+    if (!validateNode(outputNode_)) {
+        logError("Çıkış düğümü tanımlı değil");
+        return false;
+    }
+
+    int count = static_cast<int>(nodes_.size());
+
+    // Çıkışa ulaşmayan aşamalar atılır; kaynaklar her zaman canlıdır
+    std::vector<bool> live(count, false);
+    live[outputNode_] = true;
+    for (int i = outputNode_; i >= 0; --i) {
+        if (nodes_[i].isSource) {
+            live[i] = true;
+        }
+        if (live[i]) {
+            for (int input : nodes_[i].inputs) {
+                live[input] = true;
+            }
+        }
+    }
+
+    // Birincil kaynak: run()'a verilen frame sayısının hızı
+    int primary = INVALID_NODE;
+    for (int i = 0; i < count && primary == INVALID_NODE; ++i) {
+        if (nodes_[i].isSource) {
+            primary = i;
+        }
+    }
+    if (primary == INVALID_NODE) {
+        logError("Grafın kaynağı yok");
+        return false;
+    }
+
+    // Boyut/hız tutarlılığı: her kenarda frames / rate oranı (süre) korunur
+    const Node& reference = nodes_[primary];
+    for (int i = 0; i < count; ++i) {
+        const Node& node = nodes_[i];
+        if (!live[i]) {
+            continue;
+        }
+        if (static_cast<uint64_t>(node.frames) * reference.sampleRate !=
+            static_cast<uint64_t>(reference.frames) * node.sampleRate) {
+            logError("Düğüm '" + node.name + "' süresi kaynakla uyuşmuyor (" +
+                     std::to_string(node.frames) + " frame @ " + std::to_string(node.sampleRate) + " Hz)");
+            return false;
+        }
+    }
+
+    // Son kullanım adımı (yürütme sırası = id sırası)
+    std::vector<int> lastUse(count);
+    for (int i = 0; i < count; ++i) {
+        lastUse[i] = i;
+    }
+    for (int i = 0; i < count; ++i) {
+        if (live[i]) {
+            for (int input : nodes_[i].inputs) {
+                lastUse[input] = std::max(lastUse[input], i);
+            }
+        }
+    }
+    lastUse[outputNode_] = std::numeric_limits<int>::max();
+
+    // Buffer ataması: ömrü biten buffer serbest listeye döner
+    std::vector<int> freeBuffers;
+    int buffers = 0;
+    size_t maxFrames = 0;
+    auto acquire = [&]() {
+        if (!freeBuffers.empty()) {
+            int buffer = freeBuffers.back();
+            freeBuffers.pop_back();
+            return buffer;
+        }
+        return buffers++;
+    };
+
+    for (int i = 0; i < count; ++i) {
+        if (nodes_[i].isSource) {
+            nodes_[i].buffer = acquire();
+            maxFrames = std::max(maxFrames, nodes_[i].frames);
+        } else {
+            nodes_[i].buffer = -1;
+        }
+    }
+
+    for (int i = 0; i < count; ++i) {
+        Node& node = nodes_[i];
+        if (!live[i] || node.isSource) {
+            continue;
+        }
+        maxFrames = std::max(maxFrames, node.frames);
+
+        std::vector<int> uniqueInputs = node.inputs;
+        std::sort(uniqueInputs.begin(), uniqueInputs.end());
+        uniqueInputs.erase(std::unique(uniqueInputs.begin(), uniqueInputs.end()), uniqueInputs.end());
+
+        // Yerinde: ilk girişin son kullanıcısı bu aşamaysa buffer'ı devralınır
+        int inherited = INVALID_NODE;
+        if (node.inPlace && !node.inputs.empty()) {
+            int first = node.inputs[0];
+            bool repeated = std::count(node.inputs.begin(), node.inputs.end(), first) > 1;
+            if (lastUse[first] == i && !repeated) {
+                inherited = first;
+            }
+        }
+        node.buffer = inherited != INVALID_NODE ? nodes_[inherited].buffer : acquire();
+
+        for (int input : uniqueInputs) {
+            if (lastUse[input] == i && input != inherited) {
+                freeBuffers.push_back(nodes_[input].buffer);
+            }
+        }
+    }
+
+    // Tek bitişik blok; satırlar 16 float'a (64 bayt) hizalı
+    bufferStride_ = ((maxFrames + 15) / 16) * 16;
+    bufferCount_ = static_cast<size_t>(buffers);
+    storage_.assign(bufferCount_ * bufferStride_, 0.0f);
+
+    for (int i = 0; i < count; ++i) {
+        const Node& node = nodes_[i];
+        if (!live[i] || node.isSource) {
+            continue;
+        }
+
+        Step step{node.function, node.context, inputPointers_.size(), node.inputs.size(),
+                  bufferPointer(node.buffer), node.sampleRate, i,
+                  profiler_ ? profiler_->addStage(profilePrefix_ + node.name) : StageProfiler::INVALID_STAGE};
+        for (int input : node.inputs) {
+            inputPointers_.push_back(bufferPointer(nodes_[input].buffer));
+        }
+        steps_.push_back(step);
+    }
+
+    outputBuffer_ = bufferPointer(nodes_[outputNode_].buffer);
+    sourceFrames_ = reference.frames;
+    sourceRate_ = reference.sampleRate;
+    built_ = true;
+    return true;
+}
+
+float* ProcessingGraph::getSourceBuffer(int source) {
+    if (!built_ || !validateNode(source) || !nodes_[source].isSource) {
+        return nullptr;
+    }
+    return bufferPointer(nodes_[source].buffer);
+}
+
+bool ProcessingGraph::run(size_t frames) {
+    if (!built_ || frames == 0 || frames > sourceFrames_) {
+        return false;
+    }
+
+    StageProfiler* profiler = profiler_.get();
+    for (const Step& step : steps_) {
+        size_t stageFrames = static_cast<size_t>(static_cast<uint64_t>(frames) * step.sampleRate / sourceRate_);
+        StageProfiler::Scope scope(profiler, step.profileStage);
+        step.function(step.context, &inputPointers_[step.firstInput], step.inputCount, step.output, stageFrames);
+    }
+
+    return true;
+}
+
+std::string ProcessingGraph::describe() const {
+    if (!built_) {
+        return "(plan yok)";
+    }
+
+    std::string plan;
+    for (const Step& step : steps_) {
+        const Node& node = nodes_[step.node];
+        if (!plan.empty()) {
+            plan += " -> ";
+        }
+        plan += node.name + "[b" + std::to_string(node.buffer) + "]";
+    }
+    if (plan.empty()) {
+        plan = nodes_[outputNode_].name;
+    }
+
+    return plan + " (" + std::to_string(steps_.size()) + " aşama, " + std::to_string(bufferCount_) +
+           " buffer, " + std::to_string(getBufferBytes()) + " bayt)";
+}
+
+bool ProcessingGraph::validateNode(int node) const {
+    return node >= 0 && node < static_cast<int>(nodes_.size());
+}
+
+float* ProcessingGraph::bufferPointer(int buffer) {
+    return storage_.data() + static_cast<size_t>(buffer) * bufferStride_;
+}
+
+void ProcessingGraph::logError(const std::string& message) const {
+    std::cerr << "[ProcessingGraph ERROR] " << message << std::endl;
+}
+
+} // namespace NovaVoice
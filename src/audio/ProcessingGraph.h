@@ -0,0 +1,134 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <initializer_list>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include "StageProfiler.h"
+
+namespace NovaVoice {
+
+// Aşama çağrısı: girişler, çıkış buffer'ı ve çıkış hızındaki frame sayısı.
+// Yerinde çalışan aşamalarda output == inputs[0] olabilir.
+using StageFunction = void (*)(void* context, const float* const* inputs, size_t inputCount,
+                               float* output, size_t frames);
+
+// Aşama bildirimi: çıkış boyutu ve hızı
+struct StageSpec {
+    size_t frames;          // Çalıştırma başına en fazla çıkış frame'i
+    uint32_t sampleRate;    // Çıkış örnekleme hızı
+    bool inPlace;           // Çıkış ilk girişin buffer'ına yazılabilir
+
+    StageSpec(size_t f, uint32_t rate, bool place = true) : frames(f), sampleRate(rate), inPlace(place) {}
+};
+
+/**
+ * @brief Bildirimsel ses işleme grafı
+ *
+ * Aşamalar frame boyutu ve örnekleme hızıyla bildirilir, kenarlar
+ * önceden ayrılmış buffer'ları taşır. build() çıkışa ulaşmayan aşamaları
+ * atar, yürütme sırasını düz bir diziye çıkarır ve buffer ömürlerini
+ * planlar: son kullanımı geçen buffer sonraki aşamalara verilir, yerinde
+ * çalışabilen aşama girişinin buffer'ını devralır. run() bellek ayırmaz
+ * ve aşama başına tek bir dolaylı çağrı yapar. build() dışında grafı
+ * değiştirmek planı geçersiz kılar.
+ */
+class ProcessingGraph {
+public:
+    static constexpr int INVALID_NODE = -1;
+
+    ProcessingGraph();
+
+    // Plan, grafın kendi belleğine işaretçiler tutar
+    ProcessingGraph(const ProcessingGraph&) = delete;
+    ProcessingGraph& operator=(const ProcessingGraph&) = delete;
+
+    // === KURULUM ===
+    // Dış giriş: veri run()'dan önce getSourceBuffer()'a yazılır
+    int addSource(const std::string& name, size_t frames, uint32_t sampleRate);
+    int addStage(const std::string& name, const StageSpec& spec, StageFunction function, void* context,
+                 std::initializer_list<int> inputs);
+
+    // Üye fonksiyon aşaması: çağrı derleme zamanında bağlanır (tek dolaylı çağrı)
+    template <typename T, void (T::*Method)(const float* const*, size_t, float*, size_t)>
+    int addStage(const std::string& name, const StageSpec& spec, T* object, std::initializer_list<int> inputs) {
+        return addStage(name, spec, &invokeMember<T, Method>, object, inputs);
+    }
+
+    bool setOutput(int node);
+    bool build();
+    void clear();
+    bool isBuilt() const { return built_; }
+
+    // Aşama başına süre histogramı ve donanım sayaçları (aşama adı: prefix + ad)
+    void setProfiler(std::shared_ptr<StageProfiler> profiler, const std::string& prefix = "");
+
+    // === ÇALIŞTIRMA ===
+    float* getSourceBuffer(int source);
+    const float* getOutputBuffer() const { return outputBuffer_; }
+    // frames: birincil kaynağın hızında (en fazla bildirilen boyut)
+    bool run(size_t frames);
+
+    // === PLAN BİLGİSİ ===
+    size_t getStageCount() const { return steps_.size(); }
+    size_t getNodeCount() const { return nodes_.size(); }
+    size_t getBufferCount() const { return bufferCount_; }
+    size_t getBufferBytes() const { return storage_.size() * sizeof(float); }
+    std::string describe() const;
+
+private:
+    struct Node {
+        std::string name;
+        size_t frames;
+        uint32_t sampleRate;
+        bool inPlace;
+        bool isSource;
+        StageFunction function;
+        void* context;
+        std::vector<int> inputs;
+        int buffer;
+    };
+
+    struct Step {
+        StageFunction function;
+        void* context;
+        size_t firstInput;      // inputPointers_ içindeki başlangıç
+        size_t inputCount;
+        float* output;
+        uint32_t sampleRate;
+        int node;
+        int profileStage;
+    };
+
+    std::vector<Node> nodes_;
+    int outputNode_;
+    bool built_;
+
+    // Plan
+    std::vector<Step> steps_;
+    std::vector<const float*> inputPointers_;
+    std::vector<float> storage_;
+    size_t bufferStride_;
+    size_t bufferCount_;
+    float* outputBuffer_;
+    size_t sourceFrames_;
+    uint32_t sourceRate_;
+
+    std::shared_ptr<StageProfiler> profiler_;
+    std::string profilePrefix_;
+
+    template <typename T, void (T::*Method)(const float* const*, size_t, float*, size_t)>
+    static void invokeMember(void* context, const float* const* inputs, size_t inputCount,
+                             float* output, size_t frames) {
+        (static_cast<T*>(context)->*Method)(inputs, inputCount, output, frames);
+    }
+
+    bool validateNode(int node) const;
+    float* bufferPointer(int buffer);
+
+    void logError(const std::string& message) const;
+};
+
+} // namespace NovaVoice
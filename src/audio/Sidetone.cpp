@@ -0,0 +1,60 @@
+#include "Sidetone.h"
+#include <algorithm>
+
+namespace NovaVoice {
+
+Sidetone::Sidetone()
+    : levelQ15_(0)
+    , ring_(2 * Config::MAX_PERIOD_FRAMES * Config::CHANNELS)
+    , scaled_(Config::MAX_PERIOD_FRAMES * Config::CHANNELS, 0)
+    , pending_(Config::MAX_PERIOD_FRAMES * Config::CHANNELS, 0)
+    , mixedFrames_(0)
+    , droppedFrames_(0) {
+}
+
+void Sidetone::setLevel(float level) {
+    level = std::max(0.0f, std::min(1.0f, level));
+    levelQ15_ = static_cast<int32_t>(level * UNITY_Q15);
+}
+
+void Sidetone::push(const int16_t* samples, size_t frames) {
+    int32_t level = levelQ15_.load(std::memory_order_relaxed);
+    if (level == 0 || !samples) {
+        return;
+    }
+
+    size_t count = std::min(frames * Config::CHANNELS, scaled_.size());
+    for (size_t i = 0; i < count; ++i) {
+        scaled_[i] = static_cast<int16_t>((samples[i] * level) >> 15);
+    }
+
+    size_t written = ring_.write(scaled_.data(), count);
+    if (written < count) {
+        droppedFrames_ += (count - written) / Config::CHANNELS;
+    }
+}
+
+void Sidetone::mixInto(int16_t* samples, size_t frames) {
+    if (levelQ15_.load(std::memory_order_relaxed) == 0 || !samples) {
+        return;
+    }
+
+    size_t count = std::min(frames * Config::CHANNELS, pending_.size());
+
+    // Bir periyottan fazlası birikti: eskileri at, gecikme sınırlı kalsın
+    size_t available = ring_.available();
+    if (available > count) {
+        size_t dropped = ring_.discard(available - count);
+        droppedFrames_ += dropped / Config::CHANNELS;
+    }
+
+    size_t read = ring_.read(pending_.data(), count);
+    for (size_t i = 0; i < read; ++i) {
+        int32_t mixed = static_cast<int32_t>(samples[i]) + pending_[i];
+        samples[i] = static_cast<int16_t>(std::max(-32768, std::min(32767, mixed)));
+    }
+
+    mixedFrames_ += read / Config::CHANNELS;
+}
+
+} // namespace NovaVoice
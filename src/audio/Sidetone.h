@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Config.h"
+#include "RingBuffer.h"
+
+namespace NovaVoice {
+
+/**
+ * @brief Yerel sidetone (kullanıcının kendi sesini kulaklıkta duyması)
+ *
+ * Capture thread'i gain sonrası örnekleri ölçekleyip kilitsiz halkaya
+ * yazar; playback thread'i ALSA'ya yazmadan hemen önce halkadakini
+ * periyoda karıştırır. BufferManager ve ağ yolu atlanır. Halkada bir
+ * periyottan fazlası birikirse en eski örnekler atılır, böylece halkanın
+ * eklediği bekleme en fazla bir periyotla sınırlı kalır. Toplam kulak
+ * gecikmesine ayrıca capture periyodu ve karıştırılan periyodun önündeki
+ * ALSA playback buffer doluluğu (ön doldurma ve kuyruktaki periyotlar)
+ * eklenir. Örnek başına bir tamsayı çarpma ve doygun toplama maliyeti vardır.
+ */
+class Sidetone {
+public:
+    static constexpr int32_t UNITY_Q15 = 1 << 15;   // 1.0 seviyesi (Q15)
+
+    Sidetone();
+
+    // 0.0 = kapalı, 1.0 = tam seviye
+    void setLevel(float level);
+    float getLevel() const { return static_cast<float>(levelQ15_) / UNITY_Q15; }
+    bool isEnabled() const { return levelQ15_ > 0; }
+
+    // Capture thread'i: gain uygulanmış örnekler
+    void push(const int16_t* samples, size_t frames);
+
+    // Playback thread'i: periyoda karıştır (halkada en fazla bir periyot bekler)
+    void mixInto(int16_t* samples, size_t frames);
+
+    // === İSTATİSTİKLER ===
+    uint64_t getMixedFrames() const { return mixedFrames_; }
+    uint64_t getDroppedFrames() const { return droppedFrames_; }
+
+private:
+    std::atomic<int32_t> levelQ15_;
+    SpscRingBuffer<int16_t> ring_;
+    std::vector<int16_t> scaled_;   // Capture tarafı geçici buffer
+    std::vector<int16_t> pending_;  // Playback tarafı geçici buffer
+
+    std::atomic<uint64_t> mixedFrames_;
+    std::atomic<uint64_t> droppedFrames_;
+};
+
+} // namespace NovaVoice
@@ -0,0 +1,141 @@
+#include "WavFile.h"
+#include <iostream>
+#include <fstream>
+#include <cstring>
+
+namespace NovaVoice {
+
+namespace {
+
+uint32_t readU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint16_t readU16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+void writeU32(std::ofstream& out, uint32_t value) {
+    uint8_t bytes[4] = {
+        static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8),
+        static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 24)
+    };
+    out.write(reinterpret_cast<const char*>(bytes), 4);
+}
+
+void writeU16(std::ofstream& out, uint16_t value) {
+    uint8_t bytes[2] = {static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8)};
+    out.write(reinterpret_cast<const char*>(bytes), 2);
+}
+
+} // namespace
+
+bool WavFile::read(const std::string& path, std::vector<int16_t>& samples, Info& info, bool downmix) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        logError("Dosya açılamadı: " + path);
+        return false;
+    }
+
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (data.size() < 12 || std::memcmp(data.data(), "RIFF", 4) != 0 || std::memcmp(data.data() + 8, "WAVE", 4) != 0) {
+        logError("Geçerli bir WAV dosyası değil: " + path);
+        return false;
+    }
+
+    bool haveFormat = false;
+    uint16_t bitsPerSample = 0;
+    size_t offset = 12;
+
+    while (offset + 8 <= data.size()) {
+        const uint8_t* chunk = data.data() + offset;
+        uint32_t chunkSize = readU32(chunk + 4);
+        size_t bodyOffset = offset + 8;
+        size_t available = data.size() - bodyOffset;
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && chunkSize >= 16 && available >= 16) {
+            uint16_t format = readU16(chunk + 8);
+            info.channels = readU16(chunk + 10);
+            info.sampleRate = readU32(chunk + 12);
+            bitsPerSample = readU16(chunk + 22);
+            // 1 = PCM, 0xFFFE = WAVE_FORMAT_EXTENSIBLE (PCM alt tipi varsayılır)
+            if ((format != 1 && format != 0xFFFE) || bitsPerSample != 16 || info.channels == 0) {
+                logError("Yalnızca 16-bit PCM destekleniyor: " + path);
+                return false;
+            }
+            haveFormat = true;
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            if (!haveFormat) {
+                logError("data bloğu fmt bloğundan önce: " + path);
+                return false;
+            }
+
+            size_t bytes = std::min<size_t>(chunkSize, available);
+            size_t frames = bytes / (sizeof(int16_t) * info.channels);
+            const uint8_t* pcm = data.data() + bodyOffset;
+
+            if (downmix && info.channels > 1) {
+                samples.resize(frames);
+                for (size_t f = 0; f < frames; ++f) {
+                    int32_t sum = 0;
+                    for (uint16_t ch = 0; ch < info.channels; ++ch) {
+                        sum += static_cast<int16_t>(readU16(pcm + (f * info.channels + ch) * 2));
+                    }
+                    samples[f] = static_cast<int16_t>(sum / info.channels);
+                }
+                info.channels = 1;
+            } else {
+                samples.resize(frames * info.channels);
+                for (size_t i = 0; i < samples.size(); ++i) {
+                    samples[i] = static_cast<int16_t>(readU16(pcm + i * 2));
+                }
+            }
+
+            info.frames = frames;
+            return true;
+        }
+
+        // Bloklar çift bayta hizalıdır
+        offset = bodyOffset + chunkSize + (chunkSize & 1);
+    }
+
+    logError("data bloğu bulunamadı: " + path);
+    return false;
+}
+
+bool WavFile::write(const std::string& path, const int16_t* samples, size_t frames,
+                    uint32_t sampleRate, uint16_t channels) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        logError("Dosya yazılamadı: " + path);
+        return false;
+    }
+
+    uint32_t dataBytes = static_cast<uint32_t>(frames * channels * sizeof(int16_t));
+    out.write("RIFF", 4);
+    writeU32(out, 36 + dataBytes);
+    out.write("WAVE", 4);
+    out.write("fmt ", 4);
+    writeU32(out, 16);
+    writeU16(out, 1);
+    writeU16(out, channels);
+    writeU32(out, sampleRate);
+    writeU32(out, sampleRate * channels * sizeof(int16_t));
+    writeU16(out, static_cast<uint16_t>(channels * sizeof(int16_t)));
+    writeU16(out, 16);
+    out.write("data", 4);
+    writeU32(out, dataBytes);
+
+    for (size_t i = 0; i < frames * channels; ++i) {
+        writeU16(out, static_cast<uint16_t>(samples[i]));
+    }
+
+    return static_cast<bool>(out);
+}
+
+void WavFile::logError(const std::string& message) {
+    std::cerr << "[WavFile ERROR] " << message << std::endl;
+}
+
+} // namespace NovaVoice
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace NovaVoice {
+
+/**
+ * @brief 16-bit PCM WAV dosya arka ucu
+ *
+ * Ses donanımı olmadan çalışan araçlar (kalite ölçümü, simülasyon) için
+ * ALSA'nın yerine geçen dosya giriş/çıkışı. Yalnızca 16-bit PCM okunur
+ * ve yazılır; çok kanallı dosyalar okunurken mono'ya indirilebilir.
+ */
+class WavFile {
+public:
+    struct Info {
+        uint32_t sampleRate = 0;
+        uint16_t channels = 0;
+        size_t frames = 0;
+    };
+
+    // Interleaved örnekleri okur; downmix=true ise kanalların ortalaması alınır
+    static bool read(const std::string& path, std::vector<int16_t>& samples, Info& info, bool downmix = true);
+    static bool write(const std::string& path, const int16_t* samples, size_t frames,
+                      uint32_t sampleRate, uint16_t channels = 1);
+
+private:
+    static void logError(const std::string& message);
+};
+
+} // namespace NovaVoice
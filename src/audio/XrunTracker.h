@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "Config.h"
+
+namespace NovaVoice {
+
+// Xrun kurtarma istatistikleri (anlık görüntü)
+struct XrunStats {
+    uint64_t count;              // Toplam xrun (EPIPE + ESTRPIPE)
+    uint64_t suspends;           // Bunlardan askıya alma (ESTRPIPE)
+    uint64_t failedRecoveries;   // snd_pcm_recover başarısız
+    double lastRecoveryUs;       // Son kurtarma süresi
+    double maxRecoveryUs;        // En uzun kurtarma süresi
+    uint64_t lostFrames;         // Kesinti boyunca kaybedilen toplam frame
+
+    XrunStats() : count(0), suspends(0), failedRecoveries(0),
+                  lastRecoveryUs(0.0), maxRecoveryUs(0.0), lostFrames(0) {}
+};
+
+/**
+ * @brief Capture/playback xrun kurtarmalarını ölçer
+ *
+ * Kayıp ses, son başarılı okuma/yazmadan kurtarmanın bitişine kadar geçen
+ * sürenin, o anda cihaz buffer'ında bulunan bir periyottan fazlası olarak
+ * hesaplanır. Ses thread'inden kilitsiz güncellenir.
+ */
+class XrunTracker {
+public:
+    XrunTracker() : count_(0), suspends_(0), failedRecoveries_(0),
+                    lastRecoveryNs_(0), maxRecoveryNs_(0), lostFrames_(0),
+                    lastIoTime_(std::chrono::steady_clock::now()) {}
+
+    // Başarılı I/O: kayıp hesabı için referans zamanı
+    void markIo() { lastIoTime_ = std::chrono::steady_clock::now(); }
+
+    // Kurtarma bitti: süreyi ve kaybedilen frame'leri kaydet (bu xrun'da kaybı döndürür)
+    uint64_t recordRecovery(std::chrono::steady_clock::time_point detected, bool suspended, bool succeeded,
+                            size_t periodFrames) {
+        auto now = std::chrono::steady_clock::now();
+        uint64_t recoveryNs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - detected).count());
+
+        int64_t gapNs = std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastIoTime_).count();
+        int64_t gapFrames = gapNs * static_cast<int64_t>(Config::SAMPLE_RATE) / 1000000000LL -
+                            static_cast<int64_t>(periodFrames);
+
+        count_++;
+        if (suspended) {
+            suspends_++;
+        }
+        if (!succeeded) {
+            failedRecoveries_++;
+        }
+        uint64_t lost = gapFrames > 0 ? static_cast<uint64_t>(gapFrames) : 0;
+        lostFrames_ += lost;
+
+        lastRecoveryNs_ = recoveryNs;
+        if (recoveryNs > maxRecoveryNs_) {
+            maxRecoveryNs_ = recoveryNs;
+        }
+
+        lastIoTime_ = now;
+        return lost;
+    }
+
+    XrunStats getStats() const {
+        XrunStats stats;
+        stats.count = count_;
+        stats.suspends = suspends_;
+        stats.failedRecoveries = failedRecoveries_;
+        stats.lastRecoveryUs = lastRecoveryNs_ / 1000.0;
+        stats.maxRecoveryUs = maxRecoveryNs_ / 1000.0;
+        stats.lostFrames = lostFrames_;
+        return stats;
+    }
+
+private:
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> suspends_;
+    std::atomic<uint64_t> failedRecoveries_;
+    std::atomic<uint64_t> lastRecoveryNs_;
+    std::atomic<uint64_t> maxRecoveryNs_;
+    std::atomic<uint64_t> lostFrames_;
+    std::chrono::steady_clock::time_point lastIoTime_; // Yalnızca ses thread'i yazar
+};
+
+} // namespace NovaVoice
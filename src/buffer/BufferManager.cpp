@@ -1,17 +1,69 @@
 #include "BufferManager.h"
+#include "RealtimeCheck.h"
+#include "MemoryAccounting.h"
 #include <iostream>
+#include <cstring>
+#include <algorithm>
+#include <cmath>
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
 
 namespace NovaVoice {
 
 BufferManager::BufferManager() 
-    : maxBufferSize_(Config::BUFFER_COUNT)
+    : outputHead_(0)
+    , outputCount_(0)
+    , retireWrite_(0)
+    , retireRead_(0)
+    , retireOverflows_(0)
+    , maxBufferSize_(Config::BUFFER_COUNT)
     , nextSequenceNumber_(0)
+    , nextControlSequenceNumber_(0)
     , droppedPackets_(0)
-    , totalPackets_(0) {
+    , totalPackets_(0)
+    , rejectedStreamPackets_(0) {
+    
+    MemoryScope memory(MemoryTag::JITTER_BUFFER);
+    
+    // Stream havuzunu önceden ayır
+    playbackStreamId_ = 0;
+    autoPlaybackStream_ = true;
+    lastIdleSweep_ = EngineClock::now();
+    streamPool_.resize(Config::MAX_STREAMS);
+    freeStreamSlots_.reserve(Config::MAX_STREAMS);
+    streamIndex_.resize(STREAM_INDEX_SIZE);
+    tapSilence_.assign(Config::MAX_PAYLOAD_SIZE / sizeof(int16_t), 0);
+    outputRing_.resize(maxBufferSize_);
+    retireRing_.resize(RETIRE_RING_SIZE);
+    for (size_t i = Config::MAX_STREAMS; i > 0; --i) {
+        streamPool_[i - 1].ring.resize(maxBufferSize_);
+        freeStreamSlots_.push_back(i - 1);
+    }
+    
+    // Hazır olma bildirimleri için eventfd oluştur
+    inputReadyFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    outputReadyFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    
+    if (inputReadyFd_ < 0 || outputReadyFd_ < 0) {
+        std::cerr << "[BufferManager ERROR] eventfd oluşturulamadı: " << strerror(errno)
+                  << " (condition variable kullanılacak)" << std::endl;
+    }
 }
 
 BufferManager::~BufferManager() {
     clearBuffers();
+    
+    if (inputReadyFd_ >= 0) {
+        close(inputReadyFd_);
+        inputReadyFd_ = -1;
+    }
+    
+    if (outputReadyFd_ >= 0) {
+        close(outputReadyFd_);
+        outputReadyFd_ = -1;
+    }
 }
 
 bool BufferManager::pushAudioPacket(std::shared_ptr<AudioPacket> packet) {
@@ -20,15 +72,30 @@ bool BufferManager::pushAudioPacket(std::shared_ptr<AudioPacket> packet) {
     }
     
     std::lock_guard<std::mutex> lock(inputMutex_);
+    MemoryScope memory(MemoryTag::JITTER_BUFFER);
+    
+    PacketLane lane = laneForType(packet->type);
+    auto& buffer = (lane == PacketLane::CONTROL) ? controlBuffer_ : inputBuffer_;
+    auto& counters = laneCounters_[static_cast<size_t>(lane)];
     
-    if (isBufferFull(inputBuffer_)) {
+    bool wasEmpty = inputBuffer_.empty() && controlBuffer_.empty();
+    
+    if (isBufferFull(buffer)) {
         // Buffer dolu, eski paketleri temizle
-        removeOldPackets(inputBuffer_);
+        removeOldPackets(buffer);
         droppedPackets_++;
+        counters.dropped++;
     }
     
-    inputBuffer_.push(packet);
+    // Taşıma: gönderici paketi çeker çekmez son referans onda kalır (üretici thread'de free yok)
+    buffer.push(std::move(packet));
     totalPackets_++;
+    counters.enqueued++;
+    
+    // Sadece boş -> dolu geçişinde bildir
+    if (wasEmpty) {
+        signalReady(inputReadyFd_);
+    }
     
     inputCondition_.notify_one();
     return true;
@@ -36,15 +103,24 @@ bool BufferManager::pushAudioPacket(std::shared_ptr<AudioPacket> packet) {
 
 std::shared_ptr<AudioPacket> BufferManager::popAudioPacket() {
     std::unique_lock<std::mutex> lock(inputMutex_);
+    return popLanePacket();
+}
+
+size_t BufferManager::popOutputBatch(std::vector<std::shared_ptr<AudioPacket>>& batch, size_t maxPackets) {
+    batch.clear();
     
-    if (inputBuffer_.empty()) {
-        return nullptr;
-    }
+    std::lock_guard<std::mutex> lock(inputMutex_);
     
-    auto packet = inputBuffer_.front();
-    inputBuffer_.pop();
+    // Kontrol paketleri her batch'in başına yerleşir
+    while (batch.size() < maxPackets) {
+        auto packet = popLanePacket();
+        if (!packet) {
+            break;
+        }
+        batch.push_back(std::move(packet));
+    }
     
-    return packet;
+    return batch.size();
 }
 
 bool BufferManager::pushInputBuffer(const uint8_t* data, size_t size) {
@@ -52,28 +128,82 @@ bool BufferManager::pushInputBuffer(const uint8_t* data, size_t size) {
         return false;
     }
     
-    auto packet = std::make_shared<AudioPacket>(data, size, nextSequenceNumber_++);
-    return pushAudioPacket(packet);
+    std::shared_ptr<AudioPacket> packet;
+    {
+        MemoryScope memory(MemoryTag::PACKETS);
+        packet = std::make_shared<AudioPacket>(data, size, nextSequenceNumber_++);
+    }
+    return pushAudioPacket(std::move(packet));
 }
 
 std::shared_ptr<AudioPacket> BufferManager::getNextOutputPacket() {
     return popAudioPacket();
 }
 
+bool BufferManager::pushControlPacket(PacketType type, const uint8_t* data, size_t size) {
+    if (type == PacketType::AUDIO) {
+        return false;
+    }
+    
+    // Keepalive gibi kontrol paketlerinin payload'ı boş olabilir
+    std::shared_ptr<AudioPacket> packet;
+    {
+        MemoryScope memory(MemoryTag::PACKETS);
+        packet = std::make_shared<AudioPacket>(data, data ? size : 0, nextControlSequenceNumber_++, type);
+    }
+    return pushAudioPacket(std::move(packet));
+}
+
 bool BufferManager::pushNetworkPacket(std::shared_ptr<AudioPacket> packet) {
     if (!packet) {
         return false;
     }
     
+    MemoryScope memory(MemoryTag::JITTER_BUFFER);
+    
+    // Önce gönderen akışın playout buffer'ına ayır
+    bool isPlaybackStream = false;
+    bool isInOrder = false;
+    uint32_t lostPackets = 0;
+    if (!pushStreamPacket(packet, isPlaybackStream, isInOrder, lostPackets)) {
+        return false;
+    }
+    
+    // Dış dinleyiciler için kilit dışında; geç/yinelenen paket ring'e geri yazılmaz.
+    // Kayıp paketler bu paketin boyunda sessizlikle doldurulur (dinleyicinin zaman ekseni kaymasın)
+    if (pcmTap_ && isInOrder && packet->type == PacketType::AUDIO) {
+        size_t sampleCount = packet->data.size() / sizeof(int16_t);
+        size_t silenceCount = std::min(sampleCount, tapSilence_.size());
+        size_t gapPackets = std::min<size_t>(lostPackets, Config::PCM_TAP_MAX_GAP_PACKETS);
+        for (size_t i = 0; i < gapPackets && silenceCount > 0; ++i) {
+            pcmTap_->write(packet->streamId, tapSilence_.data(), silenceCount, Config::SAMPLE_RATE);
+        }
+        pcmTap_->write(packet->streamId, reinterpret_cast<const int16_t*>(packet->data.data()),
+                       sampleCount, Config::SAMPLE_RATE);
+    }
+    
+    // Tekli çalma kuyruğuna sadece seçili akış girer (konuşmacılar karışmaz)
+    if (!isPlaybackStream) {
+        return true;
+    }
+    
     std::lock_guard<std::mutex> lock(outputMutex_);
     
-    if (isBufferFull(outputBuffer_)) {
-        // Buffer dolu, eski paketleri temizle
-        removeOldPackets(outputBuffer_);
+    if (outputCount_ == outputRing_.size()) {
+        // Buffer dolu, en eski paketi at
+        popPlaybackLocked();
         droppedPackets_++;
     }
     
-    outputBuffer_.push(packet);
+    bool wasEmpty = (outputCount_ == 0);
+    outputRing_[(outputHead_ + outputCount_) % outputRing_.size()] = packet;
+    outputCount_++;
+    
+    // Sadece boş -> dolu geçişinde bildir
+    if (wasEmpty) {
+        signalReady(outputReadyFd_);
+    }
+    
     outputCondition_.notify_one();
     
     return true;
@@ -84,26 +214,171 @@ std::shared_ptr<AudioPacket> BufferManager::getNextPlaybackPacket() {
     
     // Bir paket gelene kadar bekle
     outputCondition_.wait_for(lock, std::chrono::milliseconds(10), 
-                             [this] { return !outputBuffer_.empty(); });
+                             [this] { return outputCount_ > 0; });
+    
+    return popPlaybackLocked();
+}
+
+std::shared_ptr<AudioPacket> BufferManager::getNextStreamPacket(uint32_t streamId) {
+    std::lock_guard<std::mutex> lock(streamMutex_);
     
-    if (outputBuffer_.empty()) {
+    StreamSlot* slot = findStreamSlot(streamId);
+    if (!slot || slot->count == 0) {
         return nullptr;
     }
     
-    auto packet = outputBuffer_.front();
-    outputBuffer_.pop();
+    auto packet = std::move(slot->ring[slot->head]);
+    slot->head = (slot->head + 1) % slot->ring.size();
+    slot->count--;
     
     return packet;
 }
 
+std::vector<uint32_t> BufferManager::getActiveStreams() const {
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    
+    std::vector<uint32_t> streams;
+    streams.reserve(streamPool_.size() - freeStreamSlots_.size());
+    for (const auto& slot : streamPool_) {
+        if (slot.inUse) {
+            streams.push_back(slot.streamId);
+        }
+    }
+    
+    return streams;
+}
+
+size_t BufferManager::getActiveStreamCount() const {
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    return streamPool_.size() - freeStreamSlots_.size();
+}
+
+size_t BufferManager::getStreamBufferSize(uint32_t streamId) const {
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    
+    const StreamSlot* slot = findStreamSlot(streamId);
+    return slot ? slot->count : 0;
+}
+
+std::vector<StreamStats> BufferManager::getStreamStats() const {
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    
+    // Çalınan akışın paketleri tekli çalma kuyruğunda bekler
+    // (kilit sırası: streamMutex_ -> outputMutex_; ters yönde iç içe kilit yok)
+    size_t playbackDepth;
+    {
+        std::lock_guard<std::mutex> outputLock(outputMutex_);
+        playbackDepth = outputCount_;
+    }
+    
+    std::vector<StreamStats> stats;
+    stats.reserve(streamPool_.size() - freeStreamSlots_.size());
+    for (const auto& slot : streamPool_) {
+        if (!slot.inUse) {
+            continue;
+        }
+        StreamStats stream;
+        stream.streamId = slot.streamId;
+        stream.queueDepth = slot.streamId == playbackStreamId_ ? playbackDepth : slot.count;
+        stream.packets = slot.packets;
+        stream.bytes = slot.bytes;
+        stream.overwritten = slot.overwritten;
+        uint64_t expected = slot.hasSequence ? slot.highestSequence - slot.baseSequence + 1 : 0;
+        stream.lost = expected > slot.packets ? expected - slot.packets : 0;
+        stream.jitterMs = slot.jitterMs;
+        stats.push_back(stream);
+    }
+    
+    return stats;
+}
+
+size_t BufferManager::reclaimIdleStreams(std::chrono::milliseconds idleTimeout) {
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    return reclaimIdleStreamsLocked(EngineClock::now(), idleTimeout);
+}
+
+void BufferManager::setPlaybackStream(uint32_t streamId) {
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    playbackStreamId_ = streamId;
+    autoPlaybackStream_ = false;
+}
+
+void BufferManager::setAutoPlaybackStream() {
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    autoPlaybackStream_ = true;
+}
+
+uint32_t BufferManager::getPlaybackStream() const {
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    return playbackStreamId_;
+}
+
+std::shared_ptr<AudioPacket> BufferManager::tryGetNextPlaybackPacket() {
+    std::lock_guard<std::mutex> lock(outputMutex_);
+    return popPlaybackLocked();
+}
+
+void BufferManager::retirePacket(std::shared_ptr<AudioPacket>&& packet) {
+    if (!packet) {
+        return;
+    }
+    
+    size_t write = retireWrite_.load(std::memory_order_relaxed);
+    if (write - retireRead_.load(std::memory_order_acquire) >= RETIRE_RING_SIZE) {
+        // Boşaltan thread yok veya geride: yerinde bırak (ses thread'inde free)
+        retireOverflows_++;
+        packet.reset();
+        return;
+    }
+    
+    // Boş slota taşıma: sayaç ve bellek işlemi yok
+    retireRing_[write % RETIRE_RING_SIZE] = std::move(packet);
+    retireWrite_.store(write + 1, std::memory_order_release);
+}
+
+size_t BufferManager::releaseRetiredPackets() {
+    std::lock_guard<std::mutex> lock(retireMutex_);
+    
+    size_t read = retireRead_.load(std::memory_order_relaxed);
+    size_t write = retireWrite_.load(std::memory_order_acquire);
+    for (size_t i = read; i != write; ++i) {
+        retireRing_[i % RETIRE_RING_SIZE].reset();
+    }
+    
+    retireRead_.store(write, std::memory_order_release);
+    return write - read;
+}
+
 size_t BufferManager::getInputBufferSize() const {
     std::lock_guard<std::mutex> lock(inputMutex_);
-    return inputBuffer_.size();
+    return inputBuffer_.size() + controlBuffer_.size();
 }
 
 size_t BufferManager::getOutputBufferSize() const {
-    std::lock_guard<std::mutex> lock(outputMutex_);
-    return outputBuffer_.size();
+    // Playback thread'i her paket için sorar: kilitsiz anlık değer
+    return outputCount_.load(std::memory_order_relaxed);
+}
+
+bool BufferManager::waitForInputPacket(int timeoutMs) {
+    if (inputReadyFd_ >= 0) {
+        return waitReady(inputReadyFd_, timeoutMs);
+    }
+    
+    // eventfd yoksa condition variable ile bekle
+    std::unique_lock<std::mutex> lock(inputMutex_);
+    return inputCondition_.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                                    [this] { return !inputBuffer_.empty() || !controlBuffer_.empty(); });
+}
+
+bool BufferManager::waitForPlaybackPacket(int timeoutMs) {
+    if (outputReadyFd_ >= 0) {
+        return waitReady(outputReadyFd_, timeoutMs);
+    }
+    
+    // eventfd yoksa condition variable ile bekle
+    std::unique_lock<std::mutex> lock(outputMutex_);
+    return outputCondition_.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                                     [this] { return outputCount_ > 0; });
 }
 
 bool BufferManager::isInputBufferFull() const {
@@ -113,7 +388,7 @@ bool BufferManager::isInputBufferFull() const {
 
 bool BufferManager::isOutputBufferEmpty() const {
     std::lock_guard<std::mutex> lock(outputMutex_);
-    return outputBuffer_.empty();
+    return outputCount_ == 0;
 }
 
 void BufferManager::clearBuffers() {
@@ -121,19 +396,93 @@ void BufferManager::clearBuffers() {
         std::lock_guard<std::mutex> lock(inputMutex_);
         std::queue<std::shared_ptr<AudioPacket>> empty;
         inputBuffer_.swap(empty);
+        std::queue<std::shared_ptr<AudioPacket>> emptyControl;
+        controlBuffer_.swap(emptyControl);
+        clearReady(inputReadyFd_);
     }
     
     {
         std::lock_guard<std::mutex> lock(outputMutex_);
-        std::queue<std::shared_ptr<AudioPacket>> empty;
-        outputBuffer_.swap(empty);
+        for (auto& slot : outputRing_) {
+            slot.reset();
+        }
+        outputHead_ = 0;
+        outputCount_ = 0;
+        clearReady(outputReadyFd_);
+    }
+    
+    releaseRetiredPackets();
+    
+    {
+        std::lock_guard<std::mutex> lock(streamMutex_);
+        for (size_t i = 0; i < streamPool_.size(); ++i) {
+            if (streamPool_[i].inUse) {
+                releaseStreamSlot(i);
+            }
+        }
     }
     
     nextSequenceNumber_ = 0;
+    nextControlSequenceNumber_ = 0;
+}
+
+LaneStats BufferManager::getLaneStats(PacketLane lane) const {
+    std::lock_guard<std::mutex> lock(inputMutex_);
+    
+    const auto& counters = laneCounters_[static_cast<size_t>(lane)];
+    
+    LaneStats stats;
+    stats.enqueued = counters.enqueued;
+    stats.dequeued = counters.dequeued;
+    stats.dropped = counters.dropped;
+    stats.maxQueueTimeUs = counters.maxQueueTimeUs;
+    if (counters.dequeued > 0) {
+        stats.averageQueueTimeUs = counters.totalQueueTimeUs / static_cast<double>(counters.dequeued);
+    }
+    
+    return stats;
+}
+
+void BufferManager::resetLaneStats() {
+    std::lock_guard<std::mutex> lock(inputMutex_);
+    for (auto& counters : laneCounters_) {
+        counters = LaneCounters();
+    }
+}
+
+size_t BufferManager::resyncPlayback(size_t keepPackets) {
+    std::lock_guard<std::mutex> lock(outputMutex_);
+    
+    size_t dropped = 0;
+    while (outputCount_ > keepPackets) {
+        popPlaybackLocked();
+        droppedPackets_++;
+        dropped++;
+    }
+    
+    return dropped;
 }
 
 void BufferManager::setMaxBufferSize(size_t maxSize) {
+    std::lock_guard<std::mutex> lock(outputMutex_);
+    MemoryScope memory(MemoryTag::JITTER_BUFFER);
+    
     maxBufferSize_ = maxSize;
+    
+    // Çalma ring'i yeni kapasiteye taşınır (sığmayan en eski paketler atılır);
+    // kurulumda çağrılır, ses yolunda değil
+    size_t capacity = std::max<size_t>(1, maxSize);
+    while (outputCount_ > capacity) {
+        popPlaybackLocked();
+        droppedPackets_++;
+    }
+    
+    std::vector<std::shared_ptr<AudioPacket>> ring(capacity);
+    for (size_t i = 0; i < outputCount_; ++i) {
+        ring[i] = std::move(outputRing_[(outputHead_ + i) % outputRing_.size()]);
+    }
+    outputRing_.swap(ring);
+    outputHead_ = 0;
 }
 
 bool BufferManager::isBufferFull(const std::queue<std::shared_ptr<AudioPacket>>& buffer) const {
@@ -146,4 +495,282 @@ void BufferManager::removeOldPackets(std::queue<std::shared_ptr<AudioPacket>>& b
     }
 }
 
+std::shared_ptr<AudioPacket> BufferManager::popLanePacket() {
+    // inputMutex_ çağıran tarafından tutulmalı
+    PacketLane lane;
+    std::shared_ptr<AudioPacket> packet;
+    
+    if (!controlBuffer_.empty()) {
+        lane = PacketLane::CONTROL;
+        packet = controlBuffer_.front();
+        controlBuffer_.pop();
+    } else if (!inputBuffer_.empty()) {
+        lane = PacketLane::MEDIA;
+        packet = inputBuffer_.front();
+        inputBuffer_.pop();
+    } else {
+        return nullptr;
+    }
+    
+    // Kuyrukta geçen süre
+    double queueTimeUs = std::chrono::duration<double, std::micro>(
+        EngineClock::now() - packet->timestamp).count();
+    
+    auto& counters = laneCounters_[static_cast<size_t>(lane)];
+    counters.dequeued++;
+    counters.totalQueueTimeUs += queueTimeUs;
+    counters.maxQueueTimeUs = std::max(counters.maxQueueTimeUs, queueTimeUs);
+    
+    if (inputBuffer_.empty() && controlBuffer_.empty()) {
+        clearReady(inputReadyFd_);
+    }
+    
+    return packet;
+}
+
+std::shared_ptr<AudioPacket> BufferManager::popPlaybackLocked() {
+    // outputMutex_ çağıran tarafından tutulmalı
+    if (outputCount_ == 0) {
+        return nullptr;
+    }
+    
+    auto packet = std::move(outputRing_[outputHead_]);
+    outputHead_ = (outputHead_ + 1) % outputRing_.size();
+    outputCount_--;
+    
+    if (outputCount_ == 0) {
+        clearReady(outputReadyFd_);
+    }
+    
+    return packet;
+}
+
+bool BufferManager::pushStreamPacket(const std::shared_ptr<AudioPacket>& packet, bool& isPlaybackStream, bool& isInOrder, uint32_t& lostPackets) {
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    
+    auto now = EngineClock::now();
+    
+    // Boşta kalan akışları saniyede bir geri al
+    if (now - lastIdleSweep_ >= std::chrono::seconds(1)) {
+        reclaimIdleStreamsLocked(now, std::chrono::milliseconds(Config::STREAM_IDLE_TIMEOUT_MS));
+        lastIdleSweep_ = now;
+    }
+    
+    StreamSlot* slot = findStreamSlot(packet->streamId);
+    if (!slot) {
+        slot = acquireStreamSlot(packet->streamId);
+        if (!slot) {
+            // Havuz dolu, yeni konuşmacı kabul edilemiyor
+            rejectedStreamPackets_++;
+            return false;
+        }
+    }
+    
+    slot->lastActivity = now;
+    isInOrder = !slot->hasSequence || static_cast<int32_t>(packet->sequenceNumber - slot->lastSequence) > 0;
+    lostPackets = (slot->hasSequence && isInOrder) ? packet->sequenceNumber - slot->lastSequence - 1 : 0;
+    updateStreamStats(*slot, *packet);
+    
+    // Otomatik modda çalınan akış kaybolduysa ilk gelen akışa geç
+    if (autoPlaybackStream_ && !findStreamSlot(playbackStreamId_)) {
+        playbackStreamId_ = packet->streamId;
+    }
+    
+    // Çalınan akış yalnızca tekli çalma kuyruğunda tutulur (paket iki yerde beklemez)
+    isPlaybackStream = (packet->streamId == playbackStreamId_);
+    if (isPlaybackStream) {
+        return true;
+    }
+    
+    // Ring dolu ise en eski paketin üzerine yaz (akışı okuyan yoksa normal durum)
+    size_t capacity = slot->ring.size();
+    if (slot->count == capacity) {
+        slot->ring[slot->head].reset();
+        slot->head = (slot->head + 1) % capacity;
+        slot->count--;
+        slot->overwritten++;
+    }
+    
+    slot->ring[(slot->head + slot->count) % capacity] = packet;
+    slot->count++;
+    return true;
+}
+
+BufferManager::StreamSlot* BufferManager::acquireStreamSlot(uint32_t streamId) {
+    // streamMutex_ çağıran tarafından tutulmalı
+    if (freeStreamSlots_.empty()) {
+        return nullptr;
+    }
+    
+    size_t slotIndex = freeStreamSlots_.back();
+    freeStreamSlots_.pop_back();
+    
+    StreamSlot& slot = streamPool_[slotIndex];
+    if (slot.ring.size() != maxBufferSize_) {
+        slot.ring.resize(std::max<size_t>(1, maxBufferSize_));
+    }
+    slot.streamId = streamId;
+    slot.inUse = true;
+    slot.head = 0;
+    slot.count = 0;
+    slot.packets = 0;
+    slot.bytes = 0;
+    slot.overwritten = 0;
+    slot.hasSequence = false;
+    slot.packetIntervalMs = 0.0;
+    slot.jitterMs = 0.0;
+    
+    // Tablo havuzun 4 katı: boş yer her zaman bulunur
+    size_t position = streamIndexPosition(streamId);
+    streamIndex_[position].streamId = streamId;
+    streamIndex_[position].slot = static_cast<int32_t>(slotIndex);
+    return &slot;
+}
+
+size_t BufferManager::streamIndexPosition(uint32_t streamId) const {
+    // streamMutex_ çağıran tarafından tutulmalı; anahtarın ya da ilk boş yerin konumu
+    const size_t mask = STREAM_INDEX_SIZE - 1;
+    size_t position = (streamId * 0x9E3779B1u) & mask;
+    while (streamIndex_[position].slot != NO_STREAM_SLOT && streamIndex_[position].streamId != streamId) {
+        position = (position + 1) & mask;
+    }
+    return position;
+}
+
+BufferManager::StreamSlot* BufferManager::findStreamSlot(uint32_t streamId) {
+    const StreamIndexEntry& entry = streamIndex_[streamIndexPosition(streamId)];
+    return entry.slot == NO_STREAM_SLOT ? nullptr : &streamPool_[entry.slot];
+}
+
+const BufferManager::StreamSlot* BufferManager::findStreamSlot(uint32_t streamId) const {
+    const StreamIndexEntry& entry = streamIndex_[streamIndexPosition(streamId)];
+    return entry.slot == NO_STREAM_SLOT ? nullptr : &streamPool_[entry.slot];
+}
+
+void BufferManager::eraseStreamIndex(uint32_t streamId) {
+    // Mezar taşı yok: silinen yerin ardındaki zincir geri kaydırılır
+    const size_t mask = STREAM_INDEX_SIZE - 1;
+    size_t hole = streamIndexPosition(streamId);
+    if (streamIndex_[hole].slot == NO_STREAM_SLOT) {
+        return;
+    }
+    
+    size_t position = hole;
+    while (true) {
+        position = (position + 1) & mask;
+        StreamIndexEntry& entry = streamIndex_[position];
+        if (entry.slot == NO_STREAM_SLOT) {
+            break;
+        }
+        // Girdinin ev konumu boşluk ile kendisi arasında (döngüsel) değilse boşluğa taşınabilir
+        size_t home = (entry.streamId * 0x9E3779B1u) & mask;
+        if (((position - home) & mask) >= ((position - hole) & mask)) {
+            streamIndex_[hole] = entry;
+            hole = position;
+        }
+    }
+    streamIndex_[hole] = StreamIndexEntry();
+}
+
+void BufferManager::updateStreamStats(StreamSlot& slot, const AudioPacket& packet) {
+    // streamMutex_ çağıran tarafından tutulmalı
+    slot.packets++;
+    slot.bytes += packet.size;
+    
+    if (!slot.hasSequence) {
+        slot.hasSequence = true;
+        slot.lastSequence = packet.sequenceNumber;
+        slot.baseSequence = slot.highestSequence = packet.sequenceNumber;
+        slot.lastArrival = packet.timestamp;
+        return;
+    }
+    
+    // Geç/yinelenen paket (delta <= 0) en yüksek sırayı ilerletmez
+    int32_t delta = static_cast<int32_t>(packet.sequenceNumber - slot.lastSequence);
+    if (delta <= 0) {
+        return;
+    }
+    
+    // RFC 3550: J += (|D| - J) / 16, D = varış aralığı - sıra farkı x paket aralığı
+    double arrivalMs = std::chrono::duration<double, std::milli>(packet.timestamp - slot.lastArrival).count();
+    double intervalMs = arrivalMs / delta;
+    if (slot.packetIntervalMs <= 0.0) {
+        slot.packetIntervalMs = intervalMs;
+    } else {
+        double deviation = std::fabs(arrivalMs - delta * slot.packetIntervalMs);
+        slot.jitterMs += (deviation - slot.jitterMs) / 16.0;
+        slot.packetIntervalMs += (intervalMs - slot.packetIntervalMs) / 64.0;
+    }
+    
+    slot.lastSequence = packet.sequenceNumber;
+    slot.highestSequence += static_cast<uint64_t>(delta);
+    slot.lastArrival = packet.timestamp;
+}
+
+void BufferManager::releaseStreamSlot(size_t slotIndex) {
+    // streamMutex_ çağıran tarafından tutulmalı
+    StreamSlot& slot = streamPool_[slotIndex];
+    
+    for (auto& entry : slot.ring) {
+        entry.reset();
+    }
+    
+    eraseStreamIndex(slot.streamId);
+    MemoryAccounting::endSession(slot.streamId);
+    if (pcmTap_) {
+        pcmTap_->endSession(slot.streamId);
+    }
+    slot.inUse = false;
+    slot.head = 0;
+    slot.count = 0;
+    freeStreamSlots_.push_back(slotIndex);
+}
+
+size_t BufferManager::reclaimIdleStreamsLocked(std::chrono::steady_clock::time_point now,
+                                               std::chrono::milliseconds idleTimeout) {
+    size_t reclaimed = 0;
+    
+    for (size_t i = 0; i < streamPool_.size(); ++i) {
+        if (streamPool_[i].inUse && now - streamPool_[i].lastActivity >= idleTimeout) {
+            releaseStreamSlot(i);
+            reclaimed++;
+        }
+    }
+    
+    return reclaimed;
+}
+
+void BufferManager::signalReady(int fd) {
+    if (fd < 0) {
+        return;
+    }
+    
+    // Bloklamayan eventfd: ses thread'inden bilinçli sistem çağrısı
+    BlockingSection eventfd;
+    uint64_t one = 1;
+    ssize_t result = write(fd, &one, sizeof(one));
+    (void)result; // Sayaç taşması (EAGAIN) zaten okunabilir demektir
+}
+
+void BufferManager::clearReady(int fd) {
+    if (fd < 0) {
+        return;
+    }
+    
+    BlockingSection eventfd;
+    uint64_t value;
+    ssize_t result = read(fd, &value, sizeof(value));
+    (void)result; // Zaten temizse EAGAIN döner
+}
+
+bool BufferManager::waitReady(int fd, int timeoutMs) {
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    
+    int result = poll(&pfd, 1, timeoutMs);
+    return result > 0 && (pfd.revents & POLLIN);
+}
+
 } // namespace NovaVoice
\ No newline at end of file
@@ -6,26 +6,77 @@
 #include <condition_variable>
 #include <memory>
 #include <chrono>
+#include <atomic>
 #include "Config.h"
+#include "EngineClock.h"
+#include "PcmTap.h"
 
 namespace NovaVoice {
 
+// Paket türleri (ses dışındaki her şey kontrol şeridinden gider)
+enum class PacketType : uint8_t {
+    AUDIO = 0,
+    FEEDBACK = 1,
+    NACK = 2,
+    KEEPALIVE = 3,
+    PROBE = 4
+};
+
+// Öncelik şeritleri (CONTROL her zaman MEDIA'dan önce gönderilir)
+enum class PacketLane : uint8_t {
+    CONTROL = 0,
+    MEDIA = 1
+};
+
+constexpr size_t PACKET_LANE_COUNT = 2;
+
+inline PacketLane laneForType(PacketType type) {
+    return type == PacketType::AUDIO ? PacketLane::MEDIA : PacketLane::CONTROL;
+}
+
+// Şerit başına kuyrukta bekleme istatistikleri
+struct LaneStats {
+    uint64_t enqueued;
+    uint64_t dequeued;
+    uint64_t dropped;
+    double averageQueueTimeUs;
+    double maxQueueTimeUs;
+    
+    LaneStats() : enqueued(0), dequeued(0), dropped(0), averageQueueTimeUs(0.0), maxQueueTimeUs(0.0) {}
+};
+
+// Uzak akış (oturum) başına alım istatistikleri
+struct StreamStats {
+    uint32_t streamId;
+    size_t queueDepth;
+    uint64_t packets;
+    uint64_t bytes;
+    uint64_t lost;          // Sıra numarası boşlukları (beklenen - alınan)
+    uint64_t overwritten;   // Okunmadan üzerine yazılan paketler (ring dolu)
+    double jitterMs;        // RFC 3550 varışlar arası sapma
+    
+    StreamStats() : streamId(0), queueDepth(0), packets(0), bytes(0), lost(0), overwritten(0), jitterMs(0.0) {}
+};
+
 // Ses paketi yapısı
 struct AudioPacket {
     std::vector<uint8_t> data;
     uint32_t sequenceNumber;
     std::chrono::steady_clock::time_point timestamp;
     size_t size;
+    PacketType type;
+    uint32_t streamId;  // Gönderen akış kimliği (0 = yerel/bilinmiyor)
     
-    AudioPacket() : sequenceNumber(0), size(0) {
+    AudioPacket() : sequenceNumber(0), size(0), type(PacketType::AUDIO), streamId(0) {
         data.reserve(Config::PACKET_SIZE);
-        timestamp = std::chrono::steady_clock::now();
+        timestamp = EngineClock::now();
     }
     
-    AudioPacket(const uint8_t* audioData, size_t dataSize, uint32_t seqNum)
-        : sequenceNumber(seqNum), size(dataSize) {
+    AudioPacket(const uint8_t* audioData, size_t dataSize, uint32_t seqNum,
+                PacketType packetType = PacketType::AUDIO)
+        : sequenceNumber(seqNum), size(dataSize), type(packetType), streamId(0) {
         data.assign(audioData, audioData + dataSize);
-        timestamp = std::chrono::steady_clock::now();
+        timestamp = EngineClock::now();
     }
 };
 
@@ -40,11 +91,42 @@ public:
     
     // Input buffer (mikrofon -> ağ)
     bool pushInputBuffer(const uint8_t* data, size_t size);
+    // Capture kesintisinde kaybolan periyotlar kadar sıra numarası atla
+    // (karşı taraf boşluğu görsün); pushInputBuffer ile aynı thread'den çağrılır
+    void skipInputSequence(uint32_t count) { nextSequenceNumber_ += count; }
     std::shared_ptr<AudioPacket> getNextOutputPacket();
     
+    // Kontrol şeridi (feedback, NACK, keepalive, probe)
+    bool pushControlPacket(PacketType type, const uint8_t* data, size_t size);
+    size_t popOutputBatch(std::vector<std::shared_ptr<AudioPacket>>& batch, size_t maxPackets);
+    
     // Output buffer (ağ -> hoparlör)
     bool pushNetworkPacket(std::shared_ptr<AudioPacket> packet);
     std::shared_ptr<AudioPacket> getNextPlaybackPacket();
+    std::shared_ptr<AudioPacket> tryGetNextPlaybackPacket(); // Beklemeden
+    
+    // Çalınmış paketin son referansı ses thread'inde bırakılmaz: retirePacket
+    // (tek üretici: playback thread'i) kilitsiz ring'e taşır, releaseRetiredPackets
+    // gerçek zamanlı olmayan bir thread'de (UDP gönderici) serbest bırakır.
+    // Ring doluysa paket yerinde bırakılır ve sayılır.
+    void retirePacket(std::shared_ptr<AudioPacket>&& packet);
+    size_t releaseRetiredPackets();
+    uint64_t getRetireOverflows() const { return retireOverflows_; }
+    
+    // Çoklu akış (stream) playout buffer'ları
+    // pushNetworkPacket paketleri streamId'ye göre ayırır. Çalma için seçilen akış
+    // (varsayılan: ilk aktif akış) yalnızca tekli çalma kuyruğuna girer ve
+    // getNextPlaybackPacket ile okunur; diğer akışlar kendi ring'lerinde
+    // getNextStreamPacket ile okunmayı bekler (okunmazsa en eskinin üzerine yazılır).
+    std::shared_ptr<AudioPacket> getNextStreamPacket(uint32_t streamId);
+    std::vector<uint32_t> getActiveStreams() const;
+    size_t getActiveStreamCount() const;
+    size_t getStreamBufferSize(uint32_t streamId) const;
+    std::vector<StreamStats> getStreamStats() const;
+    size_t reclaimIdleStreams(std::chrono::milliseconds idleTimeout);
+    void setPlaybackStream(uint32_t streamId);
+    void setAutoPlaybackStream();
+    uint32_t getPlaybackStream() const;
     
     // Buffer durumu
     size_t getInputBufferSize() const;
@@ -52,38 +134,141 @@ public:
     bool isInputBufferFull() const;
     bool isOutputBufferEmpty() const;
     
+    // Olay döngüsü entegrasyonu (epoll/poll)
+    // eventfd, kuyruk boştan doluya geçtiğinde okunabilir olur ve
+    // kuyruk tamamen boşaldığında temizlenir (level-triggered).
+    int getInputReadyFd() const { return inputReadyFd_; }
+    int getOutputReadyFd() const { return outputReadyFd_; }
+    bool waitForInputPacket(int timeoutMs);
+    bool waitForPlaybackPacket(int timeoutMs);
+    
     // Buffer yönetimi
     void clearBuffers();
+    // Xrun sonrası: kesinti boyunca biriken eski paketleri atıp playout
+    // kuyruğunu hedef seviyeye indirir (gecikme kalıcı olarak büyümesin)
+    size_t resyncPlayback(size_t keepPackets);
     void setMaxBufferSize(size_t maxSize);
     
+    // Sırayla gelen uzak ses akış başına PcmTap ring'ine yazılır; kayıp sıra numaraları
+    // sessizlikle doldurulur (alım thread'i; başlatmadan önce)
+    void setPcmTap(std::shared_ptr<PcmTapPublisher> tap) { pcmTap_ = tap; }
+    
     // İstatistikler
     uint64_t getDroppedPackets() const { return droppedPackets_; }
     uint64_t getTotalPackets() const { return totalPackets_; }
+    uint64_t getRejectedStreamPackets() const { return rejectedStreamPackets_; }
+    LaneStats getLaneStats(PacketLane lane) const;
+    void resetLaneStats();
     
 private:
-    // Input buffer (mikrofon ses verisi)
+    // Input buffer (mikrofon ses verisi) ve kontrol şeridi
     std::queue<std::shared_ptr<AudioPacket>> inputBuffer_;
+    std::queue<std::shared_ptr<AudioPacket>> controlBuffer_;
     mutable std::mutex inputMutex_;
     std::condition_variable inputCondition_;
     
-    // Output buffer (ağdan gelen ses verisi)
-    std::queue<std::shared_ptr<AudioPacket>> outputBuffer_;
+    // Output buffer (ağdan gelen ses verisi): önceden ayrılmış ring, alım ve
+    // çalma yolunda düğüm ayırmaz/bırakmaz (kapasite setMaxBufferSize ile değişir)
+    std::vector<std::shared_ptr<AudioPacket>> outputRing_;
+    size_t outputHead_;
+    std::atomic<size_t> outputCount_;  // outputMutex_ altında değişir; derinlik kilitsiz okunur
     mutable std::mutex outputMutex_;
     std::condition_variable outputCondition_;
     
+    // Çalınmış paketler: playback thread'i yazar, boşaltan retireMutex_ tutar
+    static constexpr size_t RETIRE_RING_SIZE = 64;
+    std::vector<std::shared_ptr<AudioPacket>> retireRing_;
+    std::atomic<size_t> retireWrite_;
+    std::atomic<size_t> retireRead_;
+    std::mutex retireMutex_;
+    std::atomic<uint64_t> retireOverflows_;
+    
+    // Stream havuzu (önceden ayrılmış slotlar, O(1) streamId -> slot)
+    struct StreamSlot {
+        uint32_t streamId = 0;
+        bool inUse = false;
+        std::vector<std::shared_ptr<AudioPacket>> ring;
+        size_t head = 0;
+        size_t count = 0;
+        std::chrono::steady_clock::time_point lastActivity;
+        
+        // Alım istatistikleri (slot alınınca sıfırlanır)
+        uint64_t packets = 0;
+        uint64_t bytes = 0;
+        uint64_t overwritten = 0;
+        bool hasSequence = false;
+        uint32_t lastSequence = 0;
+        uint64_t baseSequence = 0;
+        uint64_t highestSequence = 0;       // 32-bit taşmaya karşı genişletilmiş
+        std::chrono::steady_clock::time_point lastArrival;
+        double packetIntervalMs = 0.0;      // Sıra başına ortalama varış aralığı
+        double jitterMs = 0.0;
+    };
+    std::vector<StreamSlot> streamPool_;
+    std::vector<size_t> freeStreamSlots_;
+    
+    // streamId -> slot: sabit boyutlu açık adresli tablo (doğrusal yoklama);
+    // kurulumda ayrılır, alım yolunda düğüm ayırmaz
+    static constexpr size_t STREAM_INDEX_SIZE = 4 * Config::MAX_STREAMS;
+    static constexpr int32_t NO_STREAM_SLOT = -1;
+    struct StreamIndexEntry {
+        uint32_t streamId = 0;
+        int32_t slot = NO_STREAM_SLOT;
+    };
+    std::vector<StreamIndexEntry> streamIndex_;
+    static_assert((STREAM_INDEX_SIZE & (STREAM_INDEX_SIZE - 1)) == 0, "Akış tablosu 2'nin kuvveti olmalı");
+    mutable std::mutex streamMutex_;
+    uint32_t playbackStreamId_;
+    bool autoPlaybackStream_;
+    std::chrono::steady_clock::time_point lastIdleSweep_;
+    
+    // Hazır olma bildirimleri (eventfd)
+    int inputReadyFd_;
+    int outputReadyFd_;
+    
     // Buffer boyut limitleri
     size_t maxBufferSize_;
     
+    std::shared_ptr<PcmTapPublisher> pcmTap_;
+    std::vector<int16_t> tapSilence_;   // Sıra boşlukları için önceden ayrılmış sıfır örnekler
+    
     // Paket numaralandırma
     uint32_t nextSequenceNumber_;
+    uint32_t nextControlSequenceNumber_;
     
     // İstatistikler
     uint64_t droppedPackets_;
     uint64_t totalPackets_;
+    uint64_t rejectedStreamPackets_;
+    
+    // Şerit istatistikleri (inputMutex_ ile korunur)
+    struct LaneCounters {
+        uint64_t enqueued = 0;
+        uint64_t dequeued = 0;
+        uint64_t dropped = 0;
+        double totalQueueTimeUs = 0.0;
+        double maxQueueTimeUs = 0.0;
+    };
+    LaneCounters laneCounters_[PACKET_LANE_COUNT];
     
     // Yardımcı metodlar
     bool isBufferFull(const std::queue<std::shared_ptr<AudioPacket>>& buffer) const;
     void removeOldPackets(std::queue<std::shared_ptr<AudioPacket>>& buffer);
+    std::shared_ptr<AudioPacket> popLanePacket();
+    std::shared_ptr<AudioPacket> popPlaybackLocked();
+    bool pushStreamPacket(const std::shared_ptr<AudioPacket>& packet, bool& isPlaybackStream, bool& isInOrder, uint32_t& lostPackets);
+    StreamSlot* acquireStreamSlot(uint32_t streamId);
+    StreamSlot* findStreamSlot(uint32_t streamId);
+    const StreamSlot* findStreamSlot(uint32_t streamId) const;
+    size_t streamIndexPosition(uint32_t streamId) const;
+    void eraseStreamIndex(uint32_t streamId);
+    void updateStreamStats(StreamSlot& slot, const AudioPacket& packet);
+    void releaseStreamSlot(size_t slotIndex);
+    size_t reclaimIdleStreamsLocked(std::chrono::steady_clock::time_point now,
+                                    std::chrono::milliseconds idleTimeout);
+    void signalReady(int fd);
+    void clearReady(int fd);
+    bool waitReady(int fd, int timeoutMs);
 };
 
 } // namespace NovaVoice
\ No newline at end of file
@@ -0,0 +1,204 @@
+#include "PlayoutController.h"
+#include "EngineClock.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace NovaVoice {
+
+PlayoutController::PlayoutController()
+    : playing_(false)
+    , bufferingSince_(false)
+    , jitterFrames_(0.0)
+    , hasPreviousArrival_(false)
+    , previousFrames_(0)
+    , packetFrames_(Config::FRAMES_PER_BUFFER)
+    , minMarginFrames_(static_cast<double>(Config::SAMPLE_RATE) * Config::PLAYOUT_MIN_MARGIN_MS / 1000.0)
+    , maxMarginFrames_(std::numeric_limits<double>::max())
+    , jitterMultiplier_(Config::PLAYOUT_JITTER_MULTIPLIER)
+    , callStarted_(false)
+    , firstAudioWritten_(false)
+    , timeToFirstAudioUs_(0)
+    , talkspurts_(0)
+    , underruns_(0)
+    , earlyUnderruns_(0)
+    , earlyPackets_(0)
+    , stretchedPackets_(0) {
+}
+
+void PlayoutController::reset() {
+    playing_ = false;
+    bufferingSince_ = false;
+    jitterFrames_ = 0.0;
+    hasPreviousArrival_ = false;
+    previousFrames_ = 0;
+    packetFrames_ = Config::FRAMES_PER_BUFFER;
+    callStarted_ = false;
+    firstAudioWritten_ = false;
+    timeToFirstAudioUs_ = 0;
+    talkspurts_ = 0;
+    underruns_ = 0;
+    earlyUnderruns_ = 0;
+    earlyPackets_ = 0;
+    stretchedPackets_ = 0;
+}
+
+void PlayoutController::applyProfile(const LatencyProfile& profile) {
+    minMarginFrames_ = static_cast<double>(Config::SAMPLE_RATE) * profile.playoutMinMarginMs / 1000.0;
+    maxMarginFrames_ = std::max(minMarginFrames_,
+                                static_cast<double>(Config::SAMPLE_RATE) * profile.playoutMaxMarginMs / 1000.0);
+    jitterMultiplier_ = profile.playoutJitterMultiplier;
+}
+
+bool PlayoutController::shouldStart(size_t queuedPackets, size_t bufferedFrames) {
+    if (playing_) {
+        return true;
+    }
+
+    if (queuedPackets == 0) {
+        bufferingSince_ = false;
+        return false;
+    }
+
+    auto now = EngineClock::now();
+    if (!bufferingSince_) {
+        bufferingSince_ = true;
+        bufferingStart_ = now;
+    }
+
+    // Bir paket + pay birikti mi, ya da ilk paket payın süresi kadar bekledi mi
+    double target = targetFrames();
+    double queuedFrames = static_cast<double>(queuedPackets * packetFrames_ + bufferedFrames);
+    double marginUs = (target - packetFrames_) * 1000000.0 / Config::SAMPLE_RATE;
+    double waitedUs = std::chrono::duration<double, std::micro>(now - bufferingStart_).count();
+
+    if (queuedFrames < target && waitedUs < marginUs) {
+        return false;
+    }
+
+    playing_ = true;
+    bufferingSince_ = false;
+    talkspurts_++;
+    return true;
+}
+
+void PlayoutController::onStarved() {
+    if (!playing_) {
+        return;
+    }
+
+    playing_ = false;
+    underruns_++;
+    if (inEarlyWindow()) {
+        earlyUnderruns_++;
+    }
+
+    // Sessizlik boşluğu jitter değildir: sonraki talkspurt'ün ilk varışını atla
+    hasPreviousArrival_ = false;
+}
+
+void PlayoutController::onPacketDequeued(std::chrono::steady_clock::time_point arrival, size_t frames) {
+    if (frames == 0) {
+        return;
+    }
+
+    if (!callStarted_) {
+        callStarted_ = true;
+        firstArrival_ = arrival;
+    }
+
+    if (inEarlyWindow()) {
+        earlyPackets_++;
+    }
+
+    // RFC 3550: J += (|D| - J) / 16, D = varışlar arası süre - paket süresi
+    if (hasPreviousArrival_) {
+        double interArrivalFrames = std::chrono::duration<double>(arrival - previousArrival_).count() *
+                                    Config::SAMPLE_RATE;
+        double deviation = std::fabs(interArrivalFrames - static_cast<double>(previousFrames_));
+        double jitter = jitterFrames_;
+        jitterFrames_ = jitter + (deviation - jitter) / 16.0;
+    }
+
+    hasPreviousArrival_ = true;
+    previousArrival_ = arrival;
+    previousFrames_ = frames;
+    packetFrames_ = frames;
+}
+
+void PlayoutController::onAudioWritten(size_t frames) {
+    if (frames == 0 || firstAudioWritten_ || !callStarted_) {
+        return;
+    }
+
+    firstAudioWritten_ = true;
+    timeToFirstAudioUs_ = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(EngineClock::now() - firstArrival_).count());
+}
+
+double PlayoutController::getStretchRatio(size_t queuedPackets, size_t bufferedFrames) const {
+    double target = targetFrames();
+    // Alınmış paket çalınıyor; kuyrukta kalanlar + bu paket + çalınmayı bekleyen ses
+    double available = static_cast<double>((queuedPackets + 1) * packetFrames_ + bufferedFrames);
+
+    // Hedefin altında: uzat; iki katından fazla: kısalt
+    double ratio = 1.0;
+    if (available < target) {
+        ratio = 1.0 + Config::PLAYOUT_MAX_STRETCH * (target - available) / target;
+    } else if (available > 2.0 * target) {
+        double excess = std::min(1.0, (available - 2.0 * target) / target);
+        ratio = 1.0 - Config::PLAYOUT_MAX_STRETCH * excess;
+    }
+
+    return ratio;
+}
+
+size_t PlayoutController::stretch(const int16_t* input, size_t inputFrames, int16_t* output,
+                                  size_t maxOutputFrames, double ratio) {
+    if (inputFrames < 2 || std::fabs(ratio - 1.0) < 1e-4) {
+        size_t frames = std::min(inputFrames, maxOutputFrames);
+        std::copy(input, input + frames * Config::CHANNELS, output);
+        return frames;
+    }
+
+    size_t outputFrames = static_cast<size_t>(std::lround(inputFrames * ratio));
+    outputFrames = std::max<size_t>(2, std::min(outputFrames, maxOutputFrames));
+
+    // Uçlar korunur: paket sınırlarında süreksizlik olmaz
+    double step = static_cast<double>(inputFrames - 1) / static_cast<double>(outputFrames - 1);
+    for (size_t i = 0; i < outputFrames; ++i) {
+        double position = i * step;
+        size_t index = std::min(static_cast<size_t>(position), inputFrames - 2);
+        double fraction = position - static_cast<double>(index);
+
+        for (uint16_t ch = 0; ch < Config::CHANNELS; ++ch) {
+            double a = input[index * Config::CHANNELS + ch];
+            double b = input[(index + 1) * Config::CHANNELS + ch];
+            output[i * Config::CHANNELS + ch] = static_cast<int16_t>(std::lround(a + (b - a) * fraction));
+        }
+    }
+
+    stretchedPackets_++;
+    return outputFrames;
+}
+
+double PlayoutController::getEarlyUnderrunRate() const {
+    uint64_t packets = earlyPackets_;
+    return packets > 0 ? static_cast<double>(earlyUnderruns_) / static_cast<double>(packets) : 0.0;
+}
+
+double PlayoutController::targetFrames() const {
+    double margin = std::max(minMarginFrames_, std::min(maxMarginFrames_, jitterMultiplier_ * jitterFrames_.load()));
+    return static_cast<double>(packetFrames_) + margin;
+}
+
+bool PlayoutController::inEarlyWindow() const {
+    if (!callStarted_) {
+        return true;
+    }
+
+    auto elapsed = EngineClock::now() - firstArrival_;
+    return elapsed < std::chrono::milliseconds(Config::PLAYOUT_EARLY_WINDOW_MS);
+}
+
+} // namespace NovaVoice
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include "Config.h"
+#include "LatencyProfile.h"
+
+namespace NovaVoice {
+
+/**
+ * @brief Playout başlatma politikası ve uyarlamalı zaman esnetme
+ *
+ * Çağrı başında veya sessizlik sonrası konuşma yeniden başladığında
+ * (talkspurt) çalma, kuyrukta bir paket artı jitter'dan türetilen pay
+ * kadar ses birikince başlar; ayrıca ilk paket payın süresi kadar
+ * beklediyse tek paketle de başlanır. Çalma sırasında kuyruk hedefin
+ * altına düşerse çıkış hafifçe uzatılır (buffer büyür), çok üstüne
+ * çıkarsa kısaltılır. Jitter, RFC 3550'deki varışlar arası sapma
+ * tahminiyle hesaplanır. Yalnızca playback thread'inden çağrılır;
+ * istatistikler başka thread'lerden okunabilir.
+ */
+class PlayoutController {
+public:
+    PlayoutController();
+
+    // Yeni çağrı: tüm durum ve istatistikler sıfırlanır (profil ayarları korunur)
+    void reset();
+
+    // Jitter payı sınırları ve çarpanı (start öncesi)
+    void applyProfile(const LatencyProfile& profile);
+
+    // === POLİTİKA ===
+    // Buffering durumunda kuyruk hedefe ulaştı mı (çalıyorsa her zaman true).
+    // bufferedFrames: paketten çıkmış ama henüz çalınmamış ses (ör. playback halkası)
+    bool shouldStart(size_t queuedPackets, size_t bufferedFrames = 0);
+    // Çalarken kuyruk boş: playout underrun, yeniden buffering
+    void onStarved();
+    // Kuyruktan alınan paketin varış zamanı ve süresi (jitter tahmini)
+    void onPacketDequeued(std::chrono::steady_clock::time_point arrival, size_t frames);
+    // Cihaza yazılan ses (ilk sese kadar geçen süre ölçümü)
+    void onAudioWritten(size_t frames);
+
+    // === ZAMAN ESNETME ===
+    // Çıkış/giriş oranı: >1 uzat (buffer büyür), <1 kısalt
+    double getStretchRatio(size_t queuedPackets, size_t bufferedFrames = 0) const;
+    // Doğrusal enterpolasyonla yeniden örnekleme; yazılan frame sayısını döndürür
+    size_t stretch(const int16_t* input, size_t inputFrames, int16_t* output,
+                   size_t maxOutputFrames, double ratio);
+
+    // === İSTATİSTİKLER ===
+    bool isPlaying() const { return playing_; }
+    double getJitterMs() const { return jitterFrames_ * 1000.0 / Config::SAMPLE_RATE; }
+    double getTargetMs() const { return targetFrames() * 1000.0 / Config::SAMPLE_RATE; }
+    double getTimeToFirstAudioMs() const { return timeToFirstAudioUs_ / 1000.0; }
+    uint64_t getTalkspurts() const { return talkspurts_; }
+    uint64_t getUnderruns() const { return underruns_; }
+    uint64_t getEarlyUnderruns() const { return earlyUnderruns_; }
+    uint64_t getEarlyPackets() const { return earlyPackets_; }
+    uint64_t getStretchedPackets() const { return stretchedPackets_; }
+    double getEarlyUnderrunRate() const;
+
+private:
+    // Durum
+    std::atomic<bool> playing_;
+    bool bufferingSince_;
+    std::chrono::steady_clock::time_point bufferingStart_;
+
+    // Jitter tahmini (frame)
+    std::atomic<double> jitterFrames_;
+    bool hasPreviousArrival_;
+    std::chrono::steady_clock::time_point previousArrival_;
+    size_t previousFrames_;
+    std::atomic<size_t> packetFrames_;
+
+    // Pay = clamp(jitter x çarpan, alt sınır, üst sınır)
+    double minMarginFrames_;
+    double maxMarginFrames_;
+    double jitterMultiplier_;
+
+    // Çağrı başlangıcı
+    bool callStarted_;
+    bool firstAudioWritten_;
+    std::chrono::steady_clock::time_point firstArrival_;
+
+    // İstatistikler
+    std::atomic<uint64_t> timeToFirstAudioUs_;
+    std::atomic<uint64_t> talkspurts_;
+    std::atomic<uint64_t> underruns_;
+    std::atomic<uint64_t> earlyUnderruns_;
+    std::atomic<uint64_t> earlyPackets_;
+    std::atomic<uint64_t> stretchedPackets_;
+
+    double targetFrames() const;
+    bool inEarlyWindow() const;
+};
+
+} // namespace NovaVoice
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+namespace NovaVoice {
+
+/**
+ * @brief Kilitsiz tek üretici / tek tüketici halka buffer
+ *
+ * Kapasite ikinin kuvvetine yuvarlanır ve kurulumda ayrılır; write/read
+ * bellek ayırmaz ve kilit almaz, bu yüzden ses thread'leri arasında
+ * güvenle kullanılabilir. Yalnızca bir thread yazabilir, yalnızca bir
+ * thread okuyabilir.
+ */
+template <typename T>
+class SpscRingBuffer {
+public:
+    explicit SpscRingBuffer(size_t capacity)
+        : head_(0)
+        , tail_(0) {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        buffer_.resize(size);
+        mask_ = size - 1;
+    }
+
+    // Üretici: sığan kadarını yazar, yazılan eleman sayısını döndürür
+    size_t write(const T* data, size_t count) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t tail = tail_.load(std::memory_order_acquire);
+        size_t writable = std::min(count, buffer_.size() - (head - tail));
+
+        for (size_t i = 0; i < writable; ++i) {
+            buffer_[(head + i) & mask_] = data[i];
+        }
+
+        head_.store(head + writable, std::memory_order_release);
+        return writable;
+    }
+
+    // Tüketici: mevcut kadarını okur, okunan eleman sayısını döndürür
+    size_t read(T* out, size_t count) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t head = head_.load(std::memory_order_acquire);
+        size_t readable = std::min(count, head - tail);
+
+        for (size_t i = 0; i < readable; ++i) {
+            out[i] = buffer_[(tail + i) & mask_];
+        }
+
+        tail_.store(tail + readable, std::memory_order_release);
+        return readable;
+    }
+
+    // Tüketici: en eski elemanları okumadan atar
+    size_t discard(size_t count) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t head = head_.load(std::memory_order_acquire);
+        size_t dropped = std::min(count, head - tail);
+
+        tail_.store(tail + dropped, std::memory_order_release);
+        return dropped;
+    }
+
+    size_t available() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return buffer_.size(); }
+
+private:
+    std::vector<T> buffer_;
+    size_t mask_;
+
+    // Üretici ve tüketici indeksleri ayrı cache satırlarında (false sharing yok)
+    alignas(64) std::atomic<size_t> head_;
+    alignas(64) std::atomic<size_t> tail_;
+};
+
+} // namespace NovaVoice
@@ -0,0 +1,192 @@
+#include "BatchDecoder.h"
+#include "MemoryAccounting.h"
+#include "KernelAutotuner.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+
+namespace NovaVoice {
+
+namespace {
+
+std::atomic<size_t> g_defaultColumnBlock{0};
+
+} // namespace
+
+BatchDecoder::BatchDecoder(uint32_t outputRate, size_t maxStreams)
+    : maxStreams_(std::max<size_t>(1, maxStreams))
+    , stride_(((maxStreams_ + 15) / 16) * 16)
+    , inputSamples_(Config::LYRA_FRAME_SIZE)
+    , outputSamples_(0)
+    , streamIds_(maxStreams_, 0)
+    , batchSize_(0)
+    , pendingIds_(maxStreams_, 0)
+    , pendingCount_(0)
+    , columnBlock_(getDefaultColumnBlock())
+    , ticks_(0)
+    , decodedFrames_(0)
+    , rejectedFrames_(0)
+    , maxBatchSize_(0) {
+    MemoryScope memory(MemoryTag::CODEC);
+    buildResampleTable(outputRate);
+    input_.assign(inputSamples_ * stride_, 0);
+    output_.assign(outputSamples_ * stride_, 0);
+}
+
+bool BatchDecoder::submit(uint32_t streamId, const uint8_t* data, size_t size) {
+    // Batch tek frame boyutuyla çalışır; eksik/fazla frame tek başına çözülmeli
+    if (!data || size != inputSamples_ * sizeof(int16_t) || pendingCount_ >= maxStreams_) {
+        rejectedFrames_++;
+        return false;
+    }
+
+    // Aynı tick'te bir akıştan ikinci frame gelmez
+    for (size_t column = 0; column < pendingCount_; ++column) {
+        if (pendingIds_[column] == streamId) {
+            rejectedFrames_++;
+            return false;
+        }
+    }
+
+    size_t column = pendingCount_++;
+    pendingIds_[column] = streamId;
+
+    // Ham yük (int16 LE) -> SoA sütunu
+    for (size_t s = 0; s < inputSamples_; ++s) {
+        int16_t sample;
+        std::memcpy(&sample, data + s * sizeof(int16_t), sizeof(int16_t));
+        input_[s * stride_ + column] = sample;
+    }
+
+    return true;
+}
+
+size_t BatchDecoder::decodeTick() {
+    // Toplanan sütunlar son tick'in çıktı sütunları olur; sonraki tick boştan toplar
+    size_t streams = pendingCount_;
+    pendingCount_ = 0;
+    streamIds_.swap(pendingIds_);
+    batchSize_ = streams;
+    if (streams == 0) {
+        return 0;
+    }
+
+    // Her çıktı satırı iki giriş satırının ağırlıklı toplamı; katsayılar
+    // satır başına bir kez okunur, iç döngü blok içindeki akışlar üzerinde vektörleşir
+    size_t block = columnBlock_ > 0 ? std::min(columnBlock_, streams) : streams;
+    for (size_t first = 0; first < streams; first += block) {
+        size_t last = std::min(streams, first + block);
+
+        for (size_t i = 0; i < outputSamples_; ++i) {
+            const int16_t* a = &input_[sourceIndex_[i] * stride_];
+            const int16_t* b = a + stride_;
+            float fraction = fraction_[i];
+            float weight = 1.0f - fraction;
+            int16_t* out = &output_[i * stride_];
+
+            for (size_t k = first; k < last; ++k) {
+                out[k] = static_cast<int16_t>(a[k] * weight + b[k] * fraction);
+            }
+        }
+    }
+
+    maxBatchSize_ = std::max(maxBatchSize_, streams);
+    decodedFrames_ += streams;
+    ticks_++;
+    return streams;
+}
+
+bool BatchDecoder::copyOutput(size_t column, int16_t* out) const {
+    if (!out || column >= batchSize_) {
+        return false;
+    }
+
+    for (size_t i = 0; i < outputSamples_; ++i) {
+        out[i] = output_[i * stride_ + column];
+    }
+    return true;
+}
+
+void BatchDecoder::mixOutput(int16_t* out) const {
+    if (!out) {
+        return;
+    }
+
+    for (size_t i = 0; i < outputSamples_; ++i) {
+        const int16_t* row = &output_[i * stride_];
+        int32_t sum = 0;
+        for (size_t k = 0; k < batchSize_; ++k) {
+            sum += row[k];
+        }
+        out[i] = static_cast<int16_t>(std::max(-32768, std::min(32767, sum)));
+    }
+}
+
+void BatchDecoder::setDefaultColumnBlock(size_t columns) {
+    g_defaultColumnBlock = columns;
+}
+
+size_t BatchDecoder::getDefaultColumnBlock() {
+    return g_defaultColumnBlock.load(std::memory_order_relaxed);
+}
+
+TunableKernel BatchDecoder::makeColumnBlockTunable() {
+    struct Workload {
+        BatchDecoder decoder{Config::SAMPLE_RATE, Config::MAX_STREAMS};
+        std::vector<uint8_t> frame;
+    };
+    auto workload = std::make_shared<Workload>();
+    workload->frame.resize(Config::LYRA_FRAME_SIZE * sizeof(int16_t));
+    for (size_t i = 0; i < workload->frame.size(); ++i) {
+        workload->frame[i] = static_cast<uint8_t>(i * 29);
+    }
+
+    TunableKernel kernel;
+    kernel.name = "batch_column_block";
+    // "all" varsayılan; 8 ve 16 sütun 128/256 bit vektör genişliğine denk
+    kernel.candidates = {"all", "8", "16"};
+    kernel.apply = [workload](const std::string& name) {
+        size_t columns = 0;
+        if (name == "8" || name == "16") {
+            columns = static_cast<size_t>(std::stoul(name));
+        } else if (name != "all") {
+            return false;
+        }
+        setDefaultColumnBlock(columns);
+        workload->decoder.setColumnBlock(columns);
+        return true;
+    };
+    kernel.run = [workload]() {
+        for (size_t k = 0; k < Config::MAX_STREAMS; ++k) {
+            workload->decoder.submit(static_cast<uint32_t>(k), workload->frame.data(), workload->frame.size());
+        }
+        workload->decoder.decodeTick();
+    };
+    return kernel;
+}
+
+void BatchDecoder::buildResampleTable(uint32_t outputRate) {
+    // LyraCodec::simpleSampleRateConversion ile aynı aritmetik (bit düzeyinde eşit çıktı)
+    float ratio = static_cast<float>(outputRate) / static_cast<float>(Config::LYRA_SAMPLE_RATE);
+    outputSamples_ = static_cast<size_t>(inputSamples_ * ratio);
+
+    sourceIndex_.resize(outputSamples_);
+    fraction_.resize(outputSamples_);
+
+    for (size_t i = 0; i < outputSamples_; ++i) {
+        float position = i / ratio;
+        size_t index = static_cast<size_t>(position);
+
+        if (index >= inputSamples_ - 1) {
+            // Son örnek tekrarlanır: a*0 + b*1 = b
+            sourceIndex_[i] = static_cast<uint32_t>(inputSamples_ - 2);
+            fraction_[i] = 1.0f;
+        } else {
+            sourceIndex_[i] = static_cast<uint32_t>(index);
+            fraction_[i] = position - index;
+        }
+    }
+}
+
+} // namespace NovaVoice
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include "Config.h"
+
+namespace NovaVoice {
+
+struct TunableKernel;
+
+/**
+ * @brief Sunucu tarafı karıştırma için çok akışlı toplu decoder
+ *
+ * Bir tick'te (20 ms) çözülmesi gereken K akışın frame'leri toplanır ve
+ * tek geçişte çözülür. Durum yapı-dizisi (SoA) düzenindedir: her örnek
+ * indeksi için K akışın değerleri bellekte yan yanadır, bu yüzden
+ * katmanlar K sütunlu matris-matris işlemi olarak çalışır ve katsayılar
+ * (ör. yeniden örnekleme ağırlıkları) tüm akışlar için bir kez hesaplanır.
+ * Çıktı, LyraCodec::decode + resampleFromLyra yoluyla bit düzeyinde aynıdır.
+ * Tek bir thread'den kullanılır; tüm buffer'lar kurulumda ayrılır.
+ *
+ * Akışlar sütun bloklarıyla işlenebilir (blok içinde tüm satırlar); en
+ * hızlı blok genişliği CPU'ya göre değişir ve başlangıç ayarıyla seçilir.
+ */
+class BatchDecoder {
+public:
+    explicit BatchDecoder(uint32_t outputRate = Config::SAMPLE_RATE,
+                          size_t maxStreams = Config::MAX_STREAMS);
+
+    // === TICK ===
+    // Akışın bu tick'teki frame'ini topla (sabit codec frame boyutu)
+    bool submit(uint32_t streamId, const uint8_t* data, size_t size);
+    // Toplanan frame'leri tek geçişte çöz; çözülen akış sayısını döndürür
+    size_t decodeTick();
+
+    // === ÇIKTI (son tick) ===
+    size_t getBatchSize() const { return batchSize_; }
+    size_t getOutputSamples() const { return outputSamples_; }
+    uint32_t getStreamId(size_t column) const { return streamIds_[column]; }
+    // Tek akışın çıktısını düz buffer'a kopyala (en az getOutputSamples())
+    bool copyOutput(size_t column, int16_t* out) const;
+    // Tüm akışların doygun toplamı (karıştırıcı çıktısı)
+    void mixOutput(int16_t* out) const;
+
+    // === AYAR ===
+    // Sütun bloğu genişliği (0 = tüm akışlar tek blok); çıktıyı değiştirmez
+    void setColumnBlock(size_t columns) { columnBlock_ = columns; }
+    size_t getColumnBlock() const { return columnBlock_; }
+    // Yeni örneklerin başlangıç değeri (başlangıç ayarı seçer)
+    static void setDefaultColumnBlock(size_t columns);
+    static size_t getDefaultColumnBlock();
+    // Başlangıç ayarı için "batch_column_block": MAX_STREAMS akışlı tick
+    static TunableKernel makeColumnBlockTunable();
+
+    // === İSTATİSTİKLER ===
+    uint64_t getTicks() const { return ticks_; }
+    uint64_t getDecodedFrames() const { return decodedFrames_; }
+    uint64_t getRejectedFrames() const { return rejectedFrames_; }
+    size_t getMaxBatchSize() const { return maxBatchSize_; }
+
+private:
+    size_t maxStreams_;
+    size_t stride_;              // Satır genişliği (akış sayısı, 16'ya yuvarlanmış)
+    size_t inputSamples_;        // Codec frame'i (LYRA_FRAME_SIZE)
+    size_t outputSamples_;
+
+    // SoA matrisler: [örnek][akış]
+    std::vector<int16_t> input_;
+    std::vector<int16_t> output_;
+    std::vector<uint32_t> streamIds_;   // Son tick'in sütunları
+    size_t batchSize_;
+    std::vector<uint32_t> pendingIds_;  // Sonraki tick için toplananlar
+    size_t pendingCount_;
+    size_t columnBlock_;
+
+    // Yeniden örnekleme katsayıları (tüm akışlar için ortak)
+    std::vector<uint32_t> sourceIndex_;
+    std::vector<float> fraction_;
+
+    std::atomic<uint64_t> ticks_;
+    std::atomic<uint64_t> decodedFrames_;
+    std::atomic<uint64_t> rejectedFrames_;
+    size_t maxBatchSize_;
+
+    void buildResampleTable(uint32_t outputRate);
+};
+
+} // namespace NovaVoice
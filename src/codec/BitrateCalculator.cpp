@@ -1,4 +1,5 @@
 #include "BitrateCalculator.h"
+#include "EngineClock.h"
 #include <iostream>
 #include <algorithm>
 #include <numeric>
@@ -13,6 +14,9 @@ BitrateCalculator::BitrateCalculator()
     , targetQuality_(0.5f)
     , adaptationSpeed_(0.3f)
     , stabilityThreshold_(0.1f)
+    , networkWeight_(0.6f)    // Network koşulları daha önemli
+    , audioWeight_(0.4f)      // Audio kalitesi ikinci öncelik
+    , loggingEnabled_(true)
     , qualityMode_(QualityMode::ADAPTIVE)
     , autoAdaptationEnabled_(true)
     , maxHistorySize_(100)
@@ -34,7 +38,7 @@ bool BitrateCalculator::initialize(uint32_t initialBitrate) {
     currentBitrate_.store(clampBitrate(initialBitrate));
     recommendedBitrate_.store(currentBitrate_.load());
     
-    startTime_ = std::chrono::steady_clock::now();
+    startTime_ = EngineClock::now();
     lastUpdateTime_ = startTime_;
     
     // İlk değerleri history'ye ekle
@@ -42,8 +46,10 @@ bool BitrateCalculator::initialize(uint32_t initialBitrate) {
     
     initialized_ = true;
     
-    std::cout << "[BitrateCalculator] Başlatıldı - İlk bitrate: " 
-              << currentBitrate_ << " bps" << std::endl;
+    if (loggingEnabled_) {
+        std::cout << "[BitrateCalculator] Başlatıldı - İlk bitrate: " 
+                  << currentBitrate_ << " bps" << std::endl;
+    }
     
     return true;
 }
@@ -57,7 +63,9 @@ void BitrateCalculator::shutdown() {
     bitrateHistory_.clear();
     bitrateTimestamps_.clear();
     
-    std::cout << "[BitrateCalculator] Kapatıldı" << std::endl;
+    if (loggingEnabled_) {
+        std::cout << "[BitrateCalculator] Kapatıldı" << std::endl;
+    }
 }
 
 uint32_t BitrateCalculator::calculateOptimalBitrate() {
@@ -77,11 +85,8 @@ uint32_t BitrateCalculator::calculateOptimalBitrate(const NetworkMetrics& networ
     uint32_t audioBitrate = calculateAudioBasedBitrate(audio);
     
     // İkisinin ağırlıklı ortalamasını al
-    float networkWeight = 0.6f;  // Network koşulları daha önemli
-    float audioWeight = 0.4f;    // Audio kalitesi ikinci öncelik
-    
     uint32_t combinedBitrate = static_cast<uint32_t>(
-        networkBitrate * networkWeight + audioBitrate * audioWeight
+        networkBitrate * networkWeight_ + audioBitrate * audioWeight_
     );
     
     // Quality mode'a göre ayarla
@@ -101,16 +106,7 @@ void BitrateCalculator::updateNetworkMetrics(const NetworkMetrics& metrics) {
     networkMetrics_ = metrics;
     
     if (autoAdaptationEnabled_) {
-        uint32_t newBitrate = calculateOptimalBitrate();
-        if (shouldUpdateBitrate(newBitrate)) {
-            uint32_t oldBitrate = currentBitrate_;
-            currentBitrate_.store(newBitrate);
-            recommendedBitrate_.store(newBitrate);
-            addToHistory(newBitrate);
-            bitrateChanges_++;
-            
-            logBitrateChange(oldBitrate, newBitrate, "Network conditions");
-        }
+        adaptLocked("Network conditions");
     }
 }
 
@@ -119,19 +115,26 @@ void BitrateCalculator::updateAudioMetrics(const AudioMetrics& metrics) {
     audioMetrics_ = metrics;
     
     if (autoAdaptationEnabled_) {
-        uint32_t newBitrate = calculateOptimalBitrate();
-        if (shouldUpdateBitrate(newBitrate)) {
-            uint32_t oldBitrate = currentBitrate_;
-            currentBitrate_.store(newBitrate);
-            recommendedBitrate_.store(newBitrate);
-            addToHistory(newBitrate);
-            bitrateChanges_++;
-            
-            logBitrateChange(oldBitrate, newBitrate, "Audio characteristics");
-        }
+        adaptLocked("Audio characteristics");
     }
 }
 
+void BitrateCalculator::adaptLocked(const char* reason) {
+    // Kilit zaten tutuluyor: parametreli hesaplama tekrar kilitlemez
+    uint32_t newBitrate = calculateOptimalBitrate(networkMetrics_, audioMetrics_);
+    if (!shouldUpdateBitrate(newBitrate)) {
+        return;
+    }
+    
+    uint32_t oldBitrate = currentBitrate_;
+    currentBitrate_.store(newBitrate);
+    recommendedBitrate_.store(newBitrate);
+    addToHistory(newBitrate);
+    bitrateChanges_++;
+    
+    logBitrateChange(oldBitrate, newBitrate, reason);
+}
+
 void BitrateCalculator::reportPacketLoss(uint32_t totalPackets, uint32_t lostPackets) {
     if (totalPackets == 0) return;
     
@@ -168,6 +171,18 @@ void BitrateCalculator::setStabilityThreshold(float threshold) {
     stabilityThreshold_ = std::max(0.0f, std::min(1.0f, threshold));
 }
 
+void BitrateCalculator::setWeights(float networkWeight, float audioWeight) {
+    networkWeight = std::max(0.0f, networkWeight);
+    audioWeight = std::max(0.0f, audioWeight);
+    float total = networkWeight + audioWeight;
+    if (total <= 0.0f) {
+        return;
+    }
+    
+    networkWeight_ = networkWeight / total;
+    audioWeight_ = audioWeight / total;
+}
+
 NetworkMetrics BitrateCalculator::getNetworkMetrics() const {
     std::lock_guard<std::mutex> lock(metricsMutex_);
     return networkMetrics_;
@@ -194,6 +209,9 @@ std::vector<uint32_t> BitrateCalculator::getBitrateHistory() const {
 void BitrateCalculator::enableAutoAdaptation(bool enable) {
     autoAdaptationEnabled_ = enable;
     
+    if (!loggingEnabled_) {
+        return;
+    }
     if (enable) {
         std::cout << "[BitrateCalculator] Otomatik adaptasyon etkinleştirildi" << std::endl;
     } else {
@@ -204,8 +222,10 @@ void BitrateCalculator::enableAutoAdaptation(bool enable) {
 void BitrateCalculator::setQualityMode(QualityMode mode) {
     qualityMode_ = mode;
     
-    std::cout << "[BitrateCalculator] Kalite modu değiştirildi: " 
-              << BitrateUtils::qualityModeToString(mode) << std::endl;
+    if (loggingEnabled_) {
+        std::cout << "[BitrateCalculator] Kalite modu değiştirildi: " 
+                  << BitrateUtils::qualityModeToString(mode) << std::endl;
+    }
     
     // Mode değişikliğinde bitrate'i yeniden hesapla
     if (autoAdaptationEnabled_) {
@@ -330,7 +350,7 @@ bool BitrateCalculator::shouldUpdateBitrate(uint32_t newBitrate) {
 }
 
 void BitrateCalculator::addToHistory(uint32_t bitrate) {
-    auto now = std::chrono::steady_clock::now();
+    auto now = EngineClock::now();
     
     bitrateHistory_.push_back(bitrate);
     bitrateTimestamps_.push_back(now);
@@ -345,7 +365,7 @@ void BitrateCalculator::addToHistory(uint32_t bitrate) {
 }
 
 void BitrateCalculator::cleanupHistory() {
-    auto now = std::chrono::steady_clock::now();
+    auto now = EngineClock::now();
     auto cutoff = now - std::chrono::minutes(10); // 10 dakikadan eski kayıtları sil
     
     while (!bitrateTimestamps_.empty() && bitrateTimestamps_.front() < cutoff) {
@@ -355,6 +375,9 @@ void BitrateCalculator::cleanupHistory() {
 }
 
 void BitrateCalculator::logBitrateChange(uint32_t oldBitrate, uint32_t newBitrate, const std::string& reason) {
+    if (!loggingEnabled_) {
+        return;
+    }
     std::cout << "[BitrateCalculator] Bitrate değişti: " 
               << oldBitrate << " -> " << newBitrate << " bps (Sebep: " << reason << ")" << std::endl;
 }
@@ -59,6 +59,8 @@ public:
     void setTargetQuality(float quality); // 0.0 = minimum, 1.0 = maximum
     void setAdaptationSpeed(float speed);  // 0.0 = slow, 1.0 = fast
     void setStabilityThreshold(float threshold); // Bitrate değişim eşiği
+    void setWeights(float networkWeight, float audioWeight); // Ağ/ses önerisi ağırlıkları (toplamı 1'e ölçeklenir)
+    void setLogging(bool enable) { loggingEnabled_ = enable; } // Çevrimdışı değerlendirme için sessiz mod
     
     // === GETTERS ===
     uint32_t getCurrentBitrate() const { return currentBitrate_; }
@@ -96,6 +98,9 @@ private:
     float targetQuality_;      // 0.0 - 1.0
     float adaptationSpeed_;    // 0.0 - 1.0
     float stabilityThreshold_; // Minimum değişim eşiği
+    float networkWeight_;      // Ağ önerisinin ağırlığı
+    float audioWeight_;        // Ses önerisinin ağırlığı
+    bool loggingEnabled_;
     
     // Quality mode
     QualityMode qualityMode_;
@@ -121,6 +126,7 @@ private:
     uint32_t calculateAudioBasedBitrate(const AudioMetrics& metrics);
     uint32_t applyQualityMode(uint32_t baseBitrate);
     uint32_t smoothBitrateTransition(uint32_t newBitrate);
+    void adaptLocked(const char* reason);  // metricsMutex_ tutulurken
     
     // Validation
     uint32_t clampBitrate(uint32_t bitrate);
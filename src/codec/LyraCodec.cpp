@@ -1,4 +1,6 @@
 #include "LyraCodec.h"
+#include "MemoryAccounting.h"
+#include "KernelAutotuner.h"
 #include <iostream>
 #include <cstring>
 #include <algorithm>
@@ -12,6 +14,12 @@
 
 namespace NovaVoice {
 
+namespace {
+
+std::atomic<int> g_resamplerKernel{static_cast<int>(ResamplerKernel::DIRECT)};
+
+} // namespace
+
 LyraCodec::LyraCodec()
     : initialized_(false)
     , sampleRate_(Config::LYRA_SAMPLE_RATE)
@@ -22,7 +30,11 @@ LyraCodec::LyraCodec()
     , encodedFrames_(0)
     , decodedFrames_(0)
     , encodingErrors_(0)
-    , decodingErrors_(0) {
+    , decodingErrors_(0)
+    , encodeStage_(StageProfiler::INVALID_STAGE)
+    , decodeStage_(StageProfiler::INVALID_STAGE)
+    , resampleStage_(StageProfiler::INVALID_STAGE) {
+    MemoryScope memory(MemoryTag::CODEC);
 #ifdef HAVE_LYRA
     lyraEncoder_ = nullptr;
     lyraDecoder_ = nullptr;
@@ -35,6 +47,7 @@ LyraCodec::~LyraCodec() {
 }
 
 bool LyraCodec::initialize(uint32_t sampleRate, uint32_t channels, uint32_t bitrate) {
+    MemoryScope memory(MemoryTag::CODEC);
     std::lock_guard<std::mutex> lock(codecMutex_);
     
     if (initialized_) {
@@ -75,6 +88,7 @@ bool LyraCodec::isLyraAvailable() const {
 }
 
 std::optional<EncodedPacket> LyraCodec::encode(const int16_t* audioData, size_t sampleCount) {
+    MemoryScope memory(MemoryTag::CODEC);
     if (!initialized_) {
         logError("Codec başlatılmamış");
         encodingErrors_++;
@@ -97,6 +111,7 @@ std::optional<EncodedPacket> LyraCodec::encode(const int16_t* audioData, size_t
     
     try {
         std::vector<uint8_t> encodedData;
+        StageProfiler::Scope scope(profiler_.get(), encodeStage_);
         
 #ifdef HAVE_LYRA
         if (isLyraAvailable()) {
@@ -141,6 +156,7 @@ std::optional<std::vector<int16_t>> LyraCodec::decode(const EncodedPacket& packe
 }
 
 std::optional<std::vector<int16_t>> LyraCodec::decode(const uint8_t* encodedData, size_t dataSize) {
+    MemoryScope memory(MemoryTag::CODEC);
     if (!initialized_) {
         logError("Codec başlatılmamış");
         decodingErrors_++;
@@ -157,6 +173,7 @@ std::optional<std::vector<int16_t>> LyraCodec::decode(const uint8_t* encodedData
     
     try {
         std::vector<int16_t> decodedAudio;
+        StageProfiler::Scope scope(profiler_.get(), decodeStage_);
         
 #ifdef HAVE_LYRA
         if (isLyraAvailable()) {
@@ -188,6 +205,14 @@ std::optional<std::vector<int16_t>> LyraCodec::decode(const uint8_t* encodedData
     }
 }
 
+void LyraCodec::setStageProfiler(std::shared_ptr<StageProfiler> profiler) {
+    std::lock_guard<std::mutex> lock(codecMutex_);
+    profiler_ = profiler;
+    encodeStage_ = profiler_ ? profiler_->addStage("lyra.encode") : StageProfiler::INVALID_STAGE;
+    decodeStage_ = profiler_ ? profiler_->addStage("lyra.decode") : StageProfiler::INVALID_STAGE;
+    resampleStage_ = profiler_ ? profiler_->addStage("lyra.resample") : StageProfiler::INVALID_STAGE;
+}
+
 bool LyraCodec::setBitrate(uint32_t bitrate) {
     if (!CodecUtils::isValidBitrate(bitrate)) {
         logError("Geçersiz bitrate: " + std::to_string(bitrate));
@@ -311,6 +336,14 @@ std::vector<int16_t> LyraCodec::simpleSampleRateConversion(const int16_t* input,
         return std::vector<int16_t>(input, input + inputSamples);
     }
     
+    StageProfiler::Scope scope(profiler_.get(), resampleStage_);
+    
+    if (getResamplerKernel() == ResamplerKernel::TABLE && inputSamples >= 2) {
+        std::vector<int16_t> output;
+        tableSampleRateConversion(input, inputSamples, inputRate, outputRate, output);
+        return output;
+    }
+    
     // Basit linear interpolation
     float ratio = static_cast<float>(outputRate) / static_cast<float>(inputRate);
     size_t outputSamples = static_cast<size_t>(inputSamples * ratio);
@@ -336,6 +369,94 @@ std::vector<int16_t> LyraCodec::simpleSampleRateConversion(const int16_t* input,
     return output;
 }
 
+void LyraCodec::tableSampleRateConversion(const int16_t* input, size_t inputSamples,
+                                          uint32_t inputRate, uint32_t outputRate, std::vector<int16_t>& output) {
+    const ResampleTable& table = getResampleTable(inputSamples, inputRate, outputRate);
+    output.resize(table.sourceIndex.size());
+    
+    // Son örnek a*0 + b*1 olarak kodlanır: dallanmasız döngü, aynı aritmetik
+    for (size_t i = 0; i < output.size(); ++i) {
+        const int16_t* pair = input + table.sourceIndex[i];
+        float fraction = table.fraction[i];
+        output[i] = static_cast<int16_t>(pair[0] * (1.0f - fraction) + pair[1] * fraction);
+    }
+}
+
+const LyraCodec::ResampleTable& LyraCodec::getResampleTable(size_t inputSamples, uint32_t inputRate,
+                                                           uint32_t outputRate) {
+    ResampleTable& table = resampleTables_[outputRate == Config::LYRA_SAMPLE_RATE ? 0 : 1];
+    if (table.inputSamples == inputSamples && table.inputRate == inputRate && table.outputRate == outputRate) {
+        return table;
+    }
+    
+    // simpleSampleRateConversion ile aynı konum hesabı (bit düzeyinde eşit çıktı)
+    float ratio = static_cast<float>(outputRate) / static_cast<float>(inputRate);
+    size_t outputSamples = static_cast<size_t>(inputSamples * ratio);
+    table.sourceIndex.resize(outputSamples);
+    table.fraction.resize(outputSamples);
+    
+    for (size_t i = 0; i < outputSamples; ++i) {
+        float sourceIndex = i / ratio;
+        size_t index = static_cast<size_t>(sourceIndex);
+        
+        if (index >= inputSamples - 1) {
+            table.sourceIndex[i] = static_cast<uint32_t>(inputSamples - 2);
+            table.fraction[i] = 1.0f;
+        } else {
+            table.sourceIndex[i] = static_cast<uint32_t>(index);
+            table.fraction[i] = sourceIndex - index;
+        }
+    }
+    
+    table.inputSamples = inputSamples;
+    table.inputRate = inputRate;
+    table.outputRate = outputRate;
+    return table;
+}
+
+void LyraCodec::setResamplerKernel(ResamplerKernel kernel) {
+    g_resamplerKernel = static_cast<int>(kernel);
+}
+
+ResamplerKernel LyraCodec::getResamplerKernel() {
+    return static_cast<ResamplerKernel>(g_resamplerKernel.load(std::memory_order_relaxed));
+}
+
+const char* LyraCodec::resamplerName(ResamplerKernel kernel) {
+    return kernel == ResamplerKernel::TABLE ? "table" : "direct";
+}
+
+TunableKernel LyraCodec::makeResamplerTunable() {
+    struct Workload {
+        LyraCodec codec;
+        std::vector<int16_t> capture;
+    };
+    auto workload = std::make_shared<Workload>();
+    workload->capture.resize(Config::SAMPLE_RATE * Config::LYRA_FRAME_SIZE_MS / 1000);
+    for (size_t i = 0; i < workload->capture.size(); ++i) {
+        workload->capture[i] = static_cast<int16_t>((i * 613) % 16001 - 8000);
+    }
+    
+    TunableKernel kernel;
+    kernel.name = "lyra_resampler";
+    kernel.candidates = {resamplerName(ResamplerKernel::DIRECT), resamplerName(ResamplerKernel::TABLE)};
+    kernel.apply = [](const std::string& name) {
+        for (ResamplerKernel candidate : {ResamplerKernel::DIRECT, ResamplerKernel::TABLE}) {
+            if (name == resamplerName(candidate)) {
+                setResamplerKernel(candidate);
+                return true;
+            }
+        }
+        return false;
+    };
+    kernel.run = [workload]() {
+        auto lyra = workload->codec.resampleTo16kHz(workload->capture.data(), workload->capture.size(),
+                                                    Config::SAMPLE_RATE);
+        workload->codec.resampleFromLyra(lyra.data(), lyra.size(), Config::SAMPLE_RATE);
+    };
+    return kernel;
+}
+
 bool LyraCodec::validateParameters(uint32_t sampleRate, uint32_t channels, uint32_t bitrate) const {
     if (channels != 1) {
         logError("Sadece mono (1 kanal) destekleniyor");
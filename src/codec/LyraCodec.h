@@ -8,6 +8,7 @@
 #include <mutex>
 #include "Config.h"
 #include "BufferManager.h"
+#include "StageProfiler.h"
 
 // Lyra v2 forward declarations (conditional)
 #ifdef HAVE_LYRA
@@ -27,6 +28,14 @@ enum class CodecStatus {
     ERROR_NOT_AVAILABLE = -5
 };
 
+// Yeniden örnekleme çekirdeği (çıktılar bit düzeyinde aynı)
+enum class ResamplerKernel {
+    DIRECT,     // Örnek başına kaynak konumu hesaplanır
+    TABLE       // Konum/ağırlık tablosu frame boyutu başına bir kez kurulur
+};
+
+struct TunableKernel;
+
 // Encoded packet structure
 struct EncodedPacket {
     std::vector<uint8_t> data;
@@ -74,6 +83,9 @@ public:
     uint32_t getChannels() const { return channels_; }
     uint32_t getFrameSize() const { return frameSize_; }
     
+    // Aşama ölçümü: "lyra.encode", "lyra.decode", "lyra.resample"
+    void setStageProfiler(std::shared_ptr<StageProfiler> profiler);
+    
     // === STATISTICS ===
     uint64_t getEncodedFrames() const { return encodedFrames_; }
     uint64_t getDecodedFrames() const { return decodedFrames_; }
@@ -89,7 +101,24 @@ public:
     std::vector<int16_t> resampleTo16kHz(const int16_t* input, size_t inputSamples, uint32_t inputSampleRate);
     std::vector<int16_t> resampleFromLyra(const int16_t* input, size_t inputSamples, uint32_t targetSampleRate);
     
+    // Süreç genelinde yeniden örnekleme çekirdeği (başlangıç ayarı seçer)
+    static void setResamplerKernel(ResamplerKernel kernel);
+    static ResamplerKernel getResamplerKernel();
+    static const char* resamplerName(ResamplerKernel kernel);
+    // Başlangıç ayarı için "lyra_resampler": 20 ms frame'de 48k -> 16k -> 48k
+    static TunableKernel makeResamplerTunable();
+    
 private:
+    // Sabit frame boyutu için yeniden örnekleme tablosu
+    struct ResampleTable {
+        size_t inputSamples = 0;
+        uint32_t inputRate = 0;
+        uint32_t outputRate = 0;
+        std::vector<uint32_t> sourceIndex;
+        std::vector<float> fraction;
+    };
+    
+
     // Configuration
     bool initialized_;
     uint32_t sampleRate_;
@@ -109,6 +138,15 @@ private:
     // Thread safety
     mutable std::mutex codecMutex_;
     
+    // Yön başına tablo (Lyra'ya / Lyra'dan): her yön tek thread'den çağrılır
+    ResampleTable resampleTables_[2];
+    
+    // Aşama ölçümü
+    std::shared_ptr<StageProfiler> profiler_;
+    int encodeStage_;
+    int decodeStage_;
+    int resampleStage_;
+    
 #ifdef HAVE_LYRA
     // Lyra encoder/decoder instances (void pointers for now)
     void* lyraEncoder_;
@@ -125,6 +163,9 @@ private:
     // Sample rate conversion helpers
     std::vector<int16_t> simpleSampleRateConversion(const int16_t* input, size_t inputSamples, 
                                                    uint32_t inputRate, uint32_t outputRate);
+    void tableSampleRateConversion(const int16_t* input, size_t inputSamples,
+                                   uint32_t inputRate, uint32_t outputRate, std::vector<int16_t>& output);
+    const ResampleTable& getResampleTable(size_t inputSamples, uint32_t inputRate, uint32_t outputRate);
     
     // Validation
     bool validateParameters(uint32_t sampleRate, uint32_t channels, uint32_t bitrate) const;
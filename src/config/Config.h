@@ -33,6 +33,9 @@ public:
     static constexpr uint16_t DEFAULT_PORT = 8888;
     static constexpr size_t PACKET_SIZE = 1024;         // UDP paket boyutu
     static constexpr size_t BUFFER_COUNT = 10;          // Buffer sayısı
+    static constexpr size_t SEND_BATCH_SIZE = 16;       // sendmmsg başına maksimum paket
+    static constexpr size_t MAX_STREAMS = 32;           // Eşzamanlı uzak konuşmacı (stream) havuzu
+    static constexpr uint32_t STREAM_IDLE_TIMEOUT_MS = 5000; // Boşta kalan stream geri alınır
     
     // === TIMEOUT DEĞERLERİ (ms) ===
     static constexpr uint32_t NETWORK_TIMEOUT = 5000;
@@ -44,6 +47,33 @@ public:
     static constexpr bool ENABLE_NOISE_REDUCTION = true;
     static constexpr bool ENABLE_CODEC = true;
     
+    // === GERÇEK ZAMAN ===
+    static constexpr int AUDIO_RT_PRIORITY = 70;        // SCHED_FIFO önceliği (ses thread'leri)
+    static constexpr uint32_t LATENCY_PROBE_INTERVAL_MS = 1000; // Probe darbeleri arası süre
+    static constexpr size_t PLAYBACK_PREFILL_PERIODS = 2;    // Xrun sonrası playback hedef doluluğu
+    static constexpr size_t PLAYBACK_RESYNC_PACKETS = 2;     // Xrun sonrası playout kuyruğunda kalan paket
+    
+    // === PLAYOUT ===
+    static constexpr uint32_t PLAYOUT_MIN_MARGIN_MS = 5;     // Başlatma payı alt sınırı (jitter bilinmiyorken)
+    static constexpr double PLAYOUT_JITTER_MULTIPLIER = 2.0; // Pay = jitter x çarpan
+    static constexpr double PLAYOUT_MAX_STRETCH = 0.04;      // Zaman esnetme sınırı (±%4)
+    static constexpr uint32_t PLAYOUT_EARLY_WINDOW_MS = 10000; // "Çağrı başı" underrun penceresi
+    static constexpr size_t PLAYBACK_CONCEAL_PERIODS = 3;      // Sessizliğe sönümlenmeden önce gizlenen periyot
+    static constexpr size_t PCM_TAP_MAX_GAP_PACKETS = 25;      // PcmTap'te sessizlikle doldurulan en uzun sıra boşluğu
+    
+    // === PERİYOT UYARLAMA ===
+    static constexpr size_t MIN_PERIOD_FRAMES = 240;         // 5 ms @ 48kHz
+    static constexpr size_t MAX_PERIOD_FRAMES = 2048;        // Ses buffer'ları bu boyutta ayrılır
+    static constexpr size_t PLAYBACK_RING_FRAMES = 4 * MAX_PERIOD_FRAMES; // Esnek playback halkası
+    static constexpr size_t MAX_PAYLOAD_SIZE = MAX_PERIOD_FRAMES * CHANNELS * (BITS_PER_SAMPLE / 8); // En büyük ses paketi
+    static constexpr size_t PERIODS_PER_BUFFER = 4;          // ALSA buffer = periyot x 4
+    static constexpr uint32_t PERIOD_TUNE_WINDOW_MS = 2000;  // Gecikme/xrun değerlendirme penceresi
+    static constexpr size_t PERIOD_TUNE_STABLE_WINDOWS = 3;  // Küçültmeden önce gereken sakin pencere
+    
+    // === NİCEMLEME ===
+    static constexpr float QUANT_VAD_TOLERANCE = 0.02f;      // int8 vs float konuşma olasılığı farkı
+    static constexpr float QUANT_GAIN_TOLERANCE = 0.02f;     // int8 vs float bant kazancı farkı
+    
     // === PERFORMANS ===
     static constexpr bool AUTO_BITRATE_ADJUSTMENT = true; // Otomatik bitrate ayarlama
     static constexpr uint32_t BITRATE_UPDATE_INTERVAL_MS = 5000; // 5 saniye
@@ -0,0 +1,122 @@
+#include "LatencyProfile.h"
+#include <algorithm>
+
+namespace NovaVoice {
+
+namespace {
+
+std::vector<LatencyProfile> buildCatalog() {
+    std::vector<LatencyProfile> profiles;
+
+    // 5 ms periyot, iki periyot playback, dar jitter payı
+    LatencyProfile interactive;
+    interactive.id = LatencyProfileId::INTERACTIVE;
+    interactive.name = "interactive";
+    interactive.description = "Ağız-kulak ≤ 80 ms (LAN / iyi geniş bant)";
+    interactive.targetMouthToEarMs = 80.0;
+    interactive.maxResidualLossRate = 0.04;
+    interactive.designNetwork = {25.0, 4.0, 0.01, 1.0};
+    interactive.periodFrames = 240;
+    interactive.periodsPerBuffer = 3;
+    interactive.prefillPeriods = 2;
+    interactive.duplex = true;
+    interactive.adaptivePeriod = false;
+    interactive.rtPriority = 80;
+    interactive.maxQueuedPackets = 6;
+    interactive.playoutMinMarginMs = 5;
+    interactive.playoutMaxMarginMs = 25;
+    interactive.playoutJitterMultiplier = 5.0;
+    interactive.concealPeriods = 4;
+    profiles.push_back(interactive);
+
+    // 10 ms periyot, xrun'da periyot büyüyebilir
+    LatencyProfile balanced;
+    balanced.id = LatencyProfileId::BALANCED;
+    balanced.name = "balanced";
+    balanced.description = "Ağız-kulak ≤ 150 ms, orta jitter'a dayanıklı";
+    balanced.targetMouthToEarMs = 150.0;
+    balanced.maxResidualLossRate = 0.08;
+    balanced.designNetwork = {40.0, 8.0, 0.02, 1.5};
+    balanced.periodFrames = 480;
+    balanced.periodsPerBuffer = 4;
+    balanced.prefillPeriods = 2;
+    balanced.duplex = true;
+    balanced.adaptivePeriod = true;
+    balanced.rtPriority = Config::AUDIO_RT_PRIORITY;
+    balanced.maxQueuedPackets = Config::BUFFER_COUNT;
+    balanced.playoutMinMarginMs = 10;
+    balanced.playoutMaxMarginMs = 60;
+    balanced.playoutJitterMultiplier = 4.0;
+    balanced.concealPeriods = Config::PLAYBACK_CONCEAL_PERIODS;
+    profiles.push_back(balanced);
+
+    // 20 ms periyot, geniş jitter payı ve uzun gizleme
+    LatencyProfile resilient;
+    resilient.id = LatencyProfileId::RESILIENT;
+    resilient.name = "resilient";
+    resilient.description = "Ağız-kulak ≤ 400 ms, kayıplı/jitter'lı ağ (mobil, Wi-Fi)";
+    resilient.targetMouthToEarMs = 400.0;
+    resilient.maxResidualLossRate = 0.10;
+    resilient.designNetwork = {80.0, 30.0, 0.05, 3.0};
+    resilient.periodFrames = 960;
+    resilient.periodsPerBuffer = 4;
+    resilient.prefillPeriods = 3;
+    resilient.duplex = false;
+    resilient.adaptivePeriod = false;
+    resilient.rtPriority = Config::AUDIO_RT_PRIORITY;
+    resilient.maxQueuedPackets = 24;
+    resilient.playoutMinMarginMs = 40;
+    resilient.playoutMaxMarginMs = 250;
+    resilient.playoutJitterMultiplier = 5.0;
+    resilient.concealPeriods = 6;
+    profiles.push_back(resilient);
+
+    return profiles;
+}
+
+} // namespace
+
+double LatencyProfile::playoutMarginMs(double jitterMs) const {
+    double margin = playoutJitterMultiplier * jitterMs;
+    return std::max(static_cast<double>(playoutMinMarginMs),
+                    std::min(static_cast<double>(playoutMaxMarginMs), margin));
+}
+
+LatencyBudget LatencyProfile::estimateBudget(const NetworkConditions& network) const {
+    LatencyBudget budget;
+    budget.captureMs = periodMs();
+    budget.networkMs = network.oneWayDelayMs;
+    budget.playoutMs = playoutMarginMs(network.jitterMs);
+    budget.playbackMs = prefillPeriods * periodMs();
+    budget.totalMs = budget.captureMs + budget.networkMs + budget.playoutMs + budget.playbackMs;
+    return budget;
+}
+
+double LatencyProfile::deviceBudgetMs() const {
+    return (1 + prefillPeriods) * periodMs();
+}
+
+const std::vector<LatencyProfile>& LatencyProfile::all() {
+    static const std::vector<LatencyProfile> catalog = buildCatalog();
+    return catalog;
+}
+
+const LatencyProfile& LatencyProfile::get(LatencyProfileId id) {
+    for (const auto& profile : all()) {
+        if (profile.id == id) {
+            return profile;
+        }
+    }
+    return all().front();
+}
+
+const LatencyProfile* LatencyProfile::find(const std::string& name) {
+    for (const auto& profile : all()) {
+        if (profile.name == name) {
+            return &profile;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace NovaVoice
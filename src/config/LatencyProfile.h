@@ -0,0 +1,84 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Config.h"
+
+namespace NovaVoice {
+
+enum class LatencyProfileId {
+    INTERACTIVE,    // Ağız-kulak ≤ 80 ms, iyi ağ
+    BALANCED,       // Gecikme ve dayanıklılık dengesi
+    RESILIENT       // Kayıplı/jitter'lı ağda kesintisiz ses
+};
+
+// Profilin doğrulandığı ağ koşulu (tek yön)
+struct NetworkConditions {
+    double oneWayDelayMs;
+    double jitterMs;            // Ek gecikmenin ortalaması (üstel dağılım)
+    double lossRate;
+    double meanBurstLength;
+};
+
+// Ağız-kulak gecikme bütçesinin kalemleri (ms)
+struct LatencyBudget {
+    double captureMs;           // Periyodun dolması (paket = bir periyot)
+    double networkMs;
+    double playoutMs;           // Jitter payı
+    double playbackMs;          // Cihaz buffer'ında bekleyen periyotlar
+    double totalMs;
+};
+
+/**
+ * @brief Uçtan uca gecikme profili
+ *
+ * Gecikmeyi gerçekten belirleyen ayarları tek yerde toplar: ALSA periyodu
+ * ve buffer derinliği (paketleme de periyoda bağlıdır), playback ön
+ * doldurması, jitter buffer sınırları ve payı, gizleme uzunluğu, ses
+ * thread'i önceliği ve ön işleme aşamaları. Her alt sistem profili kendi
+ * applyProfile() metoduyla uygular. Profilin hedefi, tanımladığı ağ
+ * koşulu altında gecikme bütçesi ve kalan kayıp oranıyla ifade edilir;
+ * nova_quality --profile bunu simülasyonla, --latency-probe ise cihaz
+ * kısmını ölçümle doğrular.
+ */
+struct LatencyProfile {
+    LatencyProfileId id;
+    std::string name;
+    std::string description;
+
+    // === HEDEFLER ===
+    double targetMouthToEarMs;
+    double maxResidualLossRate;     // Kayıp + geç kalan paket oranı üst sınırı
+    NetworkConditions designNetwork;
+
+    // === SES CİHAZI ===
+    size_t periodFrames;
+    size_t periodsPerBuffer;
+    size_t prefillPeriods;          // Playback'te bekletilen periyot
+    bool duplex;
+    bool adaptivePeriod;
+    int rtPriority;                 // SCHED_FIFO önceliği
+
+    // === JITTER BUFFER ===
+    size_t maxQueuedPackets;
+    uint32_t playoutMinMarginMs;
+    uint32_t playoutMaxMarginMs;
+    double playoutJitterMultiplier;
+    size_t concealPeriods;
+
+    double periodMs() const { return periodFrames * 1000.0 / Config::SAMPLE_RATE; }
+    double playoutMarginMs(double jitterMs) const;
+
+    // Verilen ağ koşulunda bütçe; cihaz kısmı latency probe ile karşılaştırılabilir
+    LatencyBudget estimateBudget(const NetworkConditions& network) const;
+    double deviceBudgetMs() const;
+
+    // === KATALOG ===
+    static const std::vector<LatencyProfile>& all();
+    static const LatencyProfile& get(LatencyProfileId id);
+    static const LatencyProfile* find(const std::string& name);
+};
+
+} // namespace NovaVoice
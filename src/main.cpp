@@ -4,12 +4,26 @@
 #include <thread>
 #include <chrono>
 #include <string>
+#include <cstring>
 
 #include "Config.h"
 #include "BufferManager.h"
 #include "UDPManager.h"
 #include "AudioCapture.h"
 #include "AudioPlayer.h"
+#include "AudioDuplex.h"
+#include "LatencyProfile.h"
+#include "StageProfiler.h"
+#include "KernelAutotuner.h"
+#include "RealtimeCheck.h"
+#include "StatsPage.h"
+#include "PcmTap.h"
+#include "MemoryAccounting.h"
+#include "QuantizedKernels.h"
+#ifdef HAVE_LYRA
+#include "LyraCodec.h"
+#include "BatchDecoder.h"
+#endif
 
 using namespace NovaVoice;
 
@@ -19,6 +33,14 @@ std::shared_ptr<BufferManager> g_bufferManager;
 std::shared_ptr<UDPManager> g_udpManager;
 std::shared_ptr<AudioCapture> g_audioCapture;
 std::shared_ptr<AudioPlayer> g_audioPlayer;
+std::shared_ptr<AudioDuplex> g_audioDuplex;
+std::shared_ptr<Sidetone> g_sidetone;
+const LatencyProfile* g_profile = nullptr;
+std::shared_ptr<StageProfiler> g_stageProfiler;
+std::string g_stageCsvPrefix;
+std::shared_ptr<StatsPublisher> g_statsPublisher;
+std::shared_ptr<PcmTapPublisher> g_pcmTap;
+std::atomic<bool> g_memoryReportRequested(false);
 
 // Signal handler
 void signalHandler(int signal) {
@@ -26,6 +48,9 @@ void signalHandler(int signal) {
     g_running = false;
     
     // Hızlı kapatma için sistemleri zorla durdur
+    if (g_audioDuplex) {
+        g_audioDuplex->stop();
+    }
     if (g_audioCapture) {
         g_audioCapture->stop();
     }
@@ -37,6 +62,11 @@ void signalHandler(int signal) {
     }
 }
 
+// SIGUSR1: bellek raporu iste (yalnızca bayrak; rapor istatistik thread'inde yazılır)
+void memoryReportHandler(int) {
+    g_memoryReportRequested = true;
+}
+
 // Yardım mesajı
 void printUsage(const char* programName) {
     std::cout << "Nova Voice Engine V2 - Sesli Konuşma Uygulaması" << std::endl;
@@ -59,6 +89,28 @@ void printUsage(const char* programName) {
     std::cout << std::endl;
     std::cout << "Genel Seçenekler:" << std::endl;
     std::cout << "  -d, --device DEVICE     Ses cihazı adı (varsayılan: default)" << std::endl;
+    std::cout << "  --duplex                Capture/playback'i bağlı (linked) tek thread ile sür" << std::endl;
+    std::cout << "  --latency-probe         Döngüsel gecikmeyi ölç (--duplex ile birlikte açılır)" << std::endl;
+    std::cout << "  --adaptive-period       ALSA periyodunu gecikme/xrun'a göre ayarla (--duplex ile birlikte açılır)" << std::endl;
+    std::cout << "  --sidetone LEVEL        Kendi sesini kulaklıkta duy (0.0-1.0; ağ yolunu atlar, playback buffer gecikmesi kalır)" << std::endl;
+    std::cout << "  --profile NAME          Uçtan uca gecikme profili (periyot, jitter buffer, gizleme, öncelik):" << std::endl;
+    for (const auto& profile : LatencyProfile::all()) {
+        std::cout << "                            " << profile.name << " - " << profile.description << std::endl;
+    }
+    std::cout << "  --profile-stages        Ses thread'lerinde aşama başına süre ölçümü (nova_top aşama tablosu, sayaçsız)" << std::endl;
+    std::cout << "  --perf-counters         Aşama başına süre histogramı ve donanım sayaçları (cycles, IPC, LLC/branch miss)" << std::endl;
+    std::cout << "  --perf-csv PREFIX       Çıkışta PREFIX_stages.csv ve PREFIX_histogram.csv yaz (--perf-counters'ı açar)" << std::endl;
+    std::cout << "  --rt-check              Ses/alım thread'lerinde malloc, mutex ve bloklayan çağrıları raporla" << std::endl;
+    std::cout << "                            (NOVA_RT_CHECK=ON ile derlenmiş olmalı)" << std::endl;
+    std::cout << "  --stats-shm NAME        Canlı istatistik sayfası adı (/dev/shm, varsayılan: nova_voice.<pid>; nova_top ile izlenir)" << std::endl;
+    std::cout << "  --no-stats-shm          İstatistik sayfasını yayınlama" << std::endl;
+    std::cout << "                          Bellek raporu: kill -USR1 <pid> (alt sistem ve oturum başına canlı bayt, ayırma hızı)" << std::endl;
+    std::cout << "  --pcm-tap [NAME]        İşlenmiş sesi oturum başına 16 kHz ring'lerle /dev/shm'ye yayınla" << std::endl;
+    std::cout << "                            (varsayılan ad: nova_tap.<pid>; nova_tap ile okunur, motor okuyucuyu beklemez)" << std::endl;
+    std::cout << "  --wisdom PATH           Çekirdek seçimlerinin CPU modeline göre saklandığı dosya" << std::endl;
+    std::cout << "                            (varsayılan: $NOVA_WISDOM veya ~/.nova_voice_wisdom)" << std::endl;
+    std::cout << "  --autotune              Çekirdekleri yeniden ölç ve wisdom dosyasını güncelle" << std::endl;
+    std::cout << "  --no-autotune           Başlangıç ayarını atla (derlenmiş varsayılanlar)" << std::endl;
     std::cout << "  -h, --help             Bu yardım mesajını göster" << std::endl;
     std::cout << std::endl;
     std::cout << "P2P Örnekleri (Eşzamanlı çalıştırın):" << std::endl;
@@ -81,12 +133,43 @@ void printUsage(const char* programName) {
     std::cout << "  ✓ Real-time Voice Processing" << std::endl;
 }
 
+// --sidetone değeri: sayı olmalı ve 0.0-1.0 aralığında kalmalı
+bool parseSidetoneLevel(const char* text, float& level) {
+    try {
+        size_t parsed = 0;
+        float value = std::stof(text, &parsed);
+        if (parsed != std::strlen(text) || !(value >= 0.0f && value <= 1.0f)) {
+            return false;
+        }
+        level = value;
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
 // Sistem başlatma
-bool initializeSystem(const std::string& audioDevice) {
+bool initializeSystem(const std::string& audioDevice, bool useDuplex, bool latencyProbe, bool adaptivePeriod,
+                      float sidetoneLevel) {
     std::cout << "=== Nova Voice Engine V2 Başlatılıyor ===" << std::endl;
     
+    // Profil thread modelini ve periyot uyarlamasını da belirler
+    if (g_profile) {
+        useDuplex = useDuplex || g_profile->duplex;
+        adaptivePeriod = adaptivePeriod || g_profile->adaptivePeriod;
+        
+        LatencyBudget budget = g_profile->estimateBudget(g_profile->designNetwork);
+        std::cout << "✓ Gecikme profili: " << g_profile->name << " (hedef " << g_profile->targetMouthToEarMs
+                  << " ms, bütçe " << budget.totalMs << " ms = yakalama " << budget.captureMs
+                  << " + ağ " << budget.networkMs << " + jitter payı " << budget.playoutMs
+                  << " + çalma " << budget.playbackMs << ")" << std::endl;
+    }
+    
     // Buffer Manager oluştur
     g_bufferManager = std::make_shared<BufferManager>();
+    if (g_profile) {
+        g_bufferManager->setMaxBufferSize(g_profile->maxQueuedPackets);
+    }
     std::cout << "✓ Buffer Manager başlatıldı" << std::endl;
     
     // UDP Manager oluştur
@@ -96,22 +179,66 @@ bool initializeSystem(const std::string& audioDevice) {
     
     // Audio Capture oluştur
     g_audioCapture = std::make_shared<AudioCapture>();
+    if (g_profile) {
+        g_audioCapture->applyProfile(*g_profile);
+    }
     if (!g_audioCapture->initialize(audioDevice)) {
         std::cerr << "✗ Audio Capture başlatılamadı" << std::endl;
         return false;
     }
     g_audioCapture->setBufferManager(g_bufferManager);
+    if (g_stageProfiler) {
+        g_audioCapture->setStageProfiler(g_stageProfiler);
+    }
     std::cout << "✓ Audio Capture başlatıldı" << std::endl;
     
     // Audio Player oluştur
     g_audioPlayer = std::make_shared<AudioPlayer>();
+    if (g_profile) {
+        g_audioPlayer->applyProfile(*g_profile);
+    }
     if (!g_audioPlayer->initialize(audioDevice)) {
         std::cerr << "✗ Audio Player başlatılamadı" << std::endl;
         return false;
     }
     g_audioPlayer->setBufferManager(g_bufferManager);
+    if (g_stageProfiler) {
+        g_audioPlayer->setStageProfiler(g_stageProfiler);
+    }
     std::cout << "✓ Audio Player başlatıldı" << std::endl;
     
+    // PCM tap: yerel mikrofon gain sonrası, uzak akışlar alım sırasında
+    if (g_pcmTap) {
+        g_bufferManager->setPcmTap(g_pcmTap);
+        g_audioCapture->setPcmTap(g_pcmTap, g_udpManager->getLocalStreamId());
+    }
+    
+    // Sidetone: capture -> playback doğrudan yol
+    if (sidetoneLevel > 0.0f) {
+        g_sidetone = std::make_shared<Sidetone>();
+        g_sidetone->setLevel(sidetoneLevel);
+        g_audioCapture->setSidetone(g_sidetone);
+        g_audioPlayer->setSidetone(g_sidetone);
+        std::cout << "✓ Sidetone etkin (seviye: " << g_sidetone->getLevel() << ")" << std::endl;
+    }
+    
+    // Full-duplex: tek thread, bağlı PCM akışları
+    if (useDuplex) {
+        g_audioDuplex = std::make_shared<AudioDuplex>();
+        g_audioDuplex->enableLatencyProbe(latencyProbe);
+        g_audioDuplex->enableAdaptivePeriod(adaptivePeriod);
+        if (g_profile) {
+            g_audioDuplex->setRealtimePriority(g_profile->rtPriority);
+        }
+        if (!g_audioDuplex->initialize(g_audioCapture, g_audioPlayer) || !g_audioDuplex->start()) {
+            std::cerr << "✗ Full-duplex ses akışı başlatılamadı" << std::endl;
+            return false;
+        }
+        
+        std::cout << "✓ Ses sistemi başlatıldı (full-duplex)" << std::endl;
+        return true;
+    }
+    
     // Ses yakalama ve çalmayı başlat
     if (!g_audioCapture->start()) {
         std::cerr << "✗ Audio Capture başlatılamadı" << std::endl;
@@ -131,6 +258,11 @@ bool initializeSystem(const std::string& audioDevice) {
 void shutdownSystem() {
     std::cout << "\n=== Sistem Kapatılıyor ===" << std::endl;
     
+    if (g_audioDuplex) {
+        g_audioDuplex->stop();
+        std::cout << "✓ Full-duplex akış durduruldu" << std::endl;
+    }
+    
     if (g_audioCapture) {
         g_audioCapture->stop();
         std::cout << "✓ Audio Capture durduruldu" << std::endl;
@@ -151,15 +283,146 @@ void shutdownSystem() {
         std::cout << "✓ Buffer Manager temizlendi" << std::endl;
     }
     
+    if (g_stageProfiler && !g_stageCsvPrefix.empty() && g_stageProfiler->exportCsv(g_stageCsvPrefix)) {
+        std::cout << "✓ Aşama ölçümleri yazıldı: " << g_stageCsvPrefix << "_stages.csv, "
+                  << g_stageCsvPrefix << "_histogram.csv" << std::endl;
+    }
+    
+    if (g_statsPublisher) {
+        g_statsPublisher->close();
+    }
+    
+    if (g_pcmTap) {
+        std::cout << "✓ PCM tap kapatıldı (" << g_pcmTap->getWrittenSamples() << " örnek yayınlandı)" << std::endl;
+        g_pcmTap->close();
+    }
+    
+    if (RealtimeCheck::isEnabled()) {
+        std::cout << "Gerçek zamanlı denetim özeti:\n" << RealtimeCheck::formatReport(true);
+    }
+    
     std::cout << "=== Sistem Kapatıldı ===" << std::endl;
 }
 
+// İstatistik sayfasına yayınla (yalnızca getter okur ve kopyalar)
+void publishStatistics() {
+    StatsSnapshot snapshot;
+    std::memset(&snapshot, 0, sizeof(snapshot));
+    
+    if (g_udpManager) {
+        snapshot.sentPackets = g_udpManager->getSentPackets();
+        snapshot.receivedPackets = g_udpManager->getReceivedPackets();
+        snapshot.failedSends = g_udpManager->getFailedSends();
+    }
+    
+    if (g_bufferManager) {
+        snapshot.droppedPackets = g_bufferManager->getDroppedPackets();
+        snapshot.rejectedStreamPackets = g_bufferManager->getRejectedStreamPackets();
+        snapshot.inputQueue = static_cast<uint32_t>(g_bufferManager->getInputBufferSize());
+        snapshot.outputQueue = static_cast<uint32_t>(g_bufferManager->getOutputBufferSize());
+        
+        auto control = g_bufferManager->getLaneStats(PacketLane::CONTROL);
+        auto media = g_bufferManager->getLaneStats(PacketLane::MEDIA);
+        snapshot.controlDequeued = control.dequeued;
+        snapshot.mediaDequeued = media.dequeued;
+        snapshot.controlQueueUs = control.averageQueueTimeUs;
+        snapshot.mediaQueueUs = media.averageQueueTimeUs;
+        
+        auto sessionMemory = MemoryAccounting::getSessionUsage();
+        for (const auto& stream : g_bufferManager->getStreamStats()) {
+            if (snapshot.sessionCount >= Config::MAX_STREAMS) {
+                break;
+            }
+            StatsSession& session = snapshot.sessions[snapshot.sessionCount++];
+            session.streamId = stream.streamId;
+            session.queueDepth = static_cast<uint32_t>(stream.queueDepth);
+            session.packets = stream.packets;
+            session.bytes = stream.bytes;
+            session.lost = stream.lost;
+            session.jitterMs = stream.jitterMs;
+            
+            for (const auto& memory : sessionMemory) {
+                if (memory.sessionId == stream.streamId) {
+                    session.memoryBytes = memory.usage.liveBytes;
+                    session.memoryAllocations = memory.usage.allocations;
+                    break;
+                }
+            }
+        }
+    }
+    
+    if (MemoryAccounting::isCompiledIn()) {
+        for (size_t tag = 0; tag < MemoryAccounting::TAG_COUNT; ++tag) {
+            MemoryUsage usage = MemoryAccounting::getUsage(static_cast<MemoryTag>(tag));
+            StatsMemory& entry = snapshot.memory[snapshot.memoryCount++];
+            std::strncpy(entry.name, MemoryAccounting::tagName(static_cast<MemoryTag>(tag)), sizeof(entry.name) - 1);
+            entry.liveBytes = usage.liveBytes;
+            entry.liveBlocks = usage.liveBlocks;
+            entry.allocations = usage.allocations;
+            entry.allocatedBytes = usage.allocatedBytes;
+            entry.externalBytes = usage.externalBytes;
+        }
+    }
+    
+    if (g_audioCapture) {
+        snapshot.capturedFrames = g_audioCapture->getCapturedFrames();
+        snapshot.captureOverruns = g_audioCapture->getBufferOverruns();
+    }
+    
+    if (g_audioPlayer) {
+        snapshot.playedFrames = g_audioPlayer->getPlayedFrames();
+        snapshot.playbackUnderruns = g_audioPlayer->getBufferUnderruns();
+        snapshot.concealedFrames = g_audioPlayer->getConcealedFrames();
+        
+        const PlayoutController& playout = g_audioPlayer->getPlayout();
+        snapshot.playoutJitterMs = playout.getJitterMs();
+        snapshot.playoutTargetMs = playout.getTargetMs();
+        snapshot.playoutUnderruns = playout.getUnderruns();
+    }
+    
+    if (g_stageProfiler) {
+        for (const auto& stage : g_stageProfiler->getReport()) {
+            if (snapshot.stageCount >= StageProfiler::MAX_STAGES) {
+                break;
+            }
+            StatsStage& entry = snapshot.stages[snapshot.stageCount++];
+            std::strncpy(entry.name, stage.name.c_str(), sizeof(entry.name) - 1);
+            entry.calls = stage.calls;
+            entry.totalNs = static_cast<uint64_t>(stage.meanUs * 1000.0 * stage.calls);
+            entry.p50Us = stage.p50Us;
+            entry.p99Us = stage.p99Us;
+            entry.maxUs = stage.maxUs;
+        }
+    }
+    
+    snapshot.rtViolations = RealtimeCheck::getTotalViolations();
+    g_statsPublisher->publish(snapshot);
+}
+
+// İstenen bellek raporu; hızlar bir önceki rapordan bu yana
+void printMemoryReport() {
+    static MemoryReport previous = MemoryAccounting::snapshot();
+    
+    MemoryReport current = MemoryAccounting::snapshot();
+    std::cout << "\n=== Bellek Raporu ===\n" << MemoryAccounting::formatReport(current, &previous)
+             << "=====================" << std::endl;
+    previous = current;
+}
+
 // İstatistikleri yazdır
 void printStatistics() {
+    MemoryReport lastMemory = MemoryAccounting::snapshot();
+    
     while (g_running) {
-        // 5 saniye bekle ama her 100ms'de g_running kontrol et
+        // 5 saniye bekle ama her 100ms'de g_running kontrol et ve sayfayı yayınla
         for (int i = 0; i < 50 && g_running; ++i) {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            if (g_statsPublisher) {
+                publishStatistics();
+            }
+            if (g_memoryReportRequested.exchange(false)) {
+                printMemoryReport();
+            }
         }
         
         if (!g_running) break;
@@ -169,7 +432,17 @@ void printStatistics() {
         if (g_bufferManager) {
             std::cout << "Buffer - Input: " << g_bufferManager->getInputBufferSize() 
                      << ", Output: " << g_bufferManager->getOutputBufferSize()
-                     << ", Dropped: " << g_bufferManager->getDroppedPackets() << std::endl;
+                     << ", Dropped: " << g_bufferManager->getDroppedPackets()
+                     << ", Streams: " << g_bufferManager->getActiveStreamCount() << std::endl;
+            
+            auto control = g_bufferManager->getLaneStats(PacketLane::CONTROL);
+            auto media = g_bufferManager->getLaneStats(PacketLane::MEDIA);
+            std::cout << "Lanes - Control: " << control.dequeued << " pkt, ort "
+                     << static_cast<int>(control.averageQueueTimeUs) << "us, max "
+                     << static_cast<int>(control.maxQueueTimeUs) << "us"
+                     << " | Media: " << media.dequeued << " pkt, ort "
+                     << static_cast<int>(media.averageQueueTimeUs) << "us, max "
+                     << static_cast<int>(media.maxQueueTimeUs) << "us" << std::endl;
         }
         
         if (g_udpManager) {
@@ -190,24 +463,148 @@ void printStatistics() {
         }
         
         if (g_audioCapture) {
+            XrunStats xrun = g_audioCapture->getXrunStats();
             std::cout << "Audio Capture - Frames: " << g_audioCapture->getCapturedFrames()
-                     << ", Overruns: " << g_audioCapture->getBufferOverruns() << std::endl;
+                     << ", Overruns: " << g_audioCapture->getBufferOverruns();
+            if (g_audioCapture->getTruncatedPeriods() > 0) {
+                std::cout << ", Kesilen periyot: " << g_audioCapture->getTruncatedPeriods();
+            }
+            if (xrun.count > 0) {
+                std::cout << " (kurtarma max " << xrun.maxRecoveryUs << " us, kayıp "
+                         << xrun.lostFrames << " frame)";
+            }
+            std::cout << std::endl;
         }
         
         if (g_audioPlayer) {
+            XrunStats xrun = g_audioPlayer->getXrunStats();
             std::cout << "Audio Player - Frames: " << g_audioPlayer->getPlayedFrames()
-                     << ", Underruns: " << g_audioPlayer->getBufferUnderruns() << std::endl;
+                     << ", Underruns: " << g_audioPlayer->getBufferUnderruns()
+                     << ", Gizlenen: " << g_audioPlayer->getConcealedFrames() << " frame";
+            if (xrun.count > 0) {
+                std::cout << " (kurtarma max " << xrun.maxRecoveryUs << " us, kayıp "
+                         << xrun.lostFrames << " frame)";
+            }
+            std::cout << std::endl;
+        }
+        
+        if (g_audioPlayer) {
+            const PlayoutController& playout = g_audioPlayer->getPlayout();
+            if (playout.getTalkspurts() > 0) {
+                std::cout << "Playout - İlk ses: " << playout.getTimeToFirstAudioMs() << " ms"
+                         << ", Jitter: " << playout.getJitterMs() << " ms"
+                         << ", Hedef: " << playout.getTargetMs() << " ms"
+                         << ", Talkspurt: " << playout.getTalkspurts()
+                         << ", Underrun: " << playout.getUnderruns()
+                         << ", Erken underrun: " << playout.getEarlyUnderruns() << "/" << playout.getEarlyPackets()
+                         << " (%" << playout.getEarlyUnderrunRate() * 100.0 << ")"
+                         << ", Esnetilen: " << playout.getStretchedPackets() << std::endl;
+            }
+        }
+        
+        if (g_sidetone) {
+            std::cout << "Sidetone - Karıştırılan: " << g_sidetone->getMixedFrames()
+                     << " frame, Atılan: " << g_sidetone->getDroppedFrames() << " frame" << std::endl;
+        }
+        
+        if (g_pcmTap) {
+            std::cout << "PCM Tap - Yayınlanan: " << g_pcmTap->getWrittenSamples()
+                     << " örnek, Reddedilen: " << g_pcmTap->getRejectedWrites() << " yazım" << std::endl;
+        }
+        
+        if (g_audioDuplex) {
+            std::cout << "Duplex - " << (g_audioDuplex->isLinked() ? "linked" : "bağlantısız")
+                     << ", Periyot: " << g_audioDuplex->getPeriods()
+                     << ", Uyanma: " << g_audioDuplex->getWakeups()
+                     << ", Hata: " << g_audioDuplex->getErrors()
+                     << ", Periyot boyu: " << g_audioDuplex->getPeriodFrames() << " frame" << std::endl;
+            
+            const PeriodTuner* tuner = g_audioDuplex->getPeriodTuner();
+            if (tuner) {
+                std::cout << "Period Tuner - Geçiş: " << tuner->getSwitches()
+                         << ", Son pencere max gecikme: " << tuner->getLastWindowMaxLateness() << " frame"
+                         << ", xrun: " << tuner->getLastWindowXruns()
+                         << ", Son geçiş süresi: " << g_audioDuplex->getLastSwitchMs() << " ms" << std::endl;
+            }
+            
+            const LatencyProbe* probe = g_audioDuplex->getLatencyProbe();
+            if (probe && probe->getMeasurementCount() > 0) {
+                std::cout << "Latency Probe - Son: " << probe->getLastLatencyMs()
+                         << " ms, Min: " << probe->getMinLatencyMs()
+                         << " ms, Max: " << probe->getMaxLatencyMs()
+                         << " ms, Ölçüm: " << probe->getMeasurementCount()
+                         << ", Kayıp: " << probe->getMissedCount() << std::endl;
+                
+                // Ölçülen döngü, profilin cihaz bütçesiyle (yakalama + çalma) karşılaştırılır
+                if (g_profile) {
+                    double deviceBudget = g_profile->deviceBudgetMs();
+                    std::cout << "Profil " << g_profile->name << " - Cihaz bütçesi: " << deviceBudget
+                             << " ms, ölçülen max: " << probe->getMaxLatencyMs() << " ms "
+                             << (probe->getMaxLatencyMs() <= deviceBudget ? "(karşılandı)" : "(AŞILDI)")
+                             << std::endl;
+                }
+            } else if (probe) {
+                std::cout << "Latency Probe - Darbe yakalanmadı (kayıp: " << probe->getMissedCount()
+                         << ", hoparlör/mikrofon döngüsü gerekli)" << std::endl;
+            }
+        }
+        
+        if (g_stageProfiler) {
+            // Sayaç sütunları "-": sayaçlar kapalı veya perf_event_open kullanılamıyor (yalnızca süre)
+            std::cout << "Aşamalar:\n" << g_stageProfiler->formatReport();
+        }
+        
+        if (RealtimeCheck::isEnabled()) {
+            std::cout << "Gerçek zamanlı ihlal - Ayırma: " << RealtimeCheck::getViolations(RtViolation::ALLOCATION)
+                     << ", Bırakma: " << RealtimeCheck::getViolations(RtViolation::DEALLOCATION)
+                     << ", Mutex: " << RealtimeCheck::getViolations(RtViolation::MUTEX)
+                     << ", Bloklayan: " << RealtimeCheck::getViolations(RtViolation::BLOCKING_CALL)
+                     << ", Farklı yığın: " << RealtimeCheck::getSiteCount() << std::endl;
+        }
+        
+        if (MemoryAccounting::isCompiledIn()) {
+            MemoryReport memory = MemoryAccounting::snapshot();
+            MemoryUsage total;
+            uint64_t previousAllocations = 0;
+            for (size_t tag = 0; tag < MemoryAccounting::TAG_COUNT; ++tag) {
+                total.liveBytes += memory.tags[tag].liveBytes;
+                total.liveBlocks += memory.tags[tag].liveBlocks;
+                total.allocations += memory.tags[tag].allocations;
+                total.externalBytes += memory.tags[tag].externalBytes;
+                previousAllocations += lastMemory.tags[tag].allocations;
+            }
+            double seconds = (memory.timestampNs - lastMemory.timestampNs) / 1e9;
+            std::cout << "Bellek - Canlı: " << total.liveBytes / 1024 << " KB (" << total.liveBlocks << " blok)"
+                     << ", Ayırma: " << static_cast<uint64_t>((total.allocations - previousAllocations) / seconds) << "/s"
+                     << ", Eşlenmiş: " << total.externalBytes / 1024 << " KB"
+                     << ", Oturum: " << memory.sessions.size() << std::endl;
+            lastMemory = memory;
         }
         
         std::cout << "===================" << std::endl;
     }
 }
 
+// Başlangıç çekirdek ayarı: wisdom varsa anlık, yoksa bir kerelik ölçüm
+void runAutotune(const std::string& wisdomPath, bool force) {
+    KernelAutotuner tuner(wisdomPath);
+    tuner.addKernel(QuantizedKernels::makeTunable());
+#ifdef HAVE_LYRA
+    tuner.addKernel(LyraCodec::makeResamplerTunable());
+    tuner.addKernel(BatchDecoder::makeColumnBlockTunable());
+#endif
+
+    tuner.tune(force);
+    std::cout << "✓ Çekirdek seçimi (" << tuner.getCpuModel() << "):" << std::endl;
+    std::cout << tuner.formatReport();
+}
+
 // Ana fonksiyon
 int main(int argc, char* argv[]) {
     // Signal handler ayarla
     signal(SIGINT, signalHandler);
     signal(SIGTERM, signalHandler);
+    signal(SIGUSR1, memoryReportHandler);
     
     // Parametreleri parse et
     bool isServer = false;
@@ -216,6 +613,18 @@ int main(int argc, char* argv[]) {
     uint16_t localPort = Config::DEFAULT_PORT;
     uint16_t remotePort = Config::DEFAULT_PORT;
     std::string audioDevice = "default";
+    bool useDuplex = false;
+    bool latencyProbe = false;
+    bool adaptivePeriod = false;
+    float sidetoneLevel = 0.0f;
+    bool perfCounters = false;
+    bool profileStages = false;
+    bool autotune = true;
+    bool rtCheck = false;
+    bool forceAutotune = false;
+    std::string wisdomPath = KernelAutotuner::defaultWisdomPath();
+    std::string statsPageName = StatsPage::defaultName();
+    std::string pcmTapName;
     
     // P2P modu kontrolü (ilk argüman IP adresi mi?)
     if (argc >= 4 && std::string(argv[1]).find('.') != std::string::npos) {
@@ -242,6 +651,71 @@ int main(int argc, char* argv[]) {
                     return 1;
                 }
                 audioDevice = argv[++i];
+            } else if (arg == "--duplex") {
+                useDuplex = true;
+            } else if (arg == "--latency-probe") {
+                useDuplex = true;
+                latencyProbe = true;
+            } else if (arg == "--adaptive-period") {
+                useDuplex = true;
+                adaptivePeriod = true;
+            } else if (arg == "--sidetone") {
+                if (i + 1 >= argc) {
+                    std::cerr << "Hata: Sidetone seviyesi gerekli" << std::endl;
+                    printUsage(argv[0]);
+                    return 1;
+                }
+                if (!parseSidetoneLevel(argv[++i], sidetoneLevel)) {
+                    std::cerr << "Hata: Sidetone seviyesi 0.0-1.0 arasında bir sayı olmalı: " << argv[i] << std::endl;
+                    printUsage(argv[0]);
+                    return 1;
+                }
+            } else if (arg == "--profile") {
+                if (i + 1 >= argc || !(g_profile = LatencyProfile::find(argv[i + 1]))) {
+                    std::cerr << "Hata: Geçerli bir profil adı gerekli" << std::endl;
+                    printUsage(argv[0]);
+                    return 1;
+                }
+                ++i;
+            } else if (arg == "--perf-counters") {
+                perfCounters = true;
+            } else if (arg == "--profile-stages") {
+                profileStages = true;
+            } else if (arg == "--perf-csv") {
+                if (i + 1 >= argc) {
+                    std::cerr << "Hata: CSV dosya öneki gerekli" << std::endl;
+                    printUsage(argv[0]);
+                    return 1;
+                }
+                perfCounters = true;
+                g_stageCsvPrefix = argv[++i];
+            } else if (arg == "--wisdom") {
+                if (i + 1 >= argc) {
+                    std::cerr << "Hata: Wisdom dosya yolu gerekli" << std::endl;
+                    printUsage(argv[0]);
+                    return 1;
+                }
+                wisdomPath = argv[++i];
+            } else if (arg == "--stats-shm") {
+                if (i + 1 >= argc) {
+                    std::cerr << "Hata: İstatistik sayfası adı gerekli" << std::endl;
+                    printUsage(argv[0]);
+                    return 1;
+                }
+                statsPageName = argv[++i];
+            } else if (arg == "--no-stats-shm") {
+                statsPageName.clear();
+            } else if (arg == "--pcm-tap") {
+                pcmTapName = PcmTap::defaultName();
+                if (i + 1 < argc && argv[i + 1][0] != '-') {
+                    pcmTapName = argv[++i];
+                }
+            } else if (arg == "--rt-check") {
+                rtCheck = true;
+            } else if (arg == "--autotune") {
+                forceAutotune = true;
+            } else if (arg == "--no-autotune") {
+                autotune = false;
             } else if (arg == "-h" || arg == "--help") {
                 printUsage(argv[0]);
                 return 0;
@@ -283,6 +757,71 @@ int main(int argc, char* argv[]) {
                     return 1;
                 }
                 audioDevice = argv[++i];
+            } else if (arg == "--duplex") {
+                useDuplex = true;
+            } else if (arg == "--latency-probe") {
+                useDuplex = true;
+                latencyProbe = true;
+            } else if (arg == "--adaptive-period") {
+                useDuplex = true;
+                adaptivePeriod = true;
+            } else if (arg == "--sidetone") {
+                if (i + 1 >= argc) {
+                    std::cerr << "Hata: Sidetone seviyesi gerekli" << std::endl;
+                    printUsage(argv[0]);
+                    return 1;
+                }
+                if (!parseSidetoneLevel(argv[++i], sidetoneLevel)) {
+                    std::cerr << "Hata: Sidetone seviyesi 0.0-1.0 arasında bir sayı olmalı: " << argv[i] << std::endl;
+                    printUsage(argv[0]);
+                    return 1;
+                }
+            } else if (arg == "--profile") {
+                if (i + 1 >= argc || !(g_profile = LatencyProfile::find(argv[i + 1]))) {
+                    std::cerr << "Hata: Geçerli bir profil adı gerekli" << std::endl;
+                    printUsage(argv[0]);
+                    return 1;
+                }
+                ++i;
+            } else if (arg == "--perf-counters") {
+                perfCounters = true;
+            } else if (arg == "--profile-stages") {
+                profileStages = true;
+            } else if (arg == "--perf-csv") {
+                if (i + 1 >= argc) {
+                    std::cerr << "Hata: CSV dosya öneki gerekli" << std::endl;
+                    printUsage(argv[0]);
+                    return 1;
+                }
+                perfCounters = true;
+                g_stageCsvPrefix = argv[++i];
+            } else if (arg == "--wisdom") {
+                if (i + 1 >= argc) {
+                    std::cerr << "Hata: Wisdom dosya yolu gerekli" << std::endl;
+                    printUsage(argv[0]);
+                    return 1;
+                }
+                wisdomPath = argv[++i];
+            } else if (arg == "--stats-shm") {
+                if (i + 1 >= argc) {
+                    std::cerr << "Hata: İstatistik sayfası adı gerekli" << std::endl;
+                    printUsage(argv[0]);
+                    return 1;
+                }
+                statsPageName = argv[++i];
+            } else if (arg == "--no-stats-shm") {
+                statsPageName.clear();
+            } else if (arg == "--pcm-tap") {
+                pcmTapName = PcmTap::defaultName();
+                if (i + 1 < argc && argv[i + 1][0] != '-') {
+                    pcmTapName = argv[++i];
+                }
+            } else if (arg == "--rt-check") {
+                rtCheck = true;
+            } else if (arg == "--autotune") {
+                forceAutotune = true;
+            } else if (arg == "--no-autotune") {
+                autotune = false;
             } else {
                 std::cerr << "Hata: Bilinmeyen parametre: " << arg << std::endl;
                 printUsage(argv[0]);
@@ -299,8 +838,50 @@ int main(int argc, char* argv[]) {
         }
     }
     
+    // Aşama ölçümü isteğe bağlı (ses thread'lerine periyot başına saat okuması ekler);
+    // donanım sayaçları açılamazsa yalnızca süre histogramı
+    if (perfCounters || profileStages) {
+        g_stageProfiler = std::make_shared<StageProfiler>();
+        g_stageProfiler->setHardwareCounters(perfCounters);
+    }
+    
+    // Canlı istatistik sayfası; aşama tablosu yalnızca ölçüm açıksa dolar
+    if (!statsPageName.empty()) {
+        auto publisher = std::make_shared<StatsPublisher>();
+        if (publisher->open(statsPageName)) {
+            g_statsPublisher = publisher;
+            std::cout << "✓ İstatistik sayfası: " << publisher->getPath() << " (nova_top ile izlenebilir)" << std::endl;
+        }
+    }
+    
+    // Dış dinleyiciler için ses tap'i (ses thread'leri başlamadan bağlanır)
+    if (!pcmTapName.empty()) {
+        auto tap = std::make_shared<PcmTapPublisher>();
+        if (!tap->open(pcmTapName)) {
+            return 1;
+        }
+        g_pcmTap = tap;
+        std::cout << "✓ PCM tap: " << tap->getPath() << " (" << PcmTap::SAMPLE_RATE / 1000
+                  << " kHz, oturum başına ring; nova_tap ile okunabilir)" << std::endl;
+    }
+    
+    // Gerçek zamanlı denetim ses thread'leri başlamadan açılır
+    if (rtCheck) {
+        if (!RealtimeCheck::isCompiledIn()) {
+            std::cerr << "Hata: --rt-check için -DNOVA_RT_CHECK=ON ile derleyin" << std::endl;
+            return 1;
+        }
+        RealtimeCheck::setEnabled(true);
+        std::cout << "✓ Gerçek zamanlı denetim açık (capture, playback, duplex, receive)" << std::endl;
+    }
+    
+    // Ses thread'leri başlamadan: ölçüm gerçek zamanlı yolu etkilemez
+    if (autotune || forceAutotune) {
+        runAutotune(wisdomPath, forceAutotune);
+    }
+    
     // Sistemi başlat
-    if (!initializeSystem(audioDevice)) {
+    if (!initializeSystem(audioDevice, useDuplex, latencyProbe, adaptivePeriod, sidetoneLevel)) {
         std::cerr << "Sistem başlatılamadı!" << std::endl;
         return 1;
     }
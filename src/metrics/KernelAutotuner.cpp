@@ -0,0 +1,328 @@
+#include "KernelAutotuner.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace NovaVoice {
+
+namespace {
+
+// Bir ölçüm turunun en kısa süresi: zamanlayıcı çözünürlüğünün çok üstünde
+constexpr double MIN_ROUND_NS = 1e6;
+constexpr size_t MAX_ITERATIONS = 1 << 16;
+
+std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(begin, end - begin + 1);
+}
+
+double roundNs(const std::function<void()>& run, size_t iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        run();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+} // namespace
+
+KernelAutotuner::KernelAutotuner(const std::string& wisdomPath)
+    : wisdomPath_(wisdomPath)
+    , cpuModel_(detectCpuModel())
+    , rounds_(5)
+    , minGain_(0.03)
+    , calibrated_(false) {
+}
+
+void KernelAutotuner::addKernel(const TunableKernel& kernel) {
+    if (kernel.name.empty() || kernel.candidates.empty() || !kernel.apply || !kernel.run) {
+        logError("Geçersiz çekirdek tanımı: " + kernel.name);
+        return;
+    }
+    kernels_.push_back(kernel);
+}
+
+// === AYAR ===
+
+bool KernelAutotuner::tune(bool forceCalibration) {
+    results_.clear();
+    calibrated_ = false;
+
+    std::map<std::string, Section> sections;
+    bool loaded = loadWisdom(sections);
+    Section& wisdom = sections[cpuModel_];
+    Section measured;
+
+    for (auto& kernel : kernels_) {
+        auto stored = wisdom.find(kernel.name);
+        bool usable = !forceCalibration && stored != wisdom.end() &&
+                      std::find(kernel.candidates.begin(), kernel.candidates.end(), stored->second) !=
+                          kernel.candidates.end();
+
+        if (usable && kernel.apply(stored->second)) {
+            results_.push_back({kernel.name, stored->second, true, {}});
+            continue;
+        }
+
+        TuningResult result = calibrate(kernel);
+        measured[kernel.name] = result.choice;
+        results_.push_back(result);
+        calibrated_ = true;
+    }
+
+    if (!calibrated_) {
+        logInfo("Wisdom yüklendi (" + cpuModel_ + ")");
+        return true;
+    }
+
+    if (!loaded) {
+        logInfo("Wisdom dosyası yok, oluşturuluyor: " + wisdomPath_);
+    }
+    return storeWisdom(measured);
+}
+
+TuningResult KernelAutotuner::calibrate(TunableKernel& kernel) const {
+    TuningResult result;
+    result.name = kernel.name;
+    result.fromWisdom = false;
+
+    double bestNs = 0.0;
+    double defaultNs = 0.0;
+    for (const auto& candidate : kernel.candidates) {
+        if (!kernel.apply(candidate)) {
+            continue;
+        }
+
+        double ns = measureNs(kernel);
+        result.timingsNs.push_back({candidate, ns});
+        if (result.choice.empty()) {
+            // İlk uygulanabilen aday varsayılandır
+            result.choice = candidate;
+            bestNs = defaultNs = ns;
+        } else if (ns < bestNs && ns < defaultNs * (1.0 - minGain_)) {
+            // Ölçüm gürültüsüyle varsayılandan vazgeçilmez
+            result.choice = candidate;
+            bestNs = ns;
+        }
+    }
+
+    if (result.choice.empty()) {
+        result.choice = kernel.candidates.front();
+    }
+    kernel.apply(result.choice);
+    return result;
+}
+
+double KernelAutotuner::measureNs(TunableKernel& kernel) const {
+    // Isınma: önbellekler, tablo kurulumları ve frekans yükselmesi
+    kernel.run();
+
+    size_t iterations = 1;
+    while (iterations < MAX_ITERATIONS && roundNs(kernel.run, iterations) < MIN_ROUND_NS) {
+        iterations *= 2;
+    }
+
+    double best = 0.0;
+    for (size_t round = 0; round < std::max<size_t>(1, rounds_); ++round) {
+        double ns = roundNs(kernel.run, iterations) / static_cast<double>(iterations);
+        if (round == 0 || ns < best) {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+// === WISDOM DOSYASI ===
+
+bool KernelAutotuner::loadWisdom(std::map<std::string, Section>& sections) const {
+    std::ifstream in(wisdomPath_);
+    if (!in) {
+        return false;
+    }
+
+    std::string line;
+    Section* current = nullptr;
+    while (std::getline(in, line)) {
+        line = trim(line);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        if (line.front() == '[' && line.back() == ']') {
+            current = &sections[line.substr(1, line.size() - 2)];
+            continue;
+        }
+
+        size_t separator = line.find('=');
+        if (!current || separator == std::string::npos) {
+            continue;
+        }
+        (*current)[trim(line.substr(0, separator))] = trim(line.substr(separator + 1));
+    }
+
+    return true;
+}
+
+bool KernelAutotuner::storeWisdom(const Section& entries) const {
+    // Oku-değiştir-yaz kilit altında: aynı anda ayarlanan süreçler birbirinin
+    // ölçümlerini silmez, kayıtlar dosyanın o anki haline eklenir. Kilit ayrı
+    // dosyadadır; wisdom dosyası rename ile değiştiği için kendisi kilitlenemez.
+    std::string lockPath = wisdomPath_ + ".lock";
+    int lockFd = ::open(lockPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (lockFd < 0) {
+        logError("Wisdom kilidi açılamadı: " + lockPath + " (" + std::strerror(errno) + ")");
+        return false;
+    }
+
+    while (flock(lockFd, LOCK_EX) != 0) {
+        if (errno != EINTR) {
+            logError("Wisdom kilidi alınamadı: " + lockPath + " (" + std::strerror(errno) + ")");
+            ::close(lockFd);
+            return false;
+        }
+    }
+
+    std::map<std::string, Section> sections;
+    loadWisdom(sections);
+    for (const auto& entry : entries) {
+        sections[cpuModel_][entry.first] = entry.second;
+    }
+    bool saved = saveWisdom(sections);
+
+    flock(lockFd, LOCK_UN);
+    ::close(lockFd);
+    return saved;
+}
+
+bool KernelAutotuner::saveWisdom(const std::map<std::string, Section>& sections) const {
+    // Aynı dosyayı paylaşan süreçler yarım dosya görmez
+    std::string temporary = wisdomPath_ + ".tmp." + std::to_string(getpid());
+    {
+        std::ofstream out(temporary);
+        if (!out) {
+            logError("Wisdom dosyası yazılamadı: " + wisdomPath_);
+            return false;
+        }
+
+        out << "# Nova Voice çekirdek wisdom dosyası (otomatik üretilir, CPU modeli başına bir bölüm)\n";
+        for (const auto& section : sections) {
+            if (section.second.empty()) {
+                continue;
+            }
+            out << "\n[" << section.first << "]\n";
+            for (const auto& entry : section.second) {
+                out << entry.first << '=' << entry.second << '\n';
+            }
+        }
+
+        if (!out) {
+            logError("Wisdom dosyası yazılamadı: " + wisdomPath_);
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+
+    if (std::rename(temporary.c_str(), wisdomPath_.c_str()) != 0) {
+        logError("Wisdom dosyası yerine konamadı: " + wisdomPath_);
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+// === RAPOR ===
+
+std::string KernelAutotuner::formatReport() const {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+
+    for (const auto& result : results_) {
+        out << "  " << std::left << std::setw(20) << result.name << std::right << result.choice;
+        if (result.fromWisdom) {
+            out << " (wisdom)";
+        } else {
+            out << " (";
+            for (size_t i = 0; i < result.timingsNs.size(); ++i) {
+                out << (i > 0 ? ", " : "") << result.timingsNs[i].first << ' ' << result.timingsNs[i].second << " ns";
+            }
+            out << ")";
+        }
+        out << "\n";
+    }
+
+    return out.str();
+}
+
+std::string KernelAutotuner::detectCpuModel() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        // x86: "model name", ARM: "Model" / "Hardware"
+        size_t separator = line.find(':');
+        if (separator == std::string::npos) {
+            continue;
+        }
+        std::string key = trim(line.substr(0, separator));
+        std::string value = trim(line.substr(separator + 1));
+        if (!value.empty() && (key == "model name" || key == "Model" || key == "Hardware")) {
+            return value;
+        }
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int regs[12] = {0};
+    if (__get_cpuid(0x80000002, &regs[0], &regs[1], &regs[2], &regs[3]) &&
+        __get_cpuid(0x80000003, &regs[4], &regs[5], &regs[6], &regs[7]) &&
+        __get_cpuid(0x80000004, &regs[8], &regs[9], &regs[10], &regs[11])) {
+        std::string brand(reinterpret_cast<const char*>(regs), sizeof(regs));
+        brand = trim(brand.c_str());
+        if (!brand.empty()) {
+            return brand;
+        }
+    }
+#endif
+
+    return "unknown";
+}
+
+std::string KernelAutotuner::defaultWisdomPath() {
+    const char* path = std::getenv("NOVA_WISDOM");
+    if (path && *path) {
+        return path;
+    }
+
+    const char* home = std::getenv("HOME");
+    if (home && *home) {
+        return std::string(home) + "/.nova_voice_wisdom";
+    }
+    return ".nova_voice_wisdom";
+}
+
+void KernelAutotuner::logError(const std::string& message) const {
+    std::cerr << "[KernelAutotuner ERROR] " << message << std::endl;
+}
+
+void KernelAutotuner::logInfo(const std::string& message) const {
+    std::cout << "[KernelAutotuner INFO] " << message << std::endl;
+}
+
+} // namespace NovaVoice
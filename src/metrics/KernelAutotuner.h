@@ -0,0 +1,96 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace NovaVoice {
+
+/**
+ * @brief Çalışma zamanında seçilebilen, eşdeğer çıktılı çekirdek ailesi
+ *
+ * Adaylar aynı sonucu üretir, yalnızca hızları CPU'ya göre değişir. İlk
+ * aday varsayılandır; diğerleri onu ancak belirgin farkla geçerse seçilir.
+ * Çekirdeğin sahibi olan modül (QuantizedKernels, LyraCodec, BatchDecoder)
+ * kendi tanımını üretir.
+ */
+struct TunableKernel {
+    std::string name;                               // Wisdom anahtarı (ör. "dot_isa")
+    std::vector<std::string> candidates;            // Bu CPU'da desteklenen adaylar
+    std::function<bool(const std::string&)> apply;  // Adayı etkin yap
+    std::function<void()> run;                      // Sabit frame boyutunda tek ölçüm turu
+};
+
+// Bir çekirdeğin seçimi ve (ölçüldüyse) aday süreleri
+struct TuningResult {
+    std::string name;
+    std::string choice;
+    bool fromWisdom;
+    std::vector<std::pair<std::string, double>> timingsNs;  // Tur başına en iyi süre
+};
+
+/**
+ * @brief Başlangıçta çekirdek seçimi ve CPU modeline göre kalıcı "wisdom"
+ *
+ * tune() önce wisdom dosyasında bu CPU modelinin bölümünü arar; kayıtlı ve
+ * hâlâ desteklenen seçimler ölçümsüz uygulanır. Kaydı olmayan (yeni
+ * eklenmiş ya da bu CPU'da desteklenmeyen) çekirdekler mikro-benchmark ile
+ * ölçülür ve dosya güncellenir, bu yüzden sonraki açılışlar anlıktır.
+ *
+ * Dosya, CPU modeli başına bir bölüm içeren düz metindir:
+ *   [Intel(R) Xeon(R) Gold 6338 CPU @ 2.00GHz]
+ *   dot_isa=AVX2
+ * Filo aynı dosyayı paylaşabilir; diğer CPU'ların bölümleri korunur ve
+ * dosya geçici dosya + rename ile atomik yazılır.
+ */
+class KernelAutotuner {
+public:
+    explicit KernelAutotuner(const std::string& wisdomPath = defaultWisdomPath());
+
+    // === KURULUM ===
+    void addKernel(const TunableKernel& kernel);
+    // Her aday için ölçüm turu sayısı (en iyi tur kullanılır)
+    void setRounds(size_t rounds) { rounds_ = rounds; }
+    // Varsayılanı geçmek için gereken en az hız kazancı (0.03 = %3)
+    void setMinGain(double gain) { minGain_ = gain; }
+
+    // === AYAR ===
+    // Wisdom'u uygula, eksikleri ölç; force ile tüm çekirdekler yeniden ölçülür
+    bool tune(bool forceCalibration = false);
+
+    // === SONUÇ ===
+    const std::vector<TuningResult>& getResults() const { return results_; }
+    bool wasCalibrated() const { return calibrated_; }
+    const std::string& getCpuModel() const { return cpuModel_; }
+    const std::string& getWisdomPath() const { return wisdomPath_; }
+    std::string formatReport() const;
+
+    // /proc/cpuinfo "model name" (yoksa CPUID marka dizgisi)
+    static std::string detectCpuModel();
+    // $NOVA_WISDOM, yoksa $HOME/.nova_voice_wisdom
+    static std::string defaultWisdomPath();
+
+private:
+    std::string wisdomPath_;
+    std::string cpuModel_;
+    std::vector<TunableKernel> kernels_;
+    std::vector<TuningResult> results_;
+    size_t rounds_;
+    double minGain_;
+    bool calibrated_;
+
+    using Section = std::map<std::string, std::string>;
+
+    bool loadWisdom(std::map<std::string, Section>& sections) const;
+    bool saveWisdom(const std::map<std::string, Section>& sections) const;
+    bool storeWisdom(const Section& entries) const;
+    TuningResult calibrate(TunableKernel& kernel) const;
+    double measureNs(TunableKernel& kernel) const;
+
+    void logError(const std::string& message) const;
+    void logInfo(const std::string& message) const;
+};
+
+} // namespace NovaVoice
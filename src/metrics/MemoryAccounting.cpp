@@ -0,0 +1,345 @@
+#include "MemoryAccounting.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+#include <sstream>
+#include <time.h>
+
+namespace NovaVoice {
+namespace MemoryAccounting {
+
+namespace {
+
+// Etiket/yuva başına sayaçlar; thread'ler arası yanlış paylaşım olmasın diye hizalı
+struct alignas(64) Counters {
+    std::atomic<int64_t> liveBytes;
+    std::atomic<int64_t> liveBlocks;
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> allocatedBytes;
+    std::atomic<int64_t> externalBytes;
+};
+
+// sessionId 0 boş yuva demektir
+struct SessionSlot {
+    std::atomic<uint32_t> sessionId;
+    std::atomic<bool> ended;
+    Counters counters;
+};
+
+// Sıfır başlatılır (sabit başlatma): ilk operator new'den önce hazırdır
+Counters g_tags[TAG_COUNT];
+SessionSlot g_sessions[MAX_SESSIONS + 1];   // 0 kullanılmaz
+
+// Son bakılan oturum (alım thread'i her pakette aynı birkaç akışı sorar)
+thread_local uint32_t t_lastSessionId = 0;
+thread_local uint8_t t_lastSlot = 0;
+
+MemoryUsage readCounters(const Counters& counters) {
+    MemoryUsage usage;
+    usage.liveBytes = static_cast<uint64_t>(std::max<int64_t>(0, counters.liveBytes.load(std::memory_order_relaxed)));
+    usage.liveBlocks = static_cast<uint64_t>(std::max<int64_t>(0, counters.liveBlocks.load(std::memory_order_relaxed)));
+    usage.allocations = counters.allocations.load(std::memory_order_relaxed);
+    usage.allocatedBytes = counters.allocatedBytes.load(std::memory_order_relaxed);
+    usage.externalBytes = static_cast<uint64_t>(std::max<int64_t>(0, counters.externalBytes.load(std::memory_order_relaxed)));
+    return usage;
+}
+
+void resetCounters(Counters& counters) {
+    counters.liveBytes.store(0, std::memory_order_relaxed);
+    counters.liveBlocks.store(0, std::memory_order_relaxed);
+    counters.allocations.store(0, std::memory_order_relaxed);
+    counters.allocatedBytes.store(0, std::memory_order_relaxed);
+    counters.externalBytes.store(0, std::memory_order_relaxed);
+}
+
+uint64_t monotonicNs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+double rate(uint64_t current, uint64_t previous, double seconds) {
+    return seconds > 0.0 && current >= previous ? (current - previous) / seconds : 0.0;
+}
+
+} // namespace
+
+bool isCompiledIn() {
+#ifdef NOVA_MEM_ACCOUNTING
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char* tagName(MemoryTag tag) {
+    switch (tag) {
+        case MemoryTag::UNTAGGED: return "etiketsiz";
+        case MemoryTag::PACKETS: return "paketler";
+        case MemoryTag::JITTER_BUFFER: return "jitter buffer";
+        case MemoryTag::NETWORK: return "ağ";
+        case MemoryTag::AUDIO_IO: return "ses G/Ç";
+        case MemoryTag::CODEC: return "codec";
+        case MemoryTag::DENOISER: return "gürültü bastırma";
+        case MemoryTag::MODEL: return "model";
+        default: return "bilinmeyen";
+    }
+}
+
+// === SORGULAR ===
+
+MemoryUsage getUsage(MemoryTag tag) {
+    if (tag >= MemoryTag::COUNT) {
+        return MemoryUsage();
+    }
+    return readCounters(g_tags[static_cast<size_t>(tag)]);
+}
+
+MemoryUsage getTotalUsage() {
+    MemoryUsage total;
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        MemoryUsage usage = readCounters(g_tags[i]);
+        total.liveBytes += usage.liveBytes;
+        total.liveBlocks += usage.liveBlocks;
+        total.allocations += usage.allocations;
+        total.allocatedBytes += usage.allocatedBytes;
+        total.externalBytes += usage.externalBytes;
+    }
+    return total;
+}
+
+std::vector<SessionMemoryUsage> getSessionUsage() {
+    std::vector<SessionMemoryUsage> sessions;
+    for (size_t slot = 1; slot <= MAX_SESSIONS; ++slot) {
+        uint32_t sessionId = g_sessions[slot].sessionId.load(std::memory_order_acquire);
+        if (sessionId == 0) {
+            continue;
+        }
+        SessionMemoryUsage session;
+        session.sessionId = sessionId;
+        session.ended = g_sessions[slot].ended.load(std::memory_order_relaxed);
+        session.usage = readCounters(g_sessions[slot].counters);
+        sessions.push_back(session);
+    }
+    return sessions;
+}
+
+MemoryReport snapshot() {
+    MemoryReport report;
+    report.timestampNs = monotonicNs();
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        report.tags[i] = readCounters(g_tags[i]);
+    }
+    report.sessions = getSessionUsage();
+    return report;
+}
+
+std::string formatReport(const MemoryReport& current, const MemoryReport* previous) {
+    double seconds = previous && current.timestampNs > previous->timestampNs
+                         ? (current.timestampNs - previous->timestampNs) / 1e9
+                         : 0.0;
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    if (!isCompiledIn()) {
+        out << "  (bellek muhasebesi derlenmemiş: -DNOVA_MEM_ACCOUNTING=ON)\n";
+        return out.str();
+    }
+
+    MemoryUsage total;
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        const MemoryUsage& usage = current.tags[i];
+        if (usage.allocations == 0 && usage.externalBytes == 0) {
+            continue;
+        }
+        total.liveBytes += usage.liveBytes;
+        total.externalBytes += usage.externalBytes;
+
+        out << "  " << tagName(static_cast<MemoryTag>(i)) << ": " << usage.liveBytes / 1024.0 << " KB canlı ("
+            << usage.liveBlocks << " blok)";
+        if (usage.externalBytes > 0) {
+            out << " + " << usage.externalBytes / 1024.0 << " KB eşlenmiş";
+        }
+        if (previous) {
+            const MemoryUsage& before = previous->tags[i];
+            out << ", " << rate(usage.allocations, before.allocations, seconds) << " ayırma/s, "
+                << rate(usage.allocatedBytes, before.allocatedBytes, seconds) / 1024.0 << " KB/s";
+        } else {
+            out << ", toplam " << usage.allocations << " ayırma";
+        }
+        out << "\n";
+    }
+    out << "  toplam: " << total.liveBytes / 1024.0 << " KB heap + " << total.externalBytes / 1024.0
+        << " KB eşlenmiş\n";
+
+    for (const auto& session : current.sessions) {
+        out << "  oturum " << session.sessionId << ": " << session.usage.liveBytes / 1024.0 << " KB canlı ("
+            << session.usage.liveBlocks << " blok)";
+        if (previous) {
+            auto before = std::find_if(previous->sessions.begin(), previous->sessions.end(),
+                                       [&](const SessionMemoryUsage& s) { return s.sessionId == session.sessionId; });
+            if (before != previous->sessions.end()) {
+                out << ", " << rate(session.usage.allocations, before->usage.allocations, seconds) << " ayırma/s";
+            }
+        }
+        out << (session.ended ? " [bitti]" : "") << "\n";
+    }
+    return out.str();
+}
+
+// === OTURUMLAR ===
+
+uint8_t sessionSlot(uint32_t sessionId) {
+    if (sessionId == 0) {
+        return 0;
+    }
+    if (t_lastSessionId == sessionId &&
+        g_sessions[t_lastSlot].sessionId.load(std::memory_order_relaxed) == sessionId) {
+        return t_lastSlot;
+    }
+
+    uint8_t found = 0;
+    for (size_t slot = 1; slot <= MAX_SESSIONS && found == 0; ++slot) {
+        if (g_sessions[slot].sessionId.load(std::memory_order_acquire) == sessionId) {
+            found = static_cast<uint8_t>(slot);
+        }
+    }
+
+    // Yeni oturum: boş yuva, yoksa belleği tamamen bırakılmış biten oturumun yuvası
+    for (size_t slot = 1; slot <= MAX_SESSIONS && found == 0; ++slot) {
+        SessionSlot& candidate = g_sessions[slot];
+        uint32_t current = candidate.sessionId.load(std::memory_order_acquire);
+        bool reusable = current == 0 ||
+                        (candidate.ended.load(std::memory_order_relaxed) &&
+                         candidate.counters.liveBlocks.load(std::memory_order_relaxed) == 0);
+        if (reusable && candidate.sessionId.compare_exchange_strong(current, sessionId)) {
+            resetCounters(candidate.counters);
+            found = static_cast<uint8_t>(slot);
+        }
+    }
+
+    if (found != 0) {
+        g_sessions[found].ended.store(false, std::memory_order_relaxed);
+        t_lastSessionId = sessionId;
+        t_lastSlot = found;
+    }
+    return found;
+}
+
+void endSession(uint32_t sessionId) {
+    for (size_t slot = 1; slot <= MAX_SESSIONS; ++slot) {
+        if (g_sessions[slot].sessionId.load(std::memory_order_acquire) == sessionId) {
+            g_sessions[slot].ended.store(true, std::memory_order_relaxed);
+        }
+    }
+}
+
+void addExternal(MemoryTag tag, int64_t bytes) {
+    if (tag < MemoryTag::COUNT) {
+        g_tags[static_cast<size_t>(tag)].externalBytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+// === KANCALAR ===
+
+void recordAllocation(uint8_t tag, uint8_t session, size_t bytes) {
+    Counters& counters = g_tags[tag < TAG_COUNT ? tag : 0];
+    counters.liveBytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+    counters.liveBlocks.fetch_add(1, std::memory_order_relaxed);
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.allocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    if (session != 0 && session <= MAX_SESSIONS) {
+        Counters& owner = g_sessions[session].counters;
+        owner.liveBytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+        owner.liveBlocks.fetch_add(1, std::memory_order_relaxed);
+        owner.allocations.fetch_add(1, std::memory_order_relaxed);
+        owner.allocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+void recordRelease(uint8_t tag, uint8_t session, size_t bytes) {
+    Counters& counters = g_tags[tag < TAG_COUNT ? tag : 0];
+    counters.liveBytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+    counters.liveBlocks.fetch_sub(1, std::memory_order_relaxed);
+
+    if (session != 0 && session <= MAX_SESSIONS) {
+        Counters& owner = g_sessions[session].counters;
+        owner.liveBytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+        owner.liveBlocks.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace MemoryAccounting
+} // namespace NovaVoice
+
+// === OPERATOR NEW/DELETE (yalnızca NOVA_MEM_ACCOUNTING) ===
+// Çalıştırılabilir içinde tanımlanır; paylaşımlı kütüphanelerin (libstdc++)
+// ayırmaları da buraya düşer. Hizalı (align_val_t) sürümler değiştirilmez,
+// onların ayırmaları sayılmaz.
+
+#ifdef NOVA_MEM_ACCOUNTING
+
+namespace {
+
+// malloc hizasını (16) korur
+struct alignas(16) BlockHeader {
+    uint64_t size;
+    uint8_t tag;
+    uint8_t session;
+};
+
+static_assert(sizeof(BlockHeader) == 16, "BlockHeader 16 bayt olmalı");
+
+void* accountedAllocate(size_t size) noexcept {
+    void* memory = std::malloc(sizeof(BlockHeader) + size);
+    if (!memory) {
+        return nullptr;
+    }
+    const NovaVoice::MemoryAccounting::ThreadState state = NovaVoice::MemoryAccounting::t_state;
+    BlockHeader* header = static_cast<BlockHeader*>(memory);
+    header->size = size;
+    header->tag = state.tag;
+    header->session = state.session;
+    NovaVoice::MemoryAccounting::recordAllocation(state.tag, state.session, size);
+    return header + 1;
+}
+
+void* accountedAllocateOrThrow(size_t size) {
+    void* memory = accountedAllocate(size);
+    while (!memory) {
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+        memory = accountedAllocate(size);
+    }
+    return memory;
+}
+
+void accountedFree(void* pointer) noexcept {
+    if (!pointer) {
+        return;
+    }
+    BlockHeader* header = static_cast<BlockHeader*>(pointer) - 1;
+    NovaVoice::MemoryAccounting::recordRelease(header->tag, header->session, header->size);
+    std::free(header);
+}
+
+} // namespace
+
+void* operator new(size_t size) { return accountedAllocateOrThrow(size); }
+void* operator new[](size_t size) { return accountedAllocateOrThrow(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return accountedAllocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return accountedAllocate(size); }
+
+void operator delete(void* pointer) noexcept { accountedFree(pointer); }
+void operator delete[](void* pointer) noexcept { accountedFree(pointer); }
+void operator delete(void* pointer, size_t) noexcept { accountedFree(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { accountedFree(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { accountedFree(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { accountedFree(pointer); }
+
+#endif // NOVA_MEM_ACCOUNTING
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Config.h"
+
+namespace NovaVoice {
+
+// Bellek sahibi alt sistem (ayırma anındaki en içteki MemoryScope)
+enum class MemoryTag : uint8_t {
+    UNTAGGED = 0,
+    PACKETS,            // AudioPacket ve payload'ı
+    JITTER_BUFFER,      // Giriş/çıkış kuyrukları ve akış başına playout ring'leri
+    NETWORK,            // Soket gönderim/alım tamponları
+    AUDIO_IO,           // ALSA periyot, gizleme ve esnetme tamponları
+    CODEC,              // Lyra, toplu decoder, yeniden örnekleme tabloları
+    DENOISER,           // Gürültü bastırma durumu ve geçmişleri
+    MODEL,              // Model ağırlıkları (mmap heap dışı sayılır)
+    COUNT
+};
+
+struct MemoryUsage {
+    uint64_t liveBytes;
+    uint64_t liveBlocks;
+    uint64_t allocations;       // Başlangıçtan beri (hız = fark / süre)
+    uint64_t allocatedBytes;    // Başlangıçtan beri
+    uint64_t externalBytes;     // Heap dışı (mmap) canlı bayt
+
+    MemoryUsage() : liveBytes(0), liveBlocks(0), allocations(0), allocatedBytes(0), externalBytes(0) {}
+};
+
+struct SessionMemoryUsage {
+    uint32_t sessionId;
+    bool ended;                 // Oturum bitti, belleği henüz bırakılmadı
+    MemoryUsage usage;
+};
+
+struct MemoryReport {
+    uint64_t timestampNs;       // CLOCK_MONOTONIC
+    MemoryUsage tags[static_cast<size_t>(MemoryTag::COUNT)];
+    std::vector<SessionMemoryUsage> sessions;
+
+    MemoryReport() : timestampNs(0) {}
+};
+
+/**
+ * @brief Alt sistem ve oturum başına bellek muhasebesi
+ *
+ * NOVA_MEM_ACCOUNTING ile derlendiğinde global operator new/delete
+ * çalıştırılabilir içinde değiştirilir: her bloğun önüne 16 baytlık bir
+ * başlık (boyut, etiket, oturum yuvası) konur ve etiket başına canlı bayt,
+ * canlı blok ve birikimli ayırma sayaçları relaxed atomic ile güncellenir.
+ * Etiket, çağıran thread'in en içteki MemoryScope'undan okunur; blok
+ * bırakılırken başlıktaki etikete yazılır, bu yüzden başka bir thread'de
+ * silinen paket de doğru alt sistemden düşer. Oturum (uzak akış kimliği)
+ * yuvaları sabit bir tablodadır; biten oturumun yuvası belleği sıfıra
+ * inince yeniden kullanılır. mmap edilen model ağırlıkları addExternal
+ * ile heap dışı olarak sayılır.
+ *
+ * Bayrak olmadan kancalar derlenmez; kapsamlar yalnızca thread-local bir
+ * baytı değiştirir ve raporlar sıfır döner.
+ */
+namespace MemoryAccounting {
+
+constexpr size_t TAG_COUNT = static_cast<size_t>(MemoryTag::COUNT);
+constexpr size_t MAX_SESSIONS = Config::MAX_STREAMS;
+
+// Kancaların okuduğu thread durumu (statik TLS, bellek ayırmaz)
+struct ThreadState {
+    uint8_t tag;
+    uint8_t session;    // 0 = oturumsuz, 1..MAX_SESSIONS yuva
+};
+
+inline thread_local ThreadState t_state = {0, 0};
+
+bool isCompiledIn();
+const char* tagName(MemoryTag tag);
+
+// === SORGULAR ===
+MemoryUsage getUsage(MemoryTag tag);
+MemoryUsage getTotalUsage();
+std::vector<SessionMemoryUsage> getSessionUsage();
+MemoryReport snapshot();
+// previous verilirse ayırma hızları iki rapor arasındaki farktan yazılır
+std::string formatReport(const MemoryReport& current, const MemoryReport* previous = nullptr);
+
+// === OTURUMLAR ===
+// Oturumun yuvası (yoksa açılır); tablo doluysa 0
+uint8_t sessionSlot(uint32_t sessionId);
+void endSession(uint32_t sessionId);
+
+// Heap dışı bellek (mmap): eşlemede +, bırakmada -
+void addExternal(MemoryTag tag, int64_t bytes);
+
+// Kancalar tarafından çağrılır
+void recordAllocation(uint8_t tag, uint8_t session, size_t bytes);
+void recordRelease(uint8_t tag, uint8_t session, size_t bytes);
+
+} // namespace MemoryAccounting
+
+// Kapsam boyunca yapılan ayırmaları alt sisteme (ve oturuma) yazar; iç içe olabilir
+class MemoryScope {
+public:
+    explicit MemoryScope(MemoryTag tag)
+        : previous_(MemoryAccounting::t_state) {
+        MemoryAccounting::t_state.tag = static_cast<uint8_t>(tag);
+    }
+
+    MemoryScope(MemoryTag tag, uint32_t sessionId)
+        : previous_(MemoryAccounting::t_state) {
+        MemoryAccounting::t_state.tag = static_cast<uint8_t>(tag);
+        MemoryAccounting::t_state.session = MemoryAccounting::sessionSlot(sessionId);
+    }
+
+    ~MemoryScope() {
+        MemoryAccounting::t_state = previous_;
+    }
+
+    MemoryScope(const MemoryScope&) = delete;
+    MemoryScope& operator=(const MemoryScope&) = delete;
+
+private:
+    MemoryAccounting::ThreadState previous_;
+};
+
+} // namespace NovaVoice
@@ -0,0 +1,123 @@
+#include "PerfCounters.h"
+#include "RealtimeCheck.h"
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+
+namespace NovaVoice {
+
+namespace {
+
+constexpr size_t EVENT_COUNT = static_cast<size_t>(PerfEvent::COUNT);
+
+const uint64_t EVENT_CONFIGS[EVENT_COUNT] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES
+};
+
+int openEvent(uint64_t config, int groupFd) {
+    struct perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = groupFd < 0 ? 1 : 0;  // Grup lideri açıkça etkinleştirilir
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC));
+}
+
+} // namespace
+
+PerfCounters::PerfCounters()
+    : leaderFd_(-1)
+    , openCount_(0) {
+    for (size_t i = 0; i < EVENT_COUNT; ++i) {
+        fds_[i] = -1;
+        slots_[i] = 0;
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    close();
+}
+
+bool PerfCounters::open() {
+    if (isOpen()) {
+        return true;
+    }
+
+    // İlk açılabilen olay grup lideri olur
+    for (size_t i = 0; i < EVENT_COUNT; ++i) {
+        int fd = openEvent(EVENT_CONFIGS[i], leaderFd_);
+        if (fd < 0) {
+            continue;
+        }
+
+        if (leaderFd_ < 0) {
+            leaderFd_ = fd;
+        }
+        fds_[i] = fd;
+        slots_[i] = openCount_++;
+    }
+
+    if (leaderFd_ < 0) {
+        return false;
+    }
+
+    ioctl(leaderFd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leaderFd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+}
+
+void PerfCounters::close() {
+    for (size_t i = 0; i < EVENT_COUNT; ++i) {
+        if (fds_[i] >= 0) {
+            ::close(fds_[i]);
+            fds_[i] = -1;
+        }
+    }
+
+    leaderFd_ = -1;
+    openCount_ = 0;
+}
+
+bool PerfCounters::read(PerfSample& sample) const {
+    if (!isOpen()) {
+        return false;
+    }
+
+    // PERF_FORMAT_GROUP: { nr, değerler[nr] }; ölçümün kendi read()'i denetim dışı
+    uint64_t buffer[1 + EVENT_COUNT];
+    ssize_t bytes;
+    {
+        BlockingSection measurement;
+        bytes = ::read(leaderFd_, buffer, sizeof(buffer));
+    }
+    if (bytes < static_cast<ssize_t>(sizeof(uint64_t) * (1 + openCount_))) {
+        return false;
+    }
+
+    for (size_t i = 0; i < EVENT_COUNT; ++i) {
+        sample.values[i] = fds_[i] >= 0 ? buffer[1 + slots_[i]] : 0;
+    }
+    return true;
+}
+
+const char* PerfCounters::eventName(PerfEvent event) {
+    switch (event) {
+        case PerfEvent::CYCLES: return "cycles";
+        case PerfEvent::INSTRUCTIONS: return "instructions";
+        case PerfEvent::LLC_MISSES: return "llc_misses";
+        case PerfEvent::BRANCH_MISSES: return "branch_misses";
+        default: return "unknown";
+    }
+}
+
+} // namespace NovaVoice
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace NovaVoice {
+
+// Donanım sayaçları (açılamayanlar 0 kalır)
+enum class PerfEvent : size_t {
+    CYCLES = 0,
+    INSTRUCTIONS,
+    LLC_MISSES,
+    BRANCH_MISSES,
+    COUNT
+};
+
+struct PerfSample {
+    uint64_t values[static_cast<size_t>(PerfEvent::COUNT)];
+
+    PerfSample() : values{0, 0, 0, 0} {}
+    uint64_t operator[](PerfEvent event) const { return values[static_cast<size_t>(event)]; }
+};
+
+/**
+ * @brief Çağıran thread için perf_event_open sayaç grubu
+ *
+ * Cycles, instructions, LLC miss ve branch miss tek grupta açılır ve tek
+ * read() ile birlikte okunur; yalnızca kullanıcı alanı sayılır
+ * (perf_event_paranoid <= 2 yeterli). Sayaçlar açan thread'e bağlıdır,
+ * bu yüzden ölçülecek ses thread'inde açılmalıdır. Desteklenmeyen olaylar
+ * (sanal makine, container) atlanır; hiçbiri açılamazsa isOpen() false
+ * döner ve ölçüm yalnızca duvar saatiyle yapılır.
+ */
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool open();
+    void close();
+    bool isOpen() const { return leaderFd_ >= 0; }
+    bool isAvailable(PerfEvent event) const { return fds_[static_cast<size_t>(event)] >= 0; }
+
+    // Açılıştan bu yana birikmiş değerler
+    bool read(PerfSample& sample) const;
+
+    static const char* eventName(PerfEvent event);
+
+private:
+    int leaderFd_;
+    int fds_[static_cast<size_t>(PerfEvent::COUNT)];
+    size_t slots_[static_cast<size_t>(PerfEvent::COUNT)];  // Grup okumasındaki sıra
+    size_t openCount_;
+};
+
+} // namespace NovaVoice
@@ -0,0 +1,330 @@
+#include "QualityMetrics.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+namespace NovaVoice {
+namespace QualityMetrics {
+
+namespace {
+
+constexpr double SILENCE_RANGE_DB = 40.0;   // En gürültülü frame'e göre sessizlik eşiği
+constexpr double SEGSNR_MIN_DB = -10.0;
+constexpr double SEGSNR_MAX_DB = 35.0;
+constexpr double PI = 3.14159265358979323846;
+
+// MOS kalibrasyonu (-26 dBov seviye hizalı sinyalde): beyaz gürültü
+// 30/20/10 dB SNR ~4.2/3.4/2.0, rastgele %1/%5/%20 kayıp + PLC ~4.3/3.5/2.7
+constexpr double HEARING_THRESHOLD = 1e-5;  // Bant gücü, ses yüksekliği sıfır noktası
+constexpr double LOUDNESS_SCALE = 0.05;     // Bant başına ses yüksekliği ölçeği
+
+size_t fftSizeFor(uint32_t sampleRate) {
+    // ~32 ms pencere, ikinin kuvveti
+    size_t target = static_cast<size_t>(sampleRate * 0.032);
+    size_t size = 64;
+    while (size < target) {
+        size <<= 1;
+    }
+    return size;
+}
+
+void fft(std::vector<std::complex<double>>& data) {
+    size_t n = data.size();
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+
+    for (size_t length = 2; length <= n; length <<= 1) {
+        double angle = -2.0 * PI / static_cast<double>(length);
+        std::complex<double> step(std::cos(angle), std::sin(angle));
+        for (size_t i = 0; i < n; i += length) {
+            std::complex<double> w(1.0, 0.0);
+            for (size_t k = 0; k < length / 2; ++k) {
+                std::complex<double> even = data[i + k];
+                std::complex<double> odd = data[i + k + length / 2] * w;
+                data[i + k] = even + odd;
+                data[i + k + length / 2] = even - odd;
+                w *= step;
+            }
+        }
+    }
+}
+
+// Hann pencereli kısa zamanlı güç spektrumları (frame x bin), yarım örtüşme
+std::vector<std::vector<double>> powerSpectra(const int16_t* samples, size_t count, size_t fftSize, double gain) {
+    std::vector<std::vector<double>> spectra;
+    if (count < fftSize) {
+        return spectra;
+    }
+
+    std::vector<double> window(fftSize);
+    for (size_t i = 0; i < fftSize; ++i) {
+        window[i] = 0.5 - 0.5 * std::cos(2.0 * PI * i / static_cast<double>(fftSize));
+    }
+
+    std::vector<std::complex<double>> buffer(fftSize);
+    size_t hop = fftSize / 2;
+    for (size_t start = 0; start + fftSize <= count; start += hop) {
+        for (size_t i = 0; i < fftSize; ++i) {
+            buffer[i] = std::complex<double>(samples[start + i] * gain / 32768.0 * window[i], 0.0);
+        }
+        fft(buffer);
+
+        std::vector<double> power(fftSize / 2 + 1);
+        for (size_t k = 0; k < power.size(); ++k) {
+            power[k] = std::norm(buffer[k]);
+        }
+        spectra.push_back(std::move(power));
+    }
+
+    return spectra;
+}
+
+std::vector<bool> activeFrames(const std::vector<double>& energies) {
+    double loudest = energies.empty() ? 0.0 : *std::max_element(energies.begin(), energies.end());
+    double threshold = loudest * std::pow(10.0, -SILENCE_RANGE_DB / 10.0);
+
+    std::vector<bool> active(energies.size());
+    for (size_t i = 0; i < energies.size(); ++i) {
+        active[i] = loudest > 0.0 && energies[i] > threshold;
+    }
+    return active;
+}
+
+double bark(double hz) {
+    return 13.0 * std::atan(0.00076 * hz) + 3.5 * std::atan((hz / 7500.0) * (hz / 7500.0));
+}
+
+double activeRms(const int16_t* samples, size_t count, size_t frameSize) {
+    std::vector<double> energies;
+    for (size_t start = 0; start + frameSize <= count; start += frameSize) {
+        double energy = 0.0;
+        for (size_t i = 0; i < frameSize; ++i) {
+            double value = samples[start + i] / 32768.0;
+            energy += value * value;
+        }
+        energies.push_back(energy);
+    }
+
+    std::vector<bool> active = activeFrames(energies);
+    double sum = 0.0;
+    size_t frames = 0;
+    for (size_t i = 0; i < energies.size(); ++i) {
+        if (active[i]) {
+            sum += energies[i];
+            frames++;
+        }
+    }
+    return frames > 0 ? std::sqrt(sum / static_cast<double>(frames * frameSize)) : 0.0;
+}
+
+} // namespace
+
+double segmentalSnr(const int16_t* reference, const int16_t* degraded, size_t samples, uint32_t sampleRate) {
+    size_t frameSize = std::max<size_t>(1, sampleRate / 50);   // 20 ms
+    std::vector<double> signal;
+    std::vector<double> noise;
+
+    for (size_t start = 0; start + frameSize <= samples; start += frameSize) {
+        double s = 0.0;
+        double n = 0.0;
+        for (size_t i = start; i < start + frameSize; ++i) {
+            double ref = reference[i];
+            double diff = ref - degraded[i];
+            s += ref * ref;
+            n += diff * diff;
+        }
+        signal.push_back(s);
+        noise.push_back(n);
+    }
+
+    std::vector<bool> active = activeFrames(signal);
+    double sum = 0.0;
+    size_t frames = 0;
+    for (size_t i = 0; i < signal.size(); ++i) {
+        if (!active[i]) {
+            continue;
+        }
+        double snr = noise[i] > 0.0 ? 10.0 * std::log10(signal[i] / noise[i]) : SEGSNR_MAX_DB;
+        sum += std::max(SEGSNR_MIN_DB, std::min(SEGSNR_MAX_DB, snr));
+        frames++;
+    }
+
+    return frames > 0 ? sum / static_cast<double>(frames) : 0.0;
+}
+
+double logSpectralDistance(const int16_t* reference, const int16_t* degraded, size_t samples, uint32_t sampleRate) {
+    size_t fftSize = fftSizeFor(sampleRate);
+    auto refSpectra = powerSpectra(reference, samples, fftSize, 1.0);
+    auto degSpectra = powerSpectra(degraded, samples, fftSize, 1.0);
+
+    std::vector<double> energies;
+    for (const auto& spectrum : refSpectra) {
+        double energy = 0.0;
+        for (double value : spectrum) {
+            energy += value;
+        }
+        energies.push_back(energy);
+    }
+    std::vector<bool> active = activeFrames(energies);
+
+    double sum = 0.0;
+    size_t frames = 0;
+    for (size_t f = 0; f < refSpectra.size(); ++f) {
+        if (!active[f]) {
+            continue;
+        }
+
+        // Spektrum tabanı frame ortalamasının 40 dB altı: boş bin'ler mesafeyi şişirmez
+        double floor = std::max(1e-12, energies[f] / static_cast<double>(refSpectra[f].size()) * 1e-4);
+        double distance = 0.0;
+        for (size_t k = 0; k < refSpectra[f].size(); ++k) {
+            double ratio = 10.0 * std::log10((refSpectra[f][k] + floor) / (degSpectra[f][k] + floor));
+            distance += ratio * ratio;
+        }
+        sum += std::sqrt(distance / static_cast<double>(refSpectra[f].size()));
+        frames++;
+    }
+
+    return frames > 0 ? sum / static_cast<double>(frames) : 0.0;
+}
+
+double estimateMos(const int16_t* reference, const int16_t* degraded, size_t samples, uint32_t sampleRate) {
+    size_t fftSize = fftSizeFor(sampleRate);
+
+    // Seviye hizalama: iki sinyalin aktif RMS'i -26 dBov'a getirilir
+    const double targetRms = 0.05;
+    double refRms = activeRms(reference, samples, fftSize);
+    double degRms = activeRms(degraded, samples, fftSize);
+    if (refRms <= 0.0) {
+        return 1.0;
+    }
+    double refGain = targetRms / refRms;
+    double degGain = degRms > 0.0 ? targetRms / degRms : 1.0;
+
+    auto refSpectra = powerSpectra(reference, samples, fftSize, refGain);
+    auto degSpectra = powerSpectra(degraded, samples, fftSize, degGain);
+    if (refSpectra.empty()) {
+        return 1.0;
+    }
+
+    // 1 Bark genişliğinde bantlar (100 Hz - Nyquist)
+    size_t bins = refSpectra[0].size();
+    double binHz = static_cast<double>(sampleRate) / static_cast<double>(fftSize);
+    std::vector<int> bandOf(bins, -1);
+    int bands = 0;
+    for (size_t k = 0; k < bins; ++k) {
+        double hz = k * binHz;
+        if (hz < 100.0) {
+            continue;
+        }
+        bandOf[k] = static_cast<int>(bark(hz) - bark(100.0));
+        bands = std::max(bands, bandOf[k] + 1);
+    }
+
+    // Zwicker ses yüksekliği: duyma eşiğine göre 0.23 üssü
+    const double hearingThreshold = HEARING_THRESHOLD;
+    auto loudness = [&](double power) {
+        double ratio = power / hearingThreshold;
+        return ratio > 1.0 ? LOUDNESS_SCALE * (std::pow(0.5 + 0.5 * ratio, 0.23) - 1.0) : 0.0;
+    };
+
+    std::vector<double> frameEnergy;
+    for (const auto& spectrum : refSpectra) {
+        double energy = 0.0;
+        for (double value : spectrum) {
+            energy += value;
+        }
+        frameEnergy.push_back(energy);
+    }
+    std::vector<bool> active = activeFrames(frameEnergy);
+
+    std::vector<double> symmetric;
+    std::vector<double> asymmetric;
+    std::vector<double> refBand(bands);
+    std::vector<double> degBand(bands);
+
+    for (size_t f = 0; f < refSpectra.size(); ++f) {
+        if (!active[f]) {
+            continue;
+        }
+
+        std::fill(refBand.begin(), refBand.end(), 0.0);
+        std::fill(degBand.begin(), degBand.end(), 0.0);
+        for (size_t k = 0; k < bins; ++k) {
+            if (bandOf[k] >= 0) {
+                refBand[bandOf[k]] += refSpectra[f][k];
+                degBand[bandOf[k]] += degSpectra[f][k];
+            }
+        }
+
+        double symSum = 0.0;
+        double asymSum = 0.0;
+        for (int b = 0; b < bands; ++b) {
+            double refLoud = loudness(refBand[b]);
+            double degLoud = loudness(degBand[b]);
+
+            // Küçük farklar maskelenir (ölü bölge)
+            double disturbance = std::fabs(degLoud - refLoud) - 0.25 * std::min(refLoud, degLoud);
+            disturbance = std::max(0.0, disturbance);
+
+            // Eklenen bileşenler kaybolanlardan daha rahatsız edicidir
+            double asymmetry = std::pow((degBand[b] + 50.0 * hearingThreshold) /
+                                        (refBand[b] + 50.0 * hearingThreshold), 1.2);
+            asymmetry = asymmetry < 3.0 ? 0.0 : std::min(asymmetry, 12.0);
+
+            symSum += disturbance * disturbance;
+            asymSum += disturbance * asymmetry;
+        }
+
+        symmetric.push_back(std::sqrt(symSum));
+        asymmetric.push_back(asymSum);
+    }
+
+    if (symmetric.empty()) {
+        return 1.0;
+    }
+
+    // ~320 ms gruplar içinde L6, gruplar arasında L2
+    auto aggregate = [](const std::vector<double>& values) {
+        const size_t group = 20;
+        double total = 0.0;
+        size_t groups = 0;
+        for (size_t start = 0; start < values.size(); start += group) {
+            size_t end = std::min(values.size(), start + group);
+            double sum = 0.0;
+            for (size_t i = start; i < end; ++i) {
+                sum += std::pow(values[i], 6.0);
+            }
+            double l6 = std::pow(sum / static_cast<double>(end - start), 1.0 / 6.0);
+            total += l6 * l6;
+            groups++;
+        }
+        return std::sqrt(total / static_cast<double>(groups));
+    };
+
+    double raw = 4.5 - 0.1 * aggregate(symmetric) - 0.0309 * aggregate(asymmetric);
+    raw = std::max(-0.5, std::min(4.5, raw));
+
+    // P.862.1 MOS-LQO eşlemesi
+    return 0.999 + 4.0 / (1.0 + std::exp(-1.4945 * raw + 4.6607));
+}
+
+QualityScore evaluate(const int16_t* reference, const int16_t* degraded, size_t samples, uint32_t sampleRate) {
+    QualityScore score;
+    score.segmentalSnrDb = segmentalSnr(reference, degraded, samples, sampleRate);
+    score.logSpectralDistanceDb = logSpectralDistance(reference, degraded, samples, sampleRate);
+    score.mos = estimateMos(reference, degraded, samples, sampleRate);
+    return score;
+}
+
+} // namespace QualityMetrics
+} // namespace NovaVoice
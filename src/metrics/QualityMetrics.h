@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace NovaVoice {
+
+// Bir bozulmuş sinyalin referansa göre kalite skorları
+struct QualityScore {
+    double segmentalSnrDb;          // Yüksek = iyi
+    double logSpectralDistanceDb;   // Düşük = iyi
+    double mos;                     // 1.0 - 4.5 (PESQ benzeri MOS-LQO tahmini)
+
+    QualityScore() : segmentalSnrDb(0.0), logSpectralDistanceDb(0.0), mos(0.0) {}
+};
+
+/**
+ * @brief Referanslı nesnel konuşma kalitesi ölçütleri
+ *
+ * Referans ve bozulmuş sinyaller aynı örnekleme hızında ve zaman
+ * hizalıdır (hizalama çağıranın sorumluluğundadır). Sessiz frame'ler
+ * (en gürültülü frame'in 40 dB altı) ortalamaya katılmaz. MOS tahmini
+ * PESQ'in yapısını izler (seviye hizalama, Bark bantları, Zwicker
+ * ses yüksekliği, simetrik/asimetrik bozulma, L6/L2 toplama, MOS-LQO
+ * eşlemesi) fakat ITU-T P.862 uyumlu değildir; göreli karşılaştırma
+ * (ayar öncesi/sonrası) için kullanılmalıdır.
+ */
+namespace QualityMetrics {
+
+double segmentalSnr(const int16_t* reference, const int16_t* degraded, size_t samples, uint32_t sampleRate);
+double logSpectralDistance(const int16_t* reference, const int16_t* degraded, size_t samples, uint32_t sampleRate);
+double estimateMos(const int16_t* reference, const int16_t* degraded, size_t samples, uint32_t sampleRate);
+
+QualityScore evaluate(const int16_t* reference, const int16_t* degraded, size_t samples, uint32_t sampleRate);
+
+} // namespace QualityMetrics
+
+} // namespace NovaVoice
@@ -0,0 +1,367 @@
+#include "RealtimeCheck.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <execinfo.h>
+#include <sstream>
+#include <vector>
+#include <unistd.h>
+
+#ifdef NOVA_RT_CHECK
+#include <dlfcn.h>
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#endif
+
+namespace NovaVoice {
+namespace RealtimeCheck {
+
+namespace {
+
+constexpr size_t KIND_COUNT = static_cast<size_t>(RtViolation::COUNT);
+constexpr size_t MAX_SITES = 256;
+constexpr int MAX_FRAMES = 16;
+constexpr int SKIP_FRAMES = 2;  // reportViolation + hook
+
+// Farklı çağrı yığını başına kayıt; hash 0 boş yuva demektir
+struct Site {
+    std::atomic<uint64_t> hash;
+    std::atomic<uint64_t> count;
+    std::atomic<bool> ready;
+    RtViolation kind;
+    const char* function;
+    const char* thread;
+    int frameCount;
+    void* frames[MAX_FRAMES];
+};
+
+Site g_sites[MAX_SITES];
+std::atomic<uint64_t> g_counts[KIND_COUNT];
+std::atomic<size_t> g_siteCount{0};
+std::atomic<uint64_t> g_droppedSites{0};
+std::atomic<bool> g_enabled{false};
+std::atomic<bool> g_trace{true};
+
+void writeStderr(const char* text) {
+    size_t length = std::strlen(text);
+    while (length > 0) {
+        ssize_t written = ::write(STDERR_FILENO, text, length);
+        if (written <= 0) {
+            return;
+        }
+        text += written;
+        length -= static_cast<size_t>(written);
+    }
+}
+
+uint64_t hashFrames(RtViolation kind, void* const* frames, int count) {
+    // FNV-1a: dönüş adresleri + ihlal türü
+    uint64_t hash = 1469598103934665603ULL ^ static_cast<uint64_t>(kind);
+    for (int i = 0; i < count; ++i) {
+        hash ^= reinterpret_cast<uintptr_t>(frames[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash != 0 ? hash : 1;
+}
+
+// Yeni yığın ise yuvayı doldurur ve true döner
+bool recordSite(RtViolation kind, const char* function, void* const* frames, int count) {
+    uint64_t hash = hashFrames(kind, frames, count);
+
+    for (size_t probe = 0; probe < MAX_SITES; ++probe) {
+        Site& site = g_sites[(hash + probe) % MAX_SITES];
+        uint64_t current = site.hash.load(std::memory_order_acquire);
+
+        if (current == 0) {
+            if (site.hash.compare_exchange_strong(current, hash, std::memory_order_acq_rel)) {
+                site.kind = kind;
+                site.function = function;
+                site.thread = t_state.name;
+                site.frameCount = std::min(count, MAX_FRAMES);
+                std::memcpy(site.frames, frames, sizeof(void*) * static_cast<size_t>(site.frameCount));
+                site.count.fetch_add(1, std::memory_order_relaxed);
+                site.ready.store(true, std::memory_order_release);
+                g_siteCount.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+            // Başka thread aynı yuvayı aldı: aynı yığın mı diye tekrar bak
+        }
+
+        if (current == hash) {
+            site.count.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    g_droppedSites.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+std::string demangleFrame(const char* symbol) {
+    // "ikili(_ZN...+0x1f) [0x...]" biçiminden sembol adını çöz
+    std::string text(symbol);
+    size_t open = text.find('(');
+    size_t plus = text.find('+', open);
+    if (open == std::string::npos || plus == std::string::npos || plus == open + 1) {
+        return text;
+    }
+
+    std::string mangled = text.substr(open + 1, plus - open - 1);
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+    if (status != 0 || !demangled) {
+        return text;
+    }
+
+    std::string result = demangled;
+    std::free(demangled);
+    return result + text.substr(plus, text.find(')', plus) - plus);
+}
+
+} // namespace
+
+bool isCompiledIn() {
+#ifdef NOVA_RT_CHECK
+    return true;
+#else
+    return false;
+#endif
+}
+
+void setEnabled(bool enable) {
+    if (enable) {
+        // İlk backtrace() libgcc_s'i yükler (bellek ayırır): ses yolundan önce
+        void* frames[2];
+        backtrace(frames, 2);
+    }
+    g_enabled = enable;
+}
+
+bool isEnabled() {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+void setTraceOnViolation(bool enable) {
+    g_trace = enable;
+}
+
+// === SAYAÇLAR ===
+
+uint64_t getViolations(RtViolation kind) {
+    return g_counts[static_cast<size_t>(kind)].load(std::memory_order_relaxed);
+}
+
+uint64_t getTotalViolations() {
+    uint64_t total = 0;
+    for (size_t i = 0; i < KIND_COUNT; ++i) {
+        total += g_counts[i].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+size_t getSiteCount() {
+    return g_siteCount.load(std::memory_order_relaxed);
+}
+
+void reset() {
+    // Ölçüm yapılmayan bir anda çağrılmalı (yuvalar kilitsiz doldurulur)
+    for (size_t i = 0; i < KIND_COUNT; ++i) {
+        g_counts[i] = 0;
+    }
+    for (auto& site : g_sites) {
+        site.ready = false;
+        site.count = 0;
+        site.hash = 0;
+    }
+    g_siteCount = 0;
+    g_droppedSites = 0;
+}
+
+const char* violationName(RtViolation kind) {
+    switch (kind) {
+        case RtViolation::ALLOCATION: return "bellek ayırma";
+        case RtViolation::DEALLOCATION: return "bellek bırakma";
+        case RtViolation::MUTEX: return "mutex";
+        case RtViolation::BLOCKING_CALL: return "bloklayan çağrı";
+        default: return "bilinmeyen";
+    }
+}
+
+std::string formatReport(bool withStacks) {
+    // Rapor ses thread'i dışında üretilir; kendi ayırmaları sayılmaz
+    t_state.reporting++;
+
+    std::ostringstream out;
+    for (size_t i = 0; i < KIND_COUNT; ++i) {
+        out << "  " << violationName(static_cast<RtViolation>(i)) << ": " << g_counts[i].load() << "\n";
+    }
+
+    std::vector<const Site*> sites;
+    for (const auto& site : g_sites) {
+        if (site.ready.load(std::memory_order_acquire)) {
+            sites.push_back(&site);
+        }
+    }
+    std::sort(sites.begin(), sites.end(), [](const Site* a, const Site* b) {
+        return a->count.load() > b->count.load();
+    });
+
+    out << "  farklı yığın: " << sites.size();
+    if (g_droppedSites.load() > 0) {
+        out << " (+" << g_droppedSites.load() << " tablo dolu)";
+    }
+    out << "\n";
+
+    for (const Site* site : sites) {
+        out << "  - " << site->function << " x" << site->count.load()
+            << " [" << (site->thread ? site->thread : "?") << "]\n";
+        if (!withStacks) {
+            continue;
+        }
+
+        char** symbols = backtrace_symbols(site->frames, site->frameCount);
+        for (int f = 0; symbols && f < site->frameCount; ++f) {
+            out << "      " << demangleFrame(symbols[f]) << "\n";
+        }
+        std::free(symbols);
+    }
+
+    t_state.reporting--;
+    return out.str();
+}
+
+void reportViolation(RtViolation kind, const char* function) {
+    if (!g_enabled.load(std::memory_order_relaxed) || kind >= RtViolation::COUNT) {
+        return;
+    }
+
+    // Raporlama sırasındaki ayırmalar/yazmalar tekrar hook'a düşmesin
+    t_state.reporting++;
+    g_counts[static_cast<size_t>(kind)].fetch_add(1, std::memory_order_relaxed);
+
+    void* frames[MAX_FRAMES + SKIP_FRAMES];
+    int depth = backtrace(frames, MAX_FRAMES + SKIP_FRAMES);
+    int skip = std::min(depth, SKIP_FRAMES);
+
+    if (recordSite(kind, function, frames + skip, depth - skip) && g_trace.load(std::memory_order_relaxed)) {
+        char header[192];
+        std::snprintf(header, sizeof(header), "[RealtimeCheck VIOLATION] %s (%s) gerçek zamanlı thread: %s\n",
+                      function, violationName(kind), t_state.name ? t_state.name : "?");
+        writeStderr(header);
+        backtrace_symbols_fd(frames + skip, depth - skip, STDERR_FILENO);
+    }
+
+    t_state.reporting--;
+}
+
+} // namespace RealtimeCheck
+} // namespace NovaVoice
+
+// === SARMALAYICILAR (yalnızca NOVA_RT_CHECK) ===
+// Çalıştırılabilir içinde tanımlanır; paylaşımlı kütüphanelerin çağrıları
+// da dinamik bağlayıcı üzerinden buraya düşer. Asıl uygulamalar glibc'nin
+// __libc_* girişleri ve RTLD_NEXT ile bulunur.
+
+#ifdef NOVA_RT_CHECK
+
+namespace {
+
+using NovaVoice::RtViolation;
+
+inline void checkCall(RtViolation kind, const char* function) {
+    if (NovaVoice::RealtimeCheck::shouldCheck()) {
+        NovaVoice::RealtimeCheck::reportViolation(kind, function);
+    }
+}
+
+template <typename Function>
+Function resolveNext(std::atomic<Function>& cache, const char* name) {
+    Function function = cache.load(std::memory_order_relaxed);
+    if (!function) {
+        function = reinterpret_cast<Function>(dlsym(RTLD_NEXT, name));
+        cache.store(function, std::memory_order_relaxed);
+    }
+    return function;
+}
+
+std::atomic<int (*)(pthread_mutex_t*)> g_mutexLock{nullptr};
+std::atomic<int (*)(const struct timespec*, struct timespec*)> g_nanosleep{nullptr};
+std::atomic<int (*)(clockid_t, int, const struct timespec*, struct timespec*)> g_clockNanosleep{nullptr};
+std::atomic<int (*)(useconds_t)> g_usleep{nullptr};
+std::atomic<int (*)(struct pollfd*, nfds_t, int)> g_poll{nullptr};
+std::atomic<ssize_t (*)(int, void*, size_t)> g_read{nullptr};
+std::atomic<ssize_t (*)(int, const void*, size_t)> g_write{nullptr};
+
+} // namespace
+
+extern "C" {
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+void __libc_free(void* pointer);
+
+void* malloc(size_t size) noexcept {
+    checkCall(RtViolation::ALLOCATION, "malloc");
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+    checkCall(RtViolation::ALLOCATION, "calloc");
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size) noexcept {
+    checkCall(RtViolation::ALLOCATION, "realloc");
+    return __libc_realloc(pointer, size);
+}
+
+void free(void* pointer) noexcept {
+    if (pointer) {
+        checkCall(RtViolation::DEALLOCATION, "free");
+    }
+    __libc_free(pointer);
+}
+
+int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept {
+    checkCall(RtViolation::MUTEX, "pthread_mutex_lock");
+    return resolveNext(g_mutexLock, "pthread_mutex_lock")(mutex);
+}
+
+int nanosleep(const struct timespec* request, struct timespec* remaining) {
+    checkCall(RtViolation::BLOCKING_CALL, "nanosleep");
+    return resolveNext(g_nanosleep, "nanosleep")(request, remaining);
+}
+
+int clock_nanosleep(clockid_t clock, int flags, const struct timespec* request, struct timespec* remaining) {
+    checkCall(RtViolation::BLOCKING_CALL, "clock_nanosleep");
+    return resolveNext(g_clockNanosleep, "clock_nanosleep")(clock, flags, request, remaining);
+}
+
+int usleep(useconds_t microseconds) {
+    checkCall(RtViolation::BLOCKING_CALL, "usleep");
+    return resolveNext(g_usleep, "usleep")(microseconds);
+}
+
+int poll(struct pollfd* fds, nfds_t count, int timeoutMs) {
+    checkCall(RtViolation::BLOCKING_CALL, "poll");
+    return resolveNext(g_poll, "poll")(fds, count, timeoutMs);
+}
+
+ssize_t read(int fd, void* buffer, size_t size) {
+    checkCall(RtViolation::BLOCKING_CALL, "read");
+    return resolveNext(g_read, "read")(fd, buffer, size);
+}
+
+ssize_t write(int fd, const void* buffer, size_t size) {
+    checkCall(RtViolation::BLOCKING_CALL, "write");
+    return resolveNext(g_write, "write")(fd, buffer, size);
+}
+
+} // extern "C"
+
+#endif // NOVA_RT_CHECK
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace NovaVoice {
+
+// Gerçek zamanlı thread'de yasak işlem türleri
+enum class RtViolation : size_t {
+    ALLOCATION = 0,     // malloc, calloc, realloc (new dahil)
+    DEALLOCATION,       // free (delete dahil)
+    MUTEX,              // pthread_mutex_lock (std::mutex dahil)
+    BLOCKING_CALL,      // Uyku, poll, read/write
+    COUNT
+};
+
+/**
+ * @brief Ses thread'leri için gerçek zamanlı güvenlik denetimi (debug/CI)
+ *
+ * NOVA_RT_CHECK ile derlendiğinde malloc/free, pthread_mutex_lock ve
+ * bloklayan sistem çağrıları (nanosleep, usleep, poll, read, write)
+ * çalıştırılabilir içinde sarmalanır. Etkinleştirilmişse ve çağıran
+ * thread bir RealtimeSection içindeyse çağrı ihlal olarak sayılır; her
+ * farklı çağrı yığını ilk görüldüğünde stderr'e yığın izi ile yazılır.
+ * Tasarım gereği bekleme noktaları (snd_pcm_readi/writei, recvfrom,
+ * eventfd bildirimi) BlockingSection ile muaf tutulur.
+ *
+ * NOVA_RT_CHECK olmadan sarmalayıcılar derlenmez; bölümler yalnızca
+ * thread-local bir sayacı artırır, bu yüzden ses yolunda kalabilir.
+ */
+namespace RealtimeCheck {
+
+// Hook'ların okuduğu thread durumu (statik TLS, bellek ayırmaz)
+struct ThreadState {
+    int realtimeDepth;
+    int allowDepth;
+    int reporting;
+    const char* name;
+};
+
+inline thread_local ThreadState t_state = {0, 0, 0, nullptr};
+
+bool isCompiledIn();
+void setEnabled(bool enable);
+bool isEnabled();
+// İhlal yığınını ilk görüldüğünde hemen yaz (varsayılan: açık)
+void setTraceOnViolation(bool enable);
+
+// === SAYAÇLAR ===
+uint64_t getViolations(RtViolation kind);
+uint64_t getTotalViolations();
+size_t getSiteCount();
+void reset();
+
+const char* violationName(RtViolation kind);
+// Tür başına sayılar ve farklı yığınlar (withStacks: sembollü yığın izi)
+std::string formatReport(bool withStacks = false);
+
+// Hook'lar tarafından çağrılır; elle işaretlenen ihlaller için de kullanılabilir
+void reportViolation(RtViolation kind, const char* function);
+
+inline bool shouldCheck() {
+    return t_state.realtimeDepth > 0 && t_state.allowDepth == 0 && t_state.reporting == 0;
+}
+
+} // namespace RealtimeCheck
+
+// Çağıran thread'i kapsam boyunca gerçek zamanlı işaretler (iç içe olabilir)
+class RealtimeSection {
+public:
+    explicit RealtimeSection(const char* name)
+        : previousName_(RealtimeCheck::t_state.name) {
+        RealtimeCheck::t_state.name = name;
+        RealtimeCheck::t_state.realtimeDepth++;
+    }
+
+    ~RealtimeSection() {
+        RealtimeCheck::t_state.realtimeDepth--;
+        RealtimeCheck::t_state.name = previousName_;
+    }
+
+    RealtimeSection(const RealtimeSection&) = delete;
+    RealtimeSection& operator=(const RealtimeSection&) = delete;
+
+private:
+    const char* previousName_;
+};
+
+// Gerçek zamanlı thread'de bilinçli bekleme/sistem çağrısı (denetim dışı)
+class BlockingSection {
+public:
+    BlockingSection() { RealtimeCheck::t_state.allowDepth++; }
+    ~BlockingSection() { RealtimeCheck::t_state.allowDepth--; }
+
+    BlockingSection(const BlockingSection&) = delete;
+    BlockingSection& operator=(const BlockingSection&) = delete;
+};
+
+} // namespace NovaVoice
@@ -0,0 +1,293 @@
+#include "StageProfiler.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace NovaVoice {
+
+namespace {
+
+constexpr size_t EVENT_COUNT = static_cast<size_t>(PerfEvent::COUNT);
+
+// Histogramın kapsadığı en büyük süre: 2^41 ns (~36 dk)
+constexpr int MAX_MSB = static_cast<int>(StageProfiler::HISTOGRAM_BUCKETS / StageProfiler::SUB_BUCKETS) + 1;
+
+struct ThreadCounters {
+    PerfCounters counters;
+    bool attempted = false;
+};
+
+thread_local ThreadCounters t_counters;
+
+} // namespace
+
+StageProfiler::StageProfiler()
+    : stages_(new Stage[MAX_STAGES])
+    , stageCount_(0)
+    , enabled_(true)
+    , hardwareCounters_(false) {
+    reset();
+}
+
+int StageProfiler::addStage(const std::string& name) {
+    std::lock_guard<std::mutex> lock(setupMutex_);
+
+    size_t count = stageCount_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        if (stages_[i].name == name) {
+            return static_cast<int>(i);
+        }
+    }
+
+    if (count >= MAX_STAGES) {
+        logError("Aşama kapasitesi dolu: " + name);
+        return INVALID_STAGE;
+    }
+
+    // Ad, sayaç yayınlanmadan önce yazılır (okuyucular acquire ile görür)
+    stages_[count].name = name;
+    stageCount_.store(count + 1, std::memory_order_release);
+    return static_cast<int>(count);
+}
+
+bool StageProfiler::attachCurrentThread() {
+    return hardwareCounters_ && threadCounters() != nullptr;
+}
+
+PerfCounters* StageProfiler::threadCounters() {
+    if (!t_counters.attempted) {
+        t_counters.attempted = true;
+        t_counters.counters.open();
+    }
+    return t_counters.counters.isOpen() ? &t_counters.counters : nullptr;
+}
+
+// === ÖLÇÜM ===
+
+StageProfiler::Scope::Scope(StageProfiler* profiler, int stage)
+    : profiler_(profiler && profiler->enabled_.load(std::memory_order_relaxed) ? profiler : nullptr)
+    , stage_(stage)
+    , counters_(false) {
+    if (!profiler_ || stage_ < 0) {
+        profiler_ = nullptr;
+        return;
+    }
+
+    if (profiler_->hardwareCounters_.load(std::memory_order_relaxed)) {
+        PerfCounters* counters = threadCounters();
+        counters_ = counters && counters->read(startCounters_);
+    }
+
+    // Sayaç okumasından sonra: read() süresi aşamaya yazılmaz
+    startTime_ = std::chrono::steady_clock::now();
+}
+
+StageProfiler::Scope::~Scope() {
+    if (!profiler_) {
+        return;
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+    uint64_t ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime_).count());
+
+    PerfSample endCounters;
+    if (counters_ && threadCounters()->read(endCounters)) {
+        profiler_->record(stage_, ns, &startCounters_, &endCounters);
+    } else {
+        profiler_->record(stage_, ns, nullptr, nullptr);
+    }
+}
+
+void StageProfiler::record(int stage, uint64_t ns, const PerfSample* start, const PerfSample* end) {
+    if (static_cast<size_t>(stage) >= stageCount_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    Stage& target = stages_[stage];
+    target.calls.fetch_add(1, std::memory_order_relaxed);
+    target.totalNs.fetch_add(ns, std::memory_order_relaxed);
+    target.histogram[bucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t previousMax = target.maxNs.load(std::memory_order_relaxed);
+    while (ns > previousMax && !target.maxNs.compare_exchange_weak(previousMax, ns, std::memory_order_relaxed)) {
+    }
+
+    if (start && end) {
+        target.counterCalls.fetch_add(1, std::memory_order_relaxed);
+        for (size_t i = 0; i < EVENT_COUNT; ++i) {
+            target.counters[i].fetch_add(end->values[i] - start->values[i], std::memory_order_relaxed);
+        }
+    }
+}
+
+// === HİSTOGRAM ===
+
+size_t StageProfiler::bucketIndex(uint64_t ns) {
+    if (ns < SUB_BUCKETS) {
+        return static_cast<size_t>(ns);
+    }
+
+    int msb = 63 - __builtin_clzll(ns);
+    if (msb > MAX_MSB) {
+        return HISTOGRAM_BUCKETS - 1;
+    }
+
+    // Oktav içindeki konum: en anlamlı bitten sonraki 3 bit
+    size_t sub = static_cast<size_t>((ns >> (msb - 3)) & (SUB_BUCKETS - 1));
+    return static_cast<size_t>(msb - 2) * SUB_BUCKETS + sub;
+}
+
+uint64_t StageProfiler::bucketLowerNs(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+
+    int msb = static_cast<int>(index / SUB_BUCKETS) + 2;
+    uint64_t sub = index % SUB_BUCKETS;
+    return (SUB_BUCKETS + sub) << (msb - 3);
+}
+
+uint64_t StageProfiler::bucketWidthNs(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return 1;
+    }
+    return 1ULL << (index / SUB_BUCKETS - 1);
+}
+
+double StageProfiler::percentileUs(const Stage& stage, double fraction) const {
+    uint64_t calls = stage.calls.load(std::memory_order_relaxed);
+    if (calls == 0) {
+        return 0.0;
+    }
+
+    uint64_t rank = static_cast<uint64_t>(fraction * static_cast<double>(calls - 1)) + 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+        seen += stage.histogram[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            // Kova ortası (hata en fazla kova genişliğinin yarısı, ~%6)
+            return (bucketLowerNs(i) + bucketWidthNs(i) / 2.0) / 1000.0;
+        }
+    }
+
+    return stage.maxNs.load(std::memory_order_relaxed) / 1000.0;
+}
+
+// === RAPOR ===
+
+std::vector<StageReport> StageProfiler::getReport() const {
+    std::vector<StageReport> report;
+    size_t count = stageCount_.load(std::memory_order_acquire);
+
+    for (size_t i = 0; i < count; ++i) {
+        const Stage& stage = stages_[i];
+        StageReport entry;
+        entry.name = stage.name;
+        entry.calls = stage.calls.load(std::memory_order_relaxed);
+        entry.meanUs = entry.calls > 0 ? stage.totalNs.load(std::memory_order_relaxed) / 1000.0 / entry.calls : 0.0;
+        entry.p50Us = percentileUs(stage, 0.50);
+        entry.p99Us = percentileUs(stage, 0.99);
+        entry.maxUs = stage.maxNs.load(std::memory_order_relaxed) / 1000.0;
+
+        entry.counterCalls = stage.counterCalls.load(std::memory_order_relaxed);
+        double calls = entry.counterCalls > 0 ? static_cast<double>(entry.counterCalls) : 1.0;
+        double cycles = static_cast<double>(stage.counters[static_cast<size_t>(PerfEvent::CYCLES)].load());
+        double instructions = static_cast<double>(stage.counters[static_cast<size_t>(PerfEvent::INSTRUCTIONS)].load());
+        entry.cyclesPerCall = cycles / calls;
+        entry.instructionsPerCall = instructions / calls;
+        entry.ipc = cycles > 0.0 ? instructions / cycles : 0.0;
+        entry.llcMissesPerCall = stage.counters[static_cast<size_t>(PerfEvent::LLC_MISSES)].load() / calls;
+        entry.branchMissesPerCall = stage.counters[static_cast<size_t>(PerfEvent::BRANCH_MISSES)].load() / calls;
+
+        report.push_back(entry);
+    }
+
+    return report;
+}
+
+std::string StageProfiler::formatReport() const {
+    std::ostringstream out;
+    // setw bayt sayar: Türkçe karakterler (2 bayt) için genişlik artırılır
+    out << std::left << std::setw(21) << "aşama" << std::right
+        << std::setw(12) << "çağrı" << std::setw(9) << "ort us" << std::setw(9) << "p50 us"
+        << std::setw(9) << "p99 us" << std::setw(9) << "max us"
+        << std::setw(14) << "cyc/çağrı" << std::setw(6) << "IPC"
+        << std::setw(10) << "LLC miss" << std::setw(10) << "br miss" << "\n";
+
+    for (const auto& entry : getReport()) {
+        out << std::left << std::setw(20) << entry.name << std::right << std::fixed << std::setprecision(1)
+            << std::setw(9) << entry.calls << std::setw(9) << entry.meanUs << std::setw(9) << entry.p50Us
+            << std::setw(9) << entry.p99Us << std::setw(9) << entry.maxUs;
+
+        if (entry.counterCalls > 0) {
+            out << std::setw(11) << std::setprecision(0) << entry.cyclesPerCall
+                << std::setw(6) << std::setprecision(2) << entry.ipc
+                << std::setw(10) << std::setprecision(1) << entry.llcMissesPerCall
+                << std::setw(10) << entry.branchMissesPerCall;
+        } else {
+            out << std::setw(11) << "-" << std::setw(6) << "-" << std::setw(10) << "-" << std::setw(10) << "-";
+        }
+        out << "\n";
+    }
+
+    return out.str();
+}
+
+bool StageProfiler::exportCsv(const std::string& prefix) const {
+    std::ofstream summary(prefix + "_stages.csv");
+    std::ofstream histogram(prefix + "_histogram.csv");
+    if (!summary || !histogram) {
+        logError("CSV yazılamadı: " + prefix);
+        return false;
+    }
+
+    summary << "stage,calls,mean_us,p50_us,p99_us,max_us,counter_calls,cycles_per_call,"
+               "instructions_per_call,ipc,llc_misses_per_call,branch_misses_per_call\n";
+    for (const auto& entry : getReport()) {
+        summary << entry.name << ',' << entry.calls << ',' << entry.meanUs << ',' << entry.p50Us << ','
+                << entry.p99Us << ',' << entry.maxUs << ',' << entry.counterCalls << ','
+                << entry.cyclesPerCall << ',' << entry.instructionsPerCall << ',' << entry.ipc << ','
+                << entry.llcMissesPerCall << ',' << entry.branchMissesPerCall << '\n';
+    }
+
+    // Yalnızca dolu kovalar
+    histogram << "stage,lower_us,upper_us,count\n";
+    size_t count = stageCount_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t bucket = 0; bucket < HISTOGRAM_BUCKETS; ++bucket) {
+            uint64_t hits = stages_[i].histogram[bucket].load(std::memory_order_relaxed);
+            if (hits == 0) {
+                continue;
+            }
+            histogram << stages_[i].name << ',' << bucketLowerNs(bucket) / 1000.0 << ','
+                      << (bucketLowerNs(bucket) + bucketWidthNs(bucket)) / 1000.0 << ',' << hits << '\n';
+        }
+    }
+
+    return true;
+}
+
+void StageProfiler::reset() {
+    for (size_t i = 0; i < MAX_STAGES; ++i) {
+        Stage& stage = stages_[i];
+        stage.calls = 0;
+        stage.totalNs = 0;
+        stage.maxNs = 0;
+        stage.counterCalls = 0;
+        for (size_t e = 0; e < EVENT_COUNT; ++e) {
+            stage.counters[e] = 0;
+        }
+        for (size_t b = 0; b < HISTOGRAM_BUCKETS; ++b) {
+            stage.histogram[b] = 0;
+        }
+    }
+}
+
+void StageProfiler::logError(const std::string& message) const {
+    std::cerr << "[StageProfiler ERROR] " << message << std::endl;
+}
+
+} // namespace NovaVoice
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "PerfCounters.h"
+
+namespace NovaVoice {
+
+// Bir aşamanın özet ölçümleri
+struct StageReport {
+    std::string name;
+    uint64_t calls;
+    double meanUs;
+    double p50Us;
+    double p99Us;
+    double maxUs;
+
+    // Çağrı başına donanım sayaçları (counterCalls == 0 ise ölçülmedi)
+    uint64_t counterCalls;
+    double cyclesPerCall;
+    double instructionsPerCall;
+    double ipc;
+    double llcMissesPerCall;
+    double branchMissesPerCall;
+};
+
+/**
+ * @brief Pipeline aşamaları için süre histogramı ve donanım sayaçları
+ *
+ * Aşamalar kurulumda addStage() ile kaydedilir; ölçüm Scope ile aşamanın
+ * etrafında yapılır. Her aşama için duvar saati süresi log-doğrusal
+ * histograma (oktav başına 8 alt kova) işlenir. Donanım sayaçları açıksa
+ * Scope'un başında ve sonunda thread'in perf_event grubu okunur ve fark
+ * aşamaya eklenir; grup thread'in ilk ölçümünde açılır. Kayıt kilitsizdir
+ * (atomik sayaçlar) ve bellek ayırmaz, bu yüzden ses thread'lerinde
+ * kullanılabilir. Sayaç okuması aşama sınırı başına bir read() sistem
+ * çağrısıdır (~1 µs); varsayılan olarak kapalıdır.
+ */
+class StageProfiler {
+public:
+    static constexpr size_t MAX_STAGES = 32;
+    static constexpr size_t SUB_BUCKETS = 8;
+    static constexpr size_t HISTOGRAM_BUCKETS = 40 * SUB_BUCKETS;
+    static constexpr int INVALID_STAGE = -1;
+
+    StageProfiler();
+
+    StageProfiler(const StageProfiler&) = delete;
+    StageProfiler& operator=(const StageProfiler&) = delete;
+
+    // === KURULUM ===
+    // Aynı ad aynı kimliği döndürür; kapasite dolarsa INVALID_STAGE
+    int addStage(const std::string& name);
+    void setEnabled(bool enable) { enabled_ = enable; }
+    bool isEnabled() const { return enabled_; }
+    void setHardwareCounters(bool enable) { hardwareCounters_ = enable; }
+    bool hasHardwareCounters() const { return hardwareCounters_; }
+
+    // Çağıran thread'in sayaç grubunu önceden açar (ilk ölçümdeki sistem
+    // çağrılarını ses yolundan çıkarmak için thread başında çağrılabilir)
+    bool attachCurrentThread();
+
+    // === ÖLÇÜM ===
+    class Scope {
+    public:
+        Scope(StageProfiler* profiler, int stage);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        StageProfiler* profiler_;
+        int stage_;
+        bool counters_;
+        PerfSample startCounters_;
+        std::chrono::steady_clock::time_point startTime_;
+    };
+
+    // === RAPOR ===
+    std::vector<StageReport> getReport() const;
+    std::string formatReport() const;
+    // <prefix>_stages.csv (özet) ve <prefix>_histogram.csv (kova sayıları)
+    bool exportCsv(const std::string& prefix) const;
+    void reset();
+
+private:
+    struct Stage {
+        std::string name;
+        std::atomic<uint64_t> calls;
+        std::atomic<uint64_t> totalNs;
+        std::atomic<uint64_t> maxNs;
+        std::atomic<uint64_t> counterCalls;
+        std::atomic<uint64_t> counters[static_cast<size_t>(PerfEvent::COUNT)];
+        std::atomic<uint64_t> histogram[HISTOGRAM_BUCKETS];
+    };
+
+    std::unique_ptr<Stage[]> stages_;
+    std::atomic<size_t> stageCount_;
+    std::mutex setupMutex_;
+    std::atomic<bool> enabled_;
+    std::atomic<bool> hardwareCounters_;
+
+    static PerfCounters* threadCounters();
+    void record(int stage, uint64_t ns, const PerfSample* start, const PerfSample* end);
+
+    static size_t bucketIndex(uint64_t ns);
+    static uint64_t bucketLowerNs(size_t index);
+    static uint64_t bucketWidthNs(size_t index);
+    double percentileUs(const Stage& stage, double fraction) const;
+
+    void logError(const std::string& message) const;
+};
+
+} // namespace NovaVoice
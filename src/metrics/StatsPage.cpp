@@ -0,0 +1,246 @@
+#include "StatsPage.h"
+#include "StageProfiler.h"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <iostream>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace NovaVoice {
+
+static_assert(sizeof(StatsSnapshot::stages) / sizeof(StatsStage) == StageProfiler::MAX_STAGES,
+              "Sayfadaki aşama sayısı StageProfiler ile aynı olmalı");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Seqlock sayacı süreçler arası kilitsiz olmalı");
+
+namespace {
+
+// Okuyucu yazıcıyla çakışırsa yeniden dener; yazım ~µs sürer
+constexpr int MAX_READ_ATTEMPTS = 1000;
+
+} // namespace
+
+// === SAYFA ADLARI ===
+
+std::string StatsPage::defaultName() {
+    return std::string(NAME_PREFIX) + std::to_string(getpid());
+}
+
+std::string StatsPage::pathFor(const std::string& name) {
+    // Tam yol verilmişse aynen kullanılır
+    if (!name.empty() && name[0] == '/') {
+        return name;
+    }
+    return std::string(DIRECTORY) + "/" + name;
+}
+
+uint64_t StatsPage::monotonicNs() {
+    // vDSO: sistem çağrısı yapmaz
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ull + static_cast<uint64_t>(now.tv_nsec);
+}
+
+// === YAZICI ===
+
+StatsPublisher::StatsPublisher()
+    : page_(nullptr)
+    , publishCount_(0) {
+}
+
+StatsPublisher::~StatsPublisher() {
+    close();
+}
+
+bool StatsPublisher::open(const std::string& name) {
+    close();
+
+    // O_EXCL: aynı adı kullanan canlı bir motorun sayfası ezilmez; yalnızca
+    // çökmüş bir sürecin bıraktığı sayfa silinip yeniden denenir
+    path_ = StatsPage::pathFor(name);
+    int fd = ::open(path_.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0 && errno == EEXIST && removeStalePage()) {
+        fd = ::open(path_.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    }
+    if (fd < 0) {
+        logError("Sayfa oluşturulamadı: " + path_ + " (" + std::strerror(errno) + ")");
+        return false;
+    }
+
+    if (ftruncate(fd, sizeof(StatsPage::Layout)) != 0) {
+        logError("Sayfa boyutlandırılamadı: " + path_);
+        ::close(fd);
+        unlink(path_.c_str());
+        return false;
+    }
+
+    void* memory = mmap(nullptr, sizeof(StatsPage::Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        logError("Sayfa eşlenemedi: " + path_);
+        unlink(path_.c_str());
+        return false;
+    }
+
+    // ftruncate sayfayı sıfırlar; başlık en son magic ile yayınlanır
+    page_ = new (memory) StatsPage::Layout;
+    page_->version = StatsPage::VERSION;
+    page_->snapshotSize = sizeof(StatsSnapshot);
+    page_->pid = static_cast<uint32_t>(getpid());
+    page_->startNs = StatsPage::monotonicNs();
+    page_->sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    page_->magic = StatsPage::MAGIC;
+    publishCount_ = 0;
+    return true;
+}
+
+bool StatsPublisher::removeStalePage() {
+    int fd = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return errno == ENOENT;  // Bu arada silinmiş
+    }
+
+    // Başlık alanları tüm sürümlerde aynı yerde
+    uint32_t header[4] = {};
+    ssize_t bytes = pread(fd, header, sizeof(header), 0);
+    ::close(fd);
+
+    uint32_t pid = header[3];
+    if (bytes != static_cast<ssize_t>(sizeof(header)) || header[0] != StatsPage::MAGIC || pid == 0) {
+        logError("Sayfa adı motora ait olmayan bir dosyada kullanılıyor: " + path_);
+        errno = EEXIST;
+        return false;
+    }
+
+    if (kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH) {
+        logError("Sayfa başka bir motor tarafından kullanılıyor (pid " + std::to_string(pid) + "): " + path_);
+        errno = EEXIST;
+        return false;
+    }
+
+    if (unlink(path_.c_str()) != 0 && errno != ENOENT) {
+        return false;
+    }
+    return true;
+}
+
+void StatsPublisher::close() {
+    if (!page_) {
+        return;
+    }
+
+    munmap(page_, sizeof(StatsPage::Layout));
+    unlink(path_.c_str());
+    page_ = nullptr;
+}
+
+void StatsPublisher::publish(const StatsSnapshot& snapshot) {
+    if (!page_) {
+        return;
+    }
+
+    // Tek sayı: yazım sürüyor; okuyucu kopyasını atar
+    uint32_t sequence = page_->sequence.load(std::memory_order_relaxed);
+    page_->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::memcpy(&page_->snapshot, &snapshot, sizeof(StatsSnapshot));
+    page_->snapshot.publishNs = StatsPage::monotonicNs();
+    page_->snapshot.publishCount = ++publishCount_;
+
+    page_->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void StatsPublisher::logError(const std::string& message) const {
+    std::cerr << "[StatsPublisher ERROR] " << message << std::endl;
+}
+
+// === OKUYUCU ===
+
+StatsReader::StatsReader()
+    : page_(nullptr) {
+}
+
+StatsReader::~StatsReader() {
+    detach();
+}
+
+bool StatsReader::attach(const std::string& name) {
+    detach();
+
+    std::string path = StatsPage::pathFor(name);
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        logError("Sayfa açılamadı: " + path);
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(StatsPage::Layout)) {
+        logError("Sayfa boyutu uyumsuz: " + path);
+        ::close(fd);
+        return false;
+    }
+
+    void* memory = mmap(nullptr, sizeof(StatsPage::Layout), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        logError("Sayfa eşlenemedi: " + path);
+        return false;
+    }
+
+    const auto* page = static_cast<const StatsPage::Layout*>(memory);
+    if (page->magic != StatsPage::MAGIC || page->version != StatsPage::VERSION ||
+        page->snapshotSize != sizeof(StatsSnapshot)) {
+        logError("Sayfa sürümü uyumsuz: " + path + " (sürüm " + std::to_string(page->version) +
+                 ", beklenen " + std::to_string(StatsPage::VERSION) + ")");
+        munmap(memory, sizeof(StatsPage::Layout));
+        return false;
+    }
+
+    page_ = page;
+    return true;
+}
+
+void StatsReader::detach() {
+    if (!page_) {
+        return;
+    }
+
+    munmap(const_cast<StatsPage::Layout*>(page_), sizeof(StatsPage::Layout));
+    page_ = nullptr;
+}
+
+bool StatsReader::read(StatsSnapshot& snapshot) const {
+    if (!page_) {
+        return false;
+    }
+
+    for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; ++attempt) {
+        uint32_t before = page_->sequence.load(std::memory_order_acquire);
+        if (before & 1u) {
+            continue;
+        }
+
+        std::memcpy(&snapshot, &page_->snapshot, sizeof(StatsSnapshot));
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        // Kopya sırasında yazım olduysa sayaç değişmiştir
+        if (page_->sequence.load(std::memory_order_relaxed) == before) {
+            return before != 0;
+        }
+    }
+
+    return false;
+}
+
+void StatsReader::logError(const std::string& message) const {
+    std::cerr << "[StatsReader ERROR] " << message << std::endl;
+}
+
+} // namespace NovaVoice
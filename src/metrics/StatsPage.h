@@ -0,0 +1,175 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include "Config.h"
+
+namespace NovaVoice {
+
+// Sayfada yayınlanan bir uzak akış (oturum); oranlar okuyucuda farktan hesaplanır
+struct StatsSession {
+    uint32_t streamId;
+    uint32_t queueDepth;        // Playout ring'indeki paket sayısı
+    uint64_t packets;
+    uint64_t bytes;
+    uint64_t lost;              // Sıra numarası boşluklarından (beklenen - alınan)
+    double jitterMs;            // RFC 3550 varışlar arası sapma
+    uint64_t memoryBytes;       // Oturuma yazılmış canlı heap (MemoryAccounting)
+    uint64_t memoryAllocations; // Birikimli
+};
+
+// Sayfada yayınlanan bir pipeline aşaması (StageProfiler)
+struct StatsStage {
+    char name[24];
+    uint64_t calls;
+    uint64_t totalNs;           // CPU payı = totalNs farkı / duvar saati farkı
+    double p50Us;
+    double p99Us;
+    double maxUs;
+};
+
+// Sayfada yayınlanan bir bellek etiketi (MemoryAccounting)
+struct StatsMemory {
+    char name[24];
+    uint64_t liveBytes;
+    uint64_t liveBlocks;
+    uint64_t allocations;       // Birikimli; ayırma hızı okuyucuda farktan
+    uint64_t allocatedBytes;
+    uint64_t externalBytes;     // mmap
+};
+
+/**
+ * @brief Bir yayın anındaki tüm sayaç ve göstergeler (düz veri)
+ *
+ * Sayaçlar başlangıçtan beri birikimlidir; hızlar (bitrate, kayıp oranı,
+ * CPU payı) iki okuma arasındaki farktan okuyucuda hesaplanır, böylece
+ * motor yalnızca kopyalama yapar.
+ */
+struct StatsSnapshot {
+    uint64_t publishNs;         // CLOCK_MONOTONIC
+    uint64_t publishCount;
+
+    // Ağ
+    uint64_t sentPackets;
+    uint64_t receivedPackets;
+    uint64_t failedSends;
+
+    // Kuyruklar
+    uint64_t droppedPackets;
+    uint64_t rejectedStreamPackets;
+    uint32_t inputQueue;
+    uint32_t outputQueue;
+    uint64_t controlDequeued;
+    uint64_t mediaDequeued;
+    double controlQueueUs;
+    double mediaQueueUs;
+
+    // Ses cihazı
+    uint64_t capturedFrames;
+    uint64_t captureOverruns;
+    uint64_t playedFrames;
+    uint64_t playbackUnderruns;
+    uint64_t concealedFrames;
+
+    // Playout
+    double playoutJitterMs;
+    double playoutTargetMs;
+    uint64_t playoutUnderruns;
+
+    uint64_t rtViolations;
+
+    uint32_t sessionCount;
+    uint32_t stageCount;
+    uint32_t memoryCount;       // 0: motor bellek muhasebesiz derlenmiş
+    StatsSession sessions[Config::MAX_STREAMS];
+    StatsStage stages[32];
+    StatsMemory memory[16];
+};
+
+/**
+ * @brief /dev/shm üzerinde sürümlü, seqlock korumalı istatistik sayfası
+ *
+ * Motor (yazıcı) StatsPublisher ile sayfayı oluşturur ve publish() ile
+ * anlık görüntüyü kopyalar: sıra sayacı tek değere çekilir, veri yazılır,
+ * sıra sayacı çift değere çekilir. Okuyucu (nova_top) sayfayı salt okunur
+ * eşler; sayacı okur, veriyi kopyalar ve sayaç değişmemişse kopyayı kabul
+ * eder. Okuma sistem çağrısı yapmaz ve yazıcıyı hiç bekletmez; yazıcı
+ * tarafında okuyucu sayısının maliyeti yoktur. Düzen değişirse VERSION
+ * artırılır; uyumsuz sürümdeki sayfa okunmaz.
+ */
+namespace StatsPage {
+
+constexpr uint32_t MAGIC = 0x4E565354;   // "NVST"
+constexpr uint32_t VERSION = 2;
+constexpr const char* DIRECTORY = "/dev/shm";
+constexpr const char* NAME_PREFIX = "nova_voice.";
+
+struct Layout {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t snapshotSize;
+    uint32_t pid;
+    uint64_t startNs;
+    alignas(64) std::atomic<uint32_t> sequence;
+    alignas(64) StatsSnapshot snapshot;
+};
+
+// Varsayılan sayfa adı: nova_voice.<pid>
+std::string defaultName();
+std::string pathFor(const std::string& name);
+uint64_t monotonicNs();
+
+} // namespace StatsPage
+
+class StatsPublisher {
+public:
+    StatsPublisher();
+    ~StatsPublisher();
+
+    StatsPublisher(const StatsPublisher&) = delete;
+    StatsPublisher& operator=(const StatsPublisher&) = delete;
+
+    bool open(const std::string& name);
+    void close();       // Sayfa dosyası da silinir
+    bool isOpen() const { return page_ != nullptr; }
+    const std::string& getPath() const { return path_; }
+
+    // Tek yazıcı thread'inden çağrılır
+    void publish(const StatsSnapshot& snapshot);
+
+private:
+    StatsPage::Layout* page_;
+    std::string path_;
+    uint64_t publishCount_;
+
+    // Sahibi çalışmayan (çökmüş) bir sürecin sayfasını siler
+    bool removeStalePage();
+    void logError(const std::string& message) const;
+};
+
+class StatsReader {
+public:
+    StatsReader();
+    ~StatsReader();
+
+    StatsReader(const StatsReader&) = delete;
+    StatsReader& operator=(const StatsReader&) = delete;
+
+    bool attach(const std::string& name);
+    void detach();
+    bool isAttached() const { return page_ != nullptr; }
+    uint32_t getWriterPid() const { return page_ ? page_->pid : 0; }
+    uint64_t getWriterStartNs() const { return page_ ? page_->startNs : 0; }
+
+    // Tutarlı bir kopya alınamazsa (yazıcı sürekli yazıyor) false
+    bool read(StatsSnapshot& snapshot) const;
+
+private:
+    const StatsPage::Layout* page_;
+
+    void logError(const std::string& message) const;
+};
+
+} // namespace NovaVoice
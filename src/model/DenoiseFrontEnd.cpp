@@ -0,0 +1,689 @@
+#include "DenoiseFrontEnd.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace NovaVoice {
+
+namespace {
+
+using Complex = DenoiseFrontEnd::Complex;
+
+constexpr size_t FRAME_SIZE = DenoiseFrontEnd::FRAME_SIZE;
+constexpr size_t WINDOW_SIZE = DenoiseFrontEnd::WINDOW_SIZE;
+constexpr size_t FREQ_SIZE = DenoiseFrontEnd::FREQ_SIZE;
+constexpr size_t NB_BANDS = DenoiseFrontEnd::NB_BANDS;
+constexpr size_t CEPS_MEM = DenoiseFrontEnd::CEPS_MEM;
+constexpr size_t NB_DELTA_CEPS = DenoiseFrontEnd::NB_DELTA_CEPS;
+constexpr size_t PITCH_BUF_SIZE = DenoiseFrontEnd::PITCH_BUF_SIZE;
+constexpr size_t FRAME_SIZE_SHIFT = 2;         // 5ms bant sınırı -> FFT bin
+constexpr size_t MAX_RADIX = 5;
+
+// 5ms çözünürlüklü Bark bant sınırları (RNNoise eband5ms)
+constexpr int BAND_EDGES[NB_BANDS] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 10, 12, 14, 16, 20, 24, 28, 34, 40, 48, 60, 78, 100
+};
+
+// 960 = 4 * 4 * 4 * 3 * 5; çiftler (radix, kalan uzunluk)
+constexpr size_t FFT_FACTORS[] = {4, 240, 4, 60, 4, 15, 3, 5, 5, 1};
+
+// Süreç içinde bir kez hesaplanan salt okunur tablolar
+struct Tables {
+    float halfWindow[FRAME_SIZE];
+    float dct[NB_BANDS * NB_BANDS];
+    Complex twiddles[WINDOW_SIZE];
+
+    Tables() {
+        const double pi = std::acos(-1.0);
+        for (size_t i = 0; i < FRAME_SIZE; ++i) {
+            double s = std::sin(0.5 * pi * (i + 0.5) / FRAME_SIZE);
+            halfWindow[i] = static_cast<float>(std::sin(0.5 * pi * s * s));
+        }
+        for (size_t i = 0; i < NB_BANDS; ++i) {
+            for (size_t j = 0; j < NB_BANDS; ++j) {
+                double value = std::cos((i + 0.5) * j * pi / NB_BANDS);
+                if (j == 0) {
+                    value *= std::sqrt(0.5);
+                }
+                dct[i * NB_BANDS + j] = static_cast<float>(value);
+            }
+        }
+        for (size_t i = 0; i < WINDOW_SIZE; ++i) {
+            double phase = -2.0 * pi * i / WINDOW_SIZE;
+            twiddles[i] = Complex(static_cast<float>(std::cos(phase)), static_cast<float>(std::sin(phase)));
+        }
+    }
+};
+
+const Tables& tables() {
+    static const Tables instance;
+    return instance;
+}
+
+inline Complex multiply(Complex a, Complex b) {
+    return Complex(a.real() * b.real() - a.imag() * b.imag(),
+                   a.real() * b.imag() + a.imag() * b.real());
+}
+
+// Karışık tabanlı Cooley-Tukey (zaman seyreltmeli), ölçeksiz ileri DFT
+void fftWork(Complex* out, const Complex* in, size_t inStride, const size_t* factors) {
+    const Complex* twiddles = tables().twiddles;
+    size_t radix = factors[0];
+    size_t length = factors[1];
+
+    if (length == 1) {
+        for (size_t j = 0; j < radix; ++j) {
+            out[j] = in[j * inStride];
+        }
+    } else {
+        for (size_t j = 0; j < radix; ++j) {
+            fftWork(out + j * length, in + j * inStride, inStride * radix, factors + 2);
+        }
+    }
+
+    // Alt dönüşümleri twiddle ile döndür, ardından radix noktalı DFT
+    size_t rootStep = WINDOW_SIZE / radix;
+    for (size_t u = 0; u < length; ++u) {
+        Complex scratch[MAX_RADIX];
+        scratch[0] = out[u];
+        for (size_t q = 1; q < radix; ++q) {
+            scratch[q] = multiply(out[u + q * length], twiddles[inStride * u * q]);
+        }
+
+        if (radix == 4) {
+            Complex a = scratch[0] + scratch[2];
+            Complex b = scratch[0] - scratch[2];
+            Complex c = scratch[1] + scratch[3];
+            Complex d = scratch[1] - scratch[3];
+            Complex dRotated(d.imag(), -d.real());     // -i * d
+            out[u] = a + c;
+            out[u + length] = b + dRotated;
+            out[u + 2 * length] = a - c;
+            out[u + 3 * length] = b - dRotated;
+            continue;
+        }
+
+        for (size_t q1 = 0; q1 < radix; ++q1) {
+            Complex sum = scratch[0];
+            size_t root = 0;    // (q1 * q) mod radix, bölmesiz
+            for (size_t q = 1; q < radix; ++q) {
+                root += q1;
+                if (root >= radix) {
+                    root -= radix;
+                }
+                sum += multiply(scratch[q], twiddles[root * rootStep]);
+            }
+            out[u + q1 * length] = sum;
+        }
+    }
+}
+
+void forwardTransform(const float* input, Complex* output) {
+    Complex in[WINDOW_SIZE];
+    Complex out[WINDOW_SIZE];
+    for (size_t i = 0; i < WINDOW_SIZE; ++i) {
+        in[i] = Complex(input[i], 0.0f);
+    }
+    fftWork(out, in, 1, FFT_FACTORS);
+
+    constexpr float scale = 1.0f / WINDOW_SIZE;
+    for (size_t i = 0; i < FREQ_SIZE; ++i) {
+        output[i] = out[i] * scale;
+    }
+}
+
+// Hermitian simetrik spektrumdan ters dönüşüm (ileri FFT, ters indeks)
+void inverseTransform(const Complex* input, float* output) {
+    Complex in[WINDOW_SIZE];
+    Complex out[WINDOW_SIZE];
+    for (size_t i = 0; i < FREQ_SIZE; ++i) {
+        in[i] = input[i];
+    }
+    for (size_t i = FREQ_SIZE; i < WINDOW_SIZE; ++i) {
+        in[i] = std::conj(input[WINDOW_SIZE - i]);
+    }
+    fftWork(out, in, 1, FFT_FACTORS);
+
+    output[0] = out[0].real();
+    for (size_t i = 1; i < WINDOW_SIZE; ++i) {
+        output[i] = out[WINDOW_SIZE - i].real();
+    }
+}
+
+void applyWindow(float* x) {
+    const float* window = tables().halfWindow;
+    for (size_t i = 0; i < FRAME_SIZE; ++i) {
+        x[i] *= window[i];
+        x[WINDOW_SIZE - 1 - i] *= window[i];
+    }
+}
+
+// Üçgen bant ağırlıklarıyla enerji (b == nullptr) ya da çapraz korelasyon
+void computeBands(float* bands, const Complex* a, const Complex* b) {
+    std::fill(bands, bands + NB_BANDS, 0.0f);
+    for (size_t i = 0; i + 1 < NB_BANDS; ++i) {
+        size_t bandSize = static_cast<size_t>(BAND_EDGES[i + 1] - BAND_EDGES[i]) << FRAME_SIZE_SHIFT;
+        size_t start = static_cast<size_t>(BAND_EDGES[i]) << FRAME_SIZE_SHIFT;
+        for (size_t j = 0; j < bandSize; ++j) {
+            float frac = static_cast<float>(j) / bandSize;
+            const Complex& x = a[start + j];
+            const Complex& y = b ? b[start + j] : x;
+            float value = x.real() * y.real() + x.imag() * y.imag();
+            bands[i] += (1.0f - frac) * value;
+            bands[i + 1] += frac * value;
+        }
+    }
+    bands[0] *= 2.0f;
+    bands[NB_BANDS - 1] *= 2.0f;
+}
+
+void interpolateBandGain(float* gains, const float* bands) {
+    std::fill(gains, gains + FREQ_SIZE, 0.0f);
+    for (size_t i = 0; i + 1 < NB_BANDS; ++i) {
+        size_t bandSize = static_cast<size_t>(BAND_EDGES[i + 1] - BAND_EDGES[i]) << FRAME_SIZE_SHIFT;
+        size_t start = static_cast<size_t>(BAND_EDGES[i]) << FRAME_SIZE_SHIFT;
+        for (size_t j = 0; j < bandSize; ++j) {
+            float frac = static_cast<float>(j) / bandSize;
+            gains[start + j] = (1.0f - frac) * bands[i] + frac * bands[i + 1];
+        }
+    }
+}
+
+void dct(float* output, const float* input) {
+    const float* table = tables().dct;
+    const float scale = std::sqrt(2.0f / NB_BANDS);
+    for (size_t i = 0; i < NB_BANDS; ++i) {
+        float sum = 0.0f;
+        for (size_t j = 0; j < NB_BANDS; ++j) {
+            sum += input[j] * table[j * NB_BANDS + i];
+        }
+        output[i] = sum * scale;
+    }
+}
+
+// === PITCH (CELT pitch.c) ===
+
+float innerProduct(const float* x, const float* y, size_t length) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < length; ++i) {
+        sum += x[i] * y[i];
+    }
+    return sum;
+}
+
+// Dört gecikme birlikte: bağımsız toplamlar bağımlılık zincirini kırar (CELT xcorr_kernel)
+void pitchXcorr(const float* x, const float* y, float* xcorr, size_t length, size_t maxPitch) {
+    size_t i = 0;
+    for (; i + 4 <= maxPitch; i += 4) {
+        float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        for (size_t j = 0; j < length; ++j) {
+            float value = x[j];
+            sum[0] += value * y[i + j];
+            sum[1] += value * y[i + j + 1];
+            sum[2] += value * y[i + j + 2];
+            sum[3] += value * y[i + j + 3];
+        }
+        std::copy(sum, sum + 4, xcorr + i);
+    }
+    for (; i < maxPitch; ++i) {
+        xcorr[i] = innerProduct(x, y + i, length);
+    }
+}
+
+void findBestPitch(const float* xcorr, const float* y, size_t length, size_t maxPitch, int* bestPitch) {
+    float syy = 1.0f;
+    float bestNum[2] = {-1.0f, -1.0f};
+    float bestDen[2] = {0.0f, 0.0f};
+    bestPitch[0] = 0;
+    bestPitch[1] = 1;
+
+    for (size_t j = 0; j < length; ++j) {
+        syy += y[j] * y[j];
+    }
+    for (size_t i = 0; i < maxPitch; ++i) {
+        if (xcorr[i] > 0.0f) {
+            // Karesi alınırken taşma/alt taşmayı önler
+            float xcorr16 = xcorr[i] * 1e-12f;
+            float num = xcorr16 * xcorr16;
+            if (num * bestDen[1] > bestNum[1] * syy) {
+                if (num * bestDen[0] > bestNum[0] * syy) {
+                    bestNum[1] = bestNum[0];
+                    bestDen[1] = bestDen[0];
+                    bestPitch[1] = bestPitch[0];
+                    bestNum[0] = num;
+                    bestDen[0] = syy;
+                    bestPitch[0] = static_cast<int>(i);
+                } else {
+                    bestNum[1] = num;
+                    bestDen[1] = syy;
+                    bestPitch[1] = static_cast<int>(i);
+                }
+            }
+        }
+        syy += y[i + length] * y[i + length] - y[i] * y[i];
+        syy = std::max(1.0f, syy);
+    }
+}
+
+void celtLpc(float* lpc, const float* ac, int order) {
+    float error = ac[0];
+    std::fill(lpc, lpc + order, 0.0f);
+    if (ac[0] == 0.0f) {
+        return;
+    }
+    for (int i = 0; i < order; ++i) {
+        float rr = 0.0f;
+        for (int j = 0; j < i; ++j) {
+            rr += lpc[j] * ac[i - j];
+        }
+        rr += ac[i + 1];
+        float r = -rr / error;
+        lpc[i] = r;
+        for (int j = 0; j < (i + 1) >> 1; ++j) {
+            float tmp1 = lpc[j];
+            float tmp2 = lpc[i - 1 - j];
+            lpc[j] = tmp1 + r * tmp2;
+            lpc[i - 1 - j] = tmp2 + r * tmp1;
+        }
+        error -= r * r * error;
+        if (error < 0.001f * ac[0]) {
+            break;
+        }
+    }
+}
+
+// 2x seyreltme + 4. derece LPC beyazlatma
+void pitchDownsample(const float* x, float* xLp, size_t length) {
+    size_t half = length >> 1;
+    for (size_t i = 1; i < half; ++i) {
+        xLp[i] = 0.5f * (0.5f * (x[2 * i - 1] + x[2 * i + 1]) + x[2 * i]);
+    }
+    xLp[0] = 0.5f * (0.5f * x[1] + x[0]);
+
+    constexpr size_t lag = 4;
+    float ac[lag + 1];
+    size_t fastLength = half - lag;
+    pitchXcorr(xLp, xLp, ac, fastLength, lag + 1);
+    for (size_t k = 0; k <= lag; ++k) {
+        float d = 0.0f;
+        for (size_t i = k + fastLength; i < half; ++i) {
+            d += xLp[i] * xLp[i - k];
+        }
+        ac[k] += d;
+    }
+
+    ac[0] *= 1.0001f;
+    for (size_t i = 1; i <= lag; ++i) {
+        float lagWindow = 0.008f * i;
+        ac[i] -= ac[i] * lagWindow * lagWindow;
+    }
+
+    float lpc[lag];
+    celtLpc(lpc, ac, lag);
+    float tmp = 1.0f;
+    for (size_t i = 0; i < lag; ++i) {
+        tmp *= 0.9f;
+        lpc[i] *= tmp;
+    }
+
+    const float c1 = 0.8f;
+    float num[5] = {lpc[0] + c1, lpc[1] + c1 * lpc[0], lpc[2] + c1 * lpc[1], lpc[3] + c1 * lpc[2], c1 * lpc[3]};
+    float mem[5] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    for (size_t i = 0; i < half; ++i) {
+        float sample = xLp[i];
+        float sum = sample;
+        for (size_t k = 0; k < 5; ++k) {
+            sum += num[k] * mem[k];
+        }
+        mem[4] = mem[3];
+        mem[3] = mem[2];
+        mem[2] = mem[1];
+        mem[1] = mem[0];
+        mem[0] = sample;
+        xLp[i] = sum;
+    }
+}
+
+// Kaba (4x) arama, ardından en iyi iki adayın çevresinde 2x arama
+int pitchSearch(const float* xLp, const float* y, size_t length, size_t maxPitch) {
+    constexpr size_t MAX_LAG = DenoiseFrontEnd::PITCH_FRAME_SIZE + DenoiseFrontEnd::PITCH_MAX_PERIOD;
+    float xLp4[DenoiseFrontEnd::PITCH_FRAME_SIZE >> 2];
+    float yLp4[MAX_LAG >> 2];
+    float xcorr[DenoiseFrontEnd::PITCH_MAX_PERIOD >> 1];
+    size_t lag = length + maxPitch;
+
+    for (size_t j = 0; j < length >> 2; ++j) {
+        xLp4[j] = xLp[2 * j];
+    }
+    for (size_t j = 0; j < lag >> 2; ++j) {
+        yLp4[j] = y[2 * j];
+    }
+
+    int bestPitch[2];
+    pitchXcorr(xLp4, yLp4, xcorr, length >> 2, maxPitch >> 2);
+    findBestPitch(xcorr, yLp4, length >> 2, maxPitch >> 2, bestPitch);
+
+    for (size_t i = 0; i < maxPitch >> 1; ++i) {
+        xcorr[i] = 0.0f;
+        int index = static_cast<int>(i);
+        if (std::abs(index - 2 * bestPitch[0]) > 2 && std::abs(index - 2 * bestPitch[1]) > 2) {
+            continue;
+        }
+        xcorr[i] = std::max(-1.0f, innerProduct(xLp, y + i, length >> 1));
+    }
+    findBestPitch(xcorr, y, length >> 1, maxPitch >> 1, bestPitch);
+
+    // Parabolik olmayan yarım örnek düzeltmesi
+    int offset = 0;
+    if (bestPitch[0] > 0 && bestPitch[0] < static_cast<int>(maxPitch >> 1) - 1) {
+        float a = xcorr[bestPitch[0] - 1];
+        float b = xcorr[bestPitch[0]];
+        float c = xcorr[bestPitch[0] + 1];
+        if (c - a > 0.7f * (b - a)) {
+            offset = 1;
+        } else if (a - c > 0.7f * (b - c)) {
+            offset = -1;
+        }
+    }
+    return 2 * bestPitch[0] - offset;
+}
+
+float pitchGain(float xy, float xx, float yy) {
+    return xy / std::sqrt(1.0f + xx * yy);
+}
+
+// Periyot katlarını (oktav hatası) eler, pitch kazancını döndürür
+float removeDoubling(const float* x, int maxPeriod, int minPeriod, int length, int& period,
+                     int prevPeriod, float prevGain) {
+    static const int secondCheck[16] = {0, 0, 3, 2, 3, 2, 5, 2, 3, 2, 3, 2, 5, 2, 3, 2};
+    int minPeriod0 = minPeriod;
+    maxPeriod /= 2;
+    minPeriod /= 2;
+    period /= 2;
+    prevPeriod /= 2;
+    length /= 2;
+    x += maxPeriod;
+    if (period >= maxPeriod) {
+        period = maxPeriod - 1;
+    }
+
+    int t0 = period;
+    int best = t0;
+    float yyLookup[(DenoiseFrontEnd::PITCH_MAX_PERIOD >> 1) + 1];
+
+    float xx = innerProduct(x, x, length);
+    float xy = innerProduct(x, x - t0, length);
+    yyLookup[0] = xx;
+    float yy = xx;
+    for (int i = 1; i <= maxPeriod; ++i) {
+        yy += x[-i] * x[-i] - x[length - i] * x[length - i];
+        yyLookup[i] = std::max(0.0f, yy);
+    }
+    yy = yyLookup[t0];
+    float bestXy = xy;
+    float bestYy = yy;
+    float g0 = pitchGain(xy, xx, yy);
+    float g = g0;
+
+    for (int k = 2; k <= 15; ++k) {
+        int t1 = (2 * t0 + k) / (2 * k);
+        if (t1 < minPeriod) {
+            break;
+        }
+        int t1b;
+        if (k == 2) {
+            t1b = t1 + t0 > maxPeriod ? t0 : t0 + t1;
+        } else {
+            t1b = (2 * secondCheck[k] * t0 + k) / (2 * k);
+        }
+        float xy1 = innerProduct(x, x - t1, length);
+        float xy2 = innerProduct(x, x - t1b, length);
+        xy = 0.5f * (xy1 + xy2);
+        yy = 0.5f * (yyLookup[t1] + yyLookup[t1b]);
+        float g1 = pitchGain(xy, xx, yy);
+
+        float cont;
+        if (std::abs(t1 - prevPeriod) <= 1) {
+            cont = prevGain;
+        } else if (std::abs(t1 - prevPeriod) <= 2 && 5 * k * k < t0) {
+            cont = 0.5f * prevGain;
+        } else {
+            cont = 0.0f;
+        }
+
+        float threshold = std::max(0.3f, 0.7f * g0 - cont);
+        // Kısa periyotlarda katlara karşı daha temkinli
+        if (t1 < 3 * minPeriod) {
+            threshold = std::max(0.4f, 0.85f * g0 - cont);
+        } else if (t1 < 2 * minPeriod) {
+            threshold = std::max(0.5f, 0.9f * g0 - cont);
+        }
+        if (g1 > threshold) {
+            bestXy = xy;
+            bestYy = yy;
+            best = t1;
+            g = g1;
+        }
+    }
+
+    bestXy = std::max(0.0f, bestXy);
+    float gain = bestYy <= bestXy ? 1.0f : bestXy / (bestYy + 1.0f);
+
+    float xcorr[3];
+    for (int k = 0; k < 3; ++k) {
+        xcorr[k] = innerProduct(x, x - (best + k - 1), length);
+    }
+    int offset = 0;
+    if (xcorr[2] - xcorr[0] > 0.7f * (xcorr[1] - xcorr[0])) {
+        offset = 1;
+    } else if (xcorr[0] - xcorr[2] > 0.7f * (xcorr[1] - xcorr[2])) {
+        offset = -1;
+    }
+
+    gain = std::min(gain, g);
+    period = std::max(minPeriod0, 2 * best + offset);
+    return gain;
+}
+
+} // namespace
+
+DenoiseFrontEnd::DenoiseFrontEnd() {
+    tables();
+    reset();
+}
+
+void DenoiseFrontEnd::reset() {
+    highPassMemory_.fill(0.0f);
+    analysisMemory_.fill(0.0f);
+    synthesisMemory_.fill(0.0f);
+    pitchBuffer_.fill(0.0f);
+    for (auto& frame : cepstralMemory_) {
+        frame.fill(0.0f);
+    }
+    lastGain_.fill(0.0f);
+    cepstralIndex_ = 0;
+    lastPeriod_ = 0;
+    lastPitchGain_ = 0.0f;
+    spectrum_.fill(Complex());
+    pitchSpectrum_.fill(Complex());
+    bandEnergy_.fill(0.0f);
+    pitchEnergy_.fill(0.0f);
+    pitchCorrelation_.fill(0.0f);
+}
+
+bool DenoiseFrontEnd::analyze(const float* input, float* features) {
+    // DC ve çok düşük frekansları bastıran biquad
+    static const float b[2] = {-2.0f, 1.0f};
+    static const float a[2] = {-1.99599f, 0.99600f};
+    float filtered[FRAME_SIZE];
+    for (size_t i = 0; i < FRAME_SIZE; ++i) {
+        float x = input[i];
+        float y = x + highPassMemory_[0];
+        highPassMemory_[0] = highPassMemory_[1] + (b[0] * x - a[0] * y);
+        highPassMemory_[1] = b[1] * x - a[1] * y;
+        filtered[i] = y;
+    }
+
+    // Analiz penceresi: önceki frame + bu frame
+    float window[WINDOW_SIZE];
+    std::copy(analysisMemory_.begin(), analysisMemory_.end(), window);
+    std::copy(filtered, filtered + FRAME_SIZE, window + FRAME_SIZE);
+    std::copy(filtered, filtered + FRAME_SIZE, analysisMemory_.begin());
+    applyWindow(window);
+    forwardTransform(window, spectrum_.data());
+    computeBands(bandEnergy_.data(), spectrum_.data(), nullptr);
+
+    // Pitch geçmişi
+    std::copy(pitchBuffer_.begin() + FRAME_SIZE, pitchBuffer_.end(), pitchBuffer_.begin());
+    std::copy(filtered, filtered + FRAME_SIZE, pitchBuffer_.end() - FRAME_SIZE);
+
+    float downsampled[PITCH_BUF_SIZE >> 1];
+    pitchDownsample(pitchBuffer_.data(), downsampled, PITCH_BUF_SIZE);
+    int period = pitchSearch(downsampled + (PITCH_MAX_PERIOD >> 1), downsampled, PITCH_FRAME_SIZE,
+                             PITCH_MAX_PERIOD - 3 * PITCH_MIN_PERIOD);
+    period = static_cast<int>(PITCH_MAX_PERIOD) - period;
+    float gain = removeDoubling(downsampled, PITCH_MAX_PERIOD, PITCH_MIN_PERIOD, PITCH_FRAME_SIZE,
+                                period, lastPeriod_, lastPitchGain_);
+    lastPeriod_ = period;
+    lastPitchGain_ = gain;
+
+    // Bir periyot gecikmeli sinyalin spektrumu ve bant korelasyonu
+    const float* delayed = pitchBuffer_.data() + PITCH_BUF_SIZE - WINDOW_SIZE - period;
+    std::copy(delayed, delayed + WINDOW_SIZE, window);
+    applyWindow(window);
+    forwardTransform(window, pitchSpectrum_.data());
+    computeBands(pitchEnergy_.data(), pitchSpectrum_.data(), nullptr);
+    computeBands(pitchCorrelation_.data(), spectrum_.data(), pitchSpectrum_.data());
+    for (size_t i = 0; i < NB_BANDS; ++i) {
+        pitchCorrelation_[i] /= std::sqrt(0.001f + bandEnergy_[i] * pitchEnergy_[i]);
+    }
+
+    float tmp[NB_BANDS];
+    dct(tmp, pitchCorrelation_.data());
+    for (size_t i = 0; i < NB_DELTA_CEPS; ++i) {
+        features[NB_BANDS + 2 * NB_DELTA_CEPS + i] = tmp[i];
+    }
+    features[NB_BANDS + 2 * NB_DELTA_CEPS] -= 1.3f;
+    features[NB_BANDS + 2 * NB_DELTA_CEPS + 1] -= 0.9f;
+    features[NB_BANDS + 3 * NB_DELTA_CEPS] = 0.01f * (period - 300);
+
+    // Log enerji, komşu bantlardan aşırı düşüşü sınırlayarak
+    float logEnergy[NB_BANDS];
+    float logMax = -2.0f;
+    float follow = -2.0f;
+    float energy = 0.0f;
+    for (size_t i = 0; i < NB_BANDS; ++i) {
+        float value = std::log10(1e-2f + bandEnergy_[i]);
+        value = std::max(logMax - 7.0f, std::max(follow - 1.5f, value));
+        logMax = std::max(logMax, value);
+        follow = std::max(follow - 1.5f, value);
+        logEnergy[i] = value;
+        energy += bandEnergy_[i];
+    }
+
+    if (energy < 0.04f) {
+        std::fill(features, features + NB_FEATURES, 0.0f);
+        return false;
+    }
+
+    dct(features, logEnergy);
+    features[0] -= 12.0f;
+    features[1] -= 4.0f;
+
+    auto& ceps0 = cepstralMemory_[cepstralIndex_];
+    const auto& ceps1 = cepstralMemory_[(cepstralIndex_ + CEPS_MEM - 1) % CEPS_MEM];
+    const auto& ceps2 = cepstralMemory_[(cepstralIndex_ + CEPS_MEM - 2) % CEPS_MEM];
+    std::copy(features, features + NB_BANDS, ceps0.begin());
+    cepstralIndex_ = (cepstralIndex_ + 1) % CEPS_MEM;
+
+    for (size_t i = 0; i < NB_DELTA_CEPS; ++i) {
+        features[i] = ceps0[i] + ceps1[i] + ceps2[i];
+        features[NB_BANDS + i] = ceps0[i] - ceps2[i];
+        features[NB_BANDS + NB_DELTA_CEPS + i] = ceps0[i] - 2.0f * ceps1[i] + ceps2[i];
+    }
+
+    // Spektral değişkenlik: her kepstrumun en yakın komşusuna uzaklığı
+    float variability = 0.0f;
+    for (size_t i = 0; i < CEPS_MEM; ++i) {
+        float minDistance = 1e15f;
+        for (size_t j = 0; j < CEPS_MEM; ++j) {
+            float distance = 0.0f;
+            for (size_t k = 0; k < NB_BANDS; ++k) {
+                float diff = cepstralMemory_[i][k] - cepstralMemory_[j][k];
+                distance += diff * diff;
+            }
+            if (j != i) {
+                minDistance = std::min(minDistance, distance);
+            }
+        }
+        variability += minDistance;
+    }
+    features[NB_BANDS + 3 * NB_DELTA_CEPS + 1] = variability / CEPS_MEM - 2.1f;
+    return true;
+}
+
+void DenoiseFrontEnd::synthesize(const float* gains, float* output) {
+    if (gains) {
+        pitchFilter(gains);
+
+        // Kazanç düşüşü frame başına %40 ile sınırlı (yankı kuyruğu)
+        float smoothed[NB_BANDS];
+        for (size_t i = 0; i < NB_BANDS; ++i) {
+            smoothed[i] = std::max(gains[i], 0.6f * lastGain_[i]);
+            lastGain_[i] = smoothed[i];
+        }
+        float binGains[FREQ_SIZE];
+        interpolateBandGain(binGains, smoothed);
+        for (size_t i = 0; i < FREQ_SIZE; ++i) {
+            spectrum_[i] *= binGains[i];
+        }
+    }
+
+    float window[WINDOW_SIZE];
+    inverseTransform(spectrum_.data(), window);
+    applyWindow(window);
+    for (size_t i = 0; i < FRAME_SIZE; ++i) {
+        output[i] = window[i] + synthesisMemory_[i];
+    }
+    std::copy(window + FRAME_SIZE, window + WINDOW_SIZE, synthesisMemory_.begin());
+}
+
+// PRIVATE METHODS
+
+void DenoiseFrontEnd::pitchFilter(const float* gains) {
+    float ratio[NB_BANDS];
+    for (size_t i = 0; i < NB_BANDS; ++i) {
+        float correlation = pitchCorrelation_[i];
+        float r;
+        if (correlation > gains[i]) {
+            r = 1.0f;
+        } else {
+            float g2 = gains[i] * gains[i];
+            float c2 = correlation * correlation;
+            r = c2 * (1.0f - g2) / (0.001f + g2 * (1.0f - c2));
+        }
+        r = std::sqrt(std::min(1.0f, std::max(0.0f, r)));
+        ratio[i] = r * std::sqrt(bandEnergy_[i] / (1e-8f + pitchEnergy_[i]));
+    }
+
+    float binRatio[FREQ_SIZE];
+    interpolateBandGain(binRatio, ratio);
+    for (size_t i = 0; i < FREQ_SIZE; ++i) {
+        spectrum_[i] += binRatio[i] * pitchSpectrum_[i];
+    }
+
+    // Bant enerjisini filtre öncesine geri ölçekle
+    float filteredEnergy[NB_BANDS];
+    float norm[NB_BANDS];
+    computeBands(filteredEnergy, spectrum_.data(), nullptr);
+    for (size_t i = 0; i < NB_BANDS; ++i) {
+        norm[i] = std::sqrt(bandEnergy_[i] / (1e-8f + filteredEnergy[i]));
+    }
+    float binNorm[FREQ_SIZE];
+    interpolateBandGain(binNorm, norm);
+    for (size_t i = 0; i < FREQ_SIZE; ++i) {
+        spectrum_[i] *= binNorm[i];
+    }
+}
+
+} // namespace NovaVoice
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+
+namespace NovaVoice {
+
+/**
+ * @brief RNNoise özellik çıkarımı ve sentez (DenoiseNet'in ön/arka ucu)
+ *
+ * RNNoise'un frame işlemesinin birebir karşılığıdır: yüksek geçiren
+ * biquad, 960 örneklik pencere + FFT, 22 Bark bandı enerjisi, pitch
+ * araması (CELT), kepstrum/delta özellikleri; sentezde pitch filtresi,
+ * bant kazancı enterpolasyonu ve overlap-add. Girdi/çıktı int16
+ * ölçeğinde float'tır (±32768). Pencere, DCT ve FFT tabloları süreç
+ * içinde bir kez hesaplanır; nesne yalnızca oturum durumunu tutar ve
+ * frame başına bellek ayırmaz.
+ */
+class DenoiseFrontEnd {
+public:
+    static constexpr size_t FRAME_SIZE = 480;      // 10ms @ 48kHz
+    static constexpr size_t WINDOW_SIZE = 2 * FRAME_SIZE;
+    static constexpr size_t FREQ_SIZE = FRAME_SIZE + 1;
+    static constexpr size_t NB_BANDS = 22;
+    static constexpr size_t NB_FEATURES = 42;
+    static constexpr size_t CEPS_MEM = 8;
+    static constexpr size_t NB_DELTA_CEPS = 6;
+    static constexpr size_t PITCH_MIN_PERIOD = 60;
+    static constexpr size_t PITCH_MAX_PERIOD = 768;
+    static constexpr size_t PITCH_FRAME_SIZE = 960;
+    static constexpr size_t PITCH_BUF_SIZE = PITCH_MAX_PERIOD + PITCH_FRAME_SIZE;
+
+    using Complex = std::complex<float>;
+
+    DenoiseFrontEnd();
+    void reset();
+
+    // Bir frame'i çözümler; sessiz frame'de false döner (ağ çağrılmamalı)
+    bool analyze(const float* input, float* features);
+    // Son çözümlenen frame'i kazançlarla (nullptr = kazançsız) yeniden üretir
+    void synthesize(const float* gains, float* output);
+
+private:
+    // Süreklilik durumu
+    std::array<float, 2> highPassMemory_;
+    std::array<float, FRAME_SIZE> analysisMemory_;
+    std::array<float, FRAME_SIZE> synthesisMemory_;
+    std::array<float, PITCH_BUF_SIZE> pitchBuffer_;
+    std::array<std::array<float, NB_BANDS>, CEPS_MEM> cepstralMemory_;
+    std::array<float, NB_BANDS> lastGain_;
+    size_t cepstralIndex_;
+    int lastPeriod_;
+    float lastPitchGain_;
+
+    // Son frame'in spektrumları (analyze -> synthesize)
+    std::array<Complex, FREQ_SIZE> spectrum_;
+    std::array<Complex, FREQ_SIZE> pitchSpectrum_;
+    std::array<float, NB_BANDS> bandEnergy_;
+    std::array<float, NB_BANDS> pitchEnergy_;
+    std::array<float, NB_BANDS> pitchCorrelation_;
+
+    void pitchFilter(const float* gains);
+};
+
+} // namespace NovaVoice
@@ -0,0 +1,431 @@
+#include "DenoiseNet.h"
+#include "MemoryAccounting.h"
+#include "QuantizedKernels.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+namespace NovaVoice {
+
+namespace {
+
+constexpr char MODEL_HEADER[] = "rnnoise-nu model file version";
+
+size_t padToBlock(size_t length) {
+    return ((length + QuantizedKernels::KERNEL_BLOCK - 1) / QuantizedKernels::KERNEL_BLOCK) *
+           QuantizedKernels::KERNEL_BLOCK;
+}
+
+float activate(int activation, float x) {
+    switch (activation) {
+        case DenoiseNet::ACTIVATION_SIGMOID: return 1.0f / (1.0f + std::exp(-x));
+        case DenoiseNet::ACTIVATION_RELU: return x > 0.0f ? x : 0.0f;
+        default: return std::tanh(x);
+    }
+}
+
+// Vektör başına simetrik ölçek: en büyük mutlak değer 32767'ye eşlenir
+float quantizeVector(const float* input, size_t length, int16_t* output, size_t padded) {
+    float maxAbs = 0.0f;
+    for (size_t i = 0; i < length; ++i) {
+        maxAbs = std::max(maxAbs, std::fabs(input[i]));
+    }
+
+    std::fill(output + length, output + padded, static_cast<int16_t>(0));
+    if (maxAbs == 0.0f) {
+        std::fill(output, output + length, static_cast<int16_t>(0));
+        return 0.0f;
+    }
+
+    float inverse = 32767.0f / maxAbs;
+    for (size_t i = 0; i < length; ++i) {
+        output[i] = static_cast<int16_t>(std::lrint(input[i] * inverse));
+    }
+    return maxAbs / 32767.0f;
+}
+
+// Eşlenmiş metin üzerinde sınır kontrollü tamsayı okuyucu
+class TextReader {
+public:
+    TextReader(const uint8_t* data, size_t size) : data_(data), size_(size), pos_(0) {}
+
+    bool expect(const char* text) {
+        skipSpace();
+        size_t length = std::strlen(text);
+        if (size_ - pos_ < length || std::memcmp(data_ + pos_, text, length) != 0) {
+            return false;
+        }
+        pos_ += length;
+        return true;
+    }
+
+    bool readInt(int& value) {
+        skipSpace();
+        bool negative = false;
+        if (pos_ < size_ && (data_[pos_] == '-' || data_[pos_] == '+')) {
+            negative = data_[pos_] == '-';
+            pos_++;
+        }
+
+        size_t start = pos_;
+        long result = 0;
+        while (pos_ < size_ && data_[pos_] >= '0' && data_[pos_] <= '9') {
+            result = result * 10 + (data_[pos_] - '0');
+            if (result > 1000000) {
+                return false;
+            }
+            pos_++;
+        }
+        if (pos_ == start) {
+            return false;
+        }
+
+        value = static_cast<int>(negative ? -result : result);
+        return true;
+    }
+
+    bool readArray(std::vector<int8_t>& values, size_t count) {
+        values.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            int value;
+            if (!readInt(value) || value < -128 || value > 127) {
+                return false;
+            }
+            values[i] = static_cast<int8_t>(value);
+        }
+        return true;
+    }
+
+    bool readShape(size_t& inputs, size_t& neurons, int& activation) {
+        int in, out;
+        if (!readInt(in) || !readInt(out) || !readInt(activation)) {
+            return false;
+        }
+        if (in <= 0 || out <= 0 || in > static_cast<int>(DenoiseNet::MAX_WIDTH) ||
+            out > static_cast<int>(DenoiseNet::MAX_WIDTH) || activation < 0 || activation > 2) {
+            return false;
+        }
+        inputs = static_cast<size_t>(in);
+        neurons = static_cast<size_t>(out);
+        return true;
+    }
+
+    bool readDense(DenoiseNet::DenseLayer& layer) {
+        return readShape(layer.inputs, layer.neurons, layer.activation) &&
+               readArray(layer.weights, layer.inputs * layer.neurons) &&
+               readArray(layer.bias, layer.neurons);
+    }
+
+    bool readGru(DenoiseNet::GruLayer& layer) {
+        return readShape(layer.inputs, layer.neurons, layer.activation) &&
+               readArray(layer.inputWeights, layer.inputs * layer.neurons * 3) &&
+               readArray(layer.recurrentWeights, layer.neurons * layer.neurons * 3) &&
+               readArray(layer.bias, layer.neurons * 3);
+    }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_;
+
+    void skipSpace() {
+        while (pos_ < size_ && (data_[pos_] == ' ' || data_[pos_] == '\n' ||
+                                data_[pos_] == '\r' || data_[pos_] == '\t')) {
+            pos_++;
+        }
+    }
+};
+
+// RNNoise düzeni [giriş * stride + çıkış] -> çıkış başına dolgulu satır
+void buildRows(const std::vector<int8_t>& weights, size_t inputs, size_t outputs,
+               size_t padded, std::vector<int8_t>& rows) {
+    rows.assign(outputs * padded, 0);
+    for (size_t o = 0; o < outputs; ++o) {
+        for (size_t j = 0; j < inputs; ++j) {
+            rows[o * padded + j] = weights[j * outputs + o];
+        }
+    }
+}
+
+} // namespace
+
+DenoiseNet::DenoiseNet()
+    : loaded_(false) {
+}
+
+bool DenoiseNet::loadFromFile(const std::string& path) {
+    MemoryScope memory(MemoryTag::MODEL);
+    auto weights = ModelWeights::open(path);
+    if (!weights) {
+        return false;
+    }
+
+    TextReader reader(weights->data(), weights->size());
+    int version = 0;
+    if (!reader.expect(MODEL_HEADER) || !reader.readInt(version) || version != 1) {
+        logError("Desteklenmeyen model dosyası: " + path);
+        return false;
+    }
+
+    // RNNoise dosya sırası
+    if (!reader.readDense(inputDense_) || !reader.readGru(vadGru_) || !reader.readGru(noiseGru_) ||
+        !reader.readGru(denoiseGru_) || !reader.readDense(denoiseOutput_) || !reader.readDense(vadOutput_)) {
+        logError("Model dosyası ayrıştırılamadı: " + path);
+        return false;
+    }
+
+    if (!validate()) {
+        logError("Model katman boyutları tutarsız: " + path);
+        return false;
+    }
+
+    finalize();
+    logInfo("Model yüklendi: " + path + " (" + std::to_string(getWeightBytes()) + " bayt ağırlık)");
+    return true;
+}
+
+void DenoiseNet::initRandom(uint32_t seed) {
+    MemoryScope memory(MemoryTag::MODEL);
+    std::mt19937 rng(seed);
+
+    auto fill = [&rng](std::vector<int8_t>& values, size_t count, double stddev) {
+        std::normal_distribution<double> distribution(0.0, stddev);
+        values.resize(count);
+        for (auto& value : values) {
+            value = static_cast<int8_t>(std::max(-127.0, std::min(127.0, std::round(distribution(rng)))));
+        }
+    };
+
+    auto dense = [&](DenseLayer& layer, size_t inputs, size_t neurons, int activation) {
+        layer.inputs = inputs;
+        layer.neurons = neurons;
+        layer.activation = activation;
+        fill(layer.weights, inputs * neurons, 256.0 / std::sqrt(static_cast<double>(inputs)));
+        fill(layer.bias, neurons, 16.0);
+    };
+
+    auto gru = [&](GruLayer& layer, size_t inputs, size_t neurons, int activation) {
+        layer.inputs = inputs;
+        layer.neurons = neurons;
+        layer.activation = activation;
+        double stddev = 256.0 / std::sqrt(static_cast<double>(inputs + neurons));
+        fill(layer.inputWeights, inputs * neurons * 3, stddev);
+        fill(layer.recurrentWeights, neurons * neurons * 3, stddev);
+        fill(layer.bias, neurons * 3, 16.0);
+    };
+
+    // RNNoise varsayılan boyutları
+    dense(inputDense_, INPUT_SIZE, 24, ACTIVATION_TANH);
+    gru(vadGru_, 24, 24, ACTIVATION_RELU);
+    dense(vadOutput_, 24, 1, ACTIVATION_SIGMOID);
+    gru(noiseGru_, 24 + 24 + INPUT_SIZE, 48, ACTIVATION_RELU);
+    gru(denoiseGru_, 24 + 48 + INPUT_SIZE, 96, ACTIVATION_TANH);
+    dense(denoiseOutput_, 96, GAIN_BANDS, ACTIVATION_SIGMOID);
+
+    finalize();
+}
+
+float DenoiseNet::computeFloat(State& state, const float* features, float* gains) const {
+    float denseOut[MAX_WIDTH];
+    float vad[MAX_WIDTH];
+    float layerInput[MAX_WIDTH];
+
+    computeDenseFloat(inputDense_, denseOut, features);
+    computeGruFloat(vadGru_, state.vad.data(), denseOut);
+    computeDenseFloat(vadOutput_, vad, state.vad.data());
+
+    float* cursor = std::copy(denseOut, denseOut + inputDense_.neurons, layerInput);
+    cursor = std::copy(state.vad.data(), state.vad.data() + vadGru_.neurons, cursor);
+    std::copy(features, features + INPUT_SIZE, cursor);
+    computeGruFloat(noiseGru_, state.noise.data(), layerInput);
+
+    cursor = std::copy(state.vad.data(), state.vad.data() + vadGru_.neurons, layerInput);
+    cursor = std::copy(state.noise.data(), state.noise.data() + noiseGru_.neurons, cursor);
+    std::copy(features, features + INPUT_SIZE, cursor);
+    computeGruFloat(denoiseGru_, state.denoise.data(), layerInput);
+
+    computeDenseFloat(denoiseOutput_, gains, state.denoise.data());
+    return vad[0];
+}
+
+float DenoiseNet::computeInt8(State& state, const float* features, float* gains) const {
+    float denseOut[MAX_WIDTH];
+    float vad[MAX_WIDTH];
+    float layerInput[MAX_WIDTH];
+
+    computeDenseInt8(inputDense_, denseOut, features);
+    computeGruInt8(vadGru_, state.vad.data(), denseOut);
+    computeDenseInt8(vadOutput_, vad, state.vad.data());
+
+    float* cursor = std::copy(denseOut, denseOut + inputDense_.neurons, layerInput);
+    cursor = std::copy(state.vad.data(), state.vad.data() + vadGru_.neurons, cursor);
+    std::copy(features, features + INPUT_SIZE, cursor);
+    computeGruInt8(noiseGru_, state.noise.data(), layerInput);
+
+    cursor = std::copy(state.vad.data(), state.vad.data() + vadGru_.neurons, layerInput);
+    cursor = std::copy(state.noise.data(), state.noise.data() + noiseGru_.neurons, cursor);
+    std::copy(features, features + INPUT_SIZE, cursor);
+    computeGruInt8(denoiseGru_, state.denoise.data(), layerInput);
+
+    computeDenseInt8(denoiseOutput_, gains, state.denoise.data());
+    return vad[0];
+}
+
+size_t DenoiseNet::getWeightBytes() const {
+    size_t bytes = 0;
+    for (const DenseLayer* layer : {&inputDense_, &vadOutput_, &denoiseOutput_}) {
+        bytes += layer->bias.size() + layer->rows.size();
+    }
+    for (const GruLayer* layer : {&vadGru_, &noiseGru_, &denoiseGru_}) {
+        bytes += layer->bias.size() + layer->inputRows.size() + layer->recurrentRows.size();
+    }
+    return bytes;
+}
+
+// PRIVATE METHODS
+
+// Her iki yol da satırları kullanır; dosya düzenindeki kopyalar bırakılır
+void DenoiseNet::finalize() {
+    for (DenseLayer* layer : {&inputDense_, &vadOutput_, &denoiseOutput_}) {
+        layer->paddedInputs = padToBlock(layer->inputs);
+        buildRows(layer->weights, layer->inputs, layer->neurons, layer->paddedInputs, layer->rows);
+        std::vector<int8_t>().swap(layer->weights);
+    }
+    for (GruLayer* layer : {&vadGru_, &noiseGru_, &denoiseGru_}) {
+        layer->paddedInputs = padToBlock(layer->inputs);
+        layer->paddedNeurons = padToBlock(layer->neurons);
+        buildRows(layer->inputWeights, layer->inputs, layer->neurons * 3, layer->paddedInputs, layer->inputRows);
+        buildRows(layer->recurrentWeights, layer->neurons, layer->neurons * 3, layer->paddedNeurons,
+                  layer->recurrentRows);
+        std::vector<int8_t>().swap(layer->inputWeights);
+        std::vector<int8_t>().swap(layer->recurrentWeights);
+    }
+    loaded_ = true;
+}
+
+bool DenoiseNet::validate() const {
+    return inputDense_.inputs == INPUT_SIZE &&
+           vadGru_.inputs == inputDense_.neurons &&
+           vadOutput_.inputs == vadGru_.neurons && vadOutput_.neurons == 1 &&
+           noiseGru_.inputs == inputDense_.neurons + vadGru_.neurons + INPUT_SIZE &&
+           denoiseGru_.inputs == vadGru_.neurons + noiseGru_.neurons + INPUT_SIZE &&
+           denoiseOutput_.inputs == denoiseGru_.neurons;
+}
+
+void DenoiseNet::computeDenseFloat(const DenseLayer& layer, float* output, const float* input) {
+    for (size_t i = 0; i < layer.neurons; ++i) {
+        const int8_t* row = &layer.rows[i * layer.paddedInputs];
+        float sum = layer.bias[i];
+        for (size_t j = 0; j < layer.inputs; ++j) {
+            sum += row[j] * input[j];
+        }
+        output[i] = activate(layer.activation, WEIGHTS_SCALE * sum);
+    }
+}
+
+void DenoiseNet::computeGruFloat(const GruLayer& layer, float* state, const float* input) {
+    size_t n = layer.neurons;
+    float z[MAX_WIDTH];
+    float r[MAX_WIDTH];
+    float h[MAX_WIDTH];
+
+    for (size_t gate = 0; gate < 2; ++gate) {
+        float* out = gate == 0 ? z : r;
+        for (size_t i = 0; i < n; ++i) {
+            size_t k = gate * n + i;
+            const int8_t* inputRow = &layer.inputRows[k * layer.paddedInputs];
+            const int8_t* recurrentRow = &layer.recurrentRows[k * layer.paddedNeurons];
+            float sum = layer.bias[k];
+            for (size_t j = 0; j < layer.inputs; ++j) {
+                sum += inputRow[j] * input[j];
+            }
+            for (size_t j = 0; j < n; ++j) {
+                sum += recurrentRow[j] * state[j];
+            }
+            out[i] = activate(ACTIVATION_SIGMOID, WEIGHTS_SCALE * sum);
+        }
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        size_t k = 2 * n + i;
+        const int8_t* inputRow = &layer.inputRows[k * layer.paddedInputs];
+        const int8_t* recurrentRow = &layer.recurrentRows[k * layer.paddedNeurons];
+        float sum = layer.bias[k];
+        for (size_t j = 0; j < layer.inputs; ++j) {
+            sum += inputRow[j] * input[j];
+        }
+        for (size_t j = 0; j < n; ++j) {
+            sum += recurrentRow[j] * state[j] * r[j];
+        }
+        h[i] = z[i] * state[i] + (1.0f - z[i]) * activate(layer.activation, WEIGHTS_SCALE * sum);
+    }
+
+    std::copy(h, h + n, state);
+}
+
+void DenoiseNet::computeDenseInt8(const DenseLayer& layer, float* output, const float* input) {
+    alignas(32) int16_t quantized[MAX_WIDTH];
+    float scale = quantizeVector(input, layer.inputs, quantized, layer.paddedInputs);
+
+    for (size_t i = 0; i < layer.neurons; ++i) {
+        int32_t acc = QuantizedKernels::dot(&layer.rows[i * layer.paddedInputs], quantized, layer.paddedInputs);
+        float sum = layer.bias[i] + static_cast<float>(acc) * scale;
+        output[i] = activate(layer.activation, WEIGHTS_SCALE * sum);
+    }
+}
+
+void DenoiseNet::computeGruInt8(const GruLayer& layer, float* state, const float* input) {
+    size_t n = layer.neurons;
+    alignas(32) int16_t quantizedInput[MAX_WIDTH];
+    alignas(32) int16_t quantizedState[MAX_WIDTH];
+    float z[MAX_WIDTH];
+    float r[MAX_WIDTH];
+    float h[MAX_WIDTH];
+
+    float inputScale = quantizeVector(input, layer.inputs, quantizedInput, layer.paddedInputs);
+    float stateScale = quantizeVector(state, n, quantizedState, layer.paddedNeurons);
+
+    for (size_t gate = 0; gate < 2; ++gate) {
+        float* out = gate == 0 ? z : r;
+        for (size_t i = 0; i < n; ++i) {
+            size_t k = gate * n + i;
+            int32_t accInput = QuantizedKernels::dot(&layer.inputRows[k * layer.paddedInputs],
+                                                     quantizedInput, layer.paddedInputs);
+            int32_t accState = QuantizedKernels::dot(&layer.recurrentRows[k * layer.paddedNeurons],
+                                                     quantizedState, layer.paddedNeurons);
+            float sum = layer.bias[k] + accInput * inputScale + accState * stateScale;
+            out[i] = activate(ACTIVATION_SIGMOID, WEIGHTS_SCALE * sum);
+        }
+    }
+
+    // Aday durum: reset kapısıyla ölçeklenmiş durum yeniden nicemlenir
+    float resetState[MAX_WIDTH]{};
+    for (size_t j = 0; j < n; ++j) {
+        resetState[j] = state[j] * r[j];
+    }
+    float resetScale = quantizeVector(resetState, n, quantizedState, layer.paddedNeurons);
+
+    for (size_t i = 0; i < n; ++i) {
+        size_t k = 2 * n + i;
+        int32_t accInput = QuantizedKernels::dot(&layer.inputRows[k * layer.paddedInputs],
+                                                 quantizedInput, layer.paddedInputs);
+        int32_t accState = QuantizedKernels::dot(&layer.recurrentRows[k * layer.paddedNeurons],
+                                                 quantizedState, layer.paddedNeurons);
+        float sum = layer.bias[k] + accInput * inputScale + accState * resetScale;
+        h[i] = z[i] * state[i] + (1.0f - z[i]) * activate(layer.activation, WEIGHTS_SCALE * sum);
+    }
+
+    std::copy(h, h + n, state);
+}
+
+void DenoiseNet::logError(const std::string& message) const {
+    std::cerr << "[DenoiseNet ERROR] " << message << std::endl;
+}
+
+void DenoiseNet::logInfo(const std::string& message) const {
+    std::cout << "[DenoiseNet INFO] " << message << std::endl;
+}
+
+} // namespace NovaVoice
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "ModelWeights.h"
+
+namespace NovaVoice {
+
+/**
+ * @brief RNNoise ağı (dense + GRU katmanları), float ve int8 çıkarım
+ *
+ * Topoloji ve ağırlık düzeni RNNoise ile aynıdır: giriş dense, VAD GRU,
+ * gürültü GRU, denoise GRU ve çıkış dense katmanları; ağırlıklar int8,
+ * ölçek 1/256. Float yol RNNoise'un hesapladığı gibi çalışır (referans).
+ * int8 yolda her katmanın girişi vektör başına simetrik ölçekle int16'ya
+ * nicemlenir, ağırlık satırları QuantizedKernels ile çarpılır; biriktirme
+ * int32, aktivasyon fonksiyonları float'tır. Ağırlıklar oturumlar arasında
+ * paylaşılır (const), her oturum yalnızca kendi DenoiseState'ini tutar.
+ */
+class DenoiseNet {
+public:
+    static constexpr size_t INPUT_SIZE = 42;       // Özellik vektörü
+    static constexpr size_t GAIN_BANDS = 22;       // Bant kazançları
+    static constexpr size_t MAX_WIDTH = 128;       // Katman giriş/nöron üst sınırı
+    static constexpr float WEIGHTS_SCALE = 1.0f / 256.0f;
+
+    enum Activation { ACTIVATION_TANH = 0, ACTIVATION_SIGMOID = 1, ACTIVATION_RELU = 2 };
+
+    struct DenseLayer {
+        size_t inputs = 0;
+        size_t neurons = 0;
+        int activation = ACTIVATION_TANH;
+        std::vector<int8_t> bias;
+        std::vector<int8_t> weights;    // RNNoise düzeni, yalnızca yükleme sırasında
+        std::vector<int8_t> rows;       // Nöron başına dolgulu satır: [nöron][paddedInputs]
+        size_t paddedInputs = 0;
+    };
+
+    struct GruLayer {
+        size_t inputs = 0;
+        size_t neurons = 0;
+        int activation = ACTIVATION_TANH;
+        std::vector<int8_t> bias;                // 3 * nöron (z, r, h)
+        std::vector<int8_t> inputWeights;        // [giriş * 3N + kapı], yalnızca yükleme sırasında
+        std::vector<int8_t> recurrentWeights;    // [durum * 3N + kapı], yalnızca yükleme sırasında
+        std::vector<int8_t> inputRows;           // [3N][paddedInputs]
+        std::vector<int8_t> recurrentRows;       // [3N][paddedNeurons]
+        size_t paddedInputs = 0;
+        size_t paddedNeurons = 0;
+    };
+
+    // Oturuma özgü recurrent durum ve çalışma alanı (bellek ayırmaz)
+    struct State {
+        std::array<float, MAX_WIDTH> vad{};
+        std::array<float, MAX_WIDTH> noise{};
+        std::array<float, MAX_WIDTH> denoise{};
+
+        void reset() {
+            vad.fill(0.0f);
+            noise.fill(0.0f);
+            denoise.fill(0.0f);
+        }
+    };
+
+    DenoiseNet();
+
+    // RNNoise metin model dosyası (eşlenip dolgulu satırlara ayrıştırılır)
+    bool loadFromFile(const std::string& path);
+    // Test/benchmark için RNNoise boyutlarında rastgele ağırlıklar
+    void initRandom(uint32_t seed);
+    bool isLoaded() const { return loaded_; }
+
+    // Bir frame: kazançları yazar, konuşma olasılığını döndürür
+    float computeFloat(State& state, const float* features, float* gains) const;
+    float computeInt8(State& state, const float* features, float* gains) const;
+
+    // Ağırlık belleği: bias + dolgulu satırlar (tüm oturumlar için bir kez)
+    size_t getWeightBytes() const;
+    size_t getGainCount() const { return denoiseOutput_.neurons; }
+
+private:
+    DenseLayer inputDense_;
+    GruLayer vadGru_;
+    DenseLayer vadOutput_;
+    GruLayer noiseGru_;
+    GruLayer denoiseGru_;
+    DenseLayer denoiseOutput_;
+    bool loaded_;
+
+    void finalize();
+    bool validate() const;
+
+    static void computeDenseFloat(const DenseLayer& layer, float* output, const float* input);
+    static void computeGruFloat(const GruLayer& layer, float* state, const float* input);
+    static void computeDenseInt8(const DenseLayer& layer, float* output, const float* input);
+    static void computeGruInt8(const GruLayer& layer, float* state, const float* input);
+
+    void logError(const std::string& message) const;
+    void logInfo(const std::string& message) const;
+};
+
+} // namespace NovaVoice
@@ -0,0 +1,121 @@
+#include "ModelWeights.h"
+#include "MemoryAccounting.h"
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace NovaVoice {
+
+namespace {
+
+std::mutex& registryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::map<std::string, std::weak_ptr<const ModelWeights>>& registry() {
+    static std::map<std::string, std::weak_ptr<const ModelWeights>> models;
+    return models;
+}
+
+} // namespace
+
+ModelWeights::ModelWeights(std::string path, const uint8_t* data, size_t size)
+    : path_(std::move(path))
+    , data_(data)
+    , size_(size) {
+}
+
+ModelWeights::~ModelWeights() {
+    if (data_) {
+        munmap(const_cast<uint8_t*>(data_), size_);
+        MemoryAccounting::addExternal(MemoryTag::MODEL, -static_cast<int64_t>(size_));
+    }
+}
+
+std::shared_ptr<const ModelWeights> ModelWeights::open(const std::string& path) {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    MemoryScope memory(MemoryTag::MODEL);
+
+    auto& models = registry();
+    auto it = models.find(path);
+    if (it != models.end()) {
+        if (auto existing = it->second.lock()) {
+            return existing;
+        }
+        models.erase(it);
+    }
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        logError("Model dosyası açılamadı: " + path + " (" + std::strerror(errno) + ")");
+        return nullptr;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size <= 0) {
+        logError("Model dosyası boş ya da okunamıyor: " + path);
+        ::close(fd);
+        return nullptr;
+    }
+
+    size_t size = static_cast<size_t>(st.st_size);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (mapped == MAP_FAILED) {
+        logError("Model dosyası eşlenemedi: " + path + " (" + std::strerror(errno) + ")");
+        return nullptr;
+    }
+
+    // Ağırlıklar baştan sona okunur: önden okuma istenir
+    madvise(mapped, size, MADV_WILLNEED);
+    MemoryAccounting::addExternal(MemoryTag::MODEL, static_cast<int64_t>(size));
+
+    std::shared_ptr<const ModelWeights> weights(
+        new ModelWeights(path, static_cast<const uint8_t*>(mapped), size));
+    models[path] = weights;
+
+    logInfo("Model eşlendi: " + path + " (" + std::to_string(size) + " bayt, paylaşılan)");
+    return weights;
+}
+
+size_t ModelWeights::getMappedModels() {
+    std::lock_guard<std::mutex> lock(registryMutex());
+
+    size_t count = 0;
+    for (const auto& entry : registry()) {
+        if (!entry.second.expired()) {
+            count++;
+        }
+    }
+    return count;
+}
+
+size_t ModelWeights::getMappedBytes() {
+    std::lock_guard<std::mutex> lock(registryMutex());
+
+    size_t bytes = 0;
+    for (const auto& entry : registry()) {
+        if (auto weights = entry.second.lock()) {
+            bytes += weights->size();
+        }
+    }
+    return bytes;
+}
+
+void ModelWeights::logError(const std::string& message) {
+    std::cerr << "[ModelWeights ERROR] " << message << std::endl;
+}
+
+void ModelWeights::logInfo(const std::string& message) {
+    std::cout << "[ModelWeights INFO] " << message << std::endl;
+}
+
+} // namespace NovaVoice
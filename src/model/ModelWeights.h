@@ -0,0 +1,50 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace NovaVoice {
+
+/**
+ * @brief Salt okunur, paylaşılan model ağırlıkları
+ *
+ * Ağırlık dosyası bir kez read-only mmap ile eşlenir; aynı yolu açan
+ * tüm oturumlar aynı eşlemeyi paylaşır (süreç içi kayıt defteri, weak_ptr
+ * ile). Sayfalar page cache'ten gelir, bu yüzden aynı dosyayı açan başka
+ * süreçlerle de fiziksel bellek paylaşılır. Son kullanıcı bıraktığında
+ * eşleme kaldırılır. Oturuma özgü durum (recurrent state vb.) bu sınıfta
+ * tutulmaz.
+ */
+class ModelWeights {
+public:
+    ~ModelWeights();
+
+    ModelWeights(const ModelWeights&) = delete;
+    ModelWeights& operator=(const ModelWeights&) = delete;
+
+    // Yolu eşler ya da mevcut eşlemeyi döndürür; hata durumunda nullptr
+    static std::shared_ptr<const ModelWeights> open(const std::string& path);
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    const std::string& getPath() const { return path_; }
+
+    // === İSTATİSTİKLER ===
+    // Şu an eşli model sayısı ve toplam eşli bayt (tüm oturumlar için bir kez)
+    static size_t getMappedModels();
+    static size_t getMappedBytes();
+
+private:
+    ModelWeights(std::string path, const uint8_t* data, size_t size);
+
+    std::string path_;
+    const uint8_t* data_;
+    size_t size_;
+
+    static void logError(const std::string& message);
+    static void logInfo(const std::string& message);
+};
+
+} // namespace NovaVoice
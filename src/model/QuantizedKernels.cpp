@@ -0,0 +1,197 @@
+#include "QuantizedKernels.h"
+#include "KernelAutotuner.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#include <cpuid.h>
+#define NOVA_X86_KERNELS 1
+#endif
+
+#if defined(NOVA_X86_KERNELS) && defined(__GNUC__) && (__GNUC__ >= 11 || (defined(__clang__) && __clang_major__ >= 12))
+#define NOVA_AVX_VNNI_KERNEL 1
+#endif
+
+namespace NovaVoice {
+namespace QuantizedKernels {
+
+namespace {
+
+#ifdef NOVA_X86_KERNELS
+__attribute__((target("avx2")))
+int32_t dotAvx2(const int8_t* weights, const int16_t* activations, size_t length) {
+    __m256i acc = _mm256_setzero_si256();
+    for (size_t i = 0; i < length; i += KERNEL_BLOCK) {
+        __m256i w = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i)));
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(activations + i));
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(w, a));
+    }
+
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum);
+}
+#endif
+
+#ifdef NOVA_AVX_VNNI_KERNEL
+__attribute__((target("avx2,avxvnni")))
+int32_t dotAvxVnni(const int8_t* weights, const int16_t* activations, size_t length) {
+    __m256i acc = _mm256_setzero_si256();
+    for (size_t i = 0; i < length; i += KERNEL_BLOCK) {
+        __m256i w = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i)));
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(activations + i));
+        acc = _mm256_dpwssd_avx_epi32(acc, w, a);
+    }
+
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum);
+}
+#endif
+
+bool isaSupported(KernelIsa isa) {
+    switch (isa) {
+        case KernelIsa::SCALAR:
+            return true;
+#ifdef NOVA_X86_KERNELS
+        case KernelIsa::AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+#ifdef NOVA_AVX_VNNI_KERNEL
+        case KernelIsa::AVX_VNNI: {
+            // CPUID.(EAX=7,ECX=1):EAX[4]; bazı derleyiciler __builtin_cpu_supports ile tanımıyor
+            unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+            if (!__builtin_cpu_supports("avx2") || !__get_cpuid_count(7, 1, &eax, &ebx, &ecx, &edx)) {
+                return false;
+            }
+            return (eax & (1u << 4)) != 0;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+std::atomic<int> activeIsa{-1};
+
+} // namespace
+
+KernelIsa detectIsa() {
+    if (isaSupported(KernelIsa::AVX_VNNI)) {
+        return KernelIsa::AVX_VNNI;
+    }
+    if (isaSupported(KernelIsa::AVX2)) {
+        return KernelIsa::AVX2;
+    }
+    return KernelIsa::SCALAR;
+}
+
+const char* isaName(KernelIsa isa) {
+    switch (isa) {
+        case KernelIsa::AVX_VNNI: return "AVX-VNNI";
+        case KernelIsa::AVX2: return "AVX2";
+        default: return "Scalar";
+    }
+}
+
+bool setIsa(KernelIsa isa) {
+    if (!isaSupported(isa)) {
+        return false;
+    }
+    activeIsa = static_cast<int>(isa);
+    return true;
+}
+
+KernelIsa getIsa() {
+    int isa = activeIsa.load(std::memory_order_relaxed);
+    if (isa < 0) {
+        KernelIsa detected = detectIsa();
+        activeIsa = static_cast<int>(detected);
+        return detected;
+    }
+    return static_cast<KernelIsa>(isa);
+}
+
+int32_t dot(const int8_t* weights, const int16_t* activations, size_t length) {
+    switch (getIsa()) {
+#ifdef NOVA_AVX_VNNI_KERNEL
+        case KernelIsa::AVX_VNNI:
+            return dotAvxVnni(weights, activations, length);
+#endif
+#ifdef NOVA_X86_KERNELS
+        case KernelIsa::AVX2:
+            return dotAvx2(weights, activations, length);
+#endif
+        default:
+            return dotScalar(weights, activations, length);
+    }
+}
+
+int32_t dotScalar(const int8_t* weights, const int16_t* activations, size_t length) {
+    int32_t sum = 0;
+    for (size_t i = 0; i < length; ++i) {
+        sum += static_cast<int32_t>(weights[i]) * activations[i];
+    }
+    return sum;
+}
+
+TunableKernel makeTunable() {
+    // DenoiseNet'in en büyük katmanı boyutunda (96 nöron) int8 matris-vektör
+    constexpr size_t ROWS = 96;
+    constexpr size_t LENGTH = 96;
+
+    struct Workload {
+        std::vector<int8_t> weights;
+        std::vector<int16_t> activations;
+        volatile int32_t sink = 0;
+    };
+    auto workload = std::make_shared<Workload>();
+    workload->weights.resize(ROWS * LENGTH);
+    workload->activations.resize(LENGTH);
+    for (size_t i = 0; i < workload->weights.size(); ++i) {
+        workload->weights[i] = static_cast<int8_t>((i * 37) % 255 - 127);
+    }
+    for (size_t i = 0; i < LENGTH; ++i) {
+        workload->activations[i] = static_cast<int16_t>((i * 211) % 8191 - 4095);
+    }
+
+    TunableKernel kernel;
+    kernel.name = "dot_isa";
+
+    // Varsayılan (tespit edilen en geniş ISA) ilk aday
+    const KernelIsa all[] = {detectIsa(), KernelIsa::AVX_VNNI, KernelIsa::AVX2, KernelIsa::SCALAR};
+    for (KernelIsa isa : all) {
+        std::string name = isaName(isa);
+        if (isaSupported(isa) &&
+            std::find(kernel.candidates.begin(), kernel.candidates.end(), name) == kernel.candidates.end()) {
+            kernel.candidates.push_back(name);
+        }
+    }
+
+    kernel.apply = [](const std::string& name) {
+        for (KernelIsa isa : {KernelIsa::AVX_VNNI, KernelIsa::AVX2, KernelIsa::SCALAR}) {
+            if (name == isaName(isa)) {
+                return setIsa(isa);
+            }
+        }
+        return false;
+    };
+
+    kernel.run = [workload]() {
+        int32_t sum = 0;
+        for (size_t row = 0; row < ROWS; ++row) {
+            sum += dot(&workload->weights[row * LENGTH], workload->activations.data(), LENGTH);
+        }
+        workload->sink = sum;
+    };
+
+    return kernel;
+}
+
+} // namespace QuantizedKernels
+} // namespace NovaVoice
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace NovaVoice {
+
+struct TunableKernel;
+
+// Çalışma zamanında seçilen komut seti
+enum class KernelIsa {
+    SCALAR,
+    AVX2,       // vpmovsxbw + vpmaddwd
+    AVX_VNNI    // vpdpwssd (çarp-topla tek komut)
+};
+
+/**
+ * @brief int8 ağırlık / int16 aktivasyon nokta çarpımı çekirdekleri
+ *
+ * Ağırlıklar int16'ya işaret genişletilip aktivasyonlarla çift çift
+ * çarpılır ve int32'de biriktirilir. Uzunluk KERNEL_BLOCK'un katı
+ * olmalıdır (satırlar sıfırla doldurulur). CPU desteği ilk çağrıda
+ * bir kez tespit edilir; skaler yol her zaman mevcuttur.
+ */
+namespace QuantizedKernels {
+
+constexpr size_t KERNEL_BLOCK = 16;
+
+KernelIsa detectIsa();
+const char* isaName(KernelIsa isa);
+
+// Etkin ISA'yı zorla (ör. karşılaştırma için SCALAR); desteklenmiyorsa false
+bool setIsa(KernelIsa isa);
+KernelIsa getIsa();
+
+int32_t dot(const int8_t* weights, const int16_t* activations, size_t length);
+int32_t dotScalar(const int8_t* weights, const int16_t* activations, size_t length);
+
+// Başlangıç ayarı için "dot_isa": desteklenen ISA'lar, GRU boyutunda matris-vektör
+TunableKernel makeTunable();
+
+} // namespace QuantizedKernels
+
+} // namespace NovaVoice
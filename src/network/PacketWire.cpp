@@ -0,0 +1,54 @@
+#include "PacketWire.h"
+#include "MemoryAccounting.h"
+#include <cstring>
+
+namespace NovaVoice {
+
+namespace PacketWire {
+
+void serializeInto(const AudioPacket& packet, uint32_t streamId, std::vector<uint8_t>& out) {
+    // Serializasyon: [type][stream_id][sequence_number][audio_data]
+    out.resize(HEADER_SIZE + packet.data.size());
+    
+    out[0] = static_cast<uint8_t>(packet.type);
+    memcpy(out.data() + 1, &streamId, sizeof(uint32_t));
+    
+    uint32_t seqNum = packet.sequenceNumber;
+    memcpy(out.data() + 1 + sizeof(uint32_t), &seqNum, sizeof(uint32_t));
+    
+    if (!packet.data.empty()) {
+        memcpy(out.data() + HEADER_SIZE, packet.data.data(), packet.data.size());
+    }
+}
+
+std::shared_ptr<AudioPacket> deserialize(const uint8_t* data, size_t size) {
+    if (!data || size < HEADER_SIZE) {
+        return nullptr;
+    }
+    
+    // Deserializasyon: [type][stream_id][sequence_number][audio_data]
+    uint8_t type = data[0];
+    if (type > static_cast<uint8_t>(PacketType::PROBE)) {
+        return nullptr;
+    }
+    
+    uint32_t streamId;
+    memcpy(&streamId, data + 1, sizeof(uint32_t));
+    
+    uint32_t sequenceNumber;
+    memcpy(&sequenceNumber, data + 1 + sizeof(uint32_t), sizeof(uint32_t));
+    
+    size_t audioDataSize = size - HEADER_SIZE;
+    const uint8_t* audioData = data + HEADER_SIZE;
+    
+    // Alınan paket, gönderen akışın oturumuna yazılır
+    MemoryScope memory(MemoryTag::PACKETS, streamId);
+    auto packet = std::make_shared<AudioPacket>(audioData, audioDataSize, sequenceNumber,
+                                                static_cast<PacketType>(type));
+    packet->streamId = streamId;
+    return packet;
+}
+
+} // namespace PacketWire
+
+} // namespace NovaVoice
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "BufferManager.h"
+
+namespace NovaVoice {
+
+// Ağ paket biçimi: [type:1][stream_id:4][sequence_number:4][veri]
+// UDPManager ve soketsiz araçlar (simülatör) aynı kodlamayı kullanır
+namespace PacketWire {
+    constexpr size_t HEADER_SIZE = 1 + sizeof(uint32_t) + sizeof(uint32_t);
+
+    // out yeniden boyutlanır; kapasitesi korunur (gönderim buffer'ları tekrar kullanılır)
+    void serializeInto(const AudioPacket& packet, uint32_t streamId, std::vector<uint8_t>& out);
+    // Geçersiz başlık veya tür için nullptr
+    std::shared_ptr<AudioPacket> deserialize(const uint8_t* data, size_t size);
+}
+
+} // namespace NovaVoice
@@ -1,8 +1,11 @@
 #include "UDPManager.h"
+#include "MemoryAccounting.h"
 #include <iostream>
 #include <cstring>
+#include <algorithm>
 #include <unistd.h>
 #include <errno.h>
+#include <random>
 
 namespace NovaVoice {
 
@@ -10,11 +13,29 @@ UDPManager::UDPManager()
     : socketFd_(-1)
     , isRunning_(false)
     , isServer_(false)
+    , loggingEnabled_(true)
+    , remoteEndpoint_(0)
+    , localStreamId_(0)
     , sentPackets_(0)
     , receivedPackets_(0)
     , failedSends_(0) {
+    MemoryScope memory(MemoryTag::NETWORK);
     memset(&localAddr_, 0, sizeof(localAddr_));
-    memset(&remoteAddr_, 0, sizeof(remoteAddr_));
+    
+    // Rastgele akış kimliği (SSRC benzeri); 0 "yerel/bilinmiyor" anlamına gelir
+    std::random_device randomDevice;
+    uint32_t streamId = 0;
+    while (streamId == 0) {
+        streamId = randomDevice();
+    }
+    localStreamId_ = streamId;
+    
+    // Batch gönderim alanlarını önceden ayır
+    sendBatch_.reserve(Config::SEND_BATCH_SIZE);
+    sendBuffers_.resize(Config::SEND_BATCH_SIZE);
+    for (auto& buffer : sendBuffers_) {
+        buffer.reserve(HEADER_SIZE + Config::MAX_PAYLOAD_SIZE);
+    }
 }
 
 UDPManager::~UDPManager() {
@@ -76,10 +97,13 @@ bool UDPManager::startServer(uint16_t port) {
     isServer_ = true;
     isRunning_ = true;
     
-    // Receiver thread'i başlat
+    // Receiver ve sender thread'lerini başlat
     receiverThread_ = std::thread(&UDPManager::receiverLoop, this);
+    senderThread_ = std::thread(&UDPManager::senderLoop, this);
     
-    std::cout << "UDP Server port " << port << " üzerinde başlatıldı" << std::endl;
+    if (loggingEnabled_) {
+        std::cout << "UDP Server port " << port << " üzerinde başlatıldı" << std::endl;
+    }
     return true;
 }
 
@@ -93,22 +117,28 @@ bool UDPManager::startClient(const std::string& serverIP, uint16_t port) {
     }
     
     // Remote address ayarla
-    remoteAddr_.sin_family = AF_INET;
-    remoteAddr_.sin_port = htons(port);
+    struct sockaddr_in remoteAddr;
+    memset(&remoteAddr, 0, sizeof(remoteAddr));
+    remoteAddr.sin_family = AF_INET;
+    remoteAddr.sin_port = htons(port);
     
-    if (inet_pton(AF_INET, serverIP.c_str(), &remoteAddr_.sin_addr) <= 0) {
+    if (inet_pton(AF_INET, serverIP.c_str(), &remoteAddr.sin_addr) <= 0) {
         logError("Geçersiz IP adresi: " + serverIP);
         closeSocket();
         return false;
     }
+    remoteEndpoint_.store(packEndpoint(remoteAddr), std::memory_order_release);
     
     isServer_ = false;
     isRunning_ = true;
     
-    // Receiver thread'i başlat
+    // Receiver ve sender thread'lerini başlat
     receiverThread_ = std::thread(&UDPManager::receiverLoop, this);
+    senderThread_ = std::thread(&UDPManager::senderLoop, this);
     
-    std::cout << "UDP Client " << serverIP << ":" << port << " adresine bağlandı" << std::endl;
+    if (loggingEnabled_) {
+        std::cout << "UDP Client " << serverIP << ":" << port << " adresine bağlandı" << std::endl;
+    }
     return true;
 }
 
@@ -119,7 +149,15 @@ void UDPManager::stop() {
     
     isRunning_ = false;
     
-    // Socket'i kapat (receiver thread'in sonlanmasını sağlar)
+    // Sender thread bekleme süresi dolunca çıkar
+    if (senderThread_.joinable()) {
+        senderThread_.join();
+    }
+    
+    // close() recvfrom'da bekleyen thread'i uyandırmaz; shutdown 0 baytla döndürür
+    if (socketFd_ >= 0) {
+        shutdown(socketFd_, SHUT_RDWR);
+    }
     closeSocket();
     
     // Thread'in bitmesini bekle
@@ -127,7 +165,9 @@ void UDPManager::stop() {
         receiverThread_.join();
     }
     
-    std::cout << "UDP Manager durduruldu" << std::endl;
+    if (loggingEnabled_) {
+        std::cout << "UDP Manager durduruldu" << std::endl;
+    }
 }
 
 bool UDPManager::sendAudioPacket(std::shared_ptr<AudioPacket> packet) {
@@ -144,14 +184,8 @@ bool UDPManager::sendData(const uint8_t* data, size_t size) {
         return false;
     }
     
-    struct sockaddr_in targetAddr;
-    if (isServer_) {
-        // Server modunda, bilinen remote address'e gönder
-        targetAddr = remoteAddr_;
-    } else {
-        // Client modunda, server'a gönder
-        targetAddr = remoteAddr_;
-    }
+    // Server modunda bilinen remote address'e, client modunda server'a gönder
+    struct sockaddr_in targetAddr = remoteAddress();
     
     ssize_t bytesSent = sendto(socketFd_, data, size, 0, 
                               (struct sockaddr*)&targetAddr, sizeof(targetAddr));
@@ -172,6 +206,79 @@ bool UDPManager::sendData(const uint8_t* data, size_t size) {
     return true;
 }
 
+bool UDPManager::sendControlPacket(PacketType type, const uint8_t* data, size_t size) {
+    if (type == PacketType::AUDIO || !isRunning_) {
+        return false;
+    }
+    
+    // Buffer manager varsa kontrol şeridine koy, sender thread önce bunları gönderir
+    if (bufferManager_) {
+        return bufferManager_->pushControlPacket(type, data, size);
+    }
+    
+    std::shared_ptr<AudioPacket> packet;
+    {
+        MemoryScope memory(MemoryTag::PACKETS);
+        packet = std::make_shared<AudioPacket>(data, data ? size : 0, 0, type);
+    }
+    return sendAudioPacket(packet);
+}
+
+size_t UDPManager::flushOutgoing(size_t maxBatch) {
+    if (!bufferManager_ || !isRunning_ || socketFd_ < 0) {
+        return 0;
+    }
+    
+    // Remote address henüz bilinmiyorsa (server, ilk paket gelmeden) kuyruktan
+    // alma: paketler kuyrukta kalır, taşarsa BufferManager düşürüp sayar
+    struct sockaddr_in targetAddr = remoteAddress();
+    if (targetAddr.sin_port == 0) {
+        return 0;
+    }
+    
+    MemoryScope memory(MemoryTag::NETWORK);
+    maxBatch = std::min(maxBatch, sendBuffers_.size());
+    size_t count = bufferManager_->popOutputBatch(sendBatch_, maxBatch);
+    if (count == 0) {
+        return 0;
+    }
+    
+    struct mmsghdr messages[Config::SEND_BATCH_SIZE];
+    struct iovec iovecs[Config::SEND_BATCH_SIZE];
+    memset(messages, 0, sizeof(messages));
+    
+    // popOutputBatch kontrol paketlerini batch'in başına koyar
+    for (size_t i = 0; i < count; ++i) {
+        serializePacketInto(*sendBatch_[i], sendBuffers_[i]);
+        
+        iovecs[i].iov_base = sendBuffers_[i].data();
+        iovecs[i].iov_len = sendBuffers_[i].size();
+        messages[i].msg_hdr.msg_iov = &iovecs[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+        messages[i].msg_hdr.msg_name = &targetAddr;
+        messages[i].msg_hdr.msg_namelen = sizeof(targetAddr);
+    }
+    
+    size_t sent = 0;
+    while (sent < count) {
+        int result = sendmmsg(socketFd_, messages + sent, count - sent, 0);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            logError("Batch gönderilemedi: " + std::string(strerror(errno)));
+            failedSends_ += count - sent;
+            break;
+        }
+        sent += static_cast<size_t>(result);
+    }
+    
+    sentPackets_ += sent;
+    sendBatch_.clear();
+    
+    return sent;
+}
+
 void UDPManager::setBufferManager(std::shared_ptr<BufferManager> bufferManager) {
     bufferManager_ = bufferManager;
 }
@@ -184,14 +291,49 @@ void UDPManager::setOnPacketReceived(std::function<void(std::shared_ptr<AudioPac
     onPacketReceived_ = callback;
 }
 
+void UDPManager::setOnControlPacketReceived(std::function<void(std::shared_ptr<AudioPacket>)> callback) {
+    onControlPacketReceived_ = callback;
+}
+
+void UDPManager::senderLoop() {
+    while (isRunning_) {
+        if (!bufferManager_) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
+        
+        // Playback thread'inin bıraktığı paketler burada serbest kalır
+        bufferManager_->releaseRetiredPackets();
+        
+        // Input kuyruğu boştan doluya geçince uyan
+        if (!bufferManager_->waitForInputPacket(100)) {
+            continue;
+        }
+        
+        // Kuyruk boşalana kadar batch'ler halinde gönder
+        while (isRunning_ && flushOutgoing() > 0) {
+        }
+        
+        // Remote address bilinmiyorsa paketler kuyrukta bekler; meşgul döngüye girme
+        if (remoteEndpoint_.load(std::memory_order_acquire) == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+}
+
 void UDPManager::receiverLoop() {
-    uint8_t buffer[Config::PACKET_SIZE * 2]; // Biraz daha büyük buffer
+    uint8_t buffer[HEADER_SIZE + Config::MAX_PAYLOAD_SIZE]; // En büyük periyodun paketi kesilmesin
     struct sockaddr_in fromAddr;
     socklen_t fromAddrLen = sizeof(fromAddr);
+    RealtimeSection realtime("receive");
     
     while (isRunning_) {
-        ssize_t bytesReceived = recvfrom(socketFd_, buffer, sizeof(buffer), 0,
-                                        (struct sockaddr*)&fromAddr, &fromAddrLen);
+        ssize_t bytesReceived;
+        {
+            BlockingSection blocking;
+            bytesReceived = recvfrom(socketFd_, buffer, sizeof(buffer), 0,
+                                     (struct sockaddr*)&fromAddr, &fromAddrLen);
+        }
         
         if (bytesReceived < 0) {
             if (isRunning_) {
@@ -212,18 +354,26 @@ bool UDPManager::processReceivedData(const uint8_t* data, size_t size, const str
         return false;
     }
     
-    // Server modunda, remote address'i güncelle
+    // Server modunda, remote address'i güncelle (değişmediyse yazma)
     if (isServer_) {
-        remoteAddr_ = fromAddr;
+        uint64_t endpoint = packEndpoint(fromAddr);
+        if (remoteEndpoint_.load(std::memory_order_relaxed) != endpoint) {
+            remoteEndpoint_.store(endpoint, std::memory_order_release);
+        }
     }
     
     // Veriyi AudioPacket olarak deserialize et
     auto packet = deserializePacket(data, size);
     
     if (packet) {
-        // Buffer manager'a paketi ekle
-        if (bufferManager_) {
-            bufferManager_->pushNetworkPacket(packet);
+        if (packet->type == PacketType::AUDIO) {
+            // Buffer manager'a paketi ekle
+            if (bufferManager_) {
+                bufferManager_->pushNetworkPacket(packet);
+            }
+        } else if (onControlPacketReceived_) {
+            // Kontrol paketleri çalma kuyruğuna girmez
+            onControlPacketReceived_(packet);
         }
         
         // Callback çağır
@@ -241,19 +391,7 @@ bool UDPManager::processReceivedData(const uint8_t* data, size_t size, const str
 }
 
 std::shared_ptr<AudioPacket> UDPManager::deserializePacket(const uint8_t* data, size_t size) {
-    if (!data || size < sizeof(uint32_t)) {
-        return nullptr;
-    }
-    
-    // Basit deserializasyon: [sequence_number][data_size][audio_data]
-    uint32_t sequenceNumber;
-    memcpy(&sequenceNumber, data, sizeof(uint32_t));
-    
-    size_t audioDataSize = size - sizeof(uint32_t);
-    const uint8_t* audioData = data + sizeof(uint32_t);
-    
-    auto packet = std::make_shared<AudioPacket>(audioData, audioDataSize, sequenceNumber);
-    return packet;
+    return PacketWire::deserialize(data, size);
 }
 
 std::vector<uint8_t> UDPManager::serializePacket(std::shared_ptr<AudioPacket> packet) {
@@ -261,22 +399,18 @@ std::vector<uint8_t> UDPManager::serializePacket(std::shared_ptr<AudioPacket> pa
         return {};
     }
     
-    // Basit serializasyon: [sequence_number][audio_data]
+    MemoryScope memory(MemoryTag::NETWORK);
     std::vector<uint8_t> serialized;
-    serialized.reserve(sizeof(uint32_t) + packet->data.size());
-    
-    // Sequence number ekle
-    uint32_t seqNum = packet->sequenceNumber;
-    serialized.insert(serialized.end(), 
-                     reinterpret_cast<uint8_t*>(&seqNum),
-                     reinterpret_cast<uint8_t*>(&seqNum) + sizeof(uint32_t));
-    
-    // Audio data ekle
-    serialized.insert(serialized.end(), packet->data.begin(), packet->data.end());
-    
+    serializePacketInto(*packet, serialized);
     return serialized;
 }
 
+void UDPManager::serializePacketInto(const AudioPacket& packet, std::vector<uint8_t>& out) const {
+    // Yerel paketlerde akış kimliği yoktur, relay edilen paketler kendi kimliğini korur
+    uint32_t streamId = packet.streamId != 0 ? packet.streamId : localStreamId_.load();
+    PacketWire::serializeInto(packet, streamId, out);
+}
+
 std::string UDPManager::getAddressString(const struct sockaddr_in& addr) const {
     char ipStr[INET_ADDRSTRLEN];
     inet_ntop(AF_INET, &addr.sin_addr, ipStr, INET_ADDRSTRLEN);
@@ -290,18 +424,36 @@ bool UDPManager::setRemoteAddress(const std::string& ip, uint16_t port) {
     }
     
     // Remote address ayarla
-    remoteAddr_.sin_family = AF_INET;
-    remoteAddr_.sin_port = htons(port);
+    struct sockaddr_in remoteAddr;
+    memset(&remoteAddr, 0, sizeof(remoteAddr));
+    remoteAddr.sin_family = AF_INET;
+    remoteAddr.sin_port = htons(port);
     
-    if (inet_pton(AF_INET, ip.c_str(), &remoteAddr_.sin_addr) <= 0) {
+    if (inet_pton(AF_INET, ip.c_str(), &remoteAddr.sin_addr) <= 0) {
         logError("Geçersiz IP adresi: " + ip);
         return false;
     }
+    remoteEndpoint_.store(packEndpoint(remoteAddr), std::memory_order_release);
     
     std::cout << "[UDPManager] Remote address ayarlandı: " << ip << ":" << port << std::endl;
     return true;
 }
 
+uint64_t UDPManager::packEndpoint(const struct sockaddr_in& addr) {
+    // [s_addr:32][sin_port:16], ikisi de ağ bayt sırasında
+    return (static_cast<uint64_t>(addr.sin_addr.s_addr) << 16) | addr.sin_port;
+}
+
+struct sockaddr_in UDPManager::remoteAddress() const {
+    uint64_t endpoint = remoteEndpoint_.load(std::memory_order_acquire);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = static_cast<in_port_t>(endpoint & 0xFFFF);
+    addr.sin_addr.s_addr = static_cast<in_addr_t>(endpoint >> 16);
+    return addr;
+}
+
 void UDPManager::logError(const std::string& message) const {
     std::cerr << "[UDPManager ERROR] " << message << std::endl;
 }
@@ -5,11 +5,14 @@
 #include <thread>
 #include <atomic>
 #include <functional>
+#include <vector>
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include "Config.h"
 #include "BufferManager.h"
+#include "PacketWire.h"
+#include "RealtimeCheck.h"
 
 namespace NovaVoice {
 
@@ -27,6 +30,10 @@ public:
     bool sendAudioPacket(std::shared_ptr<AudioPacket> packet);
     bool sendData(const uint8_t* data, size_t size);
     
+    // Kontrol paketleri medya kuyruğunu atlar ve her batch'te önce gönderilir
+    bool sendControlPacket(PacketType type, const uint8_t* data = nullptr, size_t size = 0);
+    size_t flushOutgoing(size_t maxBatch = Config::SEND_BATCH_SIZE);
+    
     // Buffer manager bağlantısı
     void setBufferManager(std::shared_ptr<BufferManager> bufferManager);
     
@@ -42,20 +49,35 @@ public:
     // Callback ayarlama
     void setOnDataReceived(std::function<void(const uint8_t*, size_t)> callback);
     void setOnPacketReceived(std::function<void(std::shared_ptr<AudioPacket>)> callback);
+    void setOnControlPacketReceived(std::function<void(std::shared_ptr<AudioPacket>)> callback);
     
     // P2P için remote address ayarlama
     bool setRemoteAddress(const std::string& ip, uint16_t port);
     
+    // Giden paketlerin akış kimliği (alıcı tarafta demultiplexing için)
+    void setLocalStreamId(uint32_t streamId) { localStreamId_ = streamId; }
+    uint32_t getLocalStreamId() const { return localStreamId_; }
+    
+    // Başlatma/durdurma bilgi mesajları (hatalar her zaman yazılır)
+    void setLogging(bool enable) { loggingEnabled_ = enable; }
+    
 private:
     // Socket yönetimi
     int socketFd_;
     struct sockaddr_in localAddr_;
-    struct sockaddr_in remoteAddr_;
+    // Karşı uç: alıcı thread (server) yazar, gönderici okur; adres ve port tek
+    // 64-bit değerde yayınlanır, yarım güncellenmiş adres okunmaz (0 = bilinmiyor)
+    std::atomic<uint64_t> remoteEndpoint_;
     
     // Thread yönetimi
     std::thread receiverThread_;
+    std::thread senderThread_;
     std::atomic<bool> isRunning_;
     std::atomic<bool> isServer_;
+    bool loggingEnabled_;
+    
+    // Yerel akış kimliği
+    std::atomic<uint32_t> localStreamId_;
     
     // Buffer manager
     std::shared_ptr<BufferManager> bufferManager_;
@@ -63,6 +85,11 @@ private:
     // Callback fonksiyonları
     std::function<void(const uint8_t*, size_t)> onDataReceived_;
     std::function<void(std::shared_ptr<AudioPacket>)> onPacketReceived_;
+    std::function<void(std::shared_ptr<AudioPacket>)> onControlPacketReceived_;
+    
+    // Batch gönderim alanları (sender thread'e ait, tekrar kullanılır)
+    std::vector<std::shared_ptr<AudioPacket>> sendBatch_;
+    std::vector<std::vector<uint8_t>> sendBuffers_;
     
     // İstatistikler
     std::atomic<uint64_t> sentPackets_;
@@ -74,11 +101,18 @@ private:
     void closeSocket();
     bool bindSocket(uint16_t port);
     void receiverLoop();
+    void senderLoop();
     bool processReceivedData(const uint8_t* data, size_t size, const struct sockaddr_in& fromAddr);
+    static uint64_t packEndpoint(const struct sockaddr_in& addr);
+    struct sockaddr_in remoteAddress() const;
     
     // Paket işleme
     std::shared_ptr<AudioPacket> deserializePacket(const uint8_t* data, size_t size);
     std::vector<uint8_t> serializePacket(std::shared_ptr<AudioPacket> packet);
+    void serializePacketInto(const AudioPacket& packet, std::vector<uint8_t>& out) const;
+    
+    // Paket başlığı: [type:1][stream_id:4][sequence_number:4]
+    static constexpr size_t HEADER_SIZE = PacketWire::HEADER_SIZE;
     
     // Yardımcı metodlar
     std::string getAddressString(const struct sockaddr_in& addr) const;
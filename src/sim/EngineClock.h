@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace NovaVoice {
+
+/**
+ * @brief Motor saati: gerçek çalışmada steady_clock, simülasyonda sanal zaman
+ *
+ * Zamana bağlı motor bileşenleri (kuyruk bekleme süreleri, boşta akış geri
+ * alma, playout başlatma zaman aşımı, bitrate geçmişi) saati buradan okur.
+ * Ayrık olay simülatörü sanal modu açar ve zamanı olaydan olaya ilerletir;
+ * aynı nesneler soket ve thread olmadan, deterministik ve gerçek zamandan
+ * çok daha hızlı çalışır. Sanal mod kapalıyken maliyet tek bir relaxed
+ * atomic okumadır. Sanal mod yalnızca tek thread'li simülasyonda açılır.
+ */
+class EngineClock {
+public:
+    using duration = std::chrono::steady_clock::duration;
+    using time_point = std::chrono::steady_clock::time_point;
+
+    static time_point now() {
+        if (virtual_.load(std::memory_order_relaxed)) {
+            return time_point(duration(virtualTicks_.load(std::memory_order_relaxed)));
+        }
+        return std::chrono::steady_clock::now();
+    }
+
+    // === SANAL MOD ===
+    // Başlangıç sıfırdan ileride seçilir: varsayılan kurulmuş zaman damgaları geçmişte kalır
+    static void enableVirtual(time_point start) {
+        virtualTicks_.store(start.time_since_epoch().count(), std::memory_order_relaxed);
+        virtual_.store(true, std::memory_order_release);
+    }
+
+    static void disableVirtual() { virtual_.store(false, std::memory_order_release); }
+    static bool isVirtual() { return virtual_.load(std::memory_order_acquire); }
+
+    // Sanal zaman geri gitmez
+    static void advanceTo(time_point when) {
+        int64_t ticks = when.time_since_epoch().count();
+        if (ticks > virtualTicks_.load(std::memory_order_relaxed)) {
+            virtualTicks_.store(ticks, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    static inline std::atomic<bool> virtual_{false};
+    static inline std::atomic<int64_t> virtualTicks_{0};
+};
+
+} // namespace NovaVoice
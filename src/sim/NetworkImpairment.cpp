@@ -0,0 +1,59 @@
+#include "NetworkImpairment.h"
+#include <algorithm>
+#include <cmath>
+
+namespace NovaVoice {
+
+NetworkImpairment::NetworkImpairment(const ImpairmentConfig& config)
+    : config_(config)
+    , uniform_(0.0, 1.0)
+    , badState_(false)
+    , goodToBad_(0.0)
+    , badToGood_(1.0)
+    , sent_(0)
+    , lost_(0)
+    , late_(0) {
+    // Durağan kayıp = p / (p + r), ortalama patlama = 1 / r
+    double loss = std::max(0.0, std::min(0.99, config_.lossRate));
+    double burst = std::max(1.0, config_.meanBurstLength);
+    badToGood_ = 1.0 / burst;
+    goodToBad_ = loss > 0.0 ? std::min(1.0, loss * badToGood_ / (1.0 - loss)) : 0.0;
+    reset();
+}
+
+void NetworkImpairment::reset() {
+    rng_.seed(config_.seed);
+    badState_ = false;
+    sent_ = 0;
+    lost_ = 0;
+    late_ = 0;
+}
+
+NetworkImpairment::Outcome NetworkImpairment::next() {
+    sent_++;
+
+    double transition = uniform_(rng_);
+    badState_ = badState_ ? transition >= badToGood_ : transition < goodToBad_;
+    if (badState_) {
+        lost_++;
+        return {false, false, 0.0};
+    }
+
+    double delayMs = 0.0;
+    if (config_.jitterMs > 0.0) {
+        delayMs = -config_.jitterMs * std::log(std::max(1e-12, 1.0 - uniform_(rng_)));
+    }
+
+    if (delayMs > config_.playoutDelayMs) {
+        late_++;
+        return {false, true, delayMs};
+    }
+
+    return {true, false, delayMs};
+}
+
+double NetworkImpairment::getEffectiveLossRate() const {
+    return sent_ > 0 ? static_cast<double>(lost_ + late_) / static_cast<double>(sent_) : 0.0;
+}
+
+} // namespace NovaVoice
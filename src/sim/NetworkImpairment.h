@@ -0,0 +1,59 @@
+#pragma once
+
+#include <random>
+#include <cstdint>
+
+namespace NovaVoice {
+
+// Ağ bozulma parametreleri
+struct ImpairmentConfig {
+    double lossRate = 0.0;          // Ortalama paket kaybı (0.0 - 1.0)
+    double meanBurstLength = 1.0;   // Ortalama ardışık kayıp (1.0 = bağımsız kayıp)
+    double jitterMs = 0.0;          // Ek gecikmenin ortalaması (üstel dağılım)
+    double playoutDelayMs = 40.0;   // Alıcı buffer derinliği; daha geç gelen paket kayıp sayılır
+    uint32_t seed = 1;
+};
+
+/**
+ * @brief Deterministik ağ bozulma modeli
+ *
+ * Kayıplar Gilbert-Elliott modeliyle üretilir: kötü durumda her paket
+ * kaybolur, durum geçişleri ortalama kayıp oranını ve ortalama patlama
+ * uzunluğunu verecek şekilde seçilir. Ulaşan paketlere üstel dağılımlı
+ * jitter eklenir; playout gecikmesini aşanlar geç kalmış (kayıp) sayılır.
+ * Aynı seed aynı paket dizisini üretir.
+ */
+class NetworkImpairment {
+public:
+    struct Outcome {
+        bool delivered;     // Zamanında ulaştı
+        bool late;          // Ulaştı ama playout için geç kaldı
+        double delayMs;     // Ek gecikme
+    };
+
+    explicit NetworkImpairment(const ImpairmentConfig& config);
+
+    // Sıradaki paketin kaderi
+    Outcome next();
+    void reset();
+
+    // === İSTATİSTİKLER ===
+    uint64_t getSent() const { return sent_; }
+    uint64_t getLost() const { return lost_; }
+    uint64_t getLate() const { return late_; }
+    double getEffectiveLossRate() const;
+
+private:
+    ImpairmentConfig config_;
+    std::mt19937 rng_;
+    std::uniform_real_distribution<double> uniform_;
+    bool badState_;
+    double goodToBad_;
+    double badToGood_;
+
+    uint64_t sent_;
+    uint64_t lost_;
+    uint64_t late_;
+};
+
+} // namespace NovaVoice
@@ -0,0 +1,935 @@
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <cstring>
+#include <cmath>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include "Config.h"
+#include "BufferManager.h"
+#include "AudioCapture.h"
+#include "AudioPlayer.h"
+#include "UDPManager.h"
+#include "Sidetone.h"
+#include "LyraCodec.h"
+#include "BatchDecoder.h"
+#include "DenoiseNet.h"
+#include "DenoiseFrontEnd.h"
+#include "QuantizedKernels.h"
+#include "StageProfiler.h"
+#include "KernelAutotuner.h"
+#include "RealtimeCheck.h"
+
+using namespace NovaVoice;
+
+// Nova Voice Engine V2 - Headless Benchmark Aracı
+// Ses donanımı gerektirmeyen bileşenleri ölçer.
+
+namespace {
+
+struct LatencySummary {
+    double p50Us;
+    double p99Us;
+    double maxUs;
+    double meanUs;
+};
+
+LatencySummary summarize(std::vector<double>& samples) {
+    LatencySummary summary{0.0, 0.0, 0.0, 0.0};
+    if (samples.empty()) {
+        return summary;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    double sum = 0.0;
+    for (double value : samples) {
+        sum += value;
+    }
+
+    summary.p50Us = samples[samples.size() / 2];
+    summary.p99Us = samples[std::min(samples.size() - 1, (samples.size() * 99) / 100)];
+    summary.maxUs = samples.back();
+    summary.meanUs = sum / static_cast<double>(samples.size());
+    return summary;
+}
+
+void printSummary(const std::string& name, std::vector<double>& samples) {
+    LatencySummary summary = summarize(samples);
+    std::cout << std::left << std::setw(28) << name
+              << std::right << std::fixed << std::setprecision(1)
+              << " n=" << std::setw(6) << samples.size()
+              << "  ort=" << std::setw(8) << summary.meanUs << "us"
+              << "  p50=" << std::setw(8) << summary.p50Us << "us"
+              << "  p99=" << std::setw(8) << summary.p99Us << "us"
+              << "  max=" << std::setw(8) << summary.maxUs << "us" << std::endl;
+}
+
+double elapsedUs(std::chrono::steady_clock::time_point from) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - from).count();
+}
+
+// Üretici: rastgele aralıklarla (1-3 ms) ağ paketi gönderir
+void runProducer(BufferManager& buffer, size_t count, std::atomic<bool>& done) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> gapUs(1000, 3000);
+    uint8_t payload[64] = {0};
+
+    for (size_t i = 0; i < count; ++i) {
+        std::this_thread::sleep_for(std::chrono::microseconds(gapUs(rng)));
+        auto packet = std::make_shared<AudioPacket>(payload, sizeof(payload), static_cast<uint32_t>(i));
+        buffer.pushNetworkPacket(packet);
+    }
+
+    done = true;
+}
+
+// === WAKEUP: condition variable vs eventfd ===
+
+void benchWakeupConditionVariable(size_t count) {
+    BufferManager buffer;
+    std::atomic<bool> done(false);
+    std::vector<double> latencies;
+    latencies.reserve(count);
+
+    std::thread producer(runProducer, std::ref(buffer), count, std::ref(done));
+
+    while (!done || !buffer.isOutputBufferEmpty()) {
+        auto packet = buffer.getNextPlaybackPacket();
+        if (packet) {
+            latencies.push_back(elapsedUs(packet->timestamp));
+        }
+    }
+
+    producer.join();
+    printSummary("condition_variable (10ms)", latencies);
+}
+
+void benchWakeupEventFd(size_t count) {
+    BufferManager buffer;
+    std::atomic<bool> done(false);
+    std::vector<double> latencies;
+    latencies.reserve(count);
+
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0 || buffer.getOutputReadyFd() < 0) {
+        std::cerr << "epoll/eventfd kullanılamıyor, test atlandı" << std::endl;
+        if (epollFd >= 0) {
+            close(epollFd);
+        }
+        return;
+    }
+
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = buffer.getOutputReadyFd();
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, buffer.getOutputReadyFd(), &event);
+
+    std::thread producer(runProducer, std::ref(buffer), count, std::ref(done));
+
+    while (!done || !buffer.isOutputBufferEmpty()) {
+        struct epoll_event ready;
+        if (epoll_wait(epollFd, &ready, 1, 100) <= 0) {
+            continue;
+        }
+
+        // Kuyruk boşalana kadar tüket, sonra tekrar bekle
+        while (!buffer.isOutputBufferEmpty()) {
+            auto packet = buffer.getNextPlaybackPacket();
+            if (packet) {
+                latencies.push_back(elapsedUs(packet->timestamp));
+            }
+        }
+    }
+
+    producer.join();
+    close(epollFd);
+    printSummary("eventfd + epoll", latencies);
+}
+
+void benchWakeup(size_t count) {
+    std::cout << "\n=== Uyanma Gecikmesi (push -> consumer) ===" << std::endl;
+    benchWakeupConditionVariable(count);
+    benchWakeupEventFd(count);
+}
+
+// === LANES: medya yükü altında kontrol paketi kuyruk süresi ===
+
+void runLaneScenario(const std::string& name, bool priorityLanes, size_t count) {
+    BufferManager buffer;
+    buffer.setMaxBufferSize(4096);
+
+    std::atomic<bool> done(false);
+    std::vector<double> controlLatencies;
+    std::vector<double> mediaLatencies;
+    controlLatencies.reserve(count);
+
+    // Medya: tüketim hızından biraz fazla üretim (kuyruk büyür)
+    std::thread mediaProducer([&]() {
+        uint8_t payload[Config::PACKET_SIZE] = {0};
+        uint32_t seq = 0;
+        while (!done) {
+            for (int i = 0; i < 20; ++i) {
+                buffer.pushAudioPacket(std::make_shared<AudioPacket>(payload, sizeof(payload), seq++));
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    // Kontrol: her 2 ms'de bir feedback paketi
+    std::thread controlProducer([&]() {
+        uint8_t feedback[16] = {0};
+        for (size_t i = 0; i < count; ++i) {
+            PacketType type = priorityLanes ? PacketType::FEEDBACK : PacketType::AUDIO;
+            auto packet = std::make_shared<AudioPacket>(feedback, sizeof(feedback), static_cast<uint32_t>(i), type);
+            packet->size = 0; // Kontrol paketini işaretle (tek şerit modunda da ayırt edilebilsin)
+            buffer.pushAudioPacket(packet);
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        done = true;
+    });
+
+    // Tüketici: her 1 ms'de bir batch (sendmmsg temposu)
+    std::vector<std::shared_ptr<AudioPacket>> batch;
+    batch.reserve(Config::SEND_BATCH_SIZE);
+    while (!done) {
+        buffer.popOutputBatch(batch, Config::SEND_BATCH_SIZE);
+        for (const auto& packet : batch) {
+            double latency = elapsedUs(packet->timestamp);
+            if (packet->size == 0) {
+                controlLatencies.push_back(latency);
+            } else {
+                mediaLatencies.push_back(latency);
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    controlProducer.join();
+    mediaProducer.join();
+
+    std::cout << name << std::endl;
+    printSummary("  control", controlLatencies);
+    printSummary("  media", mediaLatencies);
+
+    if (priorityLanes) {
+        LaneStats control = buffer.getLaneStats(PacketLane::CONTROL);
+        LaneStats media = buffer.getLaneStats(PacketLane::MEDIA);
+        std::cout << "  LaneStats control: ort=" << control.averageQueueTimeUs << "us max=" << control.maxQueueTimeUs
+                  << "us drop=" << control.dropped << " | media: ort=" << media.averageQueueTimeUs
+                  << "us max=" << media.maxQueueTimeUs << "us drop=" << media.dropped << std::endl;
+    }
+}
+
+void benchLanes(size_t count) {
+    std::cout << "\n=== Öncelik Şeritleri (medya yükü altında kuyruk süresi) ===" << std::endl;
+    size_t controlCount = std::min<size_t>(count, 500);
+    runLaneScenario("Tek şerit (eski davranış)", false, controlCount);
+    runLaneScenario("Kontrol + medya şeritleri", true, controlCount);
+}
+
+// === SIDETONE: örnek başına push + mix maliyeti ===
+
+void benchSidetone(size_t count) {
+    std::cout << "\n=== Sidetone (capture push + playback mix) ===" << std::endl;
+
+    Sidetone sidetone;
+    sidetone.setLevel(0.3f);
+
+    std::vector<int16_t> captured(Config::FRAMES_PER_BUFFER * Config::CHANNELS);
+    std::vector<int16_t> playback(Config::FRAMES_PER_BUFFER * Config::CHANNELS);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> sample(-20000, 20000);
+    for (auto& value : captured) {
+        value = static_cast<int16_t>(sample(rng));
+    }
+
+    std::vector<double> periodCosts;
+    periodCosts.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        std::fill(playback.begin(), playback.end(), 0);
+        auto start = std::chrono::steady_clock::now();
+        sidetone.push(captured.data(), Config::FRAMES_PER_BUFFER);
+        sidetone.mixInto(playback.data(), Config::FRAMES_PER_BUFFER);
+        periodCosts.push_back(elapsedUs(start));
+    }
+
+    printSummary("push+mix / periyot", periodCosts);
+    LatencySummary summary = summarize(periodCosts);
+    std::cout << "  örnek başına: " << std::fixed << std::setprecision(2)
+              << summary.meanUs * 1000.0 / Config::FRAMES_PER_BUFFER << " ns"
+              << ", karıştırılan: " << sidetone.getMixedFrames() << " frame" << std::endl;
+}
+
+// === DECODE: akış başına decode vs çok akışlı toplu decode ===
+
+void benchDecode(size_t count) {
+    std::cout << "\n=== Sunucu Karıştırma Decode (akış başına vs toplu) ===" << std::endl;
+
+    const size_t streams = Config::MAX_STREAMS;
+    const size_t ticks = std::max<size_t>(1, count / 4);
+    const double frameSeconds = Config::LYRA_FRAME_SIZE_MS / 1000.0;
+
+    // Akış başına sabit frame'ler (ham codec yükü)
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> sample(-8000, 8000);
+    std::vector<std::vector<uint8_t>> frames(streams);
+    for (auto& frame : frames) {
+        std::vector<int16_t> pcm(Config::LYRA_FRAME_SIZE);
+        for (auto& value : pcm) {
+            value = static_cast<int16_t>(sample(rng));
+        }
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(pcm.data());
+        frame.assign(bytes, bytes + pcm.size() * sizeof(int16_t));
+    }
+
+    LyraCodec codec;
+    if (!codec.initialize(Config::LYRA_SAMPLE_RATE, 1, Config::LYRA_DEFAULT_BITRATE)) {
+        std::cerr << "Codec başlatılamadı, test atlandı" << std::endl;
+        return;
+    }
+
+    BatchDecoder batch(Config::SAMPLE_RATE, streams);
+    std::vector<int32_t> perStreamMix(batch.getOutputSamples());
+    std::vector<int16_t> perStreamOut(batch.getOutputSamples());
+    std::vector<int16_t> batchMix(batch.getOutputSamples());
+
+    // Akış başına yol: decode + yeniden örnekleme + karıştırma
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < ticks; ++t) {
+        std::fill(perStreamMix.begin(), perStreamMix.end(), 0);
+        for (size_t k = 0; k < streams; ++k) {
+            auto decoded = codec.decode(frames[k].data(), frames[k].size());
+            if (!decoded) {
+                continue;
+            }
+            auto resampled = codec.resampleFromLyra(decoded->data(), decoded->size(), Config::SAMPLE_RATE);
+            size_t n = std::min(resampled.size(), perStreamMix.size());
+            for (size_t i = 0; i < n; ++i) {
+                perStreamMix[i] += resampled[i];
+            }
+        }
+        for (size_t i = 0; i < perStreamOut.size(); ++i) {
+            perStreamOut[i] = static_cast<int16_t>(std::max(-32768, std::min(32767, perStreamMix[i])));
+        }
+    }
+    double perStreamUs = elapsedUs(start);
+
+    // Toplu yol: topla + tek geçişte çöz + karıştır
+    start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < ticks; ++t) {
+        for (size_t k = 0; k < streams; ++k) {
+            batch.submit(static_cast<uint32_t>(k), frames[k].data(), frames[k].size());
+        }
+        batch.decodeTick();
+        batch.mixOutput(batchMix.data());
+    }
+    double batchUs = elapsedUs(start);
+
+    bool identical = std::equal(perStreamOut.begin(), perStreamOut.end(), batchMix.begin());
+
+    auto report = [&](const std::string& name, double totalUs) {
+        double frameUs = totalUs / static_cast<double>(ticks * streams);
+        double streamsPerCore = (frameSeconds * 1000000.0) / frameUs;
+        std::cout << std::left << std::setw(28) << name
+                  << std::right << std::fixed << std::setprecision(2)
+                  << " frame başına=" << std::setw(8) << frameUs << "us"
+                  << "  çekirdek başına akış=" << std::setprecision(0) << streamsPerCore << std::endl;
+    };
+
+    std::cout << "  " << streams << " akış x " << ticks << " tick (" << Config::LYRA_FRAME_SIZE_MS
+              << " ms frame, " << Config::LYRA_SAMPLE_RATE << " -> " << Config::SAMPLE_RATE << " Hz)" << std::endl;
+    report("akış başına decode", perStreamUs);
+    report("toplu decode (SoA)", batchUs);
+    std::cout << "  hızlanma: " << std::setprecision(2) << perStreamUs / std::max(batchUs, 1e-3) << "x"
+              << ", çıktı eşit: " << (identical ? "evet" : "HAYIR") << std::endl;
+}
+
+// === DENOISE: RNNoise ağı float vs int8 ===
+
+double timeDenoisePath(const DenoiseNet& net, const std::vector<std::vector<float>>& features, bool quantized) {
+    DenoiseNet::State state;
+    float gains[DenoiseNet::MAX_WIDTH];
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& frame : features) {
+        if (quantized) {
+            net.computeInt8(state, frame.data(), gains);
+        } else {
+            net.computeFloat(state, frame.data(), gains);
+        }
+    }
+    return elapsedUs(start) / static_cast<double>(features.size());
+}
+
+// NoiseSuppresor'ın ağ dışındaki frame maliyeti: özellik çıkarımı + sentez
+double timeFrontEnd(size_t count) {
+    DenoiseFrontEnd frontEnd;
+    std::mt19937 rng(17);
+    std::normal_distribution<float> noise(0.0f, 1000.0f);
+    std::vector<float> frame(DenoiseFrontEnd::FRAME_SIZE);
+    float features[DenoiseFrontEnd::NB_FEATURES];
+    float gains[DenoiseFrontEnd::NB_BANDS];
+    std::fill(gains, gains + DenoiseFrontEnd::NB_BANDS, 0.5f);
+
+    double totalUs = 0.0;
+    for (size_t n = 0; n < count; ++n) {
+        for (size_t i = 0; i < frame.size(); ++i) {
+            double t = static_cast<double>(n * frame.size() + i) / Config::RNNOISE_SAMPLE_RATE;
+            frame[i] = 8000.0f * static_cast<float>(std::sin(2.0 * M_PI * 180.0 * t)) + noise(rng);
+        }
+        auto start = std::chrono::steady_clock::now();
+        bool voiced = frontEnd.analyze(frame.data(), features);
+        frontEnd.synthesize(voiced ? gains : nullptr, frame.data());
+        totalUs += elapsedUs(start);
+    }
+    return totalUs / static_cast<double>(count);
+}
+
+bool benchDenoise(size_t count, const std::string& modelPath) {
+    std::cout << "\n=== RNNoise Ağı (float vs int8 çıkarım) ===" << std::endl;
+
+    DenoiseNet net;
+    if (modelPath.empty()) {
+        net.initRandom(5);
+    } else if (!net.loadFromFile(modelPath)) {
+        std::cerr << "Model yüklenemedi, test atlandı" << std::endl;
+        return false;
+    }
+
+    // Yavaş değişen özellik vektörleri (RNNoise bant enerjisi ölçeğinde)
+    std::mt19937 rng(13);
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    std::vector<std::vector<float>> features(count, std::vector<float>(DenoiseNet::INPUT_SIZE));
+    std::vector<float> current(DenoiseNet::INPUT_SIZE, 0.0f);
+    for (auto& frame : features) {
+        for (size_t i = 0; i < current.size(); ++i) {
+            current[i] = 0.9f * current[i] + 0.6f * noise(rng);
+            frame[i] = current[i];
+        }
+    }
+
+    // Doğruluk: aynı giriş dizisi, ayrı recurrent durumlar
+    DenoiseNet::State floatState;
+    DenoiseNet::State int8State;
+    float floatGains[DenoiseNet::MAX_WIDTH];
+    float int8Gains[DenoiseNet::MAX_WIDTH];
+    float maxVadError = 0.0f;
+    float maxGainError = 0.0f;
+    for (const auto& frame : features) {
+        float floatVad = net.computeFloat(floatState, frame.data(), floatGains);
+        float int8Vad = net.computeInt8(int8State, frame.data(), int8Gains);
+        maxVadError = std::max(maxVadError, std::fabs(floatVad - int8Vad));
+        for (size_t i = 0; i < net.getGainCount(); ++i) {
+            maxGainError = std::max(maxGainError, std::fabs(floatGains[i] - int8Gains[i]));
+        }
+    }
+
+    KernelIsa isa = QuantizedKernels::getIsa();
+    double floatUs = timeDenoisePath(net, features, false);
+    double int8Us = timeDenoisePath(net, features, true);
+    QuantizedKernels::setIsa(KernelIsa::SCALAR);
+    double scalarUs = timeDenoisePath(net, features, true);
+    QuantizedKernels::setIsa(isa);
+    double frontEndUs = timeFrontEnd(count);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  " << count << " frame, model: " << (modelPath.empty() ? "rastgele (RNNoise boyutları)" : modelPath)
+              << ", ağırlık: " << net.getWeightBytes() << " bayt" << std::endl;
+    std::cout << "  float (referans)     frame başına=" << std::setw(7) << floatUs << "us" << std::endl;
+    std::cout << "  int8 skaler          frame başına=" << std::setw(7) << scalarUs << "us" << std::endl;
+    std::cout << "  int8 " << std::left << std::setw(16) << QuantizedKernels::isaName(isa) << std::right
+              << "frame başına=" << std::setw(7) << int8Us << "us  (float'a göre "
+              << floatUs / std::max(int8Us, 1e-3) << "x)" << std::endl;
+    std::cout << "  özellik + sentez     frame başına=" << std::setw(7) << frontEndUs
+              << "us  (NoiseSuppresor int8 frame toplamı " << frontEndUs + int8Us << "us)" << std::endl;
+
+    bool withinTolerance = maxVadError <= Config::QUANT_VAD_TOLERANCE && maxGainError <= Config::QUANT_GAIN_TOLERANCE;
+    std::cout << std::setprecision(5) << "  maks. sapma: konuşma olasılığı=" << maxVadError
+              << " (tolerans " << Config::QUANT_VAD_TOLERANCE << "), kazanç=" << maxGainError
+              << " (tolerans " << Config::QUANT_GAIN_TOLERANCE << ") -> "
+              << (withinTolerance ? "GEÇTİ" : "KALDI") << std::endl;
+    return withinTolerance;
+}
+
+// === STAGES: aşama başına süre histogramı ve donanım sayaçları ===
+
+void benchStages(size_t count, const std::string& csvPrefix) {
+    std::cout << "\n=== Aşama Profili (süre + perf_event sayaçları) ===" << std::endl;
+
+    auto profiler = std::make_shared<StageProfiler>();
+    profiler->setHardwareCounters(true);
+    if (!profiler->attachCurrentThread()) {
+        std::cout << "  perf_event_open kullanılamıyor (perf_event_paranoid / sanal makine); yalnızca süre ölçülür"
+                  << std::endl;
+    }
+
+    LyraCodec codec;
+    if (!codec.initialize(Config::LYRA_SAMPLE_RATE, 1, Config::LYRA_DEFAULT_BITRATE)) {
+        std::cerr << "Codec başlatılamadı, test atlandı" << std::endl;
+        return;
+    }
+    codec.setStageProfiler(profiler);
+
+    DenoiseNet net;
+    net.initRandom(5);
+    DenoiseNet::State floatState;
+    DenoiseNet::State int8State;
+    float gains[DenoiseNet::MAX_WIDTH];
+    int floatStage = profiler->addStage("denoise.float");
+    int int8Stage = profiler->addStage("denoise.int8");
+
+    BatchDecoder batch(Config::SAMPLE_RATE, Config::MAX_STREAMS);
+    std::vector<int16_t> mix(batch.getOutputSamples());
+    int batchStage = profiler->addStage("batch.decodeTick");
+
+    // 20 ms'lik 48 kHz yakalama periyodu ve RNNoise özellikleri
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> sample(-8000, 8000);
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    std::vector<int16_t> capture(Config::SAMPLE_RATE * Config::LYRA_FRAME_SIZE_MS / 1000);
+    std::vector<float> features(DenoiseNet::INPUT_SIZE);
+
+    for (size_t i = 0; i < count; ++i) {
+        for (auto& value : capture) {
+            value = static_cast<int16_t>(sample(rng));
+        }
+        for (auto& value : features) {
+            value = noise(rng);
+        }
+
+        auto resampled = codec.resampleTo16kHz(capture.data(), capture.size(), Config::SAMPLE_RATE);
+        auto packet = codec.encode(resampled.data(), resampled.size());
+        if (packet) {
+            codec.decode(*packet);
+            for (size_t k = 0; k < Config::MAX_STREAMS; ++k) {
+                batch.submit(static_cast<uint32_t>(k), packet->data.data(), packet->data.size());
+            }
+        }
+
+        {
+            StageProfiler::Scope scope(profiler.get(), floatStage);
+            net.computeFloat(floatState, features.data(), gains);
+        }
+        {
+            StageProfiler::Scope scope(profiler.get(), int8Stage);
+            net.computeInt8(int8State, features.data(), gains);
+        }
+        {
+            StageProfiler::Scope scope(profiler.get(), batchStage);
+            batch.decodeTick();
+        }
+        batch.mixOutput(mix.data());
+    }
+
+    std::cout << "  " << count << " periyot (" << Config::LYRA_FRAME_SIZE_MS << " ms)" << std::endl;
+    std::cout << profiler->formatReport();
+
+    if (!csvPrefix.empty() && profiler->exportCsv(csvPrefix)) {
+        std::cout << "  yazıldı: " << csvPrefix << "_stages.csv, " << csvPrefix << "_histogram.csv" << std::endl;
+    }
+}
+
+// === RTCHECK: ses thread'lerinin periyot fonksiyonlarında ihlal bütçeleri ===
+
+constexpr size_t RT_KIND_COUNT = static_cast<size_t>(RtViolation::COUNT);
+constexpr uint16_t RTCHECK_PORT = 47017;  // Loopback alıcı (yalnızca 127.0.0.1)
+
+const char* const RT_KIND_LABELS[RT_KIND_COUNT] = {"ayırma", "bırakma", "mutex", "bloklayan"};
+
+// setw bayt sayar; Türkçe karakterli başlıklar görünen genişlikle hizalanır
+std::string padLeft(const std::string& text, size_t width) {
+    size_t visible = 0;
+    for (unsigned char c : text) {
+        visible += (c & 0xC0) != 0x80;
+    }
+    return std::string(width > visible ? width - visible : 0, ' ') + text;
+}
+
+struct RealtimeBudget {
+    const char* name;
+    double perCall[RT_KIND_COUNT];  // Tür başına çağrı başı izin (ayırma, bırakma, mutex, bloklayan)
+};
+
+struct RealtimeTally {
+    uint64_t counts[RT_KIND_COUNT] = {};
+    size_t calls = 0;
+};
+
+void snapshotViolations(uint64_t (&counts)[RT_KIND_COUNT]) {
+    for (size_t k = 0; k < RT_KIND_COUNT; ++k) {
+        counts[k] = RealtimeCheck::getViolations(static_cast<RtViolation>(k));
+    }
+}
+
+// Son görüntüden bu yana sayılanları yola yazar; görüntüyü ilerletir
+void chargeViolations(RealtimeTally& tally, uint64_t (&since)[RT_KIND_COUNT]) {
+    uint64_t now[RT_KIND_COUNT];
+    snapshotViolations(now);
+    for (size_t k = 0; k < RT_KIND_COUNT; ++k) {
+        tally.counts[k] += now[k] - since[k];
+        since[k] = now[k];
+    }
+    tally.calls++;
+}
+
+bool waitForReceived(const UDPManager& manager, uint64_t expected) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (manager.getReceivedPackets() < expected) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+bool reportRealtime(const RealtimeBudget& budget, const RealtimeTally& tally) {
+    std::string exceeded;
+    std::cout << "  " << std::left << std::setw(22) << budget.name << std::right;
+    for (size_t k = 0; k < RT_KIND_COUNT; ++k) {
+        double perCall = tally.calls > 0 ? tally.counts[k] / static_cast<double>(tally.calls) : 0.0;
+        if (perCall > budget.perCall[k] + 1e-9) {
+            exceeded += exceeded.empty() ? "" : ", ";
+            exceeded += RealtimeCheck::violationName(static_cast<RtViolation>(k));
+        }
+        std::ostringstream cell;
+        cell << std::fixed << std::setprecision(2) << perCall << "/" << budget.perCall[k];
+        std::cout << std::setw(12) << cell.str();
+    }
+    std::cout << (exceeded.empty() ? "" : "  AŞILDI: " + exceeded) << std::endl;
+    return exceeded.empty();
+}
+
+bool benchRealtime(size_t count) {
+    std::cout << "\n=== Gerçek zamanlı güvenlik (malloc/free, mutex, bloklayan çağrı) ===" << std::endl;
+
+    // Ses thread'lerinin gerçek periyot gövdeleri loopback üzerinde sırayla:
+    // capture (okuma sonrası gövde) -> gönderim -> UDP alıcı döngüsü -> playback.processPeriod.
+    // Cihaz G/Ç'si (readi/writei) ve recvfrom BlockingSection ile zaten muaftır. Gönderici
+    // thread'inin işi (kuyruğu çekme, sendto) bu thread'de yapılır: yollar sırayla ölçülür.
+    auto sendBuffers = std::make_shared<BufferManager>();
+    auto receiveBuffers = std::make_shared<BufferManager>();
+    auto sidetone = std::make_shared<Sidetone>();
+    sidetone->setLevel(0.3f);
+
+    AudioCapture capture;
+    capture.setBufferManager(sendBuffers);
+    capture.setSidetone(sidetone);
+    AudioPlayer player;
+    player.setBufferManager(receiveBuffers);
+    player.setSidetone(sidetone);
+
+    UDPManager receiver;
+    receiver.setLogging(false);
+    receiver.setBufferManager(receiveBuffers);
+    int sendFd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sendFd < 0 || !receiver.startServer(RTCHECK_PORT)) {
+        std::cerr << "  Hata: loopback UDP başlatılamadı (port " << RTCHECK_PORT << ")" << std::endl;
+        if (sendFd >= 0) {
+            close(sendFd);
+        }
+        return false;
+    }
+
+    struct sockaddr_in target;
+    std::memset(&target, 0, sizeof(target));
+    target.sin_family = AF_INET;
+    target.sin_port = htons(RTCHECK_PORT);
+    target.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    std::vector<std::shared_ptr<AudioPacket>> outgoing;
+    std::vector<uint8_t> wire;
+
+    std::mt19937 rng(29);
+    std::uniform_int_distribution<int> sample(-8000, 8000);
+    size_t frames = player.getPeriodFrames();
+    std::vector<int16_t> period(frames * Config::CHANNELS);
+    for (auto& value : period) {
+        value = static_cast<int16_t>(sample(rng));
+    }
+
+    // Bütçeler bu ağaçta ölçülen değerlerdir (artış regresyondur, azalınca düşürülmeli).
+    // Capture ve alım paket başına make_shared + veri vector'ü ayırır (gönderim kuyruğunun
+    // deque bloğu ~32 pakette bir) ve kuyruk kilidini alır; alım ayrıca akış tablosu kilidini.
+    // Playback paket ayırmaz/bırakmaz (bırakma gönderici thread'inde), yalnızca çekme kilidi.
+    const RealtimeBudget captureBudget = {"capture.processPeriod", {2.1, 0.0, 1.0, 0.0}};
+    const RealtimeBudget receiveBudget = {"receive.datagram", {2.0, 0.0, 2.0, 0.0}};
+    const RealtimeBudget playbackBudget = {"playback.processPeriod", {0.0, 0.0, 1.0, 0.0}};
+
+    RealtimeTally captureTally;
+    RealtimeTally receiveTally;
+    RealtimeTally playbackTally;
+    uint64_t since[RT_KIND_COUNT];
+    bool delivered = true;
+
+    auto runPeriod = [&](bool charge) {
+        uint64_t expected = receiver.getReceivedPackets() + 1;
+        snapshotViolations(since);
+        {
+            RealtimeSection realtime("capture");
+            capture.processCapturedPeriod(period.data(), frames);
+        }
+        if (charge) {
+            chargeViolations(captureTally, since);
+        }
+
+        // Gönderici thread'inin işi; alıcı döngüsü (RealtimeSection "receive") paketi işler
+        sendBuffers->popOutputBatch(outgoing, Config::SEND_BATCH_SIZE);
+        for (const auto& packet : outgoing) {
+            PacketWire::serializeInto(*packet, 1, wire);
+            sendto(sendFd, wire.data(), wire.size(), 0, reinterpret_cast<struct sockaddr*>(&target), sizeof(target));
+        }
+        outgoing.clear();
+        if (!waitForReceived(receiver, expected)) {
+            delivered = false;
+            return;
+        }
+        if (charge) {
+            chargeViolations(receiveTally, since);
+        }
+
+        {
+            RealtimeSection realtime("playback");
+            player.processPeriod();
+        }
+        if (charge) {
+            chargeViolations(playbackTally, since);
+        }
+
+        // Gönderici thread'inin işi: çalınmış paketler ses thread'i dışında bırakılır
+        receiveBuffers->releaseRetiredPackets();
+    };
+
+    // Yığınlar tabloda toplanır, yalnızca bütçe aşımında yazdırılır
+    RealtimeCheck::setTraceOnViolation(false);
+    RealtimeCheck::setEnabled(true);
+
+    // Isınma: akış slotu, playout başlangıcı ve kuyrukların ilk büyümesi sayılmaz
+    for (size_t i = 0; i < Config::BUFFER_COUNT && delivered; ++i) {
+        runPeriod(false);
+    }
+    RealtimeCheck::reset();
+    for (size_t i = 0; i < count && delivered; ++i) {
+        runPeriod(true);
+    }
+
+    // Periyot gövdesi dışındaki gerçek zamanlı çekirdekler: sıfır bütçe
+    BatchDecoder batch(Config::SAMPLE_RATE, Config::MAX_STREAMS);
+    LyraCodec codec;
+    codec.initialize(Config::LYRA_SAMPLE_RATE, 1, Config::LYRA_DEFAULT_BITRATE);
+    std::vector<int16_t> lyraFrame(Config::LYRA_FRAME_SIZE);
+    auto encoded = codec.encode(lyraFrame.data(), lyraFrame.size());
+    DenoiseNet net;
+    net.initRandom(5);
+    DenoiseNet::State state;
+    float gains[DenoiseNet::MAX_WIDTH];
+    std::vector<float> features(DenoiseNet::INPUT_SIZE, 0.5f);
+
+    struct KernelPath {
+        RealtimeBudget budget;
+        std::function<void()> run;
+        RealtimeTally tally;
+    };
+    std::vector<KernelPath> kernels = {
+        {{"batch.decodeTick", {0.0, 0.0, 0.0, 0.0}},
+         [&]() {
+             for (size_t k = 0; encoded && k < Config::MAX_STREAMS; ++k) {
+                 batch.submit(static_cast<uint32_t>(k), encoded->data.data(), encoded->data.size());
+             }
+             batch.decodeTick();
+         }, {}},
+        {{"denoise.int8", {0.0, 0.0, 0.0, 0.0}},
+         [&]() { net.computeInt8(state, features.data(), gains); }, {}},
+    };
+    for (auto& kernel : kernels) {
+        kernel.run();
+        for (size_t i = 0; i < count; ++i) {
+            snapshotViolations(since);
+            {
+                RealtimeSection realtime(kernel.budget.name);
+                kernel.run();
+            }
+            chargeViolations(kernel.tally, since);
+        }
+    }
+
+    RealtimeCheck::setEnabled(false);
+    RealtimeCheck::setTraceOnViolation(true);
+    receiver.stop();
+    close(sendFd);
+
+    if (!delivered) {
+        std::cerr << "  Hata: loopback paketi 1 s içinde alınmadı" << std::endl;
+        return false;
+    }
+
+    std::cout << "  " << std::left << std::setw(22) << "yol" << std::right;
+    for (size_t k = 0; k < RT_KIND_COUNT; ++k) {
+        std::cout << padLeft(RT_KIND_LABELS[k], 12);
+    }
+    std::cout << std::endl;
+
+    bool passed = reportRealtime(captureBudget, captureTally);
+    passed = reportRealtime(receiveBudget, receiveTally) && passed;
+    passed = reportRealtime(playbackBudget, playbackTally) && passed;
+    for (const auto& kernel : kernels) {
+        passed = reportRealtime(kernel.budget, kernel.tally) && passed;
+    }
+
+    std::cout << "  (" << count << " periyot, çağrı başına ölçülen/bütçe; tür başına aşım çıkış kodunu 1 yapar)" << std::endl;
+    if (!passed) {
+        std::cout << RealtimeCheck::formatReport(true);
+    }
+    return passed;
+}
+
+// === AUTOTUNE: çekirdek adaylarının ölçümü ve wisdom dosyası ===
+
+bool benchAutotune(const std::string& wisdomPath) {
+    std::cout << "\n[autotune] Başlangıç çekirdek seçimi (" << KernelAutotuner::detectCpuModel() << ")" << std::endl;
+
+    // Adaylar eşdeğer olmalı: tablo çekirdeği doğrudan yolla bit düzeyinde aynı
+    LyraCodec codec;
+    std::vector<int16_t> capture(Config::SAMPLE_RATE * Config::LYRA_FRAME_SIZE_MS / 1000);
+    std::mt19937 rng(23);
+    std::uniform_int_distribution<int> sample(-32768, 32767);
+    for (auto& value : capture) {
+        value = static_cast<int16_t>(sample(rng));
+    }
+
+    ResamplerKernel previous = LyraCodec::getResamplerKernel();
+    LyraCodec::setResamplerKernel(ResamplerKernel::DIRECT);
+    auto directDown = codec.resampleTo16kHz(capture.data(), capture.size(), Config::SAMPLE_RATE);
+    auto directUp = codec.resampleFromLyra(directDown.data(), directDown.size(), Config::SAMPLE_RATE);
+    LyraCodec::setResamplerKernel(ResamplerKernel::TABLE);
+    auto tableDown = codec.resampleTo16kHz(capture.data(), capture.size(), Config::SAMPLE_RATE);
+    auto tableUp = codec.resampleFromLyra(tableDown.data(), tableDown.size(), Config::SAMPLE_RATE);
+    LyraCodec::setResamplerKernel(previous);
+
+    bool identical = directDown == tableDown && directUp == tableUp;
+    std::cout << "  yeniden örnekleme çekirdekleri eşit: " << (identical ? "evet" : "HAYIR") << std::endl;
+
+    KernelAutotuner tuner(wisdomPath);
+    tuner.addKernel(QuantizedKernels::makeTunable());
+    tuner.addKernel(LyraCodec::makeResamplerTunable());
+    tuner.addKernel(BatchDecoder::makeColumnBlockTunable());
+
+    auto start = std::chrono::steady_clock::now();
+    bool saved = tuner.tune(true);
+    double calibrationMs = elapsedUs(start) / 1000.0;
+
+    std::cout << tuner.formatReport();
+    std::cout << "  ölçüm süresi: " << std::fixed << std::setprecision(1) << calibrationMs << " ms"
+              << ", wisdom: " << tuner.getWisdomPath() << (saved ? "" : " (YAZILAMADI)") << std::endl;
+
+    // İkinci açılış: kayıtlı seçimler ölçümsüz uygulanmalı
+    KernelAutotuner reload(wisdomPath);
+    reload.addKernel(QuantizedKernels::makeTunable());
+    reload.addKernel(LyraCodec::makeResamplerTunable());
+    reload.addKernel(BatchDecoder::makeColumnBlockTunable());
+    start = std::chrono::steady_clock::now();
+    reload.tune();
+    std::cout << "  wisdom ile açılış: " << std::setprecision(2) << elapsedUs(start) / 1000.0 << " ms"
+              << (reload.wasCalibrated() ? " (yeniden ölçüldü)" : "") << std::endl;
+
+    return identical && saved && !reload.wasCalibrated();
+}
+
+void printUsage(const char* programName) {
+    std::cout << "Nova Voice Engine V2 - Benchmark Aracı" << std::endl;
+    std::cout << "Kullanım: " << programName << " [SEÇENEKLER]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  --scenario NAME    Sadece belirtilen senaryoyu çalıştır (wakeup, lanes, sidetone, decode, denoise, stages)" << std::endl;
+    std::cout << "                     rtcheck: yalnızca nova_bench_rtcheck ile (all'a orada dahil)" << std::endl;
+    std::cout << "                     autotune: çekirdekleri ölç ve wisdom dosyasını yenile (all'a dahil değil)" << std::endl;
+    std::cout << "  --model PATH       denoise senaryosu için RNNoise model dosyası (varsayılan: rastgele ağırlık)" << std::endl;
+    std::cout << "  --perf-csv PREFIX  stages senaryosunun özet ve histogramını CSV olarak yaz" << std::endl;
+    std::cout << "  --wisdom PATH      autotune senaryosunun wisdom dosyası (varsayılan: " << KernelAutotuner::defaultWisdomPath() << ")" << std::endl;
+    std::cout << "  --count N          Senaryo başına örnek sayısı (varsayılan: 2000)" << std::endl;
+    std::cout << "  -h, --help         Bu yardım mesajını göster" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string scenario = "all";
+    size_t count = 2000;
+    std::string modelPath;
+    std::string csvPrefix;
+    std::string wisdomPath = KernelAutotuner::defaultWisdomPath();
+    bool passed = true;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--scenario" && i + 1 < argc) {
+            scenario = argv[++i];
+        } else if (arg == "--model" && i + 1 < argc) {
+            modelPath = argv[++i];
+        } else if (arg == "--perf-csv" && i + 1 < argc) {
+            csvPrefix = argv[++i];
+        } else if (arg == "--wisdom" && i + 1 < argc) {
+            wisdomPath = argv[++i];
+        } else if (arg == "--count" && i + 1 < argc) {
+            count = static_cast<size_t>(std::stoul(argv[++i]));
+        } else {
+            std::cerr << "Hata: Bilinmeyen parametre: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::cout << "=== Nova Voice Engine V2 Benchmark ===" << std::endl;
+
+    if (scenario == "all" || scenario == "wakeup") {
+        benchWakeup(count);
+    }
+
+    if (scenario == "all" || scenario == "lanes") {
+        benchLanes(count);
+    }
+
+    if (scenario == "all" || scenario == "sidetone") {
+        benchSidetone(count);
+    }
+
+    if (scenario == "all" || scenario == "decode") {
+        benchDecode(count);
+    }
+
+    if (scenario == "all" || scenario == "denoise") {
+        passed = benchDenoise(count, modelPath) && passed;
+    }
+
+    if (scenario == "all" || scenario == "stages") {
+        benchStages(count, csvPrefix);
+    }
+
+    // Sarmalayıcılar yalnızca nova_bench_rtcheck hedefinde derlenir
+    if (scenario == "rtcheck" && !RealtimeCheck::isCompiledIn()) {
+        std::cerr << "Hata: rtcheck senaryosu için nova_bench_rtcheck kullanın" << std::endl;
+        passed = false;
+    } else if ((scenario == "all" || scenario == "rtcheck") && RealtimeCheck::isCompiledIn()) {
+        passed = benchRealtime(std::min<size_t>(count, 500)) && passed;
+    }
+
+    // Wisdom dosyasını yazdığı için yalnızca açıkça istendiğinde
+    if (scenario == "autotune") {
+        passed = benchAutotune(wisdomPath) && passed;
+    }
+
+    return passed ? 0 : 1;
+}
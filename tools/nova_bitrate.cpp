@@ -0,0 +1,738 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <random>
+#include <memory>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <cctype>
+
+#include "Config.h"
+#include "BitrateCalculator.h"
+
+using namespace NovaVoice;
+
+// Nova Voice Engine V2 - Bitrate Adaptasyon Politikası Değerlendirici
+// Kayıtlı veya sentetik ağ izlerini (zamana göre bant genişliği, kayıp ve
+// gecikme) motorun kendi BitrateCalculator'ı ve simüle bir darboğaz
+// kuyruğu üzerinden oynatır. Gönderici her 20 ms'de güncel bitrate'te bir
+// Lyra frame'i yollar; alıcının ölçtüğü kayıp, gecikme, jitter ve doygun
+// bağlantıdaki teslim hızı her geri bildirim aralığında hesaplayıcıya
+// verilir. Her politika ulaşılan bitrate, kayıp, kuyruk gecikmesi ve
+// bitrate geçiş sayısı üzerinden puanlanır. Simüle zamanda çalışır.
+
+namespace {
+
+// === PUANLAMA ===
+// Puan = 100 x (kalite - kayıp cezası - gecikme cezası - geçiş cezası)
+// Kalite, ulaşılan bitrate'in Lyra aralığındaki yeridir (0..1)
+constexpr double LOSS_PENALTY = 5.0;          // %10 kayıp = 0.5 kalite
+constexpr double DELAY_PENALTY = 0.5;         // p95 kuyruk gecikmesi DELAY_REFERENCE_MS'de
+constexpr double DELAY_REFERENCE_MS = 150.0;  // Etkileşim için tek yön bütçesi
+constexpr double SWITCH_PENALTY = 0.005;      // Dakikadaki her geçiş
+
+constexpr double FRAME_US = Config::LYRA_FRAME_SIZE_MS * 1000.0;
+
+// Seçenek sınırları (kuyruk histogramı milisaniye başına bir kova ayırır)
+constexpr double MAX_DURATION_S = 86400.0;
+constexpr double MAX_QUEUE_MS = 10000.0;
+
+// === AĞ İZİ ===
+
+struct TracePoint {
+    double timeS;
+    double bandwidthKbps;
+    double lossRate;
+    double delayMs;
+};
+
+struct Trace {
+    std::string name;
+    std::vector<TracePoint> points;  // Zamana göre sıralı; bir sonraki noktaya kadar sabit
+    double durationS = 0.0;
+};
+
+bool loadTrace(const std::string& path, Trace& trace) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Hata: İz dosyası açılamadı: " << path << std::endl;
+        return false;
+    }
+
+    // Biçim: time_s,bandwidth_kbps,loss_pct,delay_ms (başlık ve # satırları atlanır)
+    trace.name = path.substr(path.find_last_of('/') + 1);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#' || !(std::isdigit(static_cast<unsigned char>(line[0])) || line[0] == '.')) {
+            continue;
+        }
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream fields(line);
+        TracePoint point;
+        double lossPercent = 0.0;
+        if (!(fields >> point.timeS >> point.bandwidthKbps >> lossPercent >> point.delayMs)) {
+            std::cerr << "Hata: Geçersiz iz satırı: " << line << std::endl;
+            return false;
+        }
+        point.lossRate = std::max(0.0, std::min(1.0, lossPercent / 100.0));
+        if (!trace.points.empty() && point.timeS <= trace.points.back().timeS) {
+            std::cerr << "Hata: İz zamanları artan sırada olmalı: " << line << std::endl;
+            return false;
+        }
+        trace.points.push_back(point);
+    }
+
+    if (trace.points.size() < 2) {
+        std::cerr << "Hata: İz en az iki nokta içermeli: " << path << std::endl;
+        return false;
+    }
+
+    // Son nokta izin bitişini belirtir
+    trace.durationS = trace.points.back().timeS;
+    return true;
+}
+
+// Sentetik izler saniyelik adımlarla üretilir
+Trace makeSyntheticTrace(const std::string& name, double durationS, uint32_t seed) {
+    Trace trace;
+    trace.name = name;
+    trace.durationS = durationS;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    double bandwidth = 40.0;
+    double delay = 80.0;
+    double fadeUntil = -1.0;
+    for (double t = 0.0; t < durationS; t += 1.0) {
+        TracePoint point{t, 64.0, 0.005, 40.0};
+        if (name == "step") {
+            // Bağlantı 60 s içinde yarı hıza, sonra Lyra'nın taşıyamayacağı hıza düşer ve geri gelir
+            double phase = std::fmod(t, 240.0);
+            point.bandwidthKbps = phase < 60.0 ? 48.0 : phase < 120.0 ? 24.0 : phase < 180.0 ? 16.0 : 48.0;
+            point.delayMs = 50.0;
+        } else if (name == "cellular") {
+            // Log-normal rastgele yürüyüş ve ara sıra sönümlenme (fade)
+            bandwidth = std::max(14.0, std::min(64.0, bandwidth * std::exp(0.12 * normal(rng))));
+            delay = std::max(40.0, std::min(160.0, delay + 8.0 * normal(rng)));
+            if (fadeUntil < t && uniform(rng) < 0.02) {
+                fadeUntil = t + 3.0 + 5.0 * uniform(rng);
+            }
+            bool fading = t <= fadeUntil;
+            point.bandwidthKbps = fading ? bandwidth * 0.5 : bandwidth;
+            point.lossRate = fading ? 0.10 : 0.01;
+            point.delayMs = delay;
+        } else if (name == "lossy") {
+            // Bant genişliği bol; tıkanıklık dışı kayıp 20 s'de bir %1 ile %8 arasında değişir
+            point.lossRate = std::fmod(t, 40.0) < 20.0 ? 0.01 : 0.08;
+            point.delayMs = 80.0;
+        }
+        trace.points.push_back(point);
+    }
+    trace.points.push_back({durationS, trace.points.back().bandwidthKbps, trace.points.back().lossRate,
+                            trace.points.back().delayMs});
+    return trace;
+}
+
+const char* SYNTHETIC_TRACES[] = {"steady", "step", "cellular", "lossy"};
+
+// === POLİTİKA ===
+
+struct Policy {
+    std::string name;
+    float targetQuality = 0.5f;
+    float adaptationSpeed = 0.3f;
+    float stabilityThreshold = 0.1f;
+    float networkWeight = 0.6f;
+    BitrateCalculator::QualityMode mode = BitrateCalculator::QualityMode::ADAPTIVE;
+    uint32_t fixedBitrate = 0;  // 0 değilse otomatik adaptasyon kapalı
+};
+
+bool parseMode(const std::string& value, BitrateCalculator::QualityMode& mode) {
+    if (value == "adaptive") {
+        mode = BitrateCalculator::QualityMode::ADAPTIVE;
+    } else if (value == "balanced") {
+        mode = BitrateCalculator::QualityMode::BALANCED;
+    } else if (value == "high-quality") {
+        mode = BitrateCalculator::QualityMode::HIGH_QUALITY;
+    } else if (value == "power-save") {
+        mode = BitrateCalculator::QualityMode::POWER_SAVE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// "ad:target=0.7,speed=0.5,stability=0.05,network=0.8,mode=balanced" veya "ad:fixed=6000"
+bool parsePolicy(const std::string& spec, Policy& policy) {
+    size_t colon = spec.find(':');
+    policy.name = spec.substr(0, colon);
+    if (policy.name.empty()) {
+        return false;
+    }
+    if (colon == std::string::npos) {
+        return true;
+    }
+
+    std::istringstream items(spec.substr(colon + 1));
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        size_t equals = item.find('=');
+        if (equals == std::string::npos) {
+            return false;
+        }
+        std::string key = item.substr(0, equals);
+        std::string value = item.substr(equals + 1);
+        try {
+            if (key == "target") {
+                policy.targetQuality = std::stof(value);
+            } else if (key == "speed") {
+                policy.adaptationSpeed = std::stof(value);
+            } else if (key == "stability") {
+                policy.stabilityThreshold = std::stof(value);
+            } else if (key == "network") {
+                policy.networkWeight = std::stof(value);
+            } else if (key == "mode") {
+                if (!parseMode(value, policy.mode)) {
+                    return false;
+                }
+            } else if (key == "fixed") {
+                policy.fixedBitrate = static_cast<uint32_t>(std::stoul(value));
+            } else {
+                return false;
+            }
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<Policy> defaultPolicies() {
+    std::vector<Policy> policies(9);
+    policies[0].name = "default";
+    policies[1].name = "fast";
+    policies[1].adaptationSpeed = 0.8f;
+    policies[2].name = "fine-step";
+    policies[2].stabilityThreshold = 0.03f;
+    policies[3].name = "sticky";
+    policies[3].stabilityThreshold = 0.25f;
+    policies[4].name = "quality";
+    policies[4].targetQuality = 0.9f;
+    policies[5].name = "network-only";
+    policies[5].networkWeight = 1.0f;
+    policies[6].name = "balanced";
+    policies[6].mode = BitrateCalculator::QualityMode::BALANCED;
+    policies[7].name = "high-quality";
+    policies[7].mode = BitrateCalculator::QualityMode::HIGH_QUALITY;
+    policies[8].name = "fixed-6000";
+    policies[8].fixedBitrate = Config::LYRA_DEFAULT_BITRATE;
+    return policies;
+}
+
+// Hedef kalite x hız x kararlılık eşiği x ağ ağırlığı taraması
+std::vector<Policy> gridPolicies() {
+    const float targets[] = {0.3f, 0.5f, 0.7f, 0.9f};
+    const float speeds[] = {0.1f, 0.3f, 0.6f, 0.9f};
+    const float stabilities[] = {0.02f, 0.05f, 0.1f, 0.2f};
+    const float networkWeights[] = {0.4f, 0.6f, 0.8f, 1.0f};
+
+    std::vector<Policy> policies;
+    for (float target : targets) {
+        for (float speed : speeds) {
+            for (float stability : stabilities) {
+                for (float network : networkWeights) {
+                    Policy policy;
+                    std::ostringstream name;
+                    name << "t" << target << "/s" << speed << "/th" << stability << "/w" << network;
+                    policy.name = name.str();
+                    policy.targetQuality = target;
+                    policy.adaptationSpeed = speed;
+                    policy.stabilityThreshold = stability;
+                    policy.networkWeight = network;
+                    policies.push_back(policy);
+                }
+            }
+        }
+    }
+    return policies;
+}
+
+// === SİMÜLASYON ===
+
+struct EvalOptions {
+    double feedbackMs = Config::BITRATE_UPDATE_INTERVAL_MS;
+    double queueLimitMs = 300.0;   // Darboğaz tamponu (drop-tail), güncel hızda
+    size_t overheadBytes = 28 + 9; // IPv4/UDP + motor paket başlığı
+    bool speechOnly = false;
+    uint32_t seed = 1;
+};
+
+struct RunResult {
+    double achievedKbps = 0.0;  // Teslim edilen yük
+    double sentKbps = 0.0;
+    double lossRate = 0.0;      // Kuyruk atımı + hat kaybı
+    double dropRate = 0.0;      // Yalnızca kuyruk atımı (tıkanıklık)
+    double meanQueueMs = 0.0;
+    double p95QueueMs = 0.0;
+    double switchesPerMinute = 0.0;
+    uint64_t switches = 0;
+    double score = 0.0;
+};
+
+double scoreRun(const RunResult& result) {
+    double range = Config::LYRA_MAX_BITRATE - Config::LYRA_MIN_BITRATE;
+    double quality = std::max(0.0, std::min(1.0, (result.achievedKbps * 1000.0 - Config::LYRA_MIN_BITRATE) / range));
+    return 100.0 * (quality - LOSS_PENALTY * result.lossRate -
+                    DELAY_PENALTY * std::min(1.0, result.p95QueueMs / DELAY_REFERENCE_MS) -
+                    SWITCH_PENALTY * result.switchesPerMinute);
+}
+
+// Tek politika x tek iz; seed aynıysa kayıp ve konuşma desenleri politikalar arasında aynıdır
+class BottleneckRun {
+public:
+    BottleneckRun(const Policy& policy, const Trace& trace, const EvalOptions& options)
+        : policy_(policy)
+        , trace_(trace)
+        , options_(options)
+        , lossRng_(options.seed)
+        , speechRng_(options.seed ^ 0x5bd1e995u)
+        , queueHistogram_(static_cast<size_t>(options.queueLimitMs) + 2, 0) {
+    }
+
+    RunResult run() {
+        BitrateCalculator calculator;
+        calculator.setLogging(false);
+        calculator.setTargetQuality(policy_.targetQuality);
+        calculator.setAdaptationSpeed(policy_.adaptationSpeed);
+        calculator.setStabilityThreshold(policy_.stabilityThreshold);
+        calculator.setWeights(policy_.networkWeight, 1.0f - policy_.networkWeight);
+        if (policy_.fixedBitrate != 0) {
+            calculator.enableAutoAdaptation(false);
+            calculator.initialize(policy_.fixedBitrate);
+        } else {
+            calculator.initialize();
+            calculator.setQualityMode(policy_.mode);
+        }
+
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        std::exponential_distribution<double> talkSeconds(1.0 / 2.0);
+        std::exponential_distribution<double> pauseSeconds(1.0 / 1.0);
+
+        bool speaking = true;
+        double nextSpeechToggleUs = options_.speechOnly ? 1e300 : talkSeconds(speechRng_) * 1e6;
+        calculator.updateAudioMetrics(audioMetrics(speaking));
+
+        double durationUs = trace_.durationS * 1e6;
+        double nextFeedbackUs = options_.feedbackMs * 1000.0;
+        double linkFreeUs = 0.0;
+        size_t traceIndex = 0;
+
+        uint64_t sent = 0, dropped = 0, lost = 0, delivered = 0;
+        uint64_t sentPayloadBits = 0, deliveredPayloadBits = 0;
+        double queueSumMs = 0.0;
+        Window window;
+
+        for (double nowUs = 0.0; nowUs < durationUs; nowUs += FRAME_US) {
+            while (traceIndex + 1 < trace_.points.size() && trace_.points[traceIndex + 1].timeS * 1e6 <= nowUs) {
+                traceIndex++;
+            }
+            const TracePoint& link = trace_.points[traceIndex];
+
+            // Alıcı raporu: önceki pencerenin ölçümleri hesaplayıcıya
+            if (nowUs >= nextFeedbackUs) {
+                calculator.updateNetworkMetrics(window.report(options_.feedbackMs));
+                window.reset();
+                nextFeedbackUs += options_.feedbackMs * 1000.0;
+            }
+
+            // Konuşma/sessizlik değişimi: ses ölçütleri hesaplayıcıya anında gider
+            if (nowUs >= nextSpeechToggleUs) {
+                speaking = !speaking;
+                nextSpeechToggleUs = nowUs + (speaking ? talkSeconds(speechRng_) : pauseSeconds(speechRng_)) * 1e6;
+                calculator.updateAudioMetrics(audioMetrics(speaking));
+            }
+
+            // Bir frame: güncel bitrate'te yük + sabit başlık
+            uint32_t bitrate = calculator.getCurrentBitrate();
+            size_t payloadBytes = (bitrate * Config::LYRA_FRAME_SIZE_MS / 1000 + 7) / 8;
+            size_t wireBits = (payloadBytes + options_.overheadBytes) * 8;
+            sent++;
+            window.sent++;
+            sentPayloadBits += payloadBytes * 8;
+
+            // Darboğaz: FIFO, kuyruğa girişteki hızla boşalır; tampon dolarsa kuyruğun sonundan atılır
+            double bitsPerUs = std::max(1e-6, link.bandwidthKbps * 1e-3);
+            double queueUs = std::max(0.0, linkFreeUs - nowUs);
+            if (queueUs > options_.queueLimitMs * 1000.0) {
+                dropped++;
+                window.lost++;
+                continue;
+            }
+            linkFreeUs = std::max(nowUs, linkFreeUs) + wireBits / bitsPerUs;
+
+            // Tıkanıklık dışı hat kaybı kuyruktan sonra
+            if (uniform(lossRng_) < link.lossRate) {
+                lost++;
+                window.lost++;
+                continue;
+            }
+
+            double queueMs = queueUs / 1000.0;
+            double latencyMs = link.delayMs + (linkFreeUs - nowUs) / 1000.0;
+            delivered++;
+            deliveredPayloadBits += payloadBytes * 8;
+            queueSumMs += queueMs;
+            queueHistogram_[std::min(queueHistogram_.size() - 1, static_cast<size_t>(queueMs))]++;
+
+            window.delivered++;
+            window.wireBits += wireBits;
+            window.queueSumMs += queueMs;
+            window.latencySumMs += latencyMs;
+            if (window.hasLatency) {
+                // RFC 3550 jitter: ardışık gecikme farkının üstel ortalaması
+                window.jitterMs += (std::fabs(latencyMs - window.lastLatencyMs) - window.jitterMs) / 16.0;
+            }
+            window.lastLatencyMs = latencyMs;
+            window.hasLatency = true;
+        }
+
+        RunResult result;
+        double seconds = trace_.durationS;
+        result.achievedKbps = deliveredPayloadBits / seconds / 1000.0;
+        result.sentKbps = sentPayloadBits / seconds / 1000.0;
+        result.lossRate = sent > 0 ? static_cast<double>(dropped + lost) / sent : 0.0;
+        result.dropRate = sent > 0 ? static_cast<double>(dropped) / sent : 0.0;
+        result.meanQueueMs = delivered > 0 ? queueSumMs / delivered : 0.0;
+        result.p95QueueMs = percentile(delivered, 0.95);
+        result.switches = calculator.getBitrateChanges();
+        result.switchesPerMinute = result.switches / (seconds / 60.0);
+        result.score = scoreRun(result);
+        return result;
+    }
+
+private:
+    // Geri bildirim penceresi; raporlanmayan paketler sonraki pencereye kalmaz
+    struct Window {
+        uint64_t sent = 0;
+        uint64_t lost = 0;
+        uint64_t delivered = 0;
+        uint64_t wireBits = 0;
+        double queueSumMs = 0.0;
+        double latencySumMs = 0.0;
+        double lastLatencyMs = 0.0;
+        double jitterMs = 0.0;
+        bool hasLatency = false;
+
+        NetworkMetrics report(double windowMs) const {
+            NetworkMetrics metrics;
+            metrics.packetLossRate = sent > 0 ? static_cast<float>(lost) / sent : 0.0f;
+            metrics.averageLatency = delivered > 0 ? static_cast<uint32_t>(latencySumMs / delivered) : 0;
+            metrics.jitter = static_cast<uint32_t>(jitterMs);
+            // Alıcı bağlantı kapasitesini ancak bağlantı doyduğunda (kuyruk biriktiğinde)
+            // teslim hızından görebilir; aksi halde bilinmiyor (0) raporlanır
+            if (delivered > 0 && queueSumMs / delivered > Config::LYRA_FRAME_SIZE_MS) {
+                metrics.bandwidth = static_cast<float>(wireBits / windowMs);
+            }
+            return metrics;
+        }
+
+        void reset() {
+            // Jitter tahmini pencereler arasında sürer
+            double jitter = jitterMs;
+            double last = lastLatencyMs;
+            bool has = hasLatency;
+            *this = Window();
+            jitterMs = jitter;
+            lastLatencyMs = last;
+            hasLatency = has;
+        }
+    };
+
+    const Policy& policy_;
+    const Trace& trace_;
+    const EvalOptions& options_;
+    std::mt19937 lossRng_;
+    std::mt19937 speechRng_;
+    std::vector<uint64_t> queueHistogram_;  // 1 ms kutular
+
+    static AudioMetrics audioMetrics(bool speaking) {
+        AudioMetrics metrics;
+        metrics.speechDetected = speaking;
+        metrics.averageVolume = speaking ? 0.4f : 0.02f;
+        metrics.signalToNoiseRatio = 25.0f;
+        return metrics;
+    }
+
+    double percentile(uint64_t count, double fraction) const {
+        uint64_t rank = static_cast<uint64_t>(std::ceil(count * fraction));
+        uint64_t seen = 0;
+        for (size_t bin = 0; bin < queueHistogram_.size(); ++bin) {
+            seen += queueHistogram_[bin];
+            if (seen >= rank && rank > 0) {
+                return static_cast<double>(bin);
+            }
+        }
+        return 0.0;
+    }
+};
+
+// === RAPOR ===
+
+struct PolicySummary {
+    size_t index;
+    RunResult mean;
+};
+
+void printHeader() {
+    // setw bayt sayar: Türkçe karakterli başlıklarda genişlik artırılır
+    std::cout << std::left << std::setw(26) << "politika" << std::right << std::setw(8) << "kbps"
+              << std::setw(10) << "kayıp%" << std::setw(10) << "atım%" << std::setw(11) << "kuyruk ms"
+              << std::setw(9) << "p95 ms" << std::setw(11) << "geçiş/dk" << std::setw(8) << "puan" << std::endl;
+}
+
+void printRow(const std::string& name, const RunResult& result) {
+    std::cout << std::left << std::setw(26) << name.substr(0, 25) << std::right << std::fixed
+              << std::setprecision(2) << std::setw(8) << result.achievedKbps << std::setprecision(1)
+              << std::setw(9) << result.lossRate * 100.0 << std::setw(9) << result.dropRate * 100.0
+              << std::setw(11) << result.meanQueueMs << std::setw(9) << result.p95QueueMs
+              << std::setw(10) << result.switchesPerMinute << std::setw(8) << result.score << std::endl;
+}
+
+bool writeCsv(const std::string& path, const std::vector<Policy>& policies, const std::vector<Trace>& traces,
+              const std::vector<std::vector<RunResult>>& results) {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Hata: CSV yazılamadı: " << path << std::endl;
+        return false;
+    }
+
+    file << "policy,target,speed,stability,network_weight,mode,fixed_bps,trace,achieved_kbps,sent_kbps,"
+            "loss_pct,drop_pct,queue_mean_ms,queue_p95_ms,switches,switches_per_min,score\n";
+    for (size_t p = 0; p < policies.size(); ++p) {
+        const Policy& policy = policies[p];
+        for (size_t t = 0; t < traces.size(); ++t) {
+            const RunResult& r = results[p][t];
+            file << policy.name << ',' << policy.targetQuality << ',' << policy.adaptationSpeed << ','
+                 << policy.stabilityThreshold << ',' << policy.networkWeight << ','
+                 << BitrateUtils::qualityModeToString(policy.mode) << ',' << policy.fixedBitrate << ','
+                 << traces[t].name << ',' << r.achievedKbps << ',' << r.sentKbps << ',' << r.lossRate * 100.0 << ','
+                 << r.dropRate * 100.0 << ',' << r.meanQueueMs << ',' << r.p95QueueMs << ',' << r.switches << ','
+                 << r.switchesPerMinute << ',' << r.score << '\n';
+        }
+    }
+    return true;
+}
+
+bool parseNumber(const std::string& text, double& value) {
+    try {
+        size_t consumed = 0;
+        value = std::stod(text, &consumed);
+        return consumed == text.size() && std::isfinite(value);
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool parseUnsigned(const std::string& text, uint32_t& value) {
+    try {
+        size_t consumed = 0;
+        unsigned long parsed = std::stoul(text, &consumed);
+        if (consumed != text.size() || text[0] == '-' || parsed > UINT32_MAX) {
+            return false;
+        }
+        value = static_cast<uint32_t>(parsed);
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+void printUsage(const char* programName) {
+    std::cout << "Nova Voice Engine V2 - Bitrate Adaptasyon Politikası Değerlendirici" << std::endl;
+    std::cout << "Kullanım: " << programName << " [SEÇENEKLER]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  --trace FILE         CSV ağ izi: time_s,bandwidth_kbps,loss_pct,delay_ms (tekrarlanabilir)" << std::endl;
+    std::cout << "  --synthetic NAME     Sentetik iz: steady, step, cellular, lossy, all (varsayılan: all)" << std::endl;
+    std::cout << "  --duration S         Sentetik iz süresi (varsayılan: 600)" << std::endl;
+    std::cout << "  --policy SPEC        ad[:target=Q,speed=S,stability=T,network=W,mode=M,fixed=BPS] (tekrarlanabilir)" << std::endl;
+    std::cout << "  --grid               Hedef x hız x eşik x ağ ağırlığı taraması (256 politika)" << std::endl;
+    std::cout << "  --feedback-ms MS     Alıcı raporu aralığı (varsayılan: " << Config::BITRATE_UPDATE_INTERVAL_MS << ")" << std::endl;
+    std::cout << "  --queue-ms MS        Darboğaz tamponu (varsayılan: 300)" << std::endl;
+    std::cout << "  --overhead BYTES     Paket başına başlık (varsayılan: 37)" << std::endl;
+    std::cout << "  --speech-only        Sessizlik aralıklarını kapat" << std::endl;
+    std::cout << "  --seed N             Kayıp ve konuşma deseni seed'i (varsayılan: 1)" << std::endl;
+    std::cout << "  --top N              Sıralamada gösterilecek politika (varsayılan: 20)" << std::endl;
+    std::cout << "  --csv FILE           Politika x iz sonuçlarını CSV olarak yaz" << std::endl;
+    std::cout << "  -h, --help           Bu yardım mesajını göster" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    EvalOptions options;
+    std::vector<std::string> tracePaths;
+    std::vector<std::string> syntheticNames;
+    std::vector<Policy> policies;
+    double durationS = 600.0;
+    bool grid = false;
+    size_t top = 20;
+    std::string csvPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        bool valid = true;
+        uint32_t count = 0;
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--trace" && hasValue) {
+            tracePaths.push_back(argv[++i]);
+        } else if (arg == "--synthetic" && hasValue) {
+            std::string name = argv[++i];
+            if (name == "all") {
+                syntheticNames.insert(syntheticNames.end(), std::begin(SYNTHETIC_TRACES), std::end(SYNTHETIC_TRACES));
+            } else if (std::find(std::begin(SYNTHETIC_TRACES), std::end(SYNTHETIC_TRACES), name) != std::end(SYNTHETIC_TRACES)) {
+                syntheticNames.push_back(name);
+            } else {
+                std::cerr << "Hata: Bilinmeyen sentetik iz: " << name << std::endl;
+                return 1;
+            }
+        } else if (arg == "--duration" && hasValue) {
+            valid = parseNumber(argv[++i], durationS) && durationS >= 1.0 && durationS <= MAX_DURATION_S;
+        } else if (arg == "--policy" && hasValue) {
+            Policy policy;
+            if (!parsePolicy(argv[++i], policy)) {
+                std::cerr << "Hata: Geçersiz politika: " << argv[i] << std::endl;
+                return 1;
+            }
+            policies.push_back(policy);
+        } else if (arg == "--grid") {
+            grid = true;
+        } else if (arg == "--feedback-ms" && hasValue) {
+            valid = parseNumber(argv[++i], options.feedbackMs) && options.feedbackMs >= Config::LYRA_FRAME_SIZE_MS;
+        } else if (arg == "--queue-ms" && hasValue) {
+            valid = parseNumber(argv[++i], options.queueLimitMs) && options.queueLimitMs >= 1.0 &&
+                    options.queueLimitMs <= MAX_QUEUE_MS;
+        } else if (arg == "--overhead" && hasValue) {
+            valid = parseUnsigned(argv[++i], count) && count <= Config::PACKET_SIZE;
+            options.overheadBytes = count;
+        } else if (arg == "--speech-only") {
+            options.speechOnly = true;
+        } else if (arg == "--seed" && hasValue) {
+            valid = parseUnsigned(argv[++i], options.seed);
+        } else if (arg == "--top" && hasValue) {
+            valid = parseUnsigned(argv[++i], count) && count >= 1;
+            top = count;
+        } else if (arg == "--csv" && hasValue) {
+            csvPath = argv[++i];
+        } else {
+            std::cerr << "Hata: Bilinmeyen parametre: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (!valid) {
+            std::cerr << "Hata: Geçersiz değer: " << arg << " " << argv[i] << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<Trace> traces;
+    for (const auto& path : tracePaths) {
+        Trace trace;
+        if (!loadTrace(path, trace)) {
+            return 1;
+        }
+        traces.push_back(trace);
+    }
+    if (syntheticNames.empty() && tracePaths.empty()) {
+        syntheticNames.assign(std::begin(SYNTHETIC_TRACES), std::end(SYNTHETIC_TRACES));
+    }
+    for (size_t i = 0; i < syntheticNames.size(); ++i) {
+        traces.push_back(makeSyntheticTrace(syntheticNames[i], durationS, options.seed + static_cast<uint32_t>(i)));
+    }
+
+    if (grid) {
+        auto sweep = gridPolicies();
+        policies.insert(policies.end(), sweep.begin(), sweep.end());
+    }
+    if (policies.empty()) {
+        policies = defaultPolicies();
+    }
+
+    double traceSeconds = 0.0;
+    for (const auto& trace : traces) {
+        traceSeconds += trace.durationS;
+    }
+    std::cout << "=== Bitrate Politikası Değerlendirme ===" << std::endl;
+    std::cout << policies.size() << " politika x " << traces.size() << " iz (" << traceSeconds
+              << " s), geri bildirim " << options.feedbackMs << " ms, darboğaz tamponu " << options.queueLimitMs
+              << " ms, başlık " << options.overheadBytes << " B" << std::endl;
+
+    auto wallStart = std::chrono::steady_clock::now();
+    std::vector<std::vector<RunResult>> results(policies.size(), std::vector<RunResult>(traces.size()));
+    for (size_t p = 0; p < policies.size(); ++p) {
+        for (size_t t = 0; t < traces.size(); ++t) {
+            results[p][t] = BottleneckRun(policies[p], traces[t], options).run();
+        }
+    }
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    // İz başına tablo yalnızca küçük politika kümelerinde; tarama CSV'ye yazılır
+    if (policies.size() <= 12) {
+        for (size_t t = 0; t < traces.size(); ++t) {
+            std::cout << "\n--- İz: " << traces[t].name << " (" << std::setprecision(0) << traces[t].durationS
+                      << " s) ---" << std::endl;
+            printHeader();
+            for (size_t p = 0; p < policies.size(); ++p) {
+                printRow(policies[p].name, results[p][t]);
+            }
+        }
+    }
+
+    // Genel sıralama: izler üzerinde ortalama
+    std::vector<PolicySummary> summaries;
+    for (size_t p = 0; p < policies.size(); ++p) {
+        PolicySummary summary{p, RunResult()};
+        for (const auto& r : results[p]) {
+            summary.mean.achievedKbps += r.achievedKbps / traces.size();
+            summary.mean.lossRate += r.lossRate / traces.size();
+            summary.mean.dropRate += r.dropRate / traces.size();
+            summary.mean.meanQueueMs += r.meanQueueMs / traces.size();
+            summary.mean.p95QueueMs += r.p95QueueMs / traces.size();
+            summary.mean.switchesPerMinute += r.switchesPerMinute / traces.size();
+            summary.mean.score += r.score / traces.size();
+        }
+        summaries.push_back(summary);
+    }
+    std::stable_sort(summaries.begin(), summaries.end(), [](const PolicySummary& a, const PolicySummary& b) {
+        return a.mean.score > b.mean.score;
+    });
+
+    std::cout << "\n--- Sıralama (iz ortalaması) ---" << std::endl;
+    printHeader();
+    for (size_t i = 0; i < std::min(top, summaries.size()); ++i) {
+        printRow(policies[summaries[i].index].name, summaries[i].mean);
+    }
+
+    std::cout << std::defaultfloat << std::setprecision(6) << "\nPuan = 100 x (bitrate kalitesi - " << LOSS_PENALTY
+              << " x kayıp - " << DELAY_PENALTY
+              << " x min(1, p95 kuyruk / " << DELAY_REFERENCE_MS << " ms) - " << SWITCH_PENALTY << " x geçiş/dk)"
+              << std::endl;
+    double simulated = traceSeconds * policies.size();
+    std::cout << "Simülasyon: " << std::fixed << std::setprecision(0) << simulated << " iz-saniye, " << std::setprecision(2)
+              << wallSeconds << " s duvar saati (" << std::setprecision(0)
+              << (wallSeconds > 0.0 ? simulated / wallSeconds : 0.0) << " iz-saniye/s)" << std::endl;
+
+    if (!csvPath.empty() && writeCsv(csvPath, policies, traces, results)) {
+        std::cout << "✓ Sonuçlar yazıldı: " << csvPath << std::endl;
+    }
+    return 0;
+}
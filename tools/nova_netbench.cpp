@@ -0,0 +1,640 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/utsname.h>
+
+#include "Config.h"
+#include "BufferManager.h"
+#include "UDPManager.h"
+
+using namespace NovaVoice;
+
+// Nova Voice Engine V2 - Transport Benchmark
+// Motorun UDPManager'ını loopback (veya --netns ile veth) üzerinden sürer:
+// her akış kendi istemci soketinden gönderir, tek sunucu soketi alır ve
+// paketleri motorun akış başına buffer'larına koyar. Payload başındaki
+// gönderim zamanı (CLOCK_MONOTONIC) ile tek yön gecikme ölçülür. Her
+// gönderim yolu, payload boyutu ve akış sayısı için iki faz çalışır:
+// paced (akış başına 20 ms'de bir frame) ve flood (olabildiğince hızlı).
+// Sonuçlar tabloya ve trend takibi için JSON'a yazılır.
+
+// === SİSTEM ÇAĞRISI SAYACI ===
+// Transport yolunun kullandığı libc girişleri (soket, eventfd, poll, uyku)
+// çalıştırılabilir içinde sarmalanır. Çekişmesiz mutex ve condition
+// variable futex'leri sayılmaz.
+
+namespace {
+
+std::atomic<uint64_t> g_syscalls{0};
+thread_local bool t_uncounted = false;  // Sürücünün tempo uykuları
+
+inline void countSyscall() {
+    if (!t_uncounted) {
+        g_syscalls.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+template <typename Function>
+Function resolveNext(std::atomic<Function>& cache, const char* name) {
+    Function function = cache.load(std::memory_order_relaxed);
+    if (!function) {
+        function = reinterpret_cast<Function>(dlsym(RTLD_NEXT, name));
+        cache.store(function, std::memory_order_relaxed);
+    }
+    return function;
+}
+
+std::atomic<ssize_t (*)(int, const void*, size_t, int, const struct sockaddr*, socklen_t)> g_sendto{nullptr};
+std::atomic<int (*)(int, struct mmsghdr*, unsigned int, int)> g_sendmmsg{nullptr};
+std::atomic<ssize_t (*)(int, void*, size_t, int, struct sockaddr*, socklen_t*)> g_recvfrom{nullptr};
+std::atomic<ssize_t (*)(int, void*, size_t)> g_read{nullptr};
+std::atomic<ssize_t (*)(int, const void*, size_t)> g_write{nullptr};
+std::atomic<int (*)(struct pollfd*, nfds_t, int)> g_poll{nullptr};
+std::atomic<int (*)(const struct timespec*, struct timespec*)> g_nanosleep{nullptr};
+std::atomic<int (*)(clockid_t, int, const struct timespec*, struct timespec*)> g_clockNanosleep{nullptr};
+
+} // namespace
+
+extern "C" {
+
+ssize_t sendto(int fd, const void* buffer, size_t size, int flags, const struct sockaddr* address,
+               socklen_t addressLength) {
+    countSyscall();
+    return resolveNext(g_sendto, "sendto")(fd, buffer, size, flags, address, addressLength);
+}
+
+int sendmmsg(int fd, struct mmsghdr* messages, unsigned int count, int flags) {
+    countSyscall();
+    return resolveNext(g_sendmmsg, "sendmmsg")(fd, messages, count, flags);
+}
+
+ssize_t recvfrom(int fd, void* buffer, size_t size, int flags, struct sockaddr* address,
+                 socklen_t* addressLength) {
+    countSyscall();
+    return resolveNext(g_recvfrom, "recvfrom")(fd, buffer, size, flags, address, addressLength);
+}
+
+ssize_t read(int fd, void* buffer, size_t size) {
+    countSyscall();
+    return resolveNext(g_read, "read")(fd, buffer, size);
+}
+
+ssize_t write(int fd, const void* buffer, size_t size) {
+    countSyscall();
+    return resolveNext(g_write, "write")(fd, buffer, size);
+}
+
+int poll(struct pollfd* fds, nfds_t count, int timeoutMs) {
+    countSyscall();
+    return resolveNext(g_poll, "poll")(fds, count, timeoutMs);
+}
+
+int nanosleep(const struct timespec* request, struct timespec* remaining) {
+    countSyscall();
+    return resolveNext(g_nanosleep, "nanosleep")(request, remaining);
+}
+
+int clock_nanosleep(clockid_t clock, int flags, const struct timespec* request, struct timespec* remaining) {
+    countSyscall();
+    return resolveNext(g_clockNanosleep, "clock_nanosleep")(clock, flags, request, remaining);
+}
+
+} // extern "C"
+
+namespace {
+
+// === SEÇENEKLER ===
+
+enum class SendPath {
+    SENDTO,     // sendAudioPacket: paket başına sendto
+    SENDMMSG    // BufferManager + sender thread: flushOutgoing ile batch
+};
+
+struct PayloadSpec {
+    std::string name;
+    size_t bytes;
+};
+
+struct NetbenchOptions {
+    std::vector<SendPath> paths{SendPath::SENDTO, SendPath::SENDMMSG};
+    std::vector<PayloadSpec> payloads{
+        {"lyra", Config::LYRA_DEFAULT_BITRATE * Config::LYRA_FRAME_SIZE_MS / 8000},
+        {"pcm", Config::LYRA_FRAME_SIZE * sizeof(int16_t)}};
+    std::vector<size_t> streams{1, 4, 16, 32};
+    std::vector<bool> pacedModes{true, false};
+    double seconds = 1.0;
+    std::string address = "127.0.0.1";
+    uint16_t port = Config::DEFAULT_PORT + 1;
+    std::string netns;
+    std::string jsonPath;
+};
+
+constexpr size_t TIMESTAMP_BYTES = sizeof(int64_t);
+constexpr size_t LATENCY_BINS = 100000;         // 1 µs kutular, 100 ms'ye kadar
+constexpr int64_t FRAME_NS = Config::LYRA_FRAME_SIZE_MS * 1000000LL;
+constexpr auto DRAIN_TIME = std::chrono::milliseconds(100);
+
+const char* pathName(SendPath path) {
+    return path == SendPath::SENDTO ? "udp-sendto" : "udp-sendmmsg";
+}
+
+int64_t monotonicNs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<int64_t>(now.tv_sec) * 1000000000LL + now.tv_nsec;
+}
+
+// === GECİKME KAYDI ===
+// Sunucunun receive thread'inde doldurulur, stop() sonrası okunur
+
+class LatencyRecorder {
+public:
+    LatencyRecorder() : histogram_(LATENCY_BINS + 1, 0), count_(0), maxUs_(0) {}
+
+    void record(const AudioPacket& packet) {
+        if (packet.type != PacketType::AUDIO || packet.data.size() < TIMESTAMP_BYTES) {
+            return;
+        }
+        int64_t sentNs;
+        std::memcpy(&sentNs, packet.data.data(), sizeof(sentNs));
+        int64_t latencyUs = std::max<int64_t>(0, (monotonicNs() - sentNs) / 1000);
+        histogram_[std::min<size_t>(LATENCY_BINS, static_cast<size_t>(latencyUs))]++;
+        maxUs_ = std::max(maxUs_, latencyUs);
+        count_++;
+    }
+
+    uint64_t count() const { return count_; }
+    int64_t maxUs() const { return maxUs_; }
+
+    double percentile(double fraction) const {
+        if (count_ == 0) {
+            return 0.0;
+        }
+        uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(count_ * fraction)));
+        uint64_t seen = 0;
+        for (size_t bin = 0; bin < histogram_.size(); ++bin) {
+            seen += histogram_[bin];
+            if (seen >= rank) {
+                return static_cast<double>(bin);
+            }
+        }
+        return static_cast<double>(LATENCY_BINS);
+    }
+
+private:
+    std::vector<uint64_t> histogram_;
+    uint64_t count_;
+    int64_t maxUs_;
+};
+
+// === ÖLÇÜM ===
+
+struct CaseResult {
+    SendPath path;
+    PayloadSpec payload;
+    size_t streams;
+    bool paced;
+    double seconds;
+    uint64_t offered;       // Sürücünün ürettiği
+    uint64_t sent;          // Soketten çıkan
+    uint64_t received;
+    double cpuSeconds;
+    uint64_t syscalls;
+    uint64_t contextSwitches;
+    double p50, p90, p99, p999;
+    int64_t maxUs;
+
+    double pps() const { return seconds > 0.0 ? received / seconds : 0.0; }
+    double ppsPerCore() const { return cpuSeconds > 0.0 ? received / cpuSeconds : 0.0; }
+    double perPacket(double value) const { return received > 0 ? value / received : 0.0; }
+    double lossPercent() const { return sent > 0 ? 100.0 * (sent - std::min(sent, received)) / sent : 0.0; }
+    double queueDropPercent() const { return offered > 0 ? 100.0 * (offered - std::min(offered, sent)) / offered : 0.0; }
+};
+
+struct UsageSnapshot {
+    double cpuSeconds;
+    uint64_t contextSwitches;
+    uint64_t syscalls;
+
+    static UsageSnapshot take() {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        UsageSnapshot snapshot;
+        snapshot.cpuSeconds = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 +
+                              usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+        snapshot.contextSwitches = static_cast<uint64_t>(usage.ru_nvcsw + usage.ru_nivcsw);
+        snapshot.syscalls = g_syscalls.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+};
+
+void uncountedSleepUntil(std::chrono::steady_clock::time_point deadline) {
+    t_uncounted = true;
+    std::this_thread::sleep_until(deadline);
+    t_uncounted = false;
+}
+
+// Sunucu soketi --netns verilmişse o ağ ad alanında açılır (veth karşı ucu)
+bool startReceiver(UDPManager& receiver, const NetbenchOptions& options) {
+    if (options.netns.empty()) {
+        return receiver.startServer(options.port);
+    }
+
+    bool started = false;
+    std::thread worker([&] {
+        std::string path = "/var/run/netns/" + options.netns;
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            std::cerr << "Hata: Ağ ad alanı açılamadı: " << path << ": " << strerror(errno) << std::endl;
+            return;
+        }
+        // setns yalnızca bu thread'i taşır; soket oluşturulduğu ad alanında kalır
+        if (setns(fd, CLONE_NEWNET) != 0) {
+            std::cerr << "Hata: setns başarısız (root gerekir): " << strerror(errno) << std::endl;
+            close(fd);
+            return;
+        }
+        close(fd);
+        started = receiver.startServer(options.port);
+    });
+    worker.join();
+    return started;
+}
+
+bool runCase(const NetbenchOptions& options, SendPath path, const PayloadSpec& payload, size_t streamCount,
+             bool paced, CaseResult& result) {
+    // Alıcı: çoklu akış modunda motorun akış başına buffer'ları
+    auto receiveBuffers = std::make_shared<BufferManager>();
+    receiveBuffers->setPlaybackStream(0);
+    auto recorder = std::make_shared<LatencyRecorder>();
+
+    UDPManager receiver;
+    receiver.setLogging(false);
+    receiver.setBufferManager(receiveBuffers);
+    receiver.setOnPacketReceived([recorder](std::shared_ptr<AudioPacket> packet) {
+        recorder->record(*packet);
+    });
+    if (!startReceiver(receiver, options)) {
+        return false;
+    }
+
+    std::vector<std::unique_ptr<UDPManager>> senders;
+    std::vector<std::shared_ptr<BufferManager>> sendBuffers;
+    for (size_t i = 0; i < streamCount; ++i) {
+        auto sender = std::make_unique<UDPManager>();
+        sender->setLogging(false);
+        sender->setLocalStreamId(static_cast<uint32_t>(i + 1));
+        if (path == SendPath::SENDMMSG) {
+            sendBuffers.push_back(std::make_shared<BufferManager>());
+            sender->setBufferManager(sendBuffers.back());
+        }
+        if (!sender->startClient(options.address, options.port)) {
+            receiver.stop();
+            return false;
+        }
+        senders.push_back(std::move(sender));
+    }
+
+    std::vector<uint8_t> frame(payload.bytes, 0);
+    std::vector<uint32_t> sequences(streamCount, 0);
+    uint64_t offered = 0;
+
+    UsageSnapshot before = UsageSnapshot::take();
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                std::chrono::duration<double>(options.seconds));
+    // Paced: akışlar 20 ms'lik periyoda eşit aralıkla yayılır
+    auto interval = std::chrono::nanoseconds(FRAME_NS / static_cast<int64_t>(streamCount));
+
+    for (uint64_t tick = 0;; ++tick) {
+        if (paced) {
+            auto sendTime = start + interval * tick;
+            if (sendTime >= deadline) {
+                break;
+            }
+            uncountedSleepUntil(sendTime);
+        } else if ((tick & 63) == 0 && std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+
+        size_t stream = tick % streamCount;
+        int64_t nowNs = monotonicNs();
+        std::memcpy(frame.data(), &nowNs, sizeof(nowNs));
+        auto packet = std::make_shared<AudioPacket>(frame.data(), frame.size(), sequences[stream]++);
+
+        if (path == SendPath::SENDTO) {
+            senders[stream]->sendAudioPacket(packet);
+        } else {
+            sendBuffers[stream]->pushAudioPacket(packet);
+        }
+        offered++;
+    }
+
+    double sendSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uncountedSleepUntil(std::chrono::steady_clock::now() + DRAIN_TIME);
+    UsageSnapshot after = UsageSnapshot::take();
+
+    for (auto& sender : senders) {
+        sender->stop();
+    }
+    receiver.stop();
+
+    result.path = path;
+    result.payload = payload;
+    result.streams = streamCount;
+    result.paced = paced;
+    result.seconds = sendSeconds;
+    result.offered = offered;
+    result.sent = 0;
+    for (const auto& sender : senders) {
+        result.sent += sender->getSentPackets();
+    }
+    result.received = recorder->count();
+    result.cpuSeconds = after.cpuSeconds - before.cpuSeconds;
+    result.syscalls = after.syscalls - before.syscalls;
+    result.contextSwitches = after.contextSwitches - before.contextSwitches;
+    result.p50 = recorder->percentile(0.50);
+    result.p90 = recorder->percentile(0.90);
+    result.p99 = recorder->percentile(0.99);
+    result.p999 = recorder->percentile(0.999);
+    result.maxUs = recorder->maxUs();
+    return true;
+}
+
+// === ÇIKTI ===
+
+// setw bayt sayar: UTF-8 devam baytları kadar genişlik eklenir
+int displayWidth(const std::string& text, int width) {
+    for (unsigned char c : text) {
+        if ((c & 0xC0) == 0x80) {
+            width++;
+        }
+    }
+    return width;
+}
+
+void printHeader() {
+    const char* columns[] = {"akış", "faz", "pps", "pps/çekirdek", "çağrı/p", "cs/p",
+                             "kayıp%", "p50 µs", "p99 µs", "p99.9 µs"};
+    const int widths[] = {6, 8, 10, 14, 9, 7, 8, 8, 8, 10};
+
+    std::cout << std::left << std::setw(14) << "yol" << std::setw(displayWidth("yük", 5)) << "yük" << std::right;
+    for (size_t i = 0; i < sizeof(widths) / sizeof(widths[0]); ++i) {
+        std::cout << std::setw(displayWidth(columns[i], widths[i])) << columns[i];
+    }
+    std::cout << std::endl;
+}
+
+void printResult(const CaseResult& result) {
+    std::cout << std::left << std::setw(14) << pathName(result.path) << std::setw(5) << result.payload.name
+              << std::right << std::setw(6) << result.streams << std::setw(8) << (result.paced ? "paced" : "flood")
+              << std::fixed << std::setprecision(0) << std::setw(10) << result.pps()
+              << std::setw(14) << result.ppsPerCore() << std::setprecision(2)
+              << std::setw(9) << result.perPacket(result.syscalls)
+              << std::setw(7) << result.perPacket(result.contextSwitches) << std::setw(8) << result.lossPercent()
+              << std::setprecision(0) << std::setw(8) << result.p50 << std::setw(8) << result.p99
+              << std::setw(10) << result.p999 << std::endl;
+}
+
+std::string jsonString(const std::string& text) {
+    std::string escaped = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped + "\"";
+}
+
+void writeJson(std::ostream& out, const NetbenchOptions& options, const std::vector<CaseResult>& results) {
+    struct utsname host;
+    uname(&host);
+
+    out << std::fixed << "{\n"
+        << "  \"tool\": \"nova_netbench\",\n"
+        << "  \"schema\": 1,\n"
+        << "  \"timestamp\": " << static_cast<long long>(std::time(nullptr)) << ",\n"
+        << "  \"host\": {\"kernel\": " << jsonString(host.release) << ", \"machine\": " << jsonString(host.machine)
+        << ", \"cpus\": " << sysconf(_SC_NPROCESSORS_ONLN) << "},\n"
+        << "  \"link\": " << jsonString(options.netns.empty() ? "loopback" : "netns:" + options.netns) << ",\n"
+        << "  \"address\": " << jsonString(options.address) << ",\n"
+        << "  \"seconds_per_case\": " << std::setprecision(3) << options.seconds << ",\n"
+        << "  \"results\": [";
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const CaseResult& r = results[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {"
+            << "\"transport\": " << jsonString(pathName(r.path))
+            << ", \"payload\": " << jsonString(r.payload.name)
+            << ", \"payload_bytes\": " << r.payload.bytes
+            << ", \"wire_bytes\": " << r.payload.bytes + PacketWire::HEADER_SIZE
+            << ", \"streams\": " << r.streams
+            << ", \"mode\": " << jsonString(r.paced ? "paced" : "flood")
+            << ", \"duration_s\": " << std::setprecision(3) << r.seconds
+            << ", \"offered\": " << r.offered << ", \"sent\": " << r.sent << ", \"received\": " << r.received
+            << ", \"queue_drop_pct\": " << r.queueDropPercent()
+            << ", \"loss_pct\": " << r.lossPercent()
+            << ", \"pps\": " << std::setprecision(1) << r.pps()
+            << ", \"pps_per_core\": " << r.ppsPerCore()
+            << ", \"cpu_us_per_packet\": " << std::setprecision(3) << r.perPacket(r.cpuSeconds * 1e6)
+            << ", \"syscalls_per_packet\": " << r.perPacket(r.syscalls)
+            << ", \"context_switches_per_packet\": " << r.perPacket(r.contextSwitches)
+            << ", \"latency_us\": {\"p50\": " << std::setprecision(0) << r.p50 << ", \"p90\": " << r.p90
+            << ", \"p99\": " << r.p99 << ", \"p999\": " << r.p999 << ", \"max\": " << r.maxUs << "}}";
+    }
+    out << "\n  ]\n}" << std::endl;
+}
+
+// === PARAMETRELER ===
+
+bool parseStreams(const std::string& text, std::vector<size_t>& streams) {
+    streams.clear();
+    std::stringstream list(text);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        int count = std::atoi(item.c_str());
+        if (count < 1 || static_cast<size_t>(count) > Config::MAX_STREAMS) {
+            return false;
+        }
+        streams.push_back(static_cast<size_t>(count));
+    }
+    return !streams.empty();
+}
+
+bool parsePaths(const std::string& text, std::vector<SendPath>& paths) {
+    paths.clear();
+    std::stringstream list(text);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        if (item == "sendto") {
+            paths.push_back(SendPath::SENDTO);
+        } else if (item == "sendmmsg") {
+            paths.push_back(SendPath::SENDMMSG);
+        } else {
+            return false;
+        }
+    }
+    return !paths.empty();
+}
+
+bool parseModes(const std::string& text, std::vector<bool>& pacedModes) {
+    pacedModes.clear();
+    std::stringstream list(text);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        if (item == "paced") {
+            pacedModes.push_back(true);
+        } else if (item == "flood") {
+            pacedModes.push_back(false);
+        } else {
+            return false;
+        }
+    }
+    return !pacedModes.empty();
+}
+
+void printUsage(const char* programName) {
+    std::cout << "Nova Voice Engine V2 - Transport Benchmark" << std::endl;
+    std::cout << "Kullanım: " << programName << " [SEÇENEKLER]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  --transports LIST    sendto,sendmmsg (varsayılan: ikisi)" << std::endl;
+    std::cout << "  --streams LIST       Akış sayıları, en fazla " << Config::MAX_STREAMS
+              << " (varsayılan: 1,4,16,32)" << std::endl;
+    std::cout << "  --modes LIST         paced,flood (varsayılan: ikisi)" << std::endl;
+    std::cout << "  --lyra-bytes N       Lyra payload boyutu (varsayılan: 15, 6 kbps x 20 ms)" << std::endl;
+    std::cout << "  --pcm-bytes N        PCM payload boyutu (varsayılan: 640, 16 kHz x 20 ms)" << std::endl;
+    std::cout << "  --seconds S          Durum başına ölçüm süresi (varsayılan: 1)" << std::endl;
+    std::cout << "  --address IP         Sunucu adresi (varsayılan: 127.0.0.1)" << std::endl;
+    std::cout << "  --port PORT          Sunucu portu (varsayılan: " << Config::DEFAULT_PORT + 1 << ")" << std::endl;
+    std::cout << "  --netns NAME         Sunucu soketini bu ağ ad alanında aç (veth, root gerekir)" << std::endl;
+    std::cout << "  --json FILE          Sonuçları JSON olarak yaz ('-' = stdout, tablo yazılmaz)" << std::endl;
+    std::cout << "  -h, --help           Bu yardım mesajını göster" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    NetbenchOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--transports" && hasValue) {
+            if (!parsePaths(argv[++i], options.paths)) {
+                std::cerr << "Hata: Geçersiz gönderim yolu listesi" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--streams" && hasValue) {
+            if (!parseStreams(argv[++i], options.streams)) {
+                std::cerr << "Hata: Akış sayıları 1-" << Config::MAX_STREAMS << " arasında olmalı" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--modes" && hasValue) {
+            if (!parseModes(argv[++i], options.pacedModes)) {
+                std::cerr << "Hata: Geçersiz faz listesi" << std::endl;
+                return 1;
+            }
+        } else if ((arg == "--lyra-bytes" || arg == "--pcm-bytes") && hasValue) {
+            int bytes = std::atoi(argv[++i]);
+            if (bytes < static_cast<int>(TIMESTAMP_BYTES) ||
+                static_cast<size_t>(bytes) + PacketWire::HEADER_SIZE > Config::PACKET_SIZE * 2) {
+                std::cerr << "Hata: Payload " << TIMESTAMP_BYTES << "-"
+                          << Config::PACKET_SIZE * 2 - PacketWire::HEADER_SIZE << " bayt olmalı" << std::endl;
+                return 1;
+            }
+            options.payloads[arg == "--lyra-bytes" ? 0 : 1].bytes = static_cast<size_t>(bytes);
+        } else if (arg == "--seconds" && hasValue) {
+            options.seconds = std::atof(argv[++i]);
+            if (options.seconds <= 0.0) {
+                std::cerr << "Hata: Süre pozitif olmalı" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--address" && hasValue) {
+            options.address = argv[++i];
+        } else if (arg == "--port" && hasValue) {
+            int port = std::atoi(argv[++i]);
+            if (port < 1 || port > 65535) {
+                std::cerr << "Hata: Geçersiz port" << std::endl;
+                return 1;
+            }
+            options.port = static_cast<uint16_t>(port);
+        } else if (arg == "--netns" && hasValue) {
+            options.netns = argv[++i];
+        } else if (arg == "--json" && hasValue) {
+            options.jsonPath = argv[++i];
+        } else {
+            std::cerr << "Hata: Bilinmeyen parametre: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    bool table = options.jsonPath != "-";
+    if (table) {
+        std::cout << "=== Transport Benchmark ===" << std::endl;
+        std::cout << (options.netns.empty() ? "loopback" : "netns " + options.netns) << " -> " << options.address
+                  << ":" << options.port << ", durum başına " << options.seconds << " s, "
+                  << sysconf(_SC_NPROCESSORS_ONLN) << " CPU" << std::endl;
+        std::cout << "(çağrı/p: uçtan uca paket başına soket/eventfd/poll/uyku çağrısı; cs/p: bağlam geçişi)"
+                  << std::endl << std::endl;
+        printHeader();
+    }
+
+    std::vector<CaseResult> results;
+    for (SendPath path : options.paths) {
+        for (const PayloadSpec& payload : options.payloads) {
+            for (size_t streams : options.streams) {
+                for (bool paced : options.pacedModes) {
+                    CaseResult result;
+                    if (!runCase(options, path, payload, streams, paced, result)) {
+                        std::cerr << "Hata: " << pathName(path) << " " << payload.name << " x" << streams
+                                  << " çalıştırılamadı" << std::endl;
+                        return 1;
+                    }
+                    results.push_back(result);
+                    if (table) {
+                        printResult(result);
+                    }
+                }
+            }
+        }
+    }
+
+    if (options.jsonPath == "-") {
+        writeJson(std::cout, options, results);
+    } else if (!options.jsonPath.empty()) {
+        std::ofstream json(options.jsonPath);
+        if (!json) {
+            std::cerr << "Hata: JSON dosyası açılamadı: " << options.jsonPath << std::endl;
+            return 1;
+        }
+        writeJson(json, options, results);
+        std::cout << std::endl << "✓ Sonuçlar yazıldı: " << options.jsonPath << std::endl;
+    }
+
+    return 0;
+}
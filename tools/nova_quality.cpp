@@ -0,0 +1,649 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <random>
+#include <cmath>
+#include <ctime>
+#include <algorithm>
+#include <sstream>
+#include <cstdint>
+
+#include "Config.h"
+#include "LyraCodec.h"
+#include "AudioPreprocessor.h"
+#include "BitrateCalculator.h"
+#include "WavFile.h"
+#include "NetworkImpairment.h"
+#include "QualityMetrics.h"
+#include "LatencyProfile.h"
+
+using namespace NovaVoice;
+
+// Nova Voice Engine V2 - Çevrimdışı Konuşma Kalitesi Aracı
+// Referans konuşmayı motorun gönderici zincirinden (AudioPreprocessor:
+// gürültü engelleme + codec, BitrateCalculator uyarlaması), ağ bozulması
+// ve PLC yolundan geçirir; çıktıyı nesnel ölçütlerle puanlar.
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+// Feedback aralığı: alıcı raporu saniyede bir (RTCP benzeri)
+constexpr size_t FEEDBACK_FRAMES = 1000 / Config::LYRA_FRAME_SIZE_MS;
+
+// Taramaların temel yapılandırmada kapalıysa kullandığı koşullar
+constexpr double DEFAULT_NOISE_SNR_DB = 20.0;
+constexpr double DEFAULT_ADAPT_LOSS_PERCENT = 5.0;
+
+// Gönderici zinciri ayarları
+struct PipelineSettings {
+    uint32_t bitrate = Config::LYRA_DEFAULT_BITRATE;
+    float denoiseLevel = -1.0f;     // < 0: gürültü engelleme kapalı
+    float adaptThreshold = -1.0f;   // < 0: sabit bitrate; aksi halde kararlılık eşiği
+    double noiseSnrDb = 0.0;        // > 0: girişe bu SNR'de beyaz gürültü eklenir
+    std::string modelPath;          // Boş: gömülü RNNoise modeli
+};
+
+struct PipelineResult {
+    std::vector<int16_t> output;    // Gürültü engelleme gecikmesi çıkarılmış
+    double cpuMsPerSecond;
+    double payloadKbps;
+    double lossRate;
+    double averageBitrateKbps;
+    uint64_t bitrateChanges;
+};
+
+struct Row {
+    std::string sweep;
+    PipelineSettings settings;
+    ImpairmentConfig impairment;
+    PipelineResult result;
+    QualityScore score;
+};
+
+double threadCpuMs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// Sentetik konuşma benzeri referans: hece zarflı, formant şekilli harmonikler,
+// sürtünmeli ünsüz patlamaları ve kelime araları
+std::vector<int16_t> synthesizeSpeech(double seconds, uint32_t sampleRate) {
+    std::mt19937 rng(3);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    size_t count = static_cast<size_t>(seconds * sampleRate);
+    std::vector<int16_t> samples(count, 0);
+
+    const double formants[3][3] = {{700.0, 1200.0, 2600.0}, {300.0, 2300.0, 3000.0}, {500.0, 900.0, 2400.0}};
+    double phase = 0.0;
+    double highpass = 0.0;
+
+    for (size_t i = 0; i < count; ++i) {
+        double t = static_cast<double>(i) / sampleRate;
+        double word = std::fmod(t, 1.2);
+        if (word > 0.9) {
+            continue; // Kelime arası
+        }
+
+        double syllable = std::pow(std::sin(PI * std::fmod(word * 4.0, 1.0)), 2.0);
+        const double* formant = formants[static_cast<size_t>(t * 4.0) % 3];
+        double f0 = 120.0 + 40.0 * std::sin(2.0 * PI * 0.7 * t);
+        phase += 2.0 * PI * f0 / sampleRate;
+
+        double voiced = 0.0;
+        for (int h = 1; f0 * h < sampleRate / 2.0 - 200.0; ++h) {
+            double hz = f0 * h;
+            double envelope = 0.0;
+            for (int f = 0; f < 3; ++f) {
+                double distance = (hz - formant[f]) / (80.0 + 40.0 * f);
+                envelope += std::exp(-0.5 * distance * distance) / (1.0 + f);
+            }
+            voiced += envelope * std::sin(h * phase) / std::sqrt(static_cast<double>(h));
+        }
+
+        // Her hecenin sonunda kısa sürtünmeli ses
+        double white = noise(rng);
+        highpass = white - 0.7 * highpass;
+        double fricative = std::fmod(word * 4.0, 1.0) > 0.85 ? 0.3 * highpass : 0.0;
+
+        double value = 0.25 * (syllable * voiced + fricative);
+        samples[i] = static_cast<int16_t>(std::max(-1.0, std::min(1.0, value)) * 32767.0);
+    }
+
+    return samples;
+}
+
+// AudioPlayer::concealGap ile aynı şema: son frame'i tekrarla, sıfıra sönümle
+void concealFrame(const std::vector<int16_t>& history, size_t run, size_t concealFrames, int16_t* output,
+                  size_t count) {
+    if (run >= concealFrames || history.empty()) {
+        std::fill(output, output + count, static_cast<int16_t>(0));
+        return;
+    }
+
+    float startGain = 1.0f - static_cast<float>(run) / concealFrames;
+    float endGain = 1.0f - static_cast<float>(run + 1) / concealFrames;
+    for (size_t i = 0; i < count; ++i) {
+        float gain = startGain + (endGain - startGain) * static_cast<float>(i) / static_cast<float>(count);
+        output[i] = static_cast<int16_t>(history[i % history.size()] * gain);
+    }
+}
+
+// Referansa deterministik beyaz gürültü ekler (SNR tüm sinyal gücüne göre)
+std::vector<int16_t> addNoise(const std::vector<int16_t>& reference, double snrDb) {
+    if (snrDb <= 0.0 || reference.empty()) {
+        return reference;
+    }
+
+    double power = 0.0;
+    for (int16_t sample : reference) {
+        power += static_cast<double>(sample) * sample;
+    }
+    power /= reference.size();
+    double sigma = std::sqrt(power / std::pow(10.0, snrDb / 10.0));
+
+    std::mt19937 rng(7);
+    std::normal_distribution<double> noise(0.0, sigma);
+    std::vector<int16_t> noisy(reference.size());
+    for (size_t i = 0; i < reference.size(); ++i) {
+        double value = reference[i] + noise(rng);
+        noisy[i] = static_cast<int16_t>(std::max(-32768.0, std::min(32767.0, value)));
+    }
+    return noisy;
+}
+
+// Referans 16 kHz'de; gönderici motor hızında (48 kHz, 20 ms) AudioPreprocessor::encode
+// ile kodlar, alıcı ayrı bir codec ile çözer. Uyarlama açıkken alıcı raporu
+// saniyede bir göndericinin BitrateCalculator'ına geri beslenir.
+PipelineResult runPipeline(const std::vector<int16_t>& reference, const PipelineSettings& settings,
+                           const ImpairmentConfig& impairment,
+                           size_t concealFrames = Config::PLAYBACK_CONCEAL_PERIODS) {
+    PipelineResult result{std::vector<int16_t>(reference.size(), 0), 0.0, 0.0, 0.0, 0.0, 0};
+
+    // Yakalama tarafı: (gürültülü) referans motor hızına çıkarılır
+    LyraCodec converter;
+    std::vector<int16_t> noisy = addNoise(reference, settings.noiseSnrDb);
+    std::vector<int16_t> capture = converter.resampleFromLyra(noisy.data(), noisy.size(), Config::SAMPLE_RATE);
+
+    PreprocessingConfig config;
+    config.enableAGC = false;   // Seviye değişimi ölçütleri bozar
+    config.enableVAD = false;   // Kapılama PLC'den bağımsız ölçülsün
+    config.enableCodec = true;
+    config.enableNoiseSupression = settings.denoiseLevel >= 0.0f;
+    config.noiseSuppressionLevel = std::max(0.0f, settings.denoiseLevel);
+    config.noiseModelPath = settings.modelPath;
+    config.enableBitrateAdaptation = settings.adaptThreshold >= 0.0f;
+    config.targetBitrate = settings.bitrate;
+
+    AudioPreprocessor sender;
+    LyraCodec receiver;
+    if (!sender.initialize(config) || !receiver.initialize(Config::LYRA_SAMPLE_RATE, 1, settings.bitrate)) {
+        return result;
+    }
+    std::shared_ptr<BitrateCalculator> calculator = sender.getBitrateCalculator();
+    if (config.enableBitrateAdaptation && calculator) {
+        calculator->setLogging(false);
+        calculator->setStabilityThreshold(settings.adaptThreshold);
+    }
+
+    NetworkImpairment network(impairment);
+    const size_t frameSize = Config::LYRA_FRAME_SIZE;
+    const size_t captureFrameSize = Config::SAMPLE_RATE * Config::LYRA_FRAME_SIZE_MS / 1000;
+    size_t frames = std::min(reference.size() / frameSize, capture.size() / captureFrameSize);
+
+    std::vector<int16_t> history;
+    size_t concealRun = 0;
+    uint64_t payloadBytes = 0;
+    double bitrateSum = 0.0;
+
+    // Alıcı raporu penceresi
+    size_t windowSent = 0;
+    size_t windowLost = 0;
+    size_t windowDelivered = 0;
+    double windowDelayMs = 0.0;
+    double windowEnergy = 0.0;
+    double jitterMs = 0.0;
+    bool hasPreviousDelay = false;
+    double previousDelayMs = 0.0;
+
+    double cpuStart = threadCpuMs();
+    for (size_t f = 0; f < frames; ++f) {
+        const int16_t* input = capture.data() + f * captureFrameSize;
+        int16_t* output = result.output.data() + f * frameSize;
+
+        for (size_t i = 0; i < captureFrameSize; ++i) {
+            double sample = input[i] / 32768.0;
+            windowEnergy += sample * sample;
+        }
+
+        bitrateSum += sender.getCurrentBitrate();
+        auto packet = sender.encode(input, captureFrameSize);
+        if (!packet) {
+            continue;
+        }
+        payloadBytes += packet->data.size();
+
+        NetworkImpairment::Outcome outcome = network.next();
+        windowSent++;
+        std::optional<std::vector<int16_t>> decoded;
+        if (outcome.delivered) {
+            decoded = receiver.decode(*packet);
+            windowDelivered++;
+            windowDelayMs += outcome.delayMs;
+            if (hasPreviousDelay) {
+                jitterMs += (std::fabs(outcome.delayMs - previousDelayMs) - jitterMs) / 16.0;
+            }
+            hasPreviousDelay = true;
+            previousDelayMs = outcome.delayMs;
+        } else {
+            windowLost++;
+        }
+
+        if (decoded && decoded->size() >= frameSize) {
+            std::copy(decoded->begin(), decoded->begin() + frameSize, output);
+            history.assign(decoded->begin(), decoded->begin() + frameSize);
+            concealRun = 0;
+        } else {
+            concealFrame(history, concealRun, concealFrames, output, frameSize);
+            concealRun++;
+        }
+
+        if (config.enableBitrateAdaptation && calculator && (f + 1) % FEEDBACK_FRAMES == 0) {
+            AudioMetrics audio;
+            audio.averageVolume = static_cast<float>(std::sqrt(windowEnergy / (FEEDBACK_FRAMES * captureFrameSize)));
+            audio.speechDetected = audio.averageVolume > 0.01f;   // -40 dBFS
+            audio.signalToNoiseRatio = static_cast<float>(settings.noiseSnrDb > 0.0 ? settings.noiseSnrDb : 40.0);
+            calculator->updateAudioMetrics(audio);
+
+            NetworkMetrics metrics;
+            metrics.packetLossRate = windowSent > 0 ? static_cast<float>(windowLost) / windowSent : 0.0f;
+            metrics.averageLatency = windowDelivered > 0
+                ? static_cast<uint32_t>(windowDelayMs / windowDelivered) : 0;
+            metrics.jitter = static_cast<uint32_t>(jitterMs);
+            sender.updateNetworkMetrics(metrics);
+
+            windowSent = windowLost = windowDelivered = 0;
+            windowDelayMs = 0.0;
+            windowEnergy = 0.0;
+        }
+    }
+    double cpuMs = threadCpuMs() - cpuStart;
+
+    // Gürültü engelleme gecikmesi (48 kHz örnek) codec hızına çevrilip çıkarılır
+    std::shared_ptr<NoiseSuppresor> suppressor = sender.getNoiseSuppresor();
+    size_t delay = (config.enableNoiseSupression && suppressor)
+        ? suppressor->getDelaySamples() * Config::LYRA_SAMPLE_RATE / Config::SAMPLE_RATE : 0;
+    result.output.erase(result.output.begin(), result.output.begin() + std::min(delay, result.output.size()));
+
+    double audioSeconds = static_cast<double>(frames * frameSize) / Config::LYRA_SAMPLE_RATE;
+    result.cpuMsPerSecond = audioSeconds > 0.0 ? cpuMs / audioSeconds : 0.0;
+    result.payloadKbps = audioSeconds > 0.0 ? payloadBytes * 8.0 / 1000.0 / audioSeconds : 0.0;
+    result.lossRate = network.getEffectiveLossRate();
+    result.averageBitrateKbps = frames > 0 ? bitrateSum / frames / 1000.0 : 0.0;
+    result.bitrateChanges = calculator ? calculator->getBitrateChanges() : 0;
+    return result;
+}
+
+// Gecikmesi çıkarılmış çıktı, referansın aynı uzunluktaki başıyla karşılaştırılır
+QualityScore scoreResult(const std::vector<int16_t>& reference, const PipelineResult& result) {
+    return QualityMetrics::evaluate(reference.data(), result.output.data(),
+                                    std::min(reference.size(), result.output.size()), Config::LYRA_SAMPLE_RATE);
+}
+
+// PlayoutController ile aynı tahmin: RFC 3550 varışlar arası sapma.
+// Paketler periyodik gönderildiği için sapma ardışık gecikme farkıdır.
+double estimateJitterMs(ImpairmentConfig impairment, size_t packets) {
+    impairment.playoutDelayMs = 1e9;
+    NetworkImpairment network(impairment);
+
+    double jitter = 0.0;
+    double sum = 0.0;
+    size_t samples = 0;
+    bool hasPrevious = false;
+    double previousDelay = 0.0;
+    for (size_t i = 0; i < packets; ++i) {
+        NetworkImpairment::Outcome outcome = network.next();
+        if (!outcome.delivered) {
+            continue;
+        }
+        if (hasPrevious) {
+            jitter += (std::fabs(outcome.delayMs - previousDelay) - jitter) / 16.0;
+            sum += jitter;
+            samples++;
+        }
+        hasPrevious = true;
+        previousDelay = outcome.delayMs;
+    }
+
+    return samples > 0 ? sum / samples : 0.0;
+}
+
+// Her profil her profilin tasarım ağında çalıştırılır; geçme koşulu yalnızca
+// kendi ağında: bütçe ≤ hedef ve kayıp + geç kalan ≤ üst sınır. Simülasyon
+// codec frame'i (20 ms) ile paketler; periyot bütçede ayrıca hesaplanır.
+bool validateProfiles(const std::vector<int16_t>& reference, uint32_t bitrate, const std::string& selected,
+                      uint32_t seed) {
+    std::cout << "\n=== Gecikme Profilleri (" << reference.size() / Config::LYRA_SAMPLE_RATE
+              << " s referans) ===" << std::endl;
+    std::cout << std::left << std::setw(13) << "profil" << std::setw(13) << "ağ" << std::right
+              << std::setw(8) << "hedef" << std::setw(8) << "bütçe" << std::setw(8) << "pay"
+              << std::setw(9) << "kayıp%" << std::setw(7) << "MOS" << "  sonuç" << std::endl;
+
+    bool allPassed = true;
+    bool found = false;
+    for (const auto& profile : LatencyProfile::all()) {
+        if (selected != "all" && selected != profile.name) {
+            continue;
+        }
+        found = true;
+
+        for (const auto& condition : LatencyProfile::all()) {
+            const NetworkConditions& network = condition.designNetwork;
+            ImpairmentConfig impairment;
+            impairment.lossRate = network.lossRate;
+            impairment.meanBurstLength = network.meanBurstLength;
+            impairment.jitterMs = network.jitterMs;
+            impairment.seed = seed;
+
+            NetworkConditions measured = network;
+            measured.jitterMs = estimateJitterMs(impairment, reference.size() / Config::LYRA_FRAME_SIZE);
+            LatencyBudget budget = profile.estimateBudget(measured);
+            impairment.playoutDelayMs = budget.playoutMs;
+
+            size_t concealFrames = std::max<size_t>(
+                1, static_cast<size_t>(std::lround(profile.concealPeriods * profile.periodMs() / Config::LYRA_FRAME_SIZE_MS)));
+            PipelineSettings settings;
+            settings.bitrate = bitrate;
+            PipelineResult result = runPipeline(reference, settings, impairment, concealFrames);
+            QualityScore score = scoreResult(reference, result);
+
+            bool own = condition.id == profile.id;
+            bool passed = budget.totalMs <= profile.targetMouthToEarMs && result.lossRate <= profile.maxResidualLossRate;
+            if (own && !passed) {
+                allPassed = false;
+            }
+
+            std::cout << std::left << std::setw(13) << profile.name << std::setw(13) << condition.name
+                      << std::right << std::fixed
+                      << std::setw(8) << std::setprecision(0) << profile.targetMouthToEarMs
+                      << std::setw(8) << std::setprecision(1) << budget.totalMs
+                      << std::setw(8) << std::setprecision(1) << budget.playoutMs
+                      << std::setw(9) << std::setprecision(1) << result.lossRate * 100.0
+                      << std::setw(7) << std::setprecision(2) << score.mos << "  "
+                      << (own ? (passed ? "KARŞILANDI" : "KARŞILANMADI") : (passed ? "(karşılar)" : "(karşılamaz)"))
+                      << std::endl;
+        }
+    }
+
+    if (!found) {
+        std::cerr << "Hata: Bilinmeyen profil: " << selected << std::endl;
+        return false;
+    }
+
+    return allPassed;
+}
+
+// Kapalı ayarlar "-" olarak basılır
+std::string formatSetting(double value, bool enabled, int precision) {
+    if (!enabled) {
+        return "-";
+    }
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(precision) << value;
+    return stream.str();
+}
+
+void printRow(const Row& row) {
+    const PipelineSettings& settings = row.settings;
+    std::cout << std::left << std::setw(9) << row.sweep << std::right << std::fixed
+              << std::setw(8) << std::setprecision(1) << row.result.averageBitrateKbps
+              << std::setw(10) << std::setprecision(1) << row.result.payloadKbps
+              << std::setw(8) << std::setprecision(1) << row.result.lossRate * 100.0
+              << std::setw(8) << formatSetting(settings.noiseSnrDb, settings.noiseSnrDb > 0.0, 0)
+              << std::setw(9) << formatSetting(settings.denoiseLevel, settings.denoiseLevel >= 0.0f, 2)
+              << std::setw(7) << formatSetting(settings.adaptThreshold, settings.adaptThreshold >= 0.0f, 2)
+              << std::setw(9) << row.result.bitrateChanges
+              << std::setw(10) << std::setprecision(2) << row.result.cpuMsPerSecond
+              << std::setw(9) << std::setprecision(2) << row.score.segmentalSnrDb
+              << std::setw(8) << std::setprecision(2) << row.score.logSpectralDistanceDb
+              << std::setw(7) << std::setprecision(2) << row.score.mos << std::endl;
+}
+
+// Sayısal parametre: tamamı sayı olmalı (std::stod/stoul istisnası yakalanır)
+bool parseNumber(const std::string& text, double& value) {
+    try {
+        size_t consumed = 0;
+        value = std::stod(text, &consumed);
+        return consumed == text.size() && std::isfinite(value);
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool parseUnsigned(const std::string& text, uint32_t& value) {
+    try {
+        size_t consumed = 0;
+        unsigned long parsed = std::stoul(text, &consumed);
+        if (consumed != text.size() || text[0] == '-' || parsed > UINT32_MAX) {
+            return false;
+        }
+        value = static_cast<uint32_t>(parsed);
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+void printUsage(const char* programName) {
+    std::cout << "Nova Voice Engine V2 - Konuşma Kalitesi Aracı" << std::endl;
+    std::cout << "Kullanım: " << programName << " [SEÇENEKLER]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  --input FILE.wav     Referans konuşma (16-bit PCM; yoksa sentetik referans)" << std::endl;
+    std::cout << "  --output FILE.wav    Temel yapılandırmanın bozulmuş çıktısını yaz" << std::endl;
+    std::cout << "  --csv FILE           Sonuçları CSV olarak yaz" << std::endl;
+    std::cout << "  --sweep NAME         bitrate, loss, denoise, adapt veya all (varsayılan: all)" << std::endl;
+    std::cout << "  --bitrate BPS        Temel codec bitrate'i (varsayılan: " << Config::LYRA_DEFAULT_BITRATE << ")" << std::endl;
+    std::cout << "  --loss PCT           Ortalama paket kaybı yüzdesi (varsayılan: 0)" << std::endl;
+    std::cout << "  --burst N            Ortalama ardışık kayıp (varsayılan: 1)" << std::endl;
+    std::cout << "  --jitter MS          Ortalama ek gecikme (varsayılan: 0)" << std::endl;
+    std::cout << "  --playout-delay MS   Alıcı buffer derinliği (varsayılan: 40)" << std::endl;
+    std::cout << "  --seed N             Bozulma modeli seed'i (varsayılan: 1)" << std::endl;
+    std::cout << "  --denoise LEVEL      Temel yapılandırmada gürültü engelleme seviyesi 0-1 (varsayılan: kapalı)" << std::endl;
+    std::cout << "  --noise-snr DB       Referansa bu SNR'de beyaz gürültü ekle (varsayılan: yok;" << std::endl;
+    std::cout << "                       denoise taramasında " << DEFAULT_NOISE_SNR_DB << " dB)" << std::endl;
+    std::cout << "  --model PATH         Harici RNNoise modeli (int8 DenoiseNet yolu)" << std::endl;
+    std::cout << "  --adapt THRESHOLD    Temel yapılandırmada bitrate uyarlaması, kararlılık eşiği" << std::endl;
+    std::cout << "                       (varsayılan: kapalı, sabit bitrate)" << std::endl;
+    std::cout << "  --profile NAME       Gecikme profilini tasarım ağında doğrula (interactive, balanced," << std::endl;
+    std::cout << "                       resilient veya all); hedef karşılanmazsa çıkış kodu 1" << std::endl;
+    std::cout << "  -h, --help           Bu yardım mesajını göster" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string inputPath;
+    std::string outputPath;
+    std::string csvPath;
+    std::string sweep = "all";
+    std::string profileName;
+    PipelineSettings baseSettings;
+    ImpairmentConfig base;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        bool valid = true;
+        double number = 0.0;
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--input" && hasValue) {
+            inputPath = argv[++i];
+        } else if (arg == "--output" && hasValue) {
+            outputPath = argv[++i];
+        } else if (arg == "--csv" && hasValue) {
+            csvPath = argv[++i];
+        } else if (arg == "--sweep" && hasValue) {
+            sweep = argv[++i];
+        } else if (arg == "--bitrate" && hasValue) {
+            valid = parseUnsigned(argv[++i], baseSettings.bitrate);
+        } else if (arg == "--loss" && hasValue) {
+            valid = parseNumber(argv[++i], number) && number >= 0.0 && number <= 100.0;
+            base.lossRate = number / 100.0;
+        } else if (arg == "--burst" && hasValue) {
+            valid = parseNumber(argv[++i], base.meanBurstLength) && base.meanBurstLength >= 1.0;
+        } else if (arg == "--jitter" && hasValue) {
+            valid = parseNumber(argv[++i], base.jitterMs) && base.jitterMs >= 0.0;
+        } else if (arg == "--playout-delay" && hasValue) {
+            valid = parseNumber(argv[++i], base.playoutDelayMs) && base.playoutDelayMs >= 0.0;
+        } else if (arg == "--seed" && hasValue) {
+            valid = parseUnsigned(argv[++i], base.seed);
+        } else if (arg == "--denoise" && hasValue) {
+            valid = parseNumber(argv[++i], number) && number >= 0.0 && number <= 1.0;
+            baseSettings.denoiseLevel = static_cast<float>(number);
+        } else if (arg == "--noise-snr" && hasValue) {
+            valid = parseNumber(argv[++i], baseSettings.noiseSnrDb) && baseSettings.noiseSnrDb > 0.0;
+        } else if (arg == "--model" && hasValue) {
+            baseSettings.modelPath = argv[++i];
+        } else if (arg == "--adapt" && hasValue) {
+            valid = parseNumber(argv[++i], number) && number >= 0.0 && number <= 1.0;
+            baseSettings.adaptThreshold = static_cast<float>(number);
+        } else if (arg == "--profile" && hasValue) {
+            profileName = argv[++i];
+        } else {
+            std::cerr << "Hata: Bilinmeyen parametre: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        if (!valid) {
+            std::cerr << "Hata: Geçersiz değer: " << arg << " " << argv[i] << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (sweep != "all" && sweep != "bitrate" && sweep != "loss" && sweep != "denoise" && sweep != "adapt") {
+        std::cerr << "Hata: Bilinmeyen tarama: " << sweep << std::endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // Referans, codec hızında (16 kHz mono)
+    std::vector<int16_t> reference;
+    if (inputPath.empty()) {
+        reference = synthesizeSpeech(10.0, Config::LYRA_SAMPLE_RATE);
+    } else {
+        WavFile::Info info;
+        if (!WavFile::read(inputPath, reference, info)) {
+            return 1;
+        }
+        if (info.sampleRate != Config::LYRA_SAMPLE_RATE) {
+            LyraCodec converter;
+            reference = converter.resampleTo16kHz(reference.data(), reference.size(), info.sampleRate);
+        }
+    }
+    reference.resize((reference.size() / Config::LYRA_FRAME_SIZE) * Config::LYRA_FRAME_SIZE);
+    if (reference.empty()) {
+        std::cerr << "Hata: Referans en az bir codec frame'i uzunluğunda olmalı" << std::endl;
+        return 1;
+    }
+
+    if (!profileName.empty()) {
+        return validateProfiles(reference, baseSettings.bitrate, profileName, base.seed) ? 0 : 1;
+    }
+
+    std::vector<Row> rows;
+    auto run = [&](const std::string& name, const PipelineSettings& settings, const ImpairmentConfig& impairment) {
+        Row row{name, settings, impairment, runPipeline(reference, settings, impairment), QualityScore()};
+        row.score = scoreResult(reference, row.result);
+        rows.push_back(row);
+    };
+
+    run("base", baseSettings, base);
+
+    if (sweep == "all" || sweep == "bitrate") {
+        for (uint32_t rate = Config::LYRA_MIN_BITRATE; rate <= Config::LYRA_MAX_BITRATE; rate += 1000) {
+            PipelineSettings settings = baseSettings;
+            settings.bitrate = rate;
+            settings.adaptThreshold = -1.0f;  // Sabit bitrate taraması
+            run("bitrate", settings, base);
+        }
+    }
+
+    if (sweep == "all" || sweep == "loss") {
+        for (double loss : {0.0, 1.0, 2.0, 5.0, 10.0, 20.0}) {
+            ImpairmentConfig impairment = base;
+            impairment.lossRate = loss / 100.0;
+            run("loss", baseSettings, impairment);
+        }
+    }
+
+    // Gürültülü girişte seviye taraması; -1 = engelleme kapalı (karşılaştırma satırı)
+    if (sweep == "all" || sweep == "denoise") {
+        for (float level : {-1.0f, 0.25f, 0.5f, 0.75f, 1.0f}) {
+            PipelineSettings settings = baseSettings;
+            settings.denoiseLevel = level;
+            if (settings.noiseSnrDb <= 0.0) {
+                settings.noiseSnrDb = DEFAULT_NOISE_SNR_DB;
+            }
+            run("denoise", settings, base);
+        }
+    }
+
+    // Kararlılık eşiği taraması; kayıpsız ağda hesaplayıcının tepki vereceği bir şey olmaz
+    if (sweep == "all" || sweep == "adapt") {
+        ImpairmentConfig impairment = base;
+        if (impairment.lossRate <= 0.0) {
+            impairment.lossRate = DEFAULT_ADAPT_LOSS_PERCENT / 100.0;
+        }
+        for (float threshold : {0.05f, 0.1f, 0.2f, 0.4f}) {
+            PipelineSettings settings = baseSettings;
+            settings.adaptThreshold = threshold;
+            run("adapt", settings, impairment);
+        }
+    }
+
+    std::cout << "\n=== Konuşma Kalitesi (" << reference.size() / Config::LYRA_SAMPLE_RATE << " s referans"
+              << (inputPath.empty() ? ", sentetik" : ", " + inputPath) << ") ===" << std::endl;
+    std::cout << std::left << std::setw(9) << "tarama" << std::right
+              << std::setw(8) << "kbps" << std::setw(10) << "yük kbps" << std::setw(8) << "kayıp%"
+              << std::setw(8) << "SNR dB" << std::setw(9) << "denoise" << std::setw(8) << "eşik"
+              << std::setw(11) << "değişim" << std::setw(10) << "CPU ms/s" << std::setw(9) << "segSNR"
+              << std::setw(8) << "LSD" << std::setw(7) << "MOS" << std::endl;
+    for (const auto& row : rows) {
+        printRow(row);
+    }
+
+    if (!csvPath.empty()) {
+        std::ofstream csv(csvPath);
+        if (!csv) {
+            std::cerr << "Hata: CSV yazılamadı: " << csvPath << std::endl;
+            return 1;
+        }
+        csv << "sweep,bitrate_bps,avg_bitrate_kbps,payload_kbps,loss_rate,burst,jitter_ms,noise_snr_db,"
+               "denoise_level,stability_threshold,bitrate_changes,cpu_ms_per_s,seg_snr_db,lsd_db,mos\n";
+        for (const auto& row : rows) {
+            csv << row.sweep << ',' << row.settings.bitrate << ',' << row.result.averageBitrateKbps << ','
+                << row.result.payloadKbps << ',' << row.result.lossRate << ','
+                << row.impairment.meanBurstLength << ',' << row.impairment.jitterMs << ','
+                << row.settings.noiseSnrDb << ',' << row.settings.denoiseLevel << ','
+                << row.settings.adaptThreshold << ',' << row.result.bitrateChanges << ','
+                << row.result.cpuMsPerSecond << ','
+                << row.score.segmentalSnrDb << ',' << row.score.logSpectralDistanceDb << ','
+                << row.score.mos << '\n';
+        }
+    }
+
+    if (!outputPath.empty() &&
+        !WavFile::write(outputPath, rows.front().result.output.data(), rows.front().result.output.size(),
+                        Config::LYRA_SAMPLE_RATE)) {
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,914 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <queue>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#include "Config.h"
+#include "EngineClock.h"
+#include "BufferManager.h"
+#include "PlayoutController.h"
+#include "PacketWire.h"
+#include "BitrateCalculator.h"
+#include "NetworkImpairment.h"
+#include "LatencyProfile.h"
+
+using namespace NovaVoice;
+
+// Nova Voice Engine V2 - Ayrık Olay Grup Çağrısı Simülatörü
+// Yüzlerce katılımcılı bir çağrıyı sanal saatle, soket ve thread olmadan
+// çalıştırır. Her katılımcı motorun kendi nesnelerini kullanır: paket
+// biçimi (PacketWire), bitrate denetimi (BitrateCalculator), alım
+// kuyruğu (BufferManager) ve akış başına jitter buffer (PlayoutController).
+// Katılımcılar simüle uplink'lerle bir relay'e (SFU) gönderir; relay
+// en fazla --forward konuşmacıyı diğer herkesin downlink'ine iletir ve
+// her göndericiye uplink geri bildirimi yollar. Olaylar zaman ve ekleme
+// sırasına göre işlenir; aynı seed aynı sonucu (imza) üretir.
+
+namespace {
+
+constexpr int64_t FRAME_US = Config::LYRA_FRAME_SIZE_MS * 1000;
+constexpr size_t DECODED_FRAMES = Config::SAMPLE_RATE * Config::LYRA_FRAME_SIZE_MS / 1000;
+constexpr size_t IP_UDP_OVERHEAD = 28;
+constexpr size_t SEND_HISTORY = 4096;           // Sıra -> gönderim zamanı (ağız-kulak ölçümü)
+constexpr int64_t SPEAKER_HOLD_US = 300000;     // Relay: bu kadar susan konuşmacı yerini bırakır
+constexpr size_t LATENCY_BINS = 2000;           // 1 ms kutular
+constexpr int64_t PRUNE_INTERVAL_US = 1000000;  // Boşta akış temizliği
+
+// Relay'in bir frame için verdiği karar (alıcıdaki boşlukları sınıflandırmak için)
+enum RelayDecision : uint8_t {
+    RELAY_PENDING = 0,      // Henüz relay'e ulaşmadı (yolda veya uplink'te kayıp)
+    RELAY_FORWARDED,
+    RELAY_SUPPRESSED        // Konuşmacı sınırı: alıcı için kayıp değil
+};
+
+// === SİMÜLE BAĞLANTI ===
+
+struct LinkSpec {
+    double bandwidthKbps;
+    double delayMs;
+    double lossRate;
+    double meanBurstLength;
+    double jitterMs;
+    double queueMs;     // Darboğaz tamponu (drop-tail)
+};
+
+struct LinkCounters {
+    uint64_t sent = 0;
+    uint64_t lost = 0;      // Hat kaybı
+    uint64_t dropped = 0;   // Kuyruk taşması
+};
+
+// FIFO darboğaz + Gilbert-Elliott kayıp + üstel jitter
+class SimLink {
+public:
+    SimLink(const LinkSpec& spec, uint32_t seed)
+        : spec_(spec)
+        , impairment_(makeConfig(spec, seed))
+        , freeAtUs_(0) {
+    }
+
+    // Varış zamanı; paket kaybolduysa -1
+    int64_t transmit(int64_t nowUs, size_t bytes) {
+        counters_.sent++;
+        int64_t queueUs = std::max<int64_t>(0, freeAtUs_ - nowUs);
+        if (queueUs > static_cast<int64_t>(spec_.queueMs * 1000.0)) {
+            counters_.dropped++;
+            return -1;
+        }
+        freeAtUs_ = std::max(nowUs, freeAtUs_) + static_cast<int64_t>(bytes * 8000.0 / spec_.bandwidthKbps);
+
+        NetworkImpairment::Outcome outcome = impairment_.next();
+        if (!outcome.delivered) {
+            counters_.lost++;
+            return -1;
+        }
+        return freeAtUs_ + static_cast<int64_t>((spec_.delayMs + outcome.delayMs) * 1000.0);
+    }
+
+    const LinkCounters& getCounters() const { return counters_; }
+
+private:
+    LinkSpec spec_;
+    NetworkImpairment impairment_;
+    int64_t freeAtUs_;
+    LinkCounters counters_;
+
+    static ImpairmentConfig makeConfig(const LinkSpec& spec, uint32_t seed) {
+        ImpairmentConfig config;
+        config.lossRate = spec.lossRate;
+        config.meanBurstLength = spec.meanBurstLength;
+        config.jitterMs = spec.jitterMs;
+        config.playoutDelayMs = 1e9;  // Geç kalma kararı alıcının jitter buffer'ınındır
+        config.seed = seed;
+        return config;
+    }
+};
+
+// === SEÇENEKLER ===
+
+struct SimOptions {
+    size_t participants = 100;
+    double minutes = 5.0;
+    size_t forwardSpeakers = 3;
+    double talkers = 2.0;           // Ortalama eşzamanlı konuşan
+    double talkSeconds = 2.0;       // Ortalama talkspurt
+    double badFraction = 0.1;
+    const LatencyProfile* profile = &LatencyProfile::get(LatencyProfileId::BALANCED);
+    LinkSpec goodUp{128.0, 20.0, 0.005, 1.0, 3.0, 200.0};
+    LinkSpec goodDown{512.0, 20.0, 0.005, 1.0, 3.0, 200.0};
+    LinkSpec badUp{48.0, 60.0, 0.04, 2.0, 25.0, 300.0};
+    LinkSpec badDown{96.0, 60.0, 0.04, 2.0, 25.0, 300.0};
+    uint32_t seed = 1;
+    std::string csvPath;
+};
+
+// === KATILIMCI ===
+
+struct StreamPlayout {
+    uint32_t streamId;
+    std::unique_ptr<PlayoutController> playout;
+    bool hasSequence = false;
+    uint32_t lastSequence = 0;
+    int64_t bufferedUs = 0;     // Karıştırıcıya verilmiş, henüz çalınmamış ses
+};
+
+// Relay'in bir göndericinin uplink'i için tuttuğu geri bildirim penceresi
+struct UplinkWindow {
+    uint64_t received = 0;
+    bool hasSequence = false;
+    uint32_t firstSequence = 0;
+    uint32_t highestSequence = 0;
+    double transitSumMs = 0.0;
+    double lastTransitMs = 0.0;
+    double jitterMs = 0.0;      // Pencereler arasında sürer
+
+    void add(uint32_t sequence, double transitMs) {
+        if (received > 0) {
+            jitterMs += (std::fabs(transitMs - lastTransitMs) - jitterMs) / 16.0;
+        }
+        lastTransitMs = transitMs;
+        transitSumMs += transitMs;
+        received++;
+
+        if (!hasSequence) {
+            hasSequence = true;
+            firstSequence = highestSequence = sequence;
+        } else if (static_cast<int32_t>(sequence - highestSequence) > 0) {
+            highestSequence = sequence;
+        }
+    }
+
+    NetworkMetrics report() const {
+        NetworkMetrics metrics;
+        double expected = static_cast<double>(highestSequence - firstSequence) + 1.0;
+        metrics.packetLossRate = static_cast<float>(std::max(0.0, 1.0 - received / expected));
+        metrics.averageLatency = static_cast<uint32_t>(transitSumMs / received);
+        metrics.jitter = static_cast<uint32_t>(jitterMs);
+        return metrics;  // Bant genişliği relay'de bilinmiyor (0)
+    }
+
+    void reset() {
+        double jitter = jitterMs;
+        *this = UplinkWindow();
+        jitterMs = jitter;
+    }
+};
+
+struct Participant {
+    uint32_t streamId;
+    bool badLink;
+    SimLink uplink;
+    SimLink downlink;
+    BitrateCalculator calculator;
+    BufferManager buffers;
+    std::vector<StreamPlayout> streams;
+
+    std::mt19937 rng;
+    bool talking = false;
+    int64_t nextToggleUs = 0;
+    uint32_t nextSequence = 0;
+    std::vector<int64_t> sendTimeUs;
+    std::vector<uint8_t> relayDecision;
+    std::vector<uint8_t> payload;
+    UplinkWindow window;
+    uint32_t nextFeedbackSequence = 0;
+    int64_t nextPruneUs = 0;
+
+    // İstatistikler
+    uint64_t framesSent = 0;
+    uint64_t bitrateSum = 0;
+    uint64_t feedbackReceived = 0;
+    uint64_t framesPlayed = 0;
+    uint64_t framesConcealed = 0;   // Göndericinin yolladığı ama zamanında gelmeyen
+    uint64_t framesLost = 0;        // Çalınan akışta sıra boşluğu
+    uint64_t playoutUnderruns = 0;  // Kaldırılan akışlardan birikmiş
+    double latencySumMs = 0.0;
+    std::vector<uint32_t> latencyHistogram;
+
+    Participant(uint32_t id, bool bad, const SimOptions& options, uint32_t seed)
+        : streamId(id)
+        , badLink(bad)
+        , uplink(bad ? options.badUp : options.goodUp, seed * 4 + 1)
+        , downlink(bad ? options.badDown : options.goodDown, seed * 4 + 2)
+        , rng(seed * 4 + 3)
+        , sendTimeUs(SEND_HISTORY, 0)
+        , relayDecision(SEND_HISTORY, RELAY_PENDING)
+        , latencyHistogram(LATENCY_BINS, 0) {
+    }
+
+    uint64_t getUnderruns() const {
+        uint64_t underruns = playoutUnderruns;
+        for (const auto& stream : streams) {
+            underruns += stream.playout->getUnderruns();
+        }
+        return underruns;
+    }
+};
+
+// === OLAYLAR ===
+
+enum class EventType : uint8_t {
+    SEND_TICK,          // Katılımcı bir frame yakalar/gönderir
+    UPLINK_ARRIVAL,     // Paket relay'e ulaştı
+    DOWNLINK_ARRIVAL,   // Paket (ses veya geri bildirim) katılımcıya ulaştı
+    PLAYOUT_TICK,       // Katılımcının karıştırıcısı bir frame çalar
+    FEEDBACK_TICK       // Relay göndericiye uplink raporu yollar
+};
+
+struct Event {
+    int64_t timeUs;
+    uint64_t order;     // Aynı zamanlı olaylarda ekleme sırası (determinizm)
+    EventType type;
+    uint32_t participant;
+    std::shared_ptr<const std::vector<uint8_t>> wire;
+};
+
+struct EventLater {
+    bool operator()(const Event& a, const Event& b) const {
+        return a.timeUs != b.timeUs ? a.timeUs > b.timeUs : a.order > b.order;
+    }
+};
+
+// === SİMÜLATÖR ===
+
+class CallSimulator {
+public:
+    explicit CallSimulator(const SimOptions& options)
+        : options_(options)
+        , epoch_(std::chrono::hours(1))
+        , nextOrder_(0)
+        , eventsProcessed_(0)
+        , forwarded_(0)
+        , suppressed_(0) {
+    }
+
+    void run() {
+        EngineClock::enableVirtual(epoch_);
+        setup();
+
+        int64_t endUs = static_cast<int64_t>(options_.minutes * 60e6);
+        while (!events_.empty() && events_.top().timeUs <= endUs) {
+            Event event = events_.top();
+            events_.pop();
+            EngineClock::advanceTo(epoch_ + std::chrono::microseconds(event.timeUs));
+            eventsProcessed_++;
+
+            switch (event.type) {
+                case EventType::SEND_TICK: onSendTick(event.timeUs, event.participant); break;
+                case EventType::UPLINK_ARRIVAL: onUplinkArrival(event.timeUs, *event.wire); break;
+                case EventType::DOWNLINK_ARRIVAL: onDownlinkArrival(event.timeUs, event.participant, *event.wire); break;
+                case EventType::PLAYOUT_TICK: onPlayoutTick(event.timeUs, event.participant); break;
+                case EventType::FEEDBACK_TICK: onFeedbackTick(event.timeUs, event.participant); break;
+            }
+        }
+
+        EngineClock::disableVirtual();
+    }
+
+    const std::vector<std::unique_ptr<Participant>>& getParticipants() const { return participants_; }
+    uint64_t getEventsProcessed() const { return eventsProcessed_; }
+    uint64_t getForwarded() const { return forwarded_; }
+    uint64_t getSuppressed() const { return suppressed_; }
+
+private:
+    struct ActiveSpeaker {
+        uint32_t index;
+        int64_t lastUs;
+    };
+
+    const SimOptions& options_;
+    EngineClock::time_point epoch_;
+    std::vector<std::unique_ptr<Participant>> participants_;
+    std::priority_queue<Event, std::vector<Event>, EventLater> events_;
+    uint64_t nextOrder_;
+    std::vector<ActiveSpeaker> speakers_;
+
+    uint64_t eventsProcessed_;
+    uint64_t forwarded_;
+    uint64_t suppressed_;
+
+    void schedule(int64_t timeUs, EventType type, uint32_t participant,
+                  std::shared_ptr<const std::vector<uint8_t>> wire = nullptr) {
+        events_.push({timeUs, nextOrder_++, type, participant, std::move(wire)});
+    }
+
+    void setup() {
+        std::mt19937 rng(options_.seed);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        size_t badCount = static_cast<size_t>(std::round(options_.participants * options_.badFraction));
+
+        for (size_t i = 0; i < options_.participants; ++i) {
+            // Akış kimliği 0 "yerel/bilinmiyor" demektir; katılımcılar 1'den başlar
+            auto participant = std::make_unique<Participant>(static_cast<uint32_t>(i + 1), i < badCount, options_,
+                                                             options_.seed + static_cast<uint32_t>(i) * 7919u);
+            participant->calculator.setLogging(false);
+            participant->calculator.initialize();
+            participant->buffers.setMaxBufferSize(options_.profile->maxQueuedPackets);
+            // Karıştırıcı akış başına ring'lerden okur; tekli çalma kuyruğu kapalı
+            participant->buffers.setPlaybackStream(0);
+            participant->nextToggleUs = static_cast<int64_t>(silenceSeconds(*participant) * 1e6);
+
+            // Cihazlar birbirine hizalı değil: faz rastgele
+            int64_t phaseUs = static_cast<int64_t>(uniform(rng) * FRAME_US);
+            schedule(phaseUs, EventType::SEND_TICK, static_cast<uint32_t>(i));
+            schedule(static_cast<int64_t>(uniform(rng) * FRAME_US), EventType::PLAYOUT_TICK, static_cast<uint32_t>(i));
+            schedule(static_cast<int64_t>(uniform(rng) * Config::BITRATE_UPDATE_INTERVAL_MS * 1000.0),
+                     EventType::FEEDBACK_TICK, static_cast<uint32_t>(i));
+            participants_.push_back(std::move(participant));
+        }
+    }
+
+    double silenceSeconds(Participant& participant) {
+        // Konuşma oranı = talkers / katılımcı; sessizlik ortalaması buna göre
+        double activity = std::min(0.95, options_.talkers / options_.participants);
+        std::exponential_distribution<double> silence(activity / (options_.talkSeconds * (1.0 - activity)));
+        return silence(participant.rng);
+    }
+
+    double talkSeconds(Participant& participant) {
+        std::exponential_distribution<double> talk(1.0 / options_.talkSeconds);
+        return talk(participant.rng);
+    }
+
+    static AudioMetrics audioMetrics(bool speaking) {
+        AudioMetrics metrics;
+        metrics.speechDetected = speaking;
+        metrics.averageVolume = speaking ? 0.4f : 0.02f;
+        metrics.signalToNoiseRatio = 25.0f;
+        return metrics;
+    }
+
+    // --- Gönderici ---
+    void onSendTick(int64_t nowUs, uint32_t index) {
+        Participant& sender = *participants_[index];
+        schedule(nowUs + FRAME_US, EventType::SEND_TICK, index);
+
+        if (nowUs >= sender.nextToggleUs) {
+            sender.talking = !sender.talking;
+            double seconds = sender.talking ? talkSeconds(sender) : silenceSeconds(sender);
+            sender.nextToggleUs = nowUs + static_cast<int64_t>(seconds * 1e6);
+            sender.calculator.updateAudioMetrics(audioMetrics(sender.talking));
+        }
+
+        // Sessizlikte gönderim yok (DTX)
+        if (!sender.talking) {
+            return;
+        }
+
+        uint32_t bitrate = sender.calculator.getCurrentBitrate();
+        size_t payloadBytes = (bitrate * Config::LYRA_FRAME_SIZE_MS / 1000 + 7) / 8;
+        uint32_t sequence = sender.nextSequence++;
+        sender.payload.assign(payloadBytes, static_cast<uint8_t>(sequence));
+
+        AudioPacket packet(sender.payload.data(), payloadBytes, sequence);
+        auto wire = std::make_shared<std::vector<uint8_t>>();
+        PacketWire::serializeInto(packet, sender.streamId, *wire);
+
+        sender.sendTimeUs[sequence % SEND_HISTORY] = nowUs;
+        sender.relayDecision[sequence % SEND_HISTORY] = RELAY_PENDING;
+        sender.framesSent++;
+        sender.bitrateSum += bitrate;
+
+        int64_t arrivalUs = sender.uplink.transmit(nowUs, wire->size() + IP_UDP_OVERHEAD);
+        if (arrivalUs >= 0) {
+            schedule(arrivalUs, EventType::UPLINK_ARRIVAL, index, std::move(wire));
+        }
+    }
+
+    // --- Relay (SFU) ---
+    bool admitSpeaker(uint32_t index, int64_t nowUs) {
+        for (auto& speaker : speakers_) {
+            if (speaker.index == index) {
+                speaker.lastUs = nowUs;
+                return true;
+            }
+        }
+
+        speakers_.erase(std::remove_if(speakers_.begin(), speakers_.end(), [nowUs](const ActiveSpeaker& speaker) {
+            return nowUs - speaker.lastUs > SPEAKER_HOLD_US;
+        }), speakers_.end());
+
+        if (speakers_.size() >= options_.forwardSpeakers) {
+            return false;
+        }
+        speakers_.push_back({index, nowUs});
+        return true;
+    }
+
+    void onUplinkArrival(int64_t nowUs, const std::vector<uint8_t>& wire) {
+        auto packet = PacketWire::deserialize(wire.data(), wire.size());
+        if (!packet || packet->type != PacketType::AUDIO || packet->streamId == 0 ||
+            packet->streamId > participants_.size()) {
+            return;
+        }
+
+        uint32_t source = packet->streamId - 1;
+        Participant& sender = *participants_[source];
+        double transitMs = (nowUs - sender.sendTimeUs[packet->sequenceNumber % SEND_HISTORY]) / 1000.0;
+        sender.window.add(packet->sequenceNumber, transitMs);
+
+        // Yalnızca en fazla --forward konuşmacı iletilir (last-N)
+        if (!admitSpeaker(source, nowUs)) {
+            sender.relayDecision[packet->sequenceNumber % SEND_HISTORY] = RELAY_SUPPRESSED;
+            suppressed_++;
+            return;
+        }
+        sender.relayDecision[packet->sequenceNumber % SEND_HISTORY] = RELAY_FORWARDED;
+        forwarded_++;
+
+        // SFU yeniden kodlamaz: aynı bayt dizisi herkese
+        auto shared = std::make_shared<const std::vector<uint8_t>>(wire);
+        for (uint32_t r = 0; r < participants_.size(); ++r) {
+            if (r == source) {
+                continue;
+            }
+            int64_t arrivalUs = participants_[r]->downlink.transmit(nowUs, wire.size() + IP_UDP_OVERHEAD);
+            if (arrivalUs >= 0) {
+                schedule(arrivalUs, EventType::DOWNLINK_ARRIVAL, r, shared);
+            }
+        }
+    }
+
+    void onFeedbackTick(int64_t nowUs, uint32_t index) {
+        Participant& sender = *participants_[index];
+        schedule(nowUs + Config::BITRATE_UPDATE_INTERVAL_MS * 1000, EventType::FEEDBACK_TICK, index);
+
+        // Pencerede paket yoksa (sessizlik) raporlanacak ölçüm yok
+        if (sender.window.received == 0) {
+            return;
+        }
+
+        NetworkMetrics metrics = sender.window.report();
+        sender.window.reset();
+
+        AudioPacket packet(reinterpret_cast<const uint8_t*>(&metrics), sizeof(metrics),
+                           sender.nextFeedbackSequence++, PacketType::FEEDBACK);
+        auto wire = std::make_shared<std::vector<uint8_t>>();
+        PacketWire::serializeInto(packet, sender.streamId, *wire);
+
+        int64_t arrivalUs = sender.downlink.transmit(nowUs, wire->size() + IP_UDP_OVERHEAD);
+        if (arrivalUs >= 0) {
+            schedule(arrivalUs, EventType::DOWNLINK_ARRIVAL, index, std::move(wire));
+        }
+    }
+
+    // --- Alıcı ---
+    void onDownlinkArrival(int64_t nowUs, uint32_t index, const std::vector<uint8_t>& wire) {
+        (void)nowUs;
+        Participant& receiver = *participants_[index];
+        auto packet = PacketWire::deserialize(wire.data(), wire.size());
+        if (!packet) {
+            return;
+        }
+
+        // UDPManager ile aynı ayrım: kontrol paketleri çalma kuyruğuna girmez
+        if (packet->type == PacketType::FEEDBACK) {
+            NetworkMetrics metrics;
+            if (packet->data.size() == sizeof(metrics)) {
+                std::memcpy(&metrics, packet->data.data(), sizeof(metrics));
+                receiver.calculator.updateNetworkMetrics(metrics);
+                receiver.feedbackReceived++;
+            }
+            return;
+        }
+
+        if (!receiver.buffers.pushNetworkPacket(packet)) {
+            return;
+        }
+        for (const auto& stream : receiver.streams) {
+            if (stream.streamId == packet->streamId) {
+                return;
+            }
+        }
+
+        StreamPlayout stream;
+        stream.streamId = packet->streamId;
+        stream.playout = std::make_unique<PlayoutController>();
+        stream.playout->applyProfile(*options_.profile);
+        receiver.streams.push_back(std::move(stream));
+    }
+
+    void onPlayoutTick(int64_t nowUs, uint32_t index) {
+        Participant& receiver = *participants_[index];
+        schedule(nowUs + FRAME_US, EventType::PLAYOUT_TICK, index);
+
+        for (auto& stream : receiver.streams) {
+            // Karıştırıcı her tick bir frame tüketir; eldeki ses yetmezse kuyruktan alır.
+            // Esnetme oranı, AudioPlayer'daki gibi paketin çalma süresini değiştirir.
+            while (stream.bufferedUs < FRAME_US) {
+                if (!fetchPacket(receiver, stream, nowUs)) {
+                    break;
+                }
+            }
+            stream.bufferedUs = std::max<int64_t>(0, stream.bufferedUs - FRAME_US);
+        }
+
+        if (nowUs >= receiver.nextPruneUs) {
+            receiver.nextPruneUs = nowUs + PRUNE_INTERVAL_US;
+            pruneStreams(receiver);
+        }
+    }
+
+    // Sıra boşluğunda relay'in bilerek iletmediği frame'ler hariç
+    static uint64_t countLostBetween(const Participant& sender, uint32_t last, uint32_t next) {
+        int32_t gap = static_cast<int32_t>(next - last) - 1;
+        if (gap <= 0) {
+            return 0;
+        }
+
+        uint64_t lost = 0;
+        for (uint32_t sequence = next - std::min<uint32_t>(gap, SEND_HISTORY); sequence != next; ++sequence) {
+            if (sender.relayDecision[sequence % SEND_HISTORY] != RELAY_SUPPRESSED) {
+                lost++;
+            }
+        }
+        return lost;
+    }
+
+    bool fetchPacket(Participant& receiver, StreamPlayout& stream, int64_t nowUs) {
+        if (!stream.playout->shouldStart(receiver.buffers.getStreamBufferSize(stream.streamId))) {
+            return false;
+        }
+
+        const Participant& sender = *participants_[stream.streamId - 1];
+        auto packet = receiver.buffers.getNextStreamPacket(stream.streamId);
+        // Sırası geçmiş (yeniden sıralanmış) paket geç kalmıştır: boşlukta zaten kayıp sayıldı
+        while (packet && stream.hasSequence &&
+               static_cast<int32_t>(packet->sequenceNumber - stream.lastSequence) <= 0) {
+            packet = receiver.buffers.getNextStreamPacket(stream.streamId);
+        }
+        if (!packet) {
+            // Gönderici talkspurt'ü bitirdiyse veya relay iletmediyse bu sessizliktir, gizleme değil
+            uint32_t expected = stream.lastSequence + 1;
+            if (stream.hasSequence && sender.nextSequence != expected &&
+                sender.relayDecision[expected % SEND_HISTORY] != RELAY_SUPPRESSED) {
+                receiver.framesConcealed++;
+            }
+            stream.playout->onStarved();
+            return false;
+        }
+
+        if (stream.hasSequence) {
+            receiver.framesLost += countLostBetween(sender, stream.lastSequence, packet->sequenceNumber);
+        }
+        stream.hasSequence = true;
+        stream.lastSequence = packet->sequenceNumber;
+
+        stream.playout->onPacketDequeued(packet->timestamp, DECODED_FRAMES);
+        double ratio = stream.playout->getStretchRatio(receiver.buffers.getStreamBufferSize(stream.streamId));
+        stream.playout->onAudioWritten(DECODED_FRAMES);
+        receiver.framesPlayed++;
+
+        // Ağız-kulak: yakalama periyodu + gönderimden, önündeki ses çalındıktan sonra duyulana kadar
+        double latencyMs = (nowUs + stream.bufferedUs - sender.sendTimeUs[packet->sequenceNumber % SEND_HISTORY] +
+                            FRAME_US) / 1000.0;
+        receiver.latencySumMs += latencyMs;
+        receiver.latencyHistogram[std::min(LATENCY_BINS - 1, static_cast<size_t>(latencyMs))]++;
+
+        stream.bufferedUs += static_cast<int64_t>(FRAME_US * ratio);
+        return true;
+    }
+
+    // Boşta kalan akışları motorun süresiyle geri al; jitter buffer'ları da kaldır
+    void pruneStreams(Participant& receiver) {
+        receiver.buffers.reclaimIdleStreams(std::chrono::milliseconds(Config::STREAM_IDLE_TIMEOUT_MS));
+        std::vector<uint32_t> active = receiver.buffers.getActiveStreams();
+
+        auto removed = std::remove_if(receiver.streams.begin(), receiver.streams.end(), [&](const StreamPlayout& stream) {
+            if (std::find(active.begin(), active.end(), stream.streamId) != active.end()) {
+                return false;
+            }
+            receiver.playoutUnderruns += stream.playout->getUnderruns();
+            return true;
+        });
+        receiver.streams.erase(removed, receiver.streams.end());
+    }
+};
+
+// === RAPOR ===
+
+struct ClassSummary {
+    size_t participants = 0;
+    LinkCounters uplink;
+    LinkCounters downlink;
+    uint64_t framesSent = 0;
+    uint64_t bitrateSum = 0;
+    uint64_t bitrateChanges = 0;
+    uint64_t feedback = 0;
+    uint64_t framesPlayed = 0;
+    uint64_t framesConcealed = 0;
+    uint64_t framesLost = 0;
+    uint64_t underruns = 0;
+    uint64_t rejectedStreams = 0;
+    std::vector<uint64_t> latency = std::vector<uint64_t>(LATENCY_BINS, 0);
+
+    void add(const Participant& participant) {
+        participants++;
+        addLink(uplink, participant.uplink.getCounters());
+        addLink(downlink, participant.downlink.getCounters());
+        framesSent += participant.framesSent;
+        bitrateSum += participant.bitrateSum;
+        bitrateChanges += participant.calculator.getBitrateChanges();
+        feedback += participant.feedbackReceived;
+        framesPlayed += participant.framesPlayed;
+        framesConcealed += participant.framesConcealed;
+        framesLost += participant.framesLost;
+        underruns += participant.getUnderruns();
+        rejectedStreams += participant.buffers.getRejectedStreamPackets();
+        for (size_t i = 0; i < LATENCY_BINS; ++i) {
+            latency[i] += participant.latencyHistogram[i];
+        }
+    }
+
+    static void addLink(LinkCounters& total, const LinkCounters& link) {
+        total.sent += link.sent;
+        total.lost += link.lost;
+        total.dropped += link.dropped;
+    }
+
+    double percentile(double fraction) const {
+        uint64_t total = 0;
+        for (uint64_t count : latency) {
+            total += count;
+        }
+        uint64_t rank = static_cast<uint64_t>(std::ceil(total * fraction));
+        uint64_t seen = 0;
+        for (size_t bin = 0; bin < latency.size(); ++bin) {
+            seen += latency[bin];
+            if (rank > 0 && seen >= rank) {
+                return static_cast<double>(bin);
+            }
+        }
+        return 0.0;
+    }
+};
+
+// setw bayt sayar: UTF-8 devam baytları kadar genişlik eklenir
+int displayWidth(const std::string& text, int width) {
+    for (unsigned char c : text) {
+        if ((c & 0xC0) == 0x80) {
+            width++;
+        }
+    }
+    return width;
+}
+
+double percentOf(uint64_t part, uint64_t whole) {
+    return whole > 0 ? 100.0 * part / whole : 0.0;
+}
+
+void printClass(const std::string& name, const ClassSummary& summary, double minutes) {
+    if (summary.participants == 0) {
+        return;
+    }
+    std::cout << std::left << std::setw(displayWidth(name, 9)) << name << std::right << std::fixed << std::setprecision(0)
+              << std::setw(6) << summary.participants << std::setprecision(2)
+              << std::setw(9) << (summary.framesSent > 0 ? summary.bitrateSum / 1000.0 / summary.framesSent : 0.0)
+              << std::setprecision(1)
+              << std::setw(9) << summary.bitrateChanges / (summary.participants * minutes)
+              << std::setw(9) << percentOf(summary.uplink.lost + summary.uplink.dropped, summary.uplink.sent)
+              << std::setw(10) << percentOf(summary.downlink.lost + summary.downlink.dropped, summary.downlink.sent)
+              << std::setw(9) << percentOf(summary.framesConcealed, summary.framesPlayed + summary.framesConcealed)
+              << std::setw(8) << percentOf(summary.framesLost, summary.framesPlayed + summary.framesLost)
+              << std::setw(10) << summary.underruns / (summary.participants * minutes)
+              << std::setprecision(0) << std::setw(8) << summary.percentile(0.5)
+              << std::setw(8) << summary.percentile(0.95) << std::setw(8) << summary.percentile(0.99) << std::endl;
+}
+
+// Aynı seed ve seçeneklerle aynı çıktı: sayaçların FNV-1a özeti
+uint64_t digest(const std::vector<std::unique_ptr<Participant>>& participants) {
+    uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (value >> (i * 8)) & 0xff;
+            hash *= 1099511628211ull;
+        }
+    };
+    for (const auto& participant : participants) {
+        mix(participant->framesSent);
+        mix(participant->bitrateSum);
+        mix(participant->framesPlayed);
+        mix(participant->framesConcealed);
+        mix(participant->framesLost);
+        mix(participant->calculator.getBitrateChanges());
+        mix(static_cast<uint64_t>(participant->latencySumMs * 1000.0));
+    }
+    return hash;
+}
+
+bool writeCsv(const std::string& path, const std::vector<std::unique_ptr<Participant>>& participants) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Hata: CSV yazılamadı: " << path << std::endl;
+        return false;
+    }
+
+    out << "participant,link,frames_sent,mean_bitrate,bitrate_changes,uplink_sent,uplink_lost,uplink_dropped,"
+           "downlink_sent,downlink_lost,downlink_dropped,frames_played,frames_concealed,frames_lost,"
+           "playout_underruns,mean_latency_ms\n";
+    for (const auto& p : participants) {
+        const LinkCounters& up = p->uplink.getCounters();
+        const LinkCounters& down = p->downlink.getCounters();
+        out << p->streamId << ',' << (p->badLink ? "bad" : "good") << ',' << p->framesSent << ','
+            << (p->framesSent > 0 ? static_cast<double>(p->bitrateSum) / p->framesSent : 0.0) << ','
+            << p->calculator.getBitrateChanges() << ',' << up.sent << ',' << up.lost << ',' << up.dropped << ','
+            << down.sent << ',' << down.lost << ',' << down.dropped << ',' << p->framesPlayed << ','
+            << p->framesConcealed << ',' << p->framesLost << ',' << p->getUnderruns() << ','
+            << (p->framesPlayed > 0 ? p->latencySumMs / p->framesPlayed : 0.0) << '\n';
+    }
+    return true;
+}
+
+bool parseNumber(const std::string& text, double& value) {
+    try {
+        size_t consumed = 0;
+        value = std::stod(text, &consumed);
+        return consumed == text.size() && std::isfinite(value);
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool parseUnsigned(const std::string& text, uint32_t& value) {
+    try {
+        size_t consumed = 0;
+        unsigned long parsed = std::stoul(text, &consumed);
+        if (consumed != text.size() || text[0] == '-' || parsed > UINT32_MAX) {
+            return false;
+        }
+        value = static_cast<uint32_t>(parsed);
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+void printUsage(const char* programName) {
+    std::cout << "Nova Voice Engine V2 - Ayrık Olay Grup Çağrısı Simülatörü" << std::endl;
+    std::cout << "Kullanım: " << programName << " [SEÇENEKLER]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  --participants N     Katılımcı sayısı (varsayılan: 100)" << std::endl;
+    std::cout << "  --minutes M          Simüle çağrı süresi (varsayılan: 5)" << std::endl;
+    std::cout << "  --forward K          Relay'in ilettiği en fazla konuşmacı (varsayılan: 3)" << std::endl;
+    std::cout << "  --talkers X          Ortalama eşzamanlı konuşan (varsayılan: 2)" << std::endl;
+    std::cout << "  --profile NAME       Jitter buffer profili (varsayılan: balanced)" << std::endl;
+    std::cout << "  --bad-fraction PCT   Kötü bağlantılı katılımcı yüzdesi (varsayılan: 10)" << std::endl;
+    std::cout << "  --loss PCT           İyi bağlantı kaybı (varsayılan: 0.5)" << std::endl;
+    std::cout << "  --bad-loss PCT       Kötü bağlantı kaybı (varsayılan: 4)" << std::endl;
+    std::cout << "  --jitter MS          İyi bağlantı jitter'ı (varsayılan: 3)" << std::endl;
+    std::cout << "  --bad-jitter MS      Kötü bağlantı jitter'ı (varsayılan: 25)" << std::endl;
+    std::cout << "  --bad-kbps UP,DOWN   Kötü bağlantı hızı (varsayılan: 48,96)" << std::endl;
+    std::cout << "  --seed N             Senaryo seed'i (varsayılan: 1)" << std::endl;
+    std::cout << "  --csv FILE           Katılımcı başına sonuçları CSV olarak yaz" << std::endl;
+    std::cout << "  -h, --help           Bu yardım mesajını göster" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    SimOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        bool valid = true;
+        double number = 0.0;
+        uint32_t count = 0;
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--participants" && hasValue) {
+            valid = parseUnsigned(argv[++i], count) && count >= 2;
+            options.participants = count;
+        } else if (arg == "--minutes" && hasValue) {
+            valid = parseNumber(argv[++i], options.minutes) && options.minutes > 0.0;
+        } else if (arg == "--forward" && hasValue) {
+            valid = parseUnsigned(argv[++i], count) && count >= 1 && count <= Config::MAX_STREAMS;
+            options.forwardSpeakers = count;
+        } else if (arg == "--talkers" && hasValue) {
+            valid = parseNumber(argv[++i], options.talkers) && options.talkers > 0.0;
+        } else if (arg == "--profile" && hasValue) {
+            options.profile = LatencyProfile::find(argv[++i]);
+            if (!options.profile) {
+                std::cerr << "Hata: Bilinmeyen profil: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (arg == "--bad-fraction" && hasValue) {
+            valid = parseNumber(argv[++i], number) && number >= 0.0 && number <= 100.0;
+            options.badFraction = number / 100.0;
+        } else if (arg == "--loss" && hasValue) {
+            valid = parseNumber(argv[++i], number) && number >= 0.0 && number <= 100.0;
+            options.goodUp.lossRate = options.goodDown.lossRate = number / 100.0;
+        } else if (arg == "--bad-loss" && hasValue) {
+            valid = parseNumber(argv[++i], number) && number >= 0.0 && number <= 100.0;
+            options.badUp.lossRate = options.badDown.lossRate = number / 100.0;
+        } else if (arg == "--jitter" && hasValue) {
+            valid = parseNumber(argv[++i], number) && number >= 0.0;
+            options.goodUp.jitterMs = options.goodDown.jitterMs = number;
+        } else if (arg == "--bad-jitter" && hasValue) {
+            valid = parseNumber(argv[++i], number) && number >= 0.0;
+            options.badUp.jitterMs = options.badDown.jitterMs = number;
+        } else if (arg == "--bad-kbps" && hasValue) {
+            std::string value = argv[++i];
+            size_t comma = value.find(',');
+            valid = parseNumber(value.substr(0, comma), options.badUp.bandwidthKbps) && options.badUp.bandwidthKbps >= 1.0;
+            if (comma == std::string::npos) {
+                options.badDown.bandwidthKbps = options.badUp.bandwidthKbps;
+            } else {
+                valid = valid && parseNumber(value.substr(comma + 1), options.badDown.bandwidthKbps) &&
+                        options.badDown.bandwidthKbps >= 1.0;
+            }
+        } else if (arg == "--seed" && hasValue) {
+            valid = parseUnsigned(argv[++i], options.seed);
+        } else if (arg == "--csv" && hasValue) {
+            options.csvPath = argv[++i];
+        } else {
+            std::cerr << "Hata: Bilinmeyen parametre: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (!valid) {
+            std::cerr << "Hata: Geçersiz değer: " << arg << " " << argv[i] << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::cout << "=== Grup Çağrısı Simülasyonu ===" << std::endl;
+    std::cout << options.participants << " katılımcı (%" << options.badFraction * 100.0 << " kötü bağlantı), "
+              << options.minutes << " dk, relay en fazla " << options.forwardSpeakers << " konuşmacı iletir, ort. "
+              << options.talkers << " eşzamanlı konuşan, profil " << options.profile->name << ", seed "
+              << options.seed << std::endl;
+
+    auto wallStart = std::chrono::steady_clock::now();
+    CallSimulator simulator(options);
+    simulator.run();
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    ClassSummary good;
+    ClassSummary bad;
+    ClassSummary all;
+    for (const auto& participant : simulator.getParticipants()) {
+        (participant->badLink ? bad : good).add(*participant);
+        all.add(*participant);
+    }
+
+    double simulatedSeconds = options.minutes * 60.0;
+    std::cout << "Süre: " << std::fixed << std::setprecision(2) << wallSeconds << " s duvar saati (gerçek zamanın "
+              << std::setprecision(0) << (wallSeconds > 0.0 ? simulatedSeconds / wallSeconds : 0.0) << "x hızı), "
+              << simulator.getEventsProcessed() << " olay ("
+              << (wallSeconds > 0.0 ? simulator.getEventsProcessed() / wallSeconds : 0.0) << " olay/s)" << std::endl;
+    std::cout << "Relay: " << simulator.getForwarded() << " paket iletildi, " << simulator.getSuppressed()
+              << " paket konuşmacı sınırında tutuldu; " << all.feedback << " geri bildirim, "
+              << all.rejectedStreams << " paket akış havuzu dolu" << std::endl;
+
+    std::cout << "\n" << std::left << std::setw(displayWidth("bağlantı", 9)) << "bağlantı" << std::right
+              << std::setw(displayWidth("kişi", 6)) << "kişi" << std::setw(9) << "kbps"
+              << std::setw(displayWidth("geçiş/dk", 9)) << "geçiş/dk" << std::setw(9) << "up kay%"
+              << std::setw(10) << "down kay%" << std::setw(9) << "gizleme%"
+              << std::setw(displayWidth("kayıp%", 8)) << "kayıp%" << std::setw(10) << "undrn/dk"
+              << std::setw(8) << "p50 ms" << std::setw(8) << "p95 ms" << std::setw(8) << "p99 ms" << std::endl;
+    printClass("iyi", good, options.minutes);
+    printClass("kötü", bad, options.minutes);
+    printClass("tümü", all, options.minutes);
+    std::cout << "(kbps: gönderilen ortalama Lyra bitrate'i; gizleme: zamanında gelmeyen frame; "
+              << "kayıp: çalınan akışta sıra boşluğu; gecikme: ağız-kulak)" << std::endl;
+
+    std::cout << "\nSonuç imzası: 0x" << std::hex << std::setw(16) << std::setfill('0')
+              << digest(simulator.getParticipants()) << std::dec << std::setfill(' ')
+              << " (aynı seed ve seçeneklerle aynı olmalı)" << std::endl;
+
+    if (!options.csvPath.empty() && writeCsv(options.csvPath, simulator.getParticipants())) {
+        std::cout << "✓ Katılımcı sonuçları yazıldı: " << options.csvPath << std::endl;
+    }
+    return 0;
+}
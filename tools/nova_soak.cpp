@@ -0,0 +1,580 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <queue>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <algorithm>
+#include <unistd.h>
+
+#include "Config.h"
+#include "BufferManager.h"
+#include "PlayoutController.h"
+#include "NetworkImpairment.h"
+#include "LatencyProfile.h"
+
+using namespace NovaVoice;
+
+// Nova Voice Engine V2 - Uzun Süreli Dayanıklılık (Soak) Testi
+// Bir veya birden çok başsız çağrıyı bozulma simülatörü üzerinden simüle
+// edilmiş zamanda (gerçek zamandan çok daha hızlı) saatlerce çalıştırır.
+// Alıcı tarafı motorun kendi BufferManager ve PlayoutController'ıdır;
+// gönderici saati alıcıdan --drift-ppm kadar sapar. Her örnekleme
+// penceresinde RSS, canlı bellek bloğu sayısı, kuyruk derinliği ve
+// ağız-kulak gecikmesi yüzdelikleri alınır; ısınma sonrası doğrusal
+// eğilim eşiği aşan ölçüt varsa çıkış kodu 1 olur.
+
+// === BELLEK SAYACI ===
+// Aracın kendi operator new/delete'i: canlı blok sayısı sızıntıyı,
+// toplam ayırma sayısı ayırma hızını gösterir
+
+namespace {
+
+std::atomic<uint64_t> g_liveBlocks{0};
+std::atomic<uint64_t> g_totalAllocations{0};
+
+void* countedAllocate(size_t size) {
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    g_liveBlocks.fetch_add(1, std::memory_order_relaxed);
+    g_totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    return memory;
+}
+
+void countedFree(void* memory) {
+    if (memory) {
+        g_liveBlocks.fetch_sub(1, std::memory_order_relaxed);
+        std::free(memory);
+    }
+}
+
+} // namespace
+
+void* operator new(size_t size) { return countedAllocate(size); }
+void* operator new[](size_t size) { return countedAllocate(size); }
+void operator delete(void* memory) noexcept { countedFree(memory); }
+void operator delete[](void* memory) noexcept { countedFree(memory); }
+void operator delete(void* memory, size_t) noexcept { countedFree(memory); }
+void operator delete[](void* memory, size_t) noexcept { countedFree(memory); }
+
+namespace {
+
+// === SİMÜLASYON ===
+
+// Seçenek sınırları (örnek ve gecikme dizileri baştan ayrılır)
+constexpr uint32_t MAX_CALLS = 256;
+constexpr double MAX_HOURS = 1000.0;
+constexpr double MAX_SAMPLE_SECONDS = 3600.0;
+constexpr double MAX_DRIFT_PPM = 10000.0;
+
+struct SoakOptions {
+    const LatencyProfile* profile = &LatencyProfile::get(LatencyProfileId::BALANCED);
+    size_t calls = 4;
+    double hours = 2.0;
+    double driftPpm = 50.0;         // Gönderici saati alıcıdan hızlı (+) / yavaş (-)
+    double sampleSeconds = 60.0;
+    double warmupFraction = 0.1;
+    double maxGrowthPercent = 10.0; // Isınma sonrası taban değerine göre
+    double injectLeakBytesPerSecond = 0.0;
+    uint32_t seed = 1;
+    ImpairmentConfig impairment;
+    std::string csvPath;
+};
+
+struct InFlight {
+    double arrivalUs;
+    uint32_t sequence;
+
+    bool operator>(const InFlight& other) const { return arrivalUs > other.arrivalUs; }
+};
+
+// Tek yönlü çağrı: gönderici -> bozulma -> alıcı kuyruğu -> playout -> cihaz
+class SoakCall {
+public:
+    SoakCall(const SoakOptions& options, uint32_t streamId)
+        : profile_(*options.profile)
+        , network_(options.impairment)
+        , streamId_(streamId)
+        , periodFrames_(profile_.periodFrames)
+        , periodUs_(profile_.periodMs() * 1000.0)
+        , sendIntervalUs_(periodUs_ / (1.0 + options.driftPpm * 1e-6))
+        , baseDelayUs_(profile_.designNetwork.oneWayDelayMs * 1000.0)
+        , nextSendUs_(0.0)
+        , nextSequence_(0)
+        , deviceFrames_(0.0)
+        , payload_(periodFrames_ * Config::CHANNELS, 0)
+        , output_(periodFrames_ * Config::CHANNELS * 2, 0)
+        , stretchInput_(periodFrames_ * Config::CHANNELS, 0)
+        , concealed_(0)
+        , deviceUnderruns_(0) {
+        buffers_.setMaxBufferSize(profile_.maxQueuedPackets);
+        playout_.applyProfile(profile_);
+
+        // Sabit bir ton: içerik ölçütleri etkilemez, boyut gerçekçi olur
+        for (size_t i = 0; i < payload_.size(); ++i) {
+            payload_[i] = static_cast<int16_t>(3000.0 * std::sin(2.0 * 3.14159265358979323846 * 440.0 * i / Config::SAMPLE_RATE));
+        }
+    }
+
+    // Alıcının bir periyotluk adımı (simüle zaman nowUs)
+    void tick(double nowUs, std::chrono::steady_clock::time_point epoch, std::vector<double>& latencies) {
+        // Gönderici kendi saatinde periyot doldukça paket üretir
+        while (nextSendUs_ <= nowUs) {
+            NetworkImpairment::Outcome outcome = network_.next();
+            if (outcome.delivered || outcome.late) {
+                inFlight_.push({nextSendUs_ + baseDelayUs_ + outcome.delayMs * 1000.0, nextSequence_});
+            }
+            nextSequence_++;
+            nextSendUs_ = nextSequence_ * sendIntervalUs_;
+        }
+
+        // Varış zamanı gelen paketler alım yolundan kuyruğa
+        while (!inFlight_.empty() && inFlight_.top().arrivalUs <= nowUs) {
+            InFlight arrival = inFlight_.top();
+            inFlight_.pop();
+
+            auto packet = std::make_shared<AudioPacket>(reinterpret_cast<const uint8_t*>(payload_.data()),
+                                                        payload_.size() * sizeof(int16_t), arrival.sequence);
+            packet->streamId = streamId_;
+            packet->timestamp = epoch + std::chrono::microseconds(static_cast<int64_t>(arrival.arrivalUs));
+            buffers_.pushNetworkPacket(packet);
+        }
+
+        // Cihaz bir periyot çalar; yetmezse cihaz underrun
+        if (deviceFrames_ < periodFrames_) {
+            deviceUnderruns_++;
+        }
+        deviceFrames_ = std::max(0.0, deviceFrames_ - periodFrames_);
+
+        // Playback thread'i: writei bloklayana kadar (ön doldurma + 1 periyot) yazar
+        double deviceTarget = static_cast<double>((profile_.prefillPeriods + 1) * periodFrames_);
+        while (deviceFrames_ < deviceTarget) {
+            deviceFrames_ += renderPacket(nowUs, latencies);
+        }
+    }
+
+    size_t getQueueDepth() const { return buffers_.getOutputBufferSize(); }
+    double getTargetMs() const { return playout_.getTargetMs(); }
+    uint64_t getConcealed() const { return concealed_; }
+    uint64_t getDeviceUnderruns() const { return deviceUnderruns_; }
+    uint64_t getPlayoutUnderruns() const { return playout_.getUnderruns(); }
+    uint64_t getDropped() const { return buffers_.getDroppedPackets(); }
+    uint64_t getSent() const { return network_.getSent(); }
+    uint64_t getLost() const { return network_.getLost(); }
+
+private:
+    const LatencyProfile& profile_;
+    NetworkImpairment network_;
+    BufferManager buffers_;
+    PlayoutController playout_;
+    uint32_t streamId_;
+
+    size_t periodFrames_;
+    double periodUs_;
+    double sendIntervalUs_;
+    double baseDelayUs_;
+    double nextSendUs_;
+    uint32_t nextSequence_;
+    std::priority_queue<InFlight, std::vector<InFlight>, std::greater<InFlight>> inFlight_;
+
+    double deviceFrames_;
+    std::vector<int16_t> payload_;
+    std::vector<int16_t> output_;
+    std::vector<int16_t> stretchInput_;
+    uint64_t concealed_;
+    uint64_t deviceUnderruns_;
+
+    // AudioPlayer::getNextAudioData ile aynı politika; yazılan frame sayısı
+    double renderPacket(double nowUs, std::vector<double>& latencies) {
+        std::shared_ptr<AudioPacket> packet;
+        if (playout_.shouldStart(buffers_.getOutputBufferSize())) {
+            packet = buffers_.tryGetNextPlaybackPacket();
+            if (!packet) {
+                playout_.onStarved();
+            }
+        }
+
+        if (!packet) {
+            // Gizleme/sessizlik bir periyot
+            concealed_++;
+            return static_cast<double>(periodFrames_);
+        }
+
+        size_t frameBytes = Config::CHANNELS * (Config::BITS_PER_SAMPLE / 8);
+        size_t inputFrames = std::min(packet->data.size(), stretchInput_.size() * sizeof(int16_t)) / frameBytes;
+        playout_.onPacketDequeued(packet->timestamp, inputFrames);
+
+        double ratio = playout_.getStretchRatio(buffers_.getOutputBufferSize());
+        std::copy(packet->data.begin(), packet->data.begin() + inputFrames * frameBytes,
+                  reinterpret_cast<uint8_t*>(stretchInput_.data()));
+        size_t outputFrames = playout_.stretch(stretchInput_.data(), inputFrames, output_.data(),
+                                               output_.size() / Config::CHANNELS, ratio);
+
+        // Ağız-kulak: yakalama periyodu + gönderimden cihazda çalınana kadar
+        double sendUs = packet->sequenceNumber * sendIntervalUs_;
+        double playUs = nowUs + deviceFrames_ * 1e6 / Config::SAMPLE_RATE;
+        latencies.push_back((playUs - sendUs + periodUs_) / 1000.0);
+        return static_cast<double>(outputFrames);
+    }
+};
+
+// === ÖLÇÜTLER ===
+
+enum Metric : size_t {
+    METRIC_RSS_KB = 0,
+    METRIC_LIVE_BLOCKS,
+    METRIC_QUEUE_DEPTH,
+    METRIC_LATENCY_P50,
+    METRIC_LATENCY_P99,
+    METRIC_COUNT
+};
+
+struct MetricSpec {
+    const char* name;
+    const char* unit;
+    double floor;       // Mutlak eşik tabanı (küçük değerlerde gürültüyü yutmak için)
+};
+
+const MetricSpec METRICS[METRIC_COUNT] = {
+    {"rss", "KB", 1024.0},
+    {"canlı blok", "blok", 256.0},
+    {"kuyruk", "paket", 1.0},
+    {"gecikme p50", "ms", 5.0},
+    {"gecikme p99", "ms", 10.0},
+};
+
+struct Sample {
+    double hours;
+    double values[METRIC_COUNT];
+    uint64_t allocations;
+};
+
+struct Trend {
+    double baseline;
+    double slopePerHour;
+    double growth;      // Analiz süresince eğimle beklenen artış
+    double threshold;
+    bool passed;
+};
+
+double readRssKb() {
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0;
+    size_t resident = 0;
+    if (!(statm >> pages >> resident)) {
+        return 0.0;
+    }
+    return resident * (sysconf(_SC_PAGESIZE) / 1024.0);
+}
+
+double percentile(std::vector<double>& values, double fraction) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+// Isınma sonrası en küçük kareler eğimi; artış = eğim x analiz süresi
+Trend analyzeTrend(const std::vector<Sample>& samples, size_t first, Metric metric, double maxGrowthPercent) {
+    Trend trend{0.0, 0.0, 0.0, 0.0, true};
+    size_t count = samples.size() - first;
+    if (count < 3) {
+        return trend;
+    }
+
+    size_t baselineCount = std::max<size_t>(1, std::min<size_t>(3, count / 4));
+    for (size_t i = first; i < first + baselineCount; ++i) {
+        trend.baseline += samples[i].values[metric] / baselineCount;
+    }
+
+    double meanX = 0.0;
+    double meanY = 0.0;
+    for (size_t i = first; i < samples.size(); ++i) {
+        meanX += samples[i].hours / count;
+        meanY += samples[i].values[metric] / count;
+    }
+    double covariance = 0.0;
+    double variance = 0.0;
+    for (size_t i = first; i < samples.size(); ++i) {
+        double dx = samples[i].hours - meanX;
+        covariance += dx * (samples[i].values[metric] - meanY);
+        variance += dx * dx;
+    }
+
+    trend.slopePerHour = variance > 0.0 ? covariance / variance : 0.0;
+    trend.growth = trend.slopePerHour * (samples.back().hours - samples[first].hours);
+    trend.threshold = std::max(METRICS[metric].floor, std::fabs(trend.baseline) * maxGrowthPercent / 100.0);
+    trend.passed = trend.growth <= trend.threshold;
+    return trend;
+}
+
+bool writeCsv(const std::string& path, const std::vector<Sample>& samples) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Hata: CSV yazılamadı: " << path << std::endl;
+        return false;
+    }
+
+    out << "hours,rss_kb,live_blocks,queue_depth,latency_p50_ms,latency_p99_ms,allocations\n";
+    for (const auto& sample : samples) {
+        out << sample.hours;
+        for (size_t m = 0; m < METRIC_COUNT; ++m) {
+            out << ',' << sample.values[m];
+        }
+        out << ',' << sample.allocations << '\n';
+    }
+    return true;
+}
+
+bool runSoak(const SoakOptions& options) {
+    const LatencyProfile& profile = *options.profile;
+    double periodUs = profile.periodMs() * 1000.0;
+    double durationUs = options.hours * 3600.0 * 1e6;
+    double sampleUs = options.sampleSeconds * 1e6;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "=== Soak: " << options.calls << " çağrı, " << options.hours << " saat (simüle), profil "
+              << profile.name << ", periyot " << profile.periodMs() << " ms, saat kayması "
+              << options.driftPpm << " ppm ===" << std::endl;
+    std::cout << "Ağ: kayıp %" << options.impairment.lossRate * 100.0 << ", patlama "
+              << options.impairment.meanBurstLength << ", jitter " << options.impairment.jitterMs << " ms" << std::endl;
+
+    std::vector<std::unique_ptr<SoakCall>> calls;
+    for (size_t i = 0; i < options.calls; ++i) {
+        SoakOptions callOptions = options;
+        callOptions.impairment.seed = options.seed + static_cast<uint32_t>(i);
+        calls.push_back(std::make_unique<SoakCall>(callOptions, static_cast<uint32_t>(i + 1)));
+    }
+
+    std::vector<Sample> samples;
+    samples.reserve(static_cast<size_t>(durationUs / sampleUs) + 2);
+    std::vector<double> latencies;
+    latencies.reserve(static_cast<size_t>(sampleUs / periodUs * options.calls * 2));
+    std::vector<std::unique_ptr<char[]>> injectedLeak;
+
+    auto epoch = std::chrono::steady_clock::now();
+    auto wallStart = epoch;
+    double nextSampleUs = sampleUs;
+    double queueSum = 0.0;
+    size_t queueTicks = 0;
+    double leakCarry = 0.0;
+
+    for (double nowUs = 0.0; nowUs < durationUs; nowUs += periodUs) {
+        for (auto& call : calls) {
+            call->tick(nowUs, epoch, latencies);
+            queueSum += static_cast<double>(call->getQueueDepth());
+        }
+        queueTicks += calls.size();
+
+        // Dedektörün doğrulaması için bilinçli sızıntı
+        if (options.injectLeakBytesPerSecond > 0.0) {
+            leakCarry += options.injectLeakBytesPerSecond * periodUs / 1e6;
+            if (leakCarry >= 1024.0) {
+                size_t bytes = static_cast<size_t>(leakCarry);
+                injectedLeak.emplace_back(new char[bytes]);
+                std::fill(injectedLeak.back().get(), injectedLeak.back().get() + bytes, 1);
+                leakCarry -= static_cast<double>(bytes);
+            }
+        }
+
+        if (nowUs + periodUs >= nextSampleUs) {
+            Sample sample;
+            sample.hours = nextSampleUs / 3600e6;
+            sample.values[METRIC_RSS_KB] = readRssKb();
+            sample.values[METRIC_LIVE_BLOCKS] = static_cast<double>(g_liveBlocks.load(std::memory_order_relaxed));
+            sample.values[METRIC_QUEUE_DEPTH] = queueTicks > 0 ? queueSum / queueTicks : 0.0;
+            sample.values[METRIC_LATENCY_P50] = percentile(latencies, 0.50);
+            sample.values[METRIC_LATENCY_P99] = percentile(latencies, 0.99);
+            sample.allocations = g_totalAllocations.load(std::memory_order_relaxed);
+            samples.push_back(sample);
+
+            latencies.clear();
+            queueSum = 0.0;
+            queueTicks = 0;
+            nextSampleUs += sampleUs;
+        }
+    }
+
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    double simulatedSeconds = durationUs / 1e6;
+
+    uint64_t sent = 0, lost = 0, concealed = 0, deviceUnderruns = 0, playoutUnderruns = 0, dropped = 0;
+    for (const auto& call : calls) {
+        sent += call->getSent();
+        lost += call->getLost();
+        concealed += call->getConcealed();
+        deviceUnderruns += call->getDeviceUnderruns();
+        playoutUnderruns += call->getPlayoutUnderruns();
+        dropped += call->getDropped();
+    }
+
+    std::cout << "Süre: " << wallSeconds << " s duvar saati (gerçek zamanın " << std::setprecision(0)
+              << (wallSeconds > 0.0 ? simulatedSeconds / wallSeconds : 0.0) << "x hızı), " << samples.size()
+              << " örnek" << std::endl;
+    std::cout << "Paket: " << sent << " gönderilen, " << lost << " ağda kayıp, " << dropped << " kuyrukta atılan, "
+              << concealed << " gizlenen periyot, " << playoutUnderruns << " playout underrun, "
+              << deviceUnderruns << " cihaz underrun" << std::endl;
+    if (!samples.empty()) {
+        std::cout << "Ayırma: " << std::setprecision(1)
+                  << samples.back().allocations / (simulatedSeconds * options.calls) << " / çağrı-saniye" << std::endl;
+    }
+
+    if (!options.csvPath.empty() && writeCsv(options.csvPath, samples)) {
+        std::cout << "✓ Zaman serisi yazıldı: " << options.csvPath << std::endl;
+    }
+
+    size_t first = std::min(samples.size(), static_cast<size_t>(std::ceil(samples.size() * options.warmupFraction)));
+    if (samples.size() - first < 3) {
+        std::cerr << "Hata: Eğilim için yeterli örnek yok (--hours veya --sample-seconds)" << std::endl;
+        return false;
+    }
+
+    // setw bayt sayar: Türkçe karakterli başlıklarda genişlik artırılır
+    std::cout << "\n" << std::left << std::setw(14) << "ölçüt" << std::right << std::setw(12) << "taban"
+              << std::setw(12) << "son" << std::setw(13) << "eğim/saat" << std::setw(13) << "artış"
+              << std::setw(11) << "eşik" << "  birim   sonuç" << std::endl;
+
+    bool passed = true;
+    for (size_t m = 0; m < METRIC_COUNT; ++m) {
+        Metric metric = static_cast<Metric>(m);
+        Trend trend = analyzeTrend(samples, first, metric, options.maxGrowthPercent);
+        passed = passed && trend.passed;
+
+        std::cout << std::left << std::setw(13 + (m == METRIC_LIVE_BLOCKS ? 1 : 0)) << METRICS[m].name
+                  << std::right << std::setprecision(1)
+                  << std::setw(12) << trend.baseline << std::setw(12) << samples.back().values[m]
+                  << std::setw(12) << trend.slopePerHour << std::setw(11) << trend.growth
+                  << std::setw(10) << trend.threshold << "  " << std::left << std::setw(8) << METRICS[m].unit
+                  << std::right << (trend.passed ? "sabit" : "ARTIYOR") << std::endl;
+    }
+
+    std::cout << "(eşik: ısınma sonrası tabanın %" << options.maxGrowthPercent
+              << "'i veya ölçüt tabanı; artış eşiği aşarsa çıkış kodu 1)" << std::endl;
+    return passed;
+}
+
+bool parseNumber(const std::string& text, double& value) {
+    try {
+        size_t consumed = 0;
+        value = std::stod(text, &consumed);
+        return consumed == text.size() && std::isfinite(value);
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool parseUnsigned(const std::string& text, uint32_t& value) {
+    try {
+        size_t consumed = 0;
+        unsigned long parsed = std::stoul(text, &consumed);
+        if (consumed != text.size() || text[0] == '-' || parsed > UINT32_MAX) {
+            return false;
+        }
+        value = static_cast<uint32_t>(parsed);
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+void printUsage(const char* programName) {
+    std::cout << "Nova Voice Engine V2 - Uzun Süreli Dayanıklılık Testi" << std::endl;
+    std::cout << "Kullanım: " << programName << " [SEÇENEKLER]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  --profile NAME       Gecikme profili ve tasarım ağı (varsayılan: balanced)" << std::endl;
+    std::cout << "  --calls N            Eşzamanlı başsız çağrı (1-256, varsayılan: 4)" << std::endl;
+    std::cout << "  --hours H            Simüle süre (en fazla 1000, varsayılan: 2)" << std::endl;
+    std::cout << "  --drift-ppm PPM      Gönderici saat kayması (±10000, varsayılan: 50)" << std::endl;
+    std::cout << "  --loss PCT           Ağ kaybı yüzdesi (varsayılan: profilin tasarım ağı)" << std::endl;
+    std::cout << "  --burst N            Ortalama ardışık kayıp" << std::endl;
+    std::cout << "  --jitter MS          Ortalama ek gecikme" << std::endl;
+    std::cout << "  --seed N             Bozulma modeli seed'i (çağrı başına +1)" << std::endl;
+    std::cout << "  --sample-seconds S   Örnekleme penceresi (1-3600, varsayılan: 60)" << std::endl;
+    std::cout << "  --max-growth PCT     İzin verilen eğilim artışı (varsayılan: 10)" << std::endl;
+    std::cout << "  --csv FILE           Örnek zaman serisini CSV olarak yaz" << std::endl;
+    std::cout << "  --inject-leak B/S    Dedektörü doğrulamak için simüle saniye başına B bayt sızdır" << std::endl;
+    std::cout << "  -h, --help           Bu yardım mesajını göster" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    SoakOptions options;
+    ImpairmentConfig custom;
+    custom.lossRate = -1.0;
+    custom.meanBurstLength = -1.0;
+    custom.jitterMs = -1.0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        bool valid = true;
+        double number = 0.0;
+        uint32_t count = 0;
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--profile" && hasValue) {
+            options.profile = LatencyProfile::find(argv[++i]);
+            if (!options.profile) {
+                std::cerr << "Hata: Bilinmeyen profil: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (arg == "--calls" && hasValue) {
+            valid = parseUnsigned(argv[++i], count) && count >= 1 && count <= MAX_CALLS;
+            options.calls = count;
+        } else if (arg == "--hours" && hasValue) {
+            valid = parseNumber(argv[++i], options.hours) && options.hours > 0.0 && options.hours <= MAX_HOURS;
+        } else if (arg == "--drift-ppm" && hasValue) {
+            valid = parseNumber(argv[++i], options.driftPpm) && std::fabs(options.driftPpm) <= MAX_DRIFT_PPM;
+        } else if (arg == "--loss" && hasValue) {
+            valid = parseNumber(argv[++i], number) && number >= 0.0 && number <= 100.0;
+            custom.lossRate = number / 100.0;
+        } else if (arg == "--burst" && hasValue) {
+            valid = parseNumber(argv[++i], custom.meanBurstLength) && custom.meanBurstLength >= 1.0;
+        } else if (arg == "--jitter" && hasValue) {
+            valid = parseNumber(argv[++i], custom.jitterMs) && custom.jitterMs >= 0.0;
+        } else if (arg == "--seed" && hasValue) {
+            valid = parseUnsigned(argv[++i], options.seed);
+        } else if (arg == "--sample-seconds" && hasValue) {
+            valid = parseNumber(argv[++i], options.sampleSeconds) && options.sampleSeconds >= 1.0 &&
+                    options.sampleSeconds <= MAX_SAMPLE_SECONDS;
+        } else if (arg == "--max-growth" && hasValue) {
+            valid = parseNumber(argv[++i], options.maxGrowthPercent) && options.maxGrowthPercent >= 0.0;
+        } else if (arg == "--csv" && hasValue) {
+            options.csvPath = argv[++i];
+        } else if (arg == "--inject-leak" && hasValue) {
+            valid = parseNumber(argv[++i], options.injectLeakBytesPerSecond) && options.injectLeakBytesPerSecond >= 0.0;
+        } else {
+            std::cerr << "Hata: Bilinmeyen parametre: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (!valid) {
+            std::cerr << "Hata: Geçersiz değer: " << arg << " " << argv[i] << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Verilmeyen ağ parametreleri profilin tasarım ağından; geç kalma kararı
+    // simülatörün değil alıcının jitter buffer'ınındır
+    const NetworkConditions& design = options.profile->designNetwork;
+    options.impairment.lossRate = custom.lossRate >= 0.0 ? custom.lossRate : design.lossRate;
+    options.impairment.meanBurstLength = custom.meanBurstLength >= 0.0 ? custom.meanBurstLength : design.meanBurstLength;
+    options.impairment.jitterMs = custom.jitterMs >= 0.0 ? custom.jitterMs : design.jitterMs;
+    options.impairment.playoutDelayMs = 1e9;
+
+    return runSoak(options) ? 0 : 1;
+}
@@ -0,0 +1,317 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <dirent.h>
+#include <signal.h>
+#include <sys/stat.h>
+
+#include "PcmTap.h"
+#include "WavFile.h"
+
+using namespace NovaVoice;
+
+// Nova Voice Engine V2 - PCM Tap Okuyucu
+// Motorun /dev/shm'de yayınladığı oturum ring'lerini salt okunur eşler ve
+// 16 kHz sesi WAV dosyalarına ya da stdout'a (ham s16le) aktarır. Motor
+// okuyucuyu hiç beklemez: okuyucu geride kalırsa en eski örnekler üzerine
+// yazılır ve burada kayıp olarak raporlanır.
+
+namespace {
+
+constexpr size_t READ_CHUNK = 4096;
+
+std::atomic<bool> g_stop(false);
+
+void stopHandler(int) {
+    g_stop = true;
+}
+
+struct PageEntry {
+    std::string name;
+    time_t modified;
+};
+
+std::vector<PageEntry> listPages() {
+    std::vector<PageEntry> pages;
+    DIR* dir = opendir(PcmTap::DIRECTORY);
+    if (!dir) {
+        return pages;
+    }
+
+    std::string prefix = PcmTap::NAME_PREFIX;
+    while (dirent* entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        struct stat info;
+        if (stat(PcmTap::pathFor(name).c_str(), &info) == 0) {
+            pages.push_back({name, info.st_mtime});
+        }
+    }
+    closedir(dir);
+
+    // En yeni sayfa önce
+    std::sort(pages.begin(), pages.end(), [](const PageEntry& a, const PageEntry& b) {
+        return a.modified > b.modified;
+    });
+    return pages;
+}
+
+uint64_t monotonicNs() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ull + static_cast<uint64_t>(now.tv_nsec);
+}
+
+void printSessions(const PcmTapReader& reader) {
+    auto sessions = reader.listSessions();
+    uint64_t now = monotonicNs();
+
+    std::cout << std::fixed << std::setprecision(1);
+    // setw bayt sayar: Türkçe karakterli başlıklarda genişlik artırılır
+    std::cout << std::left << std::setw(6) << "ring" << std::setw(12) << "oturum" << std::setw(7) << "tür"
+              << std::setw(9) << "durum" << std::right << std::setw(11) << "süre s" << std::setw(15) << "son yazım ms" << "\n";
+    for (const auto& session : sessions) {
+        double seconds = static_cast<double>(session.writtenSamples) / reader.getSampleRate();
+        double ageMs = session.lastWriteNs > 0 && now > session.lastWriteNs ? (now - session.lastWriteNs) / 1e6 : 0.0;
+        std::cout << std::left << std::setw(6) << session.ring << std::setw(12) << session.sessionId
+                  << std::setw(6) << (session.local ? "yerel" : "uzak")
+                  << std::setw(9) << (session.ended ? "bitti" : "aktif")
+                  << std::right << std::setw(10) << seconds << std::setw(14) << ageMs << "\n";
+    }
+    if (sessions.empty()) {
+        std::cout << "  (yayınlanan oturum yok)\n";
+    }
+}
+
+// Ring başına izlenen oturum
+struct Follower {
+    PcmTapCursor cursor;
+    uint32_t sessionId = 0;
+    uint32_t generation = 0;
+    uint64_t collected = 0;
+    bool finished = false;
+    std::vector<int16_t> samples;
+};
+
+bool parseNumber(const std::string& text, double& value) {
+    try {
+        size_t consumed = 0;
+        value = std::stod(text, &consumed);
+        return consumed == text.size() && std::isfinite(value);
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool parseUnsigned(const std::string& text, uint32_t& value) {
+    try {
+        size_t consumed = 0;
+        unsigned long parsed = std::stoul(text, &consumed);
+        if (consumed != text.size() || text[0] == '-' || parsed > UINT32_MAX) {
+            return false;
+        }
+        value = static_cast<uint32_t>(parsed);
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+void printUsage(const char* programName) {
+    std::cout << "Kullanım: " << programName << " [SAYFA] [SEÇENEKLER]" << std::endl;
+    std::cout << "  SAYFA               " << PcmTap::DIRECTORY << " altındaki sayfa adı veya tam yol"
+              << " (varsayılan: en yeni " << PcmTap::NAME_PREFIX << "*)" << std::endl;
+    std::cout << "  --list              Sayfaları listele" << std::endl;
+    std::cout << "  --session ID|all    İzlenecek oturum (akış kimliği); all: tüm oturumlar" << std::endl;
+    std::cout << "  --output PATH       Tek oturum: WAV dosyası ya da - (stdout, ham s16le 16 kHz)" << std::endl;
+    std::cout << "                      all: dizin; oturum başına <id>_<generation>.wav" << std::endl;
+    std::cout << "  --duration S        S saniyelik ses toplandığında çık (varsayılan: Ctrl+C ya da oturum bitene kadar)" << std::endl;
+    std::cout << "  --interval MS       Yoklama aralığı (varsayılan: 20; ring ~2 s tutar)" << std::endl;
+    std::cout << "Seçeneksiz çalıştırılırsa sayfadaki oturumları listeler." << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string name;
+    std::string sessionArg;
+    std::string output;
+    double durationSeconds = 0.0;
+    uint32_t intervalMs = 20;
+    uint32_t sessionId = 0;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        bool valid = true;
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--list") {
+            list = true;
+        } else if (arg == "--session" && hasValue) {
+            sessionArg = argv[++i];
+            valid = sessionArg == "all" || parseUnsigned(sessionArg, sessionId);
+        } else if (arg == "--output" && hasValue) {
+            output = argv[++i];
+        } else if (arg == "--duration" && hasValue) {
+            valid = parseNumber(argv[++i], durationSeconds) && durationSeconds >= 0.0;
+        } else if (arg == "--interval" && hasValue) {
+            valid = parseUnsigned(argv[++i], intervalMs) && intervalMs >= 1;
+        } else if (!arg.empty() && arg[0] != '-' && name.empty()) {
+            name = arg;
+        } else {
+            std::cerr << "Hata: Bilinmeyen parametre: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (!valid) {
+            std::cerr << "Hata: Geçersiz değer: " << arg << " " << argv[i] << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (list) {
+        for (const auto& page : listPages()) {
+            std::cout << page.name << std::endl;
+        }
+        return 0;
+    }
+
+    if (name.empty()) {
+        auto pages = listPages();
+        if (pages.empty()) {
+            std::cerr << "Hata: " << PcmTap::DIRECTORY << " altında PCM tap sayfası yok (motor --pcm-tap ile mi çalışıyor?)" << std::endl;
+            return 1;
+        }
+        name = pages.front().name;
+    }
+
+    PcmTapReader reader;
+    if (!reader.attach(name)) {
+        return 1;
+    }
+
+    if (sessionArg.empty()) {
+        printSessions(reader);
+        return 0;
+    }
+
+    bool followAll = sessionArg == "all";
+    bool toStdout = output == "-";
+    if (output.empty() || (followAll && toStdout)) {
+        std::cerr << "Hata: --output gerekli (all için dizin, tek oturum için WAV ya da -)" << std::endl;
+        return 1;
+    }
+
+    signal(SIGINT, stopHandler);
+    signal(SIGTERM, stopHandler);
+    signal(SIGPIPE, SIG_IGN);
+
+    std::map<size_t, Follower> followers;
+    size_t maxSamples = durationSeconds > 0.0 ? static_cast<size_t>(durationSeconds * reader.getSampleRate()) : 0;
+    uint64_t totalDropped = 0;
+    size_t filesWritten = 0;
+    bool sessionSeen = false;
+    bool done = false;
+    std::vector<int16_t> chunk(READ_CHUNK);
+
+    auto finish = [&](Follower& follower) {
+        if (follower.finished) {
+            return;
+        }
+        follower.finished = true;
+        totalDropped += follower.cursor.droppedSamples;
+        if (toStdout || follower.samples.empty()) {
+            return;
+        }
+        std::string path = followAll ? output + "/" + std::to_string(follower.sessionId) + "_" +
+                                           std::to_string(follower.generation) + ".wav"
+                                     : output;
+        if (WavFile::write(path, follower.samples.data(), follower.samples.size(), reader.getSampleRate())) {
+            std::cerr << path << ": " << follower.samples.size() / static_cast<double>(reader.getSampleRate())
+                      << " s, kayıp " << follower.cursor.droppedSamples << " örnek" << std::endl;
+            filesWritten++;
+        }
+        follower.samples.clear();
+    };
+
+    while (!g_stop && !done) {
+        for (const auto& session : reader.listSessions()) {
+            if (!followAll && session.sessionId != sessionId) {
+                continue;
+            }
+            sessionSeen = true;
+
+            // Yuva yeni bir oturuma verildiyse eskisini kapat
+            Follower& follower = followers[session.ring];
+            if (follower.generation != session.generation) {
+                if (follower.generation != 0) {
+                    finish(follower);
+                }
+                follower = Follower();
+                follower.sessionId = session.sessionId;
+                follower.generation = session.generation;
+            }
+            if (follower.finished) {
+                continue;
+            }
+
+            size_t count;
+            while ((count = reader.read(session.ring, follower.cursor, chunk.data(), chunk.size())) > 0) {
+                if (toStdout) {
+                    if (fwrite(chunk.data(), sizeof(int16_t), count, stdout) != count) {
+                        g_stop = true;
+                        break;
+                    }
+                } else {
+                    follower.samples.insert(follower.samples.end(), chunk.begin(), chunk.begin() + count);
+                }
+                follower.collected += count;
+                if (maxSamples > 0 && follower.collected >= maxSamples) {
+                    finish(follower);
+                    done = !followAll;
+                    break;
+                }
+            }
+            if (toStdout) {
+                fflush(stdout);
+            }
+
+            // Tek oturum bitip boşaldıysa çık; all modunda dosyası yazılır
+            if (session.ended && follower.cursor.position >= session.writtenSamples) {
+                finish(follower);
+                done = !followAll;
+            }
+        }
+
+        if (!done) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+        }
+    }
+
+    for (auto& entry : followers) {
+        finish(entry.second);
+    }
+
+    if (!sessionSeen) {
+        std::cerr << "Uyarı: oturum görülmedi: " << sessionArg << std::endl;
+        return 1;
+    }
+    std::cerr << "Toplam kayıp " << totalDropped << " örnek" << (toStdout ? "" : ", " + std::to_string(filesWritten) + " dosya") << std::endl;
+    return 0;
+}
@@ -0,0 +1,282 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <dirent.h>
+#include <signal.h>
+#include <sys/stat.h>
+
+#include "StatsPage.h"
+
+using namespace NovaVoice;
+
+// Nova Voice Engine V2 - Canlı İstatistik Görüntüleyici
+// Motorun /dev/shm'de yayınladığı seqlock sayfasını salt okunur eşler ve
+// top benzeri bir ekranda gösterir. Okuma sistem çağrısı yapmaz, motoru
+// bekletmez; istenen sıklıkta çalıştırılabilir. Hızlar iki okuma
+// arasındaki farktan hesaplanır.
+
+namespace {
+
+// Yayın bu kadar eskiyse motor durmuş/kilitlenmiş sayılır
+constexpr double STALE_MS = 2000.0;
+
+struct PageEntry {
+    std::string name;
+    time_t modified;
+};
+
+std::vector<PageEntry> listPages() {
+    std::vector<PageEntry> pages;
+    DIR* dir = opendir(StatsPage::DIRECTORY);
+    if (!dir) {
+        return pages;
+    }
+
+    std::string prefix = StatsPage::NAME_PREFIX;
+    while (dirent* entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        struct stat info;
+        if (stat(StatsPage::pathFor(name).c_str(), &info) == 0) {
+            pages.push_back({name, info.st_mtime});
+        }
+    }
+    closedir(dir);
+
+    // En yeni sayfa önce
+    std::sort(pages.begin(), pages.end(), [](const PageEntry& a, const PageEntry& b) {
+        return a.modified > b.modified;
+    });
+    return pages;
+}
+
+const StatsSession* findSession(const StatsSnapshot& snapshot, uint32_t streamId) {
+    for (uint32_t i = 0; i < snapshot.sessionCount; ++i) {
+        if (snapshot.sessions[i].streamId == streamId) {
+            return &snapshot.sessions[i];
+        }
+    }
+    return nullptr;
+}
+
+const StatsStage* findStage(const StatsSnapshot& snapshot, const char* name) {
+    for (uint32_t i = 0; i < snapshot.stageCount; ++i) {
+        if (std::string(snapshot.stages[i].name) == name) {
+            return &snapshot.stages[i];
+        }
+    }
+    return nullptr;
+}
+
+const StatsMemory* findMemory(const StatsSnapshot& snapshot, const char* name) {
+    for (uint32_t i = 0; i < snapshot.memoryCount; ++i) {
+        if (std::string(snapshot.memory[i].name) == name) {
+            return &snapshot.memory[i];
+        }
+    }
+    return nullptr;
+}
+
+double perSecond(uint64_t current, uint64_t previous, double seconds) {
+    return seconds > 0.0 && current >= previous ? (current - previous) / seconds : 0.0;
+}
+
+// UTF-8 ad sola yaslı, görünen genişliğe göre doldurulur (etiket adları Türkçe)
+std::string padRight(const char* text, size_t width) {
+    std::string padded = text;
+    size_t columns = 0;
+    for (unsigned char c : padded) {
+        if ((c & 0xC0) != 0x80) {
+            columns++;
+        }
+    }
+    if (columns < width) {
+        padded.append(width - columns, ' ');
+    }
+    return padded;
+}
+
+void render(const StatsReader& reader, const StatsSnapshot& now, const StatsSnapshot* previous, const std::string& name) {
+    double seconds = previous ? (now.publishNs - previous->publishNs) / 1e9 : 0.0;
+    double ageMs = (StatsPage::monotonicNs() - now.publishNs) / 1e6;
+    double uptime = (now.publishNs - reader.getWriterStartNs()) / 1e9;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "nova_top - " << name << " (pid " << reader.getWriterPid() << ", çalışma " << uptime
+              << " s, yayın " << ageMs << " ms önce" << (ageMs > STALE_MS ? ", GÜNCEL DEĞİL" : "") << ")\n\n";
+
+    std::cout << "Ağ       gönderilen " << perSecond(now.sentPackets, previous ? previous->sentPackets : 0, seconds)
+              << " pkt/s, alınan " << perSecond(now.receivedPackets, previous ? previous->receivedPackets : 0, seconds)
+              << " pkt/s, başarısız " << now.failedSends << ", atılan " << now.droppedPackets
+              << ", reddedilen akış " << now.rejectedStreamPackets << "\n";
+    std::cout << "Kuyruk   giriş " << now.inputQueue << ", çıkış " << now.outputQueue
+              << ", kontrol ort " << now.controlQueueUs << " us, medya ort " << now.mediaQueueUs << " us\n";
+    std::cout << "Ses      yakalanan " << now.capturedFrames << " frame (overrun " << now.captureOverruns
+              << "), çalınan " << now.playedFrames << " frame (underrun " << now.playbackUnderruns
+              << ", gizlenen " << now.concealedFrames << ")\n";
+    std::cout << "Playout  jitter " << now.playoutJitterMs << " ms, hedef " << now.playoutTargetMs
+              << " ms, underrun " << now.playoutUnderruns << ", gerçek zamanlı ihlal " << now.rtViolations << "\n\n";
+
+    // setw bayt sayar: Türkçe karakterli başlıklarda genişlik artırılır
+    std::cout << std::left << std::setw(13) << "akış" << std::right << std::setw(10) << "kbps"
+              << std::setw(10) << "pkt/s" << std::setw(10) << "kayıp%" << std::setw(11) << "jitter ms"
+              << std::setw(8) << "kuyruk" << std::setw(14) << "toplam kayıp" << std::setw(11) << "bellek KB" << "\n";
+    for (uint32_t i = 0; i < now.sessionCount; ++i) {
+        const StatsSession& session = now.sessions[i];
+        const StatsSession* before = previous ? findSession(*previous, session.streamId) : nullptr;
+
+        double kbps = before ? perSecond(session.bytes, before->bytes, seconds) * 8.0 / 1000.0 : 0.0;
+        double packets = before ? perSecond(session.packets, before->packets, seconds) : 0.0;
+        double lossPercent = 0.0;
+        if (before && session.packets >= before->packets && session.lost >= before->lost) {
+            double received = static_cast<double>(session.packets - before->packets);
+            double lost = static_cast<double>(session.lost - before->lost);
+            lossPercent = received + lost > 0.0 ? 100.0 * lost / (received + lost) : 0.0;
+        }
+
+        std::cout << std::left << std::setw(11) << session.streamId << std::right << std::setw(10) << kbps
+                  << std::setw(10) << packets << std::setw(9) << lossPercent << std::setw(11) << session.jitterMs
+                  << std::setw(8) << session.queueDepth << std::setw(13) << session.lost
+                  << std::setw(11) << session.memoryBytes / 1024.0 << "\n";
+    }
+    if (now.sessionCount == 0) {
+        std::cout << "  (aktif uzak akış yok)\n";
+    }
+
+    std::cout << "\n" << std::left << std::setw(21) << "aşama" << std::right << std::setw(13) << "çağrı/s"
+              << std::setw(10) << "ort us" << std::setw(10) << "p99 us" << std::setw(10) << "max us"
+              << std::setw(8) << "CPU%" << "\n";
+    for (uint32_t i = 0; i < now.stageCount; ++i) {
+        const StatsStage& stage = now.stages[i];
+        const StatsStage* before = previous ? findStage(*previous, stage.name) : nullptr;
+
+        double calls = before ? perSecond(stage.calls, before->calls, seconds) : 0.0;
+        double meanUs = 0.0;
+        double cpuPercent = 0.0;
+        if (before && stage.calls > before->calls && stage.totalNs >= before->totalNs) {
+            double ns = static_cast<double>(stage.totalNs - before->totalNs);
+            meanUs = ns / 1000.0 / (stage.calls - before->calls);
+            cpuPercent = seconds > 0.0 ? 100.0 * ns / (seconds * 1e9) : 0.0;
+        }
+
+        std::cout << std::left << std::setw(20) << stage.name << std::right << std::setw(10) << calls
+                  << std::setw(10) << meanUs << std::setw(10) << stage.p99Us << std::setw(10) << stage.maxUs
+                  << std::setw(8) << cpuPercent << "\n";
+    }
+    if (now.stageCount == 0) {
+        std::cout << "  (aşama ölçümü yok)\n";
+    }
+
+    std::cout << "\n" << padRight("bellek", 18) << std::right << std::setw(12) << "canlı KB" << std::setw(10) << "blok"
+              << std::setw(12) << "ayırma/s" << std::setw(10) << "KB/s" << std::setw(14) << "eşlenmiş KB" << "\n";
+    for (uint32_t i = 0; i < now.memoryCount; ++i) {
+        const StatsMemory& memory = now.memory[i];
+        const StatsMemory* before = previous ? findMemory(*previous, memory.name) : nullptr;
+        if (memory.allocations == 0 && memory.externalBytes == 0) {
+            continue;
+        }
+
+        double allocations = before ? perSecond(memory.allocations, before->allocations, seconds) : 0.0;
+        double kbPerSecond = before ? perSecond(memory.allocatedBytes, before->allocatedBytes, seconds) / 1024.0 : 0.0;
+        std::cout << padRight(memory.name, 18) << std::right << std::setw(11) << memory.liveBytes / 1024.0
+                  << std::setw(10) << memory.liveBlocks << std::setw(11) << allocations << std::setw(10) << kbPerSecond
+                  << std::setw(12) << memory.externalBytes / 1024.0 << "\n";
+    }
+    if (now.memoryCount == 0) {
+        std::cout << "  (bellek muhasebesi derlenmemiş)\n";
+    }
+}
+
+void printUsage(const char* programName) {
+    std::cout << "Kullanım: " << programName << " [SAYFA] [SEÇENEKLER]" << std::endl;
+    std::cout << "  SAYFA               " << StatsPage::DIRECTORY << " altındaki sayfa adı veya tam yol"
+              << " (varsayılan: en yeni " << StatsPage::NAME_PREFIX << "*)" << std::endl;
+    std::cout << "  --interval MS       Yenileme aralığı (varsayılan: 1000)" << std::endl;
+    std::cout << "  --once              Bir fark aralığı ölçüp tek ekran yaz ve çık" << std::endl;
+    std::cout << "  --list              Yayınlanan sayfaları listele" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string name;
+    int intervalMs = 1000;
+    bool once = false;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--interval" && hasValue) {
+            intervalMs = std::max(10, std::stoi(argv[++i]));
+        } else if (arg == "--once") {
+            once = true;
+        } else if (arg == "--list") {
+            list = true;
+        } else if (!arg.empty() && arg[0] != '-' && name.empty()) {
+            name = arg;
+        } else {
+            std::cerr << "Hata: Bilinmeyen parametre: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (list) {
+        for (const auto& page : listPages()) {
+            std::cout << page.name << std::endl;
+        }
+        return 0;
+    }
+
+    if (name.empty()) {
+        auto pages = listPages();
+        if (pages.empty()) {
+            std::cerr << "Hata: " << StatsPage::DIRECTORY << " altında yayınlanan sayfa yok (motor çalışıyor mu?)" << std::endl;
+            return 1;
+        }
+        name = pages.front().name;
+    }
+
+    StatsReader reader;
+    if (!reader.attach(name)) {
+        return 1;
+    }
+
+    StatsSnapshot previous;
+    StatsSnapshot current;
+    bool hasPrevious = false;
+
+    // Sayfa eşlemesi motor çıkınca da geçerli kalır; SIGINT ile çıkılır
+    signal(SIGINT, SIG_DFL);
+    while (true) {
+        if (!reader.read(current)) {
+            std::cerr << "Sayfa henüz yayınlanmadı veya tutarlı okunamadı" << std::endl;
+        } else {
+            // --once: hızlar için ilk okuma yalnızca referanstır
+            if (!once || hasPrevious) {
+                if (!once) {
+                    std::cout << "\033[H\033[2J";
+                }
+                render(reader, current, hasPrevious ? &previous : nullptr, name);
+                std::cout << std::flush;
+                if (once) {
+                    return 0;
+                }
+            }
+            previous = current;
+            hasPrevious = true;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+    }
+}